@@ -76,6 +76,8 @@ option(CINOLIB_USES_EXACT_PREDICATES  "Use Exact Predicates"       OFF)
 option(CINOLIB_USES_GRAPH_CUT         "Use Graph Cut"              OFF)
 option(CINOLIB_USES_BOOST             "Use Boost"                  OFF)
 option(CINOLIB_USES_VTK               "Use VTK"                    OFF)
+option(CINOLIB_USES_PROFILER          "Use profiler zones"         OFF)
+option(CINOLIB_USES_AVX2              "Use AVX2 instructions"      OFF)
 
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -208,3 +210,19 @@ if(CINOLIB_USES_VTK)
 endif()
 
 #::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+if(CINOLIB_USES_PROFILER)
+    message("CINOLIB OPTIONAL MODULE: Profiler")
+    target_compile_definitions(cinolib ${CINOLIB_ACCESS} CINOLIB_USES_PROFILER)
+endif()
+
+#::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+if(CINOLIB_USES_AVX2)
+    message("CINOLIB OPTIONAL MODULE: AVX2")
+    if(MSVC)
+        target_compile_options(cinolib ${CINOLIB_ACCESS} /arch:AVX2)
+    else()
+        target_compile_options(cinolib ${CINOLIB_ACCESS} -mavx2)
+    endif()
+endif()
@@ -0,0 +1,82 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: compares the sort based (bulk) mesh construction used by init()
+ * against the incremental one (one poly_add per polygon). Input can either be
+ * a mesh file, or the resolution of a synthetic triangulated grid.
+ *
+ * usage:
+ *      bulk_mesh_construction [mesh | grid_resolution]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::vector<vec3d>                     verts;
+    std::vector<std::vector<unsigned int>> polys;
+
+    std::string arg = (argc>=2) ? std::string(argv[1]) : std::string("1000");
+    if(arg.find('.')!=std::string::npos)
+    {
+        Trimesh<> tmp(arg.c_str());
+        verts = tmp.vector_verts();
+        polys = tmp.vector_polys();
+    }
+    else
+    {
+        unsigned int n = std::stoi(arg);
+        for(unsigned int i=0; i<=n; ++i)
+        for(unsigned int j=0; j<=n; ++j)
+        {
+            verts.push_back(vec3d{double(i),double(j),0.0});
+        }
+        for(unsigned int i=0; i<n; ++i)
+        for(unsigned int j=0; j<n; ++j)
+        {
+            unsigned int v0 = i*(n+1)+j;
+            unsigned int v1 = v0+1;
+            unsigned int v2 = v0+n+1;
+            unsigned int v3 = v2+1;
+            polys.push_back({v0,v1,v3});
+            polys.push_back({v0,v3,v2});
+        }
+    }
+
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    Trimesh<> m_incr;
+    m_incr.init_incremental(verts, polys);
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    Trimesh<> m_bulk;
+    m_bulk.init(verts, polys);
+    std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+    // make sure the two meshes have exactly the same topology
+    bool same = (m_incr.num_verts()    == m_bulk.num_verts() &&
+                 m_incr.num_edges()    == m_bulk.num_edges() &&
+                 m_incr.num_polys()    == m_bulk.num_polys() &&
+                 m_incr.vector_edges() == m_bulk.vector_edges());
+    for(unsigned int vid=0; same && vid<m_bulk.num_verts(); ++vid)
+    {
+        same = (m_incr.adj_v2v(vid) == m_bulk.adj_v2v(vid) &&
+                m_incr.adj_v2e(vid) == m_bulk.adj_v2e(vid) &&
+                m_incr.adj_v2p(vid) == m_bulk.adj_v2p(vid));
+    }
+    for(unsigned int eid=0; same && eid<m_bulk.num_edges(); ++eid)
+    {
+        same = (m_incr.adj_e2p(eid) == m_bulk.adj_e2p(eid));
+    }
+    for(unsigned int pid=0; same && pid<m_bulk.num_polys(); ++pid)
+    {
+        same = (m_incr.adj_p2e(pid) == m_bulk.adj_p2e(pid) &&
+                m_incr.adj_p2p(pid) == m_bulk.adj_p2p(pid));
+    }
+
+    std::cout << "\n" << m_bulk.num_polys() << " triangles" << std::endl;
+    std::cout << "incremental construction : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "bulk construction        : " << how_many_seconds(t1,t2) << "s" << std::endl;
+    std::cout << "speedup                  : " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x" << std::endl;
+    std::cout << "same topology            : " << (same ? "YES" : "NO") << "\n" << std::endl;
+
+    return same ? 0 : -1;
+}
@@ -0,0 +1,92 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/octree.h>
+#include <cinolib/bvh.h>
+#include <cinolib/how_many_seconds.h>
+#include <random>
+
+/* Benchmark: compares the BVH against the Octree on ray casting and closest
+ * point queries. Queries are random points (and directions) sampled in a box
+ * slightly larger than the bounding box of the input mesh.
+ *
+ * usage:
+ *      bvh [mesh] [#queries]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n_queries = (argc>=3) ? atoi(argv[2]) : 100000;
+    Trimesh<> m(s.c_str());
+
+    Time::time_point t0 = Time::now();
+    Octree octree;
+    octree.build_from_mesh_polys(m);
+    Time::time_point t1 = Time::now();
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+    Time::time_point t2 = Time::now();
+
+    std::cout << "\n" << m.num_polys() << " triangles" << std::endl;
+    std::cout << "build         : Octree " << how_many_seconds(t0,t1) << "s\tBVH " << how_many_seconds(t1,t2) << "s" << std::endl;
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> rnd(0,1);
+    AABB  box = m.bbox();
+    vec3d d   = box.delta();
+    std::vector<vec3d> points, dirs;
+    for(unsigned int i=0; i<n_queries; ++i)
+    {
+        points.push_back(box.min + vec3d{(1.4*rnd(rng)-0.2)*d[0], (1.4*rnd(rng)-0.2)*d[1], (1.4*rnd(rng)-0.2)*d[2]});
+        vec3d dir{rnd(rng)-0.5, rnd(rng)-0.5, rnd(rng)-0.5};
+        dir.normalize();
+        dirs.push_back(dir);
+    }
+
+    // ray casting (first hit)
+    unsigned int mismatches = 0;
+    std::vector<double> t_octree(n_queries,-1), t_bvh(n_queries,-1);
+    t0 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i)
+    {
+        unsigned int id;
+        octree.intersects_ray(points[i], dirs[i], t_octree[i], id);
+    }
+    t1 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i)
+    {
+        unsigned int id;
+        bvh.intersects_ray(points[i], dirs[i], t_bvh[i], id);
+    }
+    t2 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i) if(std::fabs(t_octree[i]-t_bvh[i])>1e-9) ++mismatches;
+    std::cout << "ray casting   : Octree " << how_many_seconds(t0,t1) << "s\tBVH " << how_many_seconds(t1,t2) << "s"
+              << "\t(speedup " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x)" << std::endl;
+
+    // closest point (note: the Octree returns squared distances)
+    std::vector<double> d_octree(n_queries), d_bvh(n_queries);
+    t0 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i)
+    {
+        unsigned int id;
+        vec3d pos;
+        octree.closest_point(points[i], id, pos, d_octree[i]);
+    }
+    t1 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i)
+    {
+        unsigned int id;
+        vec3d pos;
+        bvh.closest_point(points[i], id, pos, d_bvh[i]);
+    }
+    t2 = Time::now();
+    for(unsigned int i=0; i<n_queries; ++i) if(std::fabs(std::sqrt(d_octree[i])-d_bvh[i])>1e-9) ++mismatches;
+    std::cout << "closest point : Octree " << how_many_seconds(t0,t1) << "s\tBVH " << how_many_seconds(t1,t2) << "s"
+              << "\t(speedup " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x)" << std::endl;
+
+    std::cout << "mismatches    : " << mismatches << "\n" << std::endl;
+
+    return (mismatches==0) ? 0 : -1;
+}
@@ -0,0 +1,105 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/bvh.h>
+#include <cinolib/how_many_seconds.h>
+#include <random>
+
+/* Benchmark: compares batched (packet) ray queries against a loop of scalar
+ * BVH::intersects_ray calls, both for first hit and any hit (occlusion).
+ * Two sets of rays are traced: coherent rays, shot from a pinhole camera
+ * through the pixels of a res x res image, and incoherent random rays.
+ *
+ * usage:
+ *      batched_ray_queries [mesh] [res]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s   = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int res = (argc>=3) ? atoi(argv[2]) : 1024;
+    Trimesh<> m(s.c_str());
+
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+
+    // coherent rays: a pinhole camera looking at the mesh along -Z.
+    // Pixels are visited in 2x4 tiles, so that each packet covers a tile
+    AABB  box = m.bbox();
+    vec3d eye = box.center() + vec3d{0, 0, 2*box.diag()};
+    std::vector<vec3d> coherent_p, coherent_dir;
+    for(unsigned int i=0; i<res; i+=2)
+    for(unsigned int j=0; j<res; j+=4)
+    for(unsigned int ii=i; ii<i+2; ++ii)
+    for(unsigned int jj=j; jj<j+4; ++jj)
+    {
+        vec3d target = box.center() + vec3d{(double(jj)/res-0.5)*box.diag(), (double(ii)/res-0.5)*box.diag(), 0};
+        vec3d dir    = target - eye;
+        dir.normalize();
+        coherent_p.push_back(eye);
+        coherent_dir.push_back(dir);
+    }
+
+    // incoherent rays: random origins and directions around the mesh
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> rnd(0,1);
+    vec3d d = box.delta();
+    std::vector<vec3d> random_p, random_dir;
+    for(unsigned int i=0; i<coherent_p.size(); ++i)
+    {
+        random_p.push_back(box.min + vec3d{(1.4*rnd(rng)-0.2)*d[0], (1.4*rnd(rng)-0.2)*d[1], (1.4*rnd(rng)-0.2)*d[2]});
+        vec3d dir{rnd(rng)-0.5, rnd(rng)-0.5, rnd(rng)-0.5};
+        dir.normalize();
+        random_dir.push_back(dir);
+    }
+
+    std::cout << "\n" << m.num_polys() << " triangles, " << coherent_p.size() << " rays per test" << std::endl;
+
+    unsigned int mismatches = 0;
+    auto run = [&](const std::string & name, const std::vector<vec3d> & p, const std::vector<vec3d> & dir)
+    {
+        unsigned int n = static_cast<unsigned int>(p.size());
+
+        // first hit
+        Time::time_point t0 = Time::now();
+        std::vector<double> t_scalar(n, inf_double);
+        for(unsigned int i=0; i<n; ++i)
+        {
+            unsigned int id;
+            bvh.intersects_ray(p[i], dir[i], t_scalar[i], id);
+        }
+        Time::time_point t1 = Time::now();
+        std::vector<double> t_batch;
+        std::vector<int>    ids;
+        bvh.intersects_rays(p, dir, t_batch, ids);
+        Time::time_point t2 = Time::now();
+        for(unsigned int i=0; i<n; ++i) if(std::fabs(t_scalar[i]-t_batch[i])>1e-9 && t_scalar[i]!=t_batch[i]) ++mismatches;
+
+        // any hit
+        std::vector<bool> occ_scalar(n);
+        for(unsigned int i=0; i<n; ++i)
+        {
+            double       t;
+            unsigned int id;
+            occ_scalar[i] = bvh.intersects_ray(p[i], dir[i], t, id);
+        }
+        Time::time_point t3 = Time::now();
+        std::vector<bool> occ_batch;
+        bvh.intersects_rays_any(p, dir, occ_batch);
+        Time::time_point t4 = Time::now();
+        if(occ_scalar!=occ_batch) ++mismatches;
+
+        std::cout << name << " first hit : scalar " << how_many_seconds(t0,t1) << "s\tbatched " << how_many_seconds(t1,t2) << "s"
+                  << "\t(" << n/how_many_seconds(t1,t2)*1e-6 << " Mrays/s, speedup " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x)" << std::endl;
+        std::cout << name << " any hit   : scalar " << how_many_seconds(t2,t3) << "s\tbatched " << how_many_seconds(t3,t4) << "s"
+                  << "\t(" << n/how_many_seconds(t3,t4)*1e-6 << " Mrays/s, speedup " << how_many_seconds(t2,t3)/how_many_seconds(t3,t4) << "x)" << std::endl;
+    };
+
+    run("coherent  ", coherent_p, coherent_dir);
+    run("incoherent", random_p,   random_dir);
+
+    std::cout << "mismatches           : " << mismatches << "\n" << std::endl;
+
+    return (mismatches==0) ? 0 : -1;
+}
@@ -0,0 +1,78 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/signed_distance.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: samples the signed distance from a triangle mesh at the nodes of
+ * a res x res x res regular grid enclosing it. Unsigned distances computed with
+ * batched closest point queries (BVH::closest_points) are compared against a
+ * loop of scalar BVH::closest_point calls, then the field is signed using the
+ * angle weighted pseudo normals (see signed_distance.h).
+ *
+ * usage:
+ *      signed_distance_field [mesh] [res]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s   = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int res = (argc>=3) ? atoi(argv[2]) : 128;
+    Trimesh<> m(s.c_str());
+
+    Time::time_point t0 = Time::now();
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+    Time::time_point t1 = Time::now();
+
+    // grid nodes, in scanline order
+    AABB  box = m.bbox();
+    box.scale(1.2);
+    vec3d d = box.delta();
+    std::vector<vec3d> points;
+    points.reserve(res*res*res);
+    for(unsigned int i=0; i<res; ++i)
+    for(unsigned int j=0; j<res; ++j)
+    for(unsigned int k=0; k<res; ++k)
+    {
+        points.push_back(box.min + vec3d{d[0]*i/(res-1), d[1]*j/(res-1), d[2]*k/(res-1)});
+    }
+    unsigned int n = static_cast<unsigned int>(points.size());
+
+    Time::time_point t2 = Time::now();
+    std::vector<double> dist_scalar(n);
+    for(unsigned int i=0; i<n; ++i)
+    {
+        unsigned int id;
+        vec3d        pos;
+        bvh.closest_point(points[i], id, pos, dist_scalar[i]);
+    }
+    Time::time_point t3 = Time::now();
+    std::vector<unsigned int> ids;
+    std::vector<vec3d>        pos;
+    std::vector<double>       dist_batch;
+    bvh.closest_points(points, ids, pos, dist_batch);
+    Time::time_point t4 = Time::now();
+    std::vector<double> sdf;
+    signed_distances(m, bvh, points, sdf);
+    Time::time_point t5 = Time::now();
+
+    unsigned int mismatches = 0;
+    unsigned int inside     = 0;
+    for(unsigned int i=0; i<n; ++i)
+    {
+        if(std::fabs(dist_scalar[i]-dist_batch[i])>1e-9) ++mismatches;
+        if(std::fabs(std::fabs(sdf[i])-dist_batch[i])>1e-9) ++mismatches;
+        if(sdf[i]<0) ++inside;
+    }
+
+    std::cout << "\n" << m.num_polys() << " triangles, " << res << "^3 grid (" << n << " points)" << std::endl;
+    std::cout << "BVH build            : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "scalar closest point : " << how_many_seconds(t2,t3) << "s" << std::endl;
+    std::cout << "batch closest points : " << how_many_seconds(t3,t4) << "s\t(speedup " << how_many_seconds(t2,t3)/how_many_seconds(t3,t4) << "x)" << std::endl;
+    std::cout << "signed distances     : " << how_many_seconds(t4,t5) << "s\t(" << inside << " points inside)" << std::endl;
+    std::cout << "mismatches           : " << mismatches << "\n" << std::endl;
+
+    return (mismatches==0) ? 0 : -1;
+}
@@ -0,0 +1,85 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: compares loading a mesh from a text file (OBJ) against loading
+ * it from the native binary format (.cinobin), with and without precomputed
+ * adjacency. Input can either be a mesh file, or the resolution of a synthetic
+ * triangulated grid. Output files are written in the current directory.
+ *
+ * usage:
+ *      binary_mesh_format [mesh | grid_resolution]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    Trimesh<> m;
+    std::string arg = (argc>=2) ? std::string(argv[1]) : std::string("1000");
+    if(arg.find('.')!=std::string::npos)
+    {
+        m.load(arg.c_str());
+    }
+    else
+    {
+        std::vector<vec3d>                     verts;
+        std::vector<std::vector<unsigned int>> polys;
+        unsigned int n = std::stoi(arg);
+        for(unsigned int i=0; i<=n; ++i)
+        for(unsigned int j=0; j<=n; ++j)
+        {
+            verts.push_back(vec3d{double(i),double(j),0.0});
+        }
+        for(unsigned int i=0; i<n; ++i)
+        for(unsigned int j=0; j<n; ++j)
+        {
+            unsigned int v0 = i*(n+1)+j;
+            unsigned int v1 = v0+1;
+            unsigned int v2 = v0+n+1;
+            unsigned int v3 = v2+1;
+            polys.push_back({v0,v1,v3});
+            polys.push_back({v0,v3,v2});
+        }
+        m.init(verts, polys);
+    }
+
+    Time::time_point t0 = Time::now();
+    m.save("bench.obj");
+    Time::time_point t1 = Time::now();
+    m.save_BIN("bench.cinobin");
+    Time::time_point t2 = Time::now();
+    m.save_BIN("bench_noadj.cinobin", false);
+    Time::time_point t3 = Time::now();
+
+    Trimesh<> m_obj("bench.obj");
+    Time::time_point t4 = Time::now();
+    Trimesh<> m_bin("bench.cinobin");
+    Time::time_point t5 = Time::now();
+    Trimesh<> m_noadj("bench_noadj.cinobin");
+    Time::time_point t6 = Time::now();
+
+    // make sure the binary files restore exactly the same mesh
+    bool same = (m_bin.num_verts()      == m.num_verts()      &&
+                 m_bin.num_polys()      == m.num_polys()      &&
+                 m_bin.vector_edges()   == m.vector_edges()   &&
+                 m_noadj.vector_edges() == m.vector_edges()   &&
+                 m_bin.vector_verts()   == m.vector_verts()   &&
+                 m_bin.vector_polys()   == m.vector_polys());
+    for(unsigned int vid=0; same && vid<m.num_verts(); ++vid)
+    {
+        same = (m_bin.adj_v2p_span(vid) == m.adj_v2p(vid) &&
+                m_noadj.adj_v2p(vid)   == m.adj_v2p(vid));
+    }
+
+    std::cout << "\n" << m.num_polys() << " triangles" << std::endl;
+    std::cout << "save OBJ                   : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "save cinobin               : " << how_many_seconds(t1,t2) << "s" << std::endl;
+    std::cout << "save cinobin (no adjacency): " << how_many_seconds(t2,t3) << "s" << std::endl;
+    std::cout << "load OBJ                   : " << how_many_seconds(t3,t4) << "s" << std::endl;
+    std::cout << "load cinobin               : " << how_many_seconds(t4,t5) << "s\t(speedup " << how_many_seconds(t3,t4)/how_many_seconds(t4,t5) << "x)" << std::endl;
+    std::cout << "load cinobin (no adjacency): " << how_many_seconds(t5,t6) << "s\t(speedup " << how_many_seconds(t3,t4)/how_many_seconds(t5,t6) << "x)" << std::endl;
+    std::cout << "same mesh                  : " << (same ? "yes" : "no") << "\n" << std::endl;
+
+    return same ? 0 : -1;
+}
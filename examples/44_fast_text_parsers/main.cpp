@@ -0,0 +1,127 @@
+#include <cinolib/io/read_OBJ.h>
+#include <cinolib/io/read_OFF.h>
+#include <cinolib/io/write_OBJ.h>
+#include <cinolib/io/write_OFF.h>
+#include <cinolib/how_many_seconds.h>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+/* Benchmark: measures the throughput of the OBJ and OFF readers on a synthetic
+ * triangulated grid (res x res vertices), and compares it with a plain serial
+ * reader based on std::getline and sscanf (i.e. the approach used by the
+ * previous implementation). Output files are written in the current directory.
+ *
+ * usage:
+ *      fast_text_parsers [res]
+*/
+
+using namespace cinolib;
+
+void read_OBJ_getline(const char * filename, std::vector<vec3d> & verts, std::vector<std::vector<unsigned int>> & polys)
+{
+    std::ifstream f(filename);
+    std::string line;
+    while(std::getline(f,line))
+    {
+        double a, b, c;
+        if(line[0]=='v' && sscanf(line.data(), "v %lf %lf %lf", &a, &b, &c)==3) verts.push_back(vec3d{a,b,c});
+        else if(line[0]=='f')
+        {
+            std::istringstream ss(line.substr(1));
+            std::vector<unsigned int> p;
+            for(std::string tok; ss >> tok;)
+            {
+                int vid;
+                if(sscanf(tok.c_str(), "%d", &vid)==1) p.push_back(vid-1);
+            }
+            polys.push_back(p);
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+void read_OFF_getline(const char * filename, std::vector<vec3d> & verts, std::vector<std::vector<unsigned int>> & polys)
+{
+    std::ifstream f(filename);
+    std::string line;
+    unsigned int nv, np, ne;
+    do getline(f, line); while(line.find("OFF")==std::string::npos);
+    do getline(f, line); while(sscanf(line.c_str(), "%d %d %d", &nv, &np, &ne)!=3);
+    while(verts.size()<nv && getline(f,line))
+    {
+        std::stringstream ss(line);
+        double x, y, z;
+        if(ss >> x >> y >> z) verts.push_back(vec3d{x,y,z});
+    }
+    while(polys.size()<np && getline(f,line))
+    {
+        std::stringstream ss(line);
+        unsigned int n, vid;
+        if(!(ss >> n)) continue;
+        std::vector<unsigned int> p;
+        for(unsigned int j=0; j<n && ss >> vid; ++j) p.push_back(vid);
+        polys.push_back(p);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+int main(int argc, char **argv)
+{
+    typedef std::chrono::high_resolution_clock Time;
+
+    unsigned int res = (argc>=2) ? atoi(argv[1]) : 1000;
+
+    // synthetic (slightly bumpy) grid, with coordinates written at full precision
+    std::vector<double>                    xyz;
+    std::vector<std::vector<unsigned int>> tris;
+    for(unsigned int i=0; i<res; ++i)
+    for(unsigned int j=0; j<res; ++j)
+    {
+        xyz.push_back(i/double(res));
+        xyz.push_back(j/double(res));
+        xyz.push_back(0.01*sin(0.1*i)*cos(0.1*j));
+    }
+    for(unsigned int i=0; i+1<res; ++i)
+    for(unsigned int j=0; j+1<res; ++j)
+    {
+        unsigned int v0 = i*res+j;
+        tris.push_back({v0, v0+1, v0+res+1});
+        tris.push_back({v0, v0+res+1, v0+res});
+    }
+    write_OBJ("bench.obj", xyz, tris);
+    write_OFF("bench.off", xyz, tris);
+
+    auto file_size = [](const char * filename)
+    {
+        std::ifstream f(filename, std::ios::binary | std::ios::ate);
+        return double(f.tellg())/(1024*1024);
+    };
+
+    bool same = true;
+    auto run = [&](const char * name, const char * filename, auto baseline, auto reader)
+    {
+        std::vector<vec3d> v0, v1;
+        std::vector<std::vector<unsigned int>> p0, p1;
+        Time::time_point t0 = Time::now();
+        baseline(filename, v0, p0);
+        Time::time_point t1 = Time::now();
+        reader(filename, v1, p1);
+        Time::time_point t2 = Time::now();
+        same = same && (v0.size()==v1.size()) && (p0==p1);
+        for(unsigned int i=0; same && i<v0.size(); ++i) same = (v0[i]==v1[i]);
+        double mb = file_size(filename);
+        std::cout << name << " (" << mb << " MB): getline+sscanf " << how_many_seconds(t0,t1) << "s (" << mb/how_many_seconds(t0,t1) << " MB/s)"
+                  << "\treader " << how_many_seconds(t1,t2) << "s (" << mb/how_many_seconds(t1,t2) << " MB/s, speedup "
+                  << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x)" << std::endl;
+    };
+
+    std::cout << "\n" << res*res << " vertices, " << tris.size() << " triangles" << std::endl;
+    run("OBJ", "bench.obj", read_OBJ_getline, [](const char * f, std::vector<vec3d> & v, std::vector<std::vector<unsigned int>> & p) { read_OBJ(f,v,p); });
+    run("OFF", "bench.off", read_OFF_getline, [](const char * f, std::vector<vec3d> & v, std::vector<std::vector<unsigned int>> & p) { read_OFF(f,v,p); });
+    std::cout << "same output: " << (same ? "yes" : "no") << "\n" << std::endl;
+
+    return same ? 0 : -1;
+}
@@ -0,0 +1,104 @@
+#include <cinolib/io/read_STL.h>
+#include <cinolib/io/write_STL.h>
+#include <cinolib/vertex_welder.h>
+#include <cinolib/geometry/aabb.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Streaming (out-of-core) STL processing: the input file is read in batches
+ * of triangles of fixed size, and each batch is used to accumulate surface
+ * area, enclosed volume and bounding box, to weld coincident vertices and to
+ * convert the file to the other STL flavour (binary <=> ASCII). At no point
+ * the full mesh is stored in memory: only the current batch and the welded
+ * vertices are. If no input is provided, a synthetic binary STL is generated
+ * with the streaming writer.
+ *
+ * usage:
+ *      streaming_STL [input.stl] [output.stl] [weld_eps]
+*/
+
+using namespace cinolib;
+
+int main(int argc, char **argv)
+{
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string in  = (argc>=2) ? argv[1] : "bench.stl";
+    std::string out = (argc>=3) ? argv[2] : "converted.stl";
+    double      eps = (argc>=4) ? atof(argv[3]) : 0.0;
+
+    if(argc<2)
+    {
+        // synthetic closed surface: a res x res parametric torus
+        unsigned int res = 700;
+        STLWriter w(in.c_str());
+        auto torus = [&](unsigned int i, unsigned int j)
+        {
+            double u = 2*M_PI*(i%res)/res, v = 2*M_PI*(j%res)/res;
+            return vec3d{(1+0.3*cos(v))*cos(u), (1+0.3*cos(v))*sin(u), 0.3*sin(v)};
+        };
+        for(unsigned int i=0; i<res; ++i)
+        for(unsigned int j=0; j<res; ++j)
+        {
+            w.write(torus(i,j), torus(i+1,j), torus(i+1,j+1));
+            w.write(torus(i,j), torus(i+1,j+1), torus(i,j+1));
+        }
+        std::cout << "\nwritten synthetic STL " << in << " (" << w.num_triangles() << " triangles)" << std::endl;
+    }
+
+    // detect the input flavour, so as to write the other one
+    bool in_is_binary;
+    {
+        std::ifstream f(in, std::ios::binary);
+        char c[6] = {0};
+        f.read(c,5);
+        in_is_binary = std::string(c)!="solid";
+        uint32_t nt = 0;
+        f.seekg(80);
+        f.read((char*)&nt, 4);
+        f.seekg(0, std::ios::end);
+        if(uint64_t(f.tellg())==84+50*uint64_t(nt)) in_is_binary = true;
+    }
+
+    Time::time_point t0 = Time::now();
+
+    double       area   = 0;
+    double       volume = 0;
+    AABB         bbox;
+    VertexWelder welder(eps);
+    STLWriter    writer(out.c_str(), !in_is_binary);
+    const unsigned int batch_size = 65536;
+
+    size_t nt = stream_STL(in.c_str(), [&](const std::vector<vec3d> & tri_verts, const std::vector<vec3d> & tri_normals)
+    {
+        for(size_t i=0; i<tri_normals.size(); ++i)
+        {
+            const vec3d & v0 = tri_verts.at(3*i  );
+            const vec3d & v1 = tri_verts.at(3*i+1);
+            const vec3d & v2 = tri_verts.at(3*i+2);
+            area   += 0.5*(v1-v0).cross(v2-v0).norm();
+            volume += v0.dot(v1.cross(v2))/6.0;
+            bbox.push(v0);
+            bbox.push(v1);
+            bbox.push(v2);
+            welder.weld(v0);
+            welder.weld(v1);
+            welder.weld(v2);
+        }
+        writer.write(tri_verts, tri_normals);
+    },
+    batch_size);
+    writer.close();
+
+    Time::time_point t1 = Time::now();
+
+    std::cout << "\nstreamed " << nt << " triangles from " << in << " in " << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    std::cout << "area         : " << area   << std::endl;
+    std::cout << "volume       : " << volume << std::endl;
+    std::cout << "bbox         : " << bbox.min << " - " << bbox.max << std::endl;
+    std::cout << "welded verts : " << welder.num_verts() << " (eps=" << eps << ", from " << 3*nt << " soup verts)" << std::endl;
+    std::cout << "converted to : " << out << (in_is_binary ? " (ASCII)" : " (binary)") << std::endl;
+    std::cout << "memory used  : " << (4*batch_size*sizeof(vec3d))/(1024*1024) << " MB of batch buffers (vs "
+              << (nt*4*sizeof(vec3d))/(1024*1024) << " MB to store the triangle soup)\n" << std::endl;
+
+    return 0;
+}
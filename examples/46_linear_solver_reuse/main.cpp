@@ -0,0 +1,74 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/harmonic_map.h>
+#include <cinolib/heat_flow.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: compares repeated solves of the same linear operator with and
+ * without a persistent LinearSystemSolver. Two workloads are considered:
+ *
+ *  - a 3D harmonic map whose Dirichlet values change at every iteration
+ *    (e.g. an interactive deformation tool), where the persistent solver
+ *    factorizes once and solves the three coordinates as a 3 column rhs
+ *  - heat diffusion from a different source at every iteration
+ *
+ * usage:
+ *      linear_solver_reuse [mesh] [iterations]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s     = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int iters = (argc>=3) ? atoi(argv[2]) : 20;
+    Trimesh<> m(s.c_str());
+
+    // handles: a few vertices, moved a little more at every iteration
+    std::map<unsigned int,vec3d> bc;
+    for(unsigned int i=0; i<10; ++i) bc[i*m.num_verts()/10] = vec3d{0,0,0};
+    auto update_bc = [&](unsigned int it)
+    {
+        for(auto & obj : bc) obj.second = m.vert(obj.first) + vec3d{0, 0.01*it*m.bbox().diag(), 0};
+    };
+
+    Time::time_point t0 = Time::now();
+    std::vector<vec3d> res0;
+    for(unsigned int it=0; it<iters; ++it)
+    {
+        update_bc(it);
+        res0 = harmonic_map_3d(m, bc);
+    }
+    Time::time_point t1 = Time::now();
+    LinearSystemSolver solver;
+    std::vector<vec3d> res1;
+    for(unsigned int it=0; it<iters; ++it)
+    {
+        update_bc(it);
+        res1 = harmonic_map_3d(m, bc, solver);
+    }
+    Time::time_point t2 = Time::now();
+
+    double err = 0;
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid) err = std::max(err, res0.at(vid).dist(res1.at(vid)));
+
+    std::cout << "\n" << iters << " harmonic maps (" << m.num_verts() << " verts)" << std::endl;
+    std::cout << "  factorize every time   : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "  LinearSystemSolver     : " << how_many_seconds(t1,t2) << "s ("
+              << solver.num_factorizations() << " factorization(s), speedup " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x, max diff " << err << ")" << std::endl;
+
+    t0 = Time::now();
+    ScalarField h0, h1;
+    for(unsigned int it=0; it<iters; ++it) h0 = heat_flow(m, {it*m.num_verts()/iters});
+    t1 = Time::now();
+    LinearSystemSolver heat_solver;
+    for(unsigned int it=0; it<iters; ++it) h1 = heat_flow(m, {it*m.num_verts()/iters}, heat_solver);
+    t2 = Time::now();
+
+    std::cout << "\n" << iters << " heat flows (" << m.num_verts() << " verts)" << std::endl;
+    std::cout << "  factorize every time   : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "  LinearSystemSolver     : " << how_many_seconds(t1,t2) << "s ("
+              << heat_solver.num_factorizations() << " factorization(s), speedup " << how_many_seconds(t0,t1)/how_many_seconds(t1,t2) << "x, diff " << (h0-h1).norm() << ")\n" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/dijkstra.h>
+#include <cinolib/dijkstra_engine.h>
+#include <cinolib/how_many_seconds.h>
+#include <random>
+
+/* Benchmark: compares the dijkstra* free functions with a DijkstraEngine bound
+ * to the mesh once, for three typical workloads:
+ *
+ *  - full distance fields from many sources (serial and parallel batch)
+ *  - distance fields bounded by a max radius (local neighborhoods)
+ *  - point to point shortest paths (early exit at the target)
+ *
+ * usage:
+ *      dijkstra_engine [mesh] [num_queries]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n = (argc>=3) ? atoi(argv[2]) : 200;
+    Trimesh<> m(s.c_str());
+
+    std::mt19937 rng(0);
+    std::vector<unsigned int> sources(n), targets(n);
+    for(unsigned int i=0; i<n; ++i)
+    {
+        sources.at(i) = rng()%m.num_verts();
+        targets.at(i) = rng()%m.num_verts();
+    }
+
+    Time::time_point t0 = Time::now();
+    DijkstraEngine dijkstra(m);
+    Time::time_point t1 = Time::now();
+    std::cout << "\nEngine bound to " << m.num_verts() << " verts in " << how_many_seconds(t0,t1) << "s" << std::endl;
+
+    // full distance fields
+    bool same = true;
+    std::vector<double> d0, d1;
+    double t_free = 0, t_engine = 0;
+    for(unsigned int i=0; i<n; ++i)
+    {
+        t0 = Time::now(); dijkstra_exhaustive(m, sources.at(i), d0);
+        t1 = Time::now(); dijkstra.distances({sources.at(i)}, d1);
+        Time::time_point t2 = Time::now();
+        t_free   += how_many_seconds(t0,t1);
+        t_engine += how_many_seconds(t1,t2);
+        same &= (d0==d1);
+    }
+    std::vector<std::vector<double>> batch;
+    t0 = Time::now();
+    dijkstra.distances_batch(sources, batch);
+    t1 = Time::now();
+    std::cout << "\n" << n << " distance fields" << std::endl;
+    std::cout << "  dijkstra_exhaustive      : " << t_free   << "s" << std::endl;
+    std::cout << "  DijkstraEngine           : " << t_engine << "s (" << t_free/t_engine << "x)" << std::endl;
+    std::cout << "  DijkstraEngine (batch)   : " << how_many_seconds(t0,t1) << "s (" << t_free/how_many_seconds(t0,t1) << "x)" << std::endl;
+
+    // radius bounded
+    double r = 0.05*m.bbox().diag();
+    t0 = Time::now();
+    for(unsigned int i=0; i<n; ++i) dijkstra.distances({sources.at(i)}, d1, r);
+    t1 = Time::now();
+    std::cout << "  DijkstraEngine (r=5%)    : " << how_many_seconds(t0,t1) << "s (" << t_free/how_many_seconds(t0,t1) << "x)" << std::endl;
+
+    // point to point
+    std::vector<unsigned int> p0, p1;
+    t_free = t_engine = 0;
+    for(unsigned int i=0; i<n; ++i)
+    {
+        t0 = Time::now(); double l0 = cinolib::dijkstra(m, sources.at(i), targets.at(i), p0);
+        t1 = Time::now(); double l1 = dijkstra.shortest_path(sources.at(i), targets.at(i), p1);
+        Time::time_point t2 = Time::now();
+        t_free   += how_many_seconds(t0,t1);
+        t_engine += how_many_seconds(t1,t2);
+        same &= (p0==p1 && l0==l1);
+    }
+    std::cout << "\n" << n << " shortest paths" << std::endl;
+    std::cout << "  dijkstra                 : " << t_free   << "s" << std::endl;
+    std::cout << "  DijkstraEngine           : " << t_engine << "s (" << t_free/t_engine << "x)" << std::endl;
+    std::cout << "\nsame output: " << (same ? "yes" : "no") << "\n" << std::endl;
+
+    return same ? 0 : -1;
+}
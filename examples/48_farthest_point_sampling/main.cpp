@@ -0,0 +1,47 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/sample_mesh.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: farthest point sampling of a mesh with the two strategies of
+ * sample_mesh. The heat based one solves for the geodesic distances from the
+ * whole sample set every time a new sample is added, the incremental one only
+ * updates the vertices that get closer to the new sample, and keeps the
+ * farthest vertex in a heap.
+ *
+ * usage:
+ *      farthest_point_sampling [mesh] [num_samples_heat] [num_samples_incremental]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s      = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n_heat = (argc>=3) ? atoi(argv[2]) : 50;
+    unsigned int n_inc  = (argc>=4) ? atoi(argv[3]) : 10000;
+    Trimesh<> m(s.c_str());
+
+    std::vector<unsigned int> samples;
+    Time::time_point t0 = Time::now();
+    sample_mesh(m, n_heat, samples, SamplingStrategy::HEAT_GEODESICS);
+    Time::time_point t1 = Time::now();
+    double t_heat = how_many_seconds(t0,t1);
+
+    t0 = Time::now();
+    sample_mesh(m, n_heat, samples, SamplingStrategy::INCREMENTAL);
+    t1 = Time::now();
+    double t_inc = how_many_seconds(t0,t1);
+
+    std::cout << "\n" << n_heat << " samples" << std::endl;
+    std::cout << "  heat geodesics : " << t_heat << "s" << std::endl;
+    std::cout << "  incremental    : " << t_inc  << "s (" << t_heat/t_inc << "x)" << std::endl;
+
+    t0 = Time::now();
+    sample_mesh(m, n_inc, samples, SamplingStrategy::INCREMENTAL);
+    t1 = Time::now();
+    std::cout << "\n" << samples.size() << " samples (out of " << m.num_verts() << " verts)" << std::endl;
+    std::cout << "  incremental    : " << how_many_seconds(t0,t1) << "s\n" << std::endl;
+
+    return 0;
+}
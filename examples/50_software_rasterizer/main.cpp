@@ -0,0 +1,45 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/rasterizer.h>
+#include <cinolib/ambient_occlusion.h>
+#include <cinolib/3d_printing/shadow_on_build_platform.h>
+#include <cinolib/sphere_coverage.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Headless rendering: computes the ambient occlusion of a mesh and its shadow
+ * on the building platform for many candidate build directions, using the CPU
+ * rasterizer in place of an offline OpenGL context. No window system is needed,
+ * hence this program can run on compute nodes without a GPU
+ *
+ * usage:
+ *      software_rasterizer [mesh] [buffer_size] [num_dirs]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int b = (argc>=3) ? atoi(argv[2]) : 256;
+    unsigned int n = (argc>=4) ? atoi(argv[3]) : 300;
+    Trimesh<> m(s.c_str());
+
+    Rasterizer r(b,b);
+
+    Time::time_point t0 = Time::now();
+    ambient_occlusion_srf_meshes(m, r, 32);
+    Time::time_point t1 = Time::now();
+    std::cout << "\nAmbient occlusion (32 views, " << b << "x" << b << ") : " << how_many_seconds(t0,t1) << "s" << std::endl;
+
+    std::vector<vec3d> dirs;
+    sphere_coverage(n, dirs);
+    std::vector<uint8_t> data(b*b);
+    float min_shadow = 1;
+    t0 = Time::now();
+    for(const vec3d & dir : dirs) min_shadow = std::min(min_shadow, shadow_on_build_platform(m, dir, b, data.data(), r));
+    t1 = Time::now();
+    std::cout << "Shadow on build platform (" << n << " dirs)   : " << how_many_seconds(t0,t1) << "s ("
+              << 1000*how_many_seconds(t0,t1)/n << "ms per dir, min area " << min_shadow << ")\n" << std::endl;
+
+    return 0;
+}
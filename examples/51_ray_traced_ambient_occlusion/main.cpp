@@ -0,0 +1,54 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/ambient_occlusion.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Benchmark: ambient occlusion computed by rendering the mesh from many view
+ * directions (with the CPU rasterizer) versus ray tracing the hemisphere of
+ * each polygon with progressive refinement. The correlation between the two
+ * AO fields is reported as a measure of agreement
+ *
+ * usage:
+ *      ray_traced_ambient_occlusion [mesh] [tolerance] [max_rays]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    Trimesh<> m(s.c_str());
+
+    AmbientOcclusionOptions opt;
+    if(argc>=3) opt.tolerance = atof(argv[2]);
+    if(argc>=4) opt.max_rays  = atoi(argv[3]);
+
+    Rasterizer r(256,256);
+    Time::time_point t0 = Time::now();
+    ambient_occlusion_srf_meshes(m, r, 128);
+    Time::time_point t1 = Time::now();
+    std::vector<double> ao_zbuf(m.num_polys());
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) ao_zbuf.at(pid) = m.poly_data(pid).AO;
+
+    ambient_occlusion_ray_traced(m, opt);
+    Time::time_point t2 = Time::now();
+
+    double sa=0, sb=0, sab=0, saa=0, sbb=0;
+    unsigned int n = m.num_polys();
+    for(unsigned int pid=0; pid<n; ++pid)
+    {
+        double a = ao_zbuf.at(pid);
+        double b = m.poly_data(pid).AO;
+        sa += a; sb += b; sab += a*b; saa += a*a; sbb += b*b;
+    }
+    double cov = sab/n - (sa/n)*(sb/n);
+    double va  = saa/n - (sa/n)*(sa/n);
+    double vb  = sbb/n - (sb/n)*(sb/n);
+
+    std::cout << "\nAO on " << n << " polys" << std::endl;
+    std::cout << "  Z-buffer (128 views, 256x256) : " << how_many_seconds(t0,t1) << "s" << std::endl;
+    std::cout << "  ray traced (tol " << opt.tolerance << ")        : " << how_many_seconds(t1,t2) << "s" << std::endl;
+    std::cout << "  correlation                   : " << cov/std::sqrt(va*vb) << "\n" << std::endl;
+
+    return 0;
+}
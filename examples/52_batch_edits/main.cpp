@@ -0,0 +1,78 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/how_many_seconds.h>
+#include <random>
+
+/* Benchmark: removal of many elements from a mesh. By default, each removal
+ * moves the last element of its kind in the hole it leaves, patching all the
+ * relations of the moved element. With batch edits removed elements are just
+ * marked as dead, and the mesh is compacted once at the end.
+ *
+ * usage:
+ *      batch_edits [mesh] [fraction_of_polys_to_remove]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+    typedef std::chrono::high_resolution_clock Time;
+
+    std::string s    = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    double      frac = (argc>=3) ? atof(argv[2]) : 0.5;
+    Trimesh<> m(s.c_str());
+
+    // 1) remove a random subset of the polygons
+    //
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> coin(0,1);
+    std::vector<unsigned int> pids;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) if(coin(rng)<frac) pids.push_back(pid);
+    std::sort(pids.begin(), pids.end(), std::greater<unsigned int>());
+
+    Trimesh<> m0 = m;
+    Time::time_point t0 = Time::now();
+    for(unsigned int pid : pids) m0.poly_remove(pid);
+    Time::time_point t1 = Time::now();
+    double t_immediate = how_many_seconds(t0,t1);
+
+    Trimesh<> m1 = m;
+    t0 = Time::now();
+    m1.batch_edits_begin();
+    for(unsigned int pid : pids) m1.poly_remove(pid);
+    m1.batch_edits_end();
+    t1 = Time::now();
+    double t_batch = how_many_seconds(t0,t1);
+
+    std::cout << "\nremove " << pids.size() << " polys (out of " << m.num_polys() << ")" << std::endl;
+    std::cout << "  immediate : " << t_immediate << "s" << std::endl;
+    std::cout << "  batch     : " << t_batch     << "s (" << t_immediate/t_batch << "x)" << std::endl;
+
+    // 2) collapse all the edges shorter than the average edge length
+    //
+    double l = m.edge_avg_length();
+    m0 = m;
+    t0 = Time::now();
+    for(unsigned int eid=0; eid<m0.num_edges(); ++eid)
+    {
+        if(m0.edge_length(eid)<l) m0.edge_collapse(eid, 0.5);
+    }
+    t1 = Time::now();
+    t_immediate = how_many_seconds(t0,t1);
+
+    m1 = m;
+    t0 = Time::now();
+    m1.batch_edits_begin();
+    for(unsigned int eid=0; eid<m1.num_edges(); ++eid)
+    {
+        if(m1.edge_is_dead(eid)) continue;
+        if(m1.edge_length(eid)<l) m1.edge_collapse(eid, 0.5);
+    }
+    m1.batch_edits_end();
+    t1 = Time::now();
+    t_batch = how_many_seconds(t0,t1);
+
+    std::cout << "\ncollapse edges shorter than " << l << std::endl;
+    std::cout << "  immediate : " << t_immediate << "s (" << m0.num_verts() << " verts left)" << std::endl;
+    std::cout << "  batch     : " << t_batch     << "s (" << m1.num_verts() << " verts left)\n" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/remesh_isotropic.h>
+
+/* Benchmark: isotropic remeshing of a triangle mesh. The target edge length is
+ * expressed as a fraction of the average edge length of the input mesh (e.g.
+ * 0.5 roughly quadruples the number of triangles). The output mesh is saved
+ * only if a filename is provided.
+ *
+ * usage:
+ *      isotropic_remeshing [mesh] [target_edge_length_scale] [time_budget_in_seconds] [output_mesh]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string s      = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    double      scale  = (argc>=3) ? atof(argv[2]) : 0.5;
+    double      budget = (argc>=4) ? atof(argv[3]) : -1;
+    Trimesh<> m(s.c_str());
+
+    IsotropicRemeshingOptions opt;
+    opt.target_edge_length = scale * m.edge_avg_length();
+    opt.time_budget        = budget;
+    opt.verbose            = true;
+    IsotropicRemeshingStats stats = remesh_isotropic(m, opt);
+    std::cout << "\n" << stats << std::endl;
+
+    // edge length and valence statistics of the output mesh
+    double min_len = inf_double;
+    double max_len = 0;
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        min_len = std::min(min_len, m.edge_length(eid));
+        max_len = std::max(max_len, m.edge_length(eid));
+    }
+    unsigned int regular = 0;
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid)
+    {
+        if(m.vert_valence(vid) == (m.vert_is_boundary(vid) ? 4u : 6u)) ++regular;
+    }
+    std::cout << "target edge length " << opt.target_edge_length << std::endl;
+    std::cout << "edge length        " << min_len/opt.target_edge_length << " (min) "
+                                       << m.edge_avg_length()/opt.target_edge_length << " (avg) "
+                                       << max_len/opt.target_edge_length << " (max), relative to target" << std::endl;
+    std::cout << "regular verts      " << 100.0*regular/m.num_verts() << "%\n" << std::endl;
+
+    if(argc>=5) m.save(argv[4]);
+    return 0;
+}
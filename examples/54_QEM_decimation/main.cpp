@@ -0,0 +1,36 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/decimate_QEM.h>
+
+/* Benchmark: decimation of a triangle mesh with quadric error metrics. The mesh
+ * is first decimated serially, then in partitioned mode (slabs of the mesh are
+ * decimated in parallel, stitched, and refined with a final serial pass). The
+ * output of the serial decimation is saved only if a filename is provided.
+ *
+ * usage:
+ *      QEM_decimation [mesh] [fraction_of_triangles_to_keep] [num_partitions] [output_mesh]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string  s     = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    double       frac  = (argc>=3) ? atof(argv[2]) : 0.1;
+    unsigned int parts = (argc>=4) ? atoi(argv[3]) : 8;
+    Trimesh<> m(s.c_str());
+
+    QEMDecimationOptions opt;
+    opt.target_num_polys = frac * m.num_polys();
+
+    Trimesh<> m_serial = m;
+    QEMDecimationStats stats = decimate_QEM(m_serial, opt);
+    std::cout << "\nserial decimation\n" << stats << std::endl;
+
+    Trimesh<> m_parts = m;
+    opt.num_partitions = parts;
+    stats = decimate_QEM(m_parts, opt);
+    std::cout << "partitioned decimation (" << parts << " slabs)\n" << stats << std::endl;
+
+    if(argc>=5) m_serial.save(argv[4]);
+    return 0;
+}
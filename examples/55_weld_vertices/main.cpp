@@ -0,0 +1,83 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/weld_vertices.h>
+#include <cinolib/profiler.h>
+
+/* Benchmark: welding of a triangle soup. The input mesh is exploded into a soup
+ * of disconnected triangles (three private vertices each), which is then welded
+ * back with a spatial hash. Proximity clustering is also compared against the
+ * all pairs test on the first few thousand soup vertices. Soup edges are labeled
+ * with the id of the input edge they come from, and the example checks that the
+ * welded mesh keeps these labels.
+ *
+ * usage:
+ *      weld_vertices [mesh] [eps] [num_verts_all_pairs]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string  s   = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    double       eps = (argc>=3) ? atof(argv[2]) : 1e-8;
+    unsigned int nbf = (argc>=4) ? atoi(argv[3]) : 10000;
+    Trimesh<> m(s.c_str());
+
+    std::vector<vec3d> soup_verts;
+    std::vector<std::vector<unsigned int>> soup_polys;
+    std::vector<unsigned int> orig_vid; // soup vertex => input vertex
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        std::vector<unsigned int> p;
+        for(unsigned int vid : m.poly_verts_id(pid))
+        {
+            p.push_back(soup_verts.size());
+            soup_verts.push_back(m.vert(vid));
+            orig_vid.push_back(vid);
+        }
+        soup_polys.push_back(p);
+    }
+    Trimesh<> soup(soup_verts, soup_polys);
+    for(unsigned int eid=0; eid<soup.num_edges(); ++eid)
+    {
+        soup.edge_data(eid).label = m.edge_id(orig_vid.at(soup.edge_vert_id(eid,0)),
+                                              orig_vid.at(soup.edge_vert_id(eid,1)));
+    }
+
+    // all pairs vs spatial hash
+    nbf = std::min(nbf, (unsigned int)soup_verts.size());
+    std::vector<vec3d> pts(soup_verts.begin(), soup_verts.begin()+nbf);
+    Profiler profiler;
+    profiler.push("all pairs clustering");
+    unsigned int n_pairs = 0;
+    for(unsigned int vid0=0;      vid0+1<nbf; ++vid0)
+    for(unsigned int vid1=vid0+1; vid1<nbf;   ++vid1)
+    {
+        if(pts.at(vid0).dist(pts.at(vid1)) < eps) ++n_pairs;
+    }
+    profiler.pop();
+    profiler.push("spatial hash clustering");
+    std::vector<std::unordered_set<unsigned int>> clusters;
+    vertex_clustering(pts, eps, clusters);
+    profiler.pop();
+    std::cout << nbf << " points, " << n_pairs << " close pairs, " << clusters.size() << " clusters\n" << std::endl;
+
+    profiler.push("weld soup");
+    unsigned int n_removed = weld_vertices(soup, eps);
+    profiler.pop();
+
+    std::cout << "\nsoup    " << soup_verts.size() << "V / " << soup_polys.size() << "P" << std::endl;
+    std::cout << "welded  " << soup.num_verts()  << "V / " << soup.num_polys()  << "P (" << n_removed << " vertices removed)" << std::endl;
+    std::cout << "input   " << m.num_verts()     << "V / " << m.num_polys()     << "P" << std::endl;
+
+    // welded edges must keep the labels of the soup edges they come from
+    bool ok = true;
+    for(unsigned int eid=0; ok && eid<soup.num_edges(); ++eid)
+    {
+        int orig = soup.edge_data(eid).label;
+        ok = (orig>=0 && (unsigned int)orig<m.num_edges() &&
+              std::min(soup.edge_vert(eid,0).dist(m.edge_vert(orig,0)), soup.edge_vert(eid,0).dist(m.edge_vert(orig,1))) <= eps &&
+              std::min(soup.edge_vert(eid,1).dist(m.edge_vert(orig,0)), soup.edge_vert(eid,1).dist(m.edge_vert(orig,1))) <= eps);
+    }
+    std::cout << "edge attributes preserved: " << (ok ? "YES" : "NO") << "\n" << std::endl;
+    return ok ? 0 : 1;
+}
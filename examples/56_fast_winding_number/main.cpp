@@ -0,0 +1,62 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/fast_winding_number.h>
+#include <cinolib/profiler.h>
+
+/* Benchmark: inside/outside classification of a regular grid of points against a
+ * watertight mesh, using fast winding numbers. Accuracy and timings are compared
+ * against the exact (brute force) evaluation on a subset of the grid points.
+ *
+ * usage:
+ *      fast_winding_number [mesh] [grid_resolution] [beta] [num_exact_queries]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string  s    = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/blub_triangulated.obj";
+    unsigned int res  = (argc>=3) ? atoi(argv[2]) : 64;
+    double       beta = (argc>=4) ? atof(argv[3]) : 2.0;
+    unsigned int nex  = (argc>=5) ? atoi(argv[4]) : 1000;
+    Trimesh<> m(s.c_str());
+
+    AABB bb(m.vector_verts(), 1.1);
+    std::vector<vec3d> points;
+    points.reserve(res*res*res);
+    for(unsigned int i=0; i<res; ++i)
+    for(unsigned int j=0; j<res; ++j)
+    for(unsigned int k=0; k<res; ++k)
+    {
+        points.push_back(bb.min + vec3d{bb.delta_x()*(i+0.5)/res, bb.delta_y()*(j+0.5)/res, bb.delta_z()*(k+0.5)/res});
+    }
+
+    Profiler profiler;
+    FastWindingNumber fwn(beta);
+    profiler.push("build tree");
+    fwn.build_from_mesh_polys(m);
+    profiler.pop();
+
+    std::vector<double> w;
+    profiler.push("fast winding numbers (" + std::to_string(points.size()) + " points)");
+    fwn.winding_numbers(points, w);
+    profiler.pop();
+
+    // exact evaluation on a subset of the grid
+    nex = std::min(nex, (unsigned int)points.size());
+    unsigned int step  = points.size()/nex;
+    unsigned int wrong = 0;
+    double       err   = 0;
+    profiler.push("exact winding numbers (" + std::to_string(nex) + " points)");
+    for(unsigned int i=0; i<nex; ++i)
+    {
+        double we = fwn.winding_number_exact(points.at(i*step));
+        err = std::max(err, std::fabs(we - w.at(i*step)));
+        if((we>0.5) != (w.at(i*step)>0.5)) ++wrong;
+    }
+    profiler.pop();
+
+    unsigned int n_inside = std::count_if(w.begin(), w.end(), [](const double x){ return x>0.5; });
+    std::cout << "\n" << n_inside << "/" << points.size() << " points inside" << std::endl;
+    std::cout << "max error: " << err << ", misclassified: " << wrong << "/" << nex << std::endl;
+    return 0;
+}
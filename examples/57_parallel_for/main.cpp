@@ -0,0 +1,94 @@
+#include <cinolib/parallel_for.h>
+#include <cinolib/profiler.h>
+#include <cmath>
+#include <iostream>
+
+/* Microbenchmark: PARALLEL_FOR on the persistent thread pool, compared against
+ * the previous implementation, which spawned and joined a set of threads at each
+ * call and statically split the range in equal slices. Measures the per call
+ * overhead (many loops with a tiny body), an unbalanced loop (the cost of each
+ * iteration grows with its index) and a reduction.
+ *
+ * usage:
+ *      parallel_for [num_threads] [num_calls]
+*/
+
+// previous PARALLEL_FOR: one thread per slice, created at each call
+template<typename Func>
+void PARALLEL_FOR_spawn_threads(unsigned int beg, unsigned int end, unsigned int n_threads, const Func & func)
+{
+    unsigned int n     = end - beg;
+    unsigned int slice = std::max<unsigned int>(1, (unsigned int)std::round(n/double(n_threads)));
+    auto subrange_helper = [&func](unsigned int k1, unsigned int k2)
+    {
+        for(unsigned int k=k1; k<k2; ++k) func(k);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(n_threads);
+    unsigned int i1 = beg;
+    unsigned int i2 = std::min(beg+slice, end);
+    for(unsigned int i=0; i+1<n_threads && i1<end; ++i)
+    {
+        pool.emplace_back(subrange_helper, i1, i2);
+        i1 = i2;
+        i2 = std::min(i2+slice, end);
+    }
+    if(i1<end) pool.emplace_back(subrange_helper, i1, end);
+    for(std::thread & t : pool) t.join();
+}
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    unsigned int nt      = (argc>=2) ? atoi(argv[1]) : std::max(1u, std::thread::hardware_concurrency());
+    unsigned int n_calls = (argc>=3) ? atoi(argv[2]) : 10000;
+    ThreadPool::instance().set_num_threads(nt);
+    std::cout << ThreadPool::instance().num_threads() << " threads\n" << std::endl;
+
+    // resizing the pool from one of its jobs would deadlock, and must be refused
+    bool resized = true;
+    ThreadPool::instance().run([&](unsigned int tid){ if(tid==0) resized = ThreadPool::instance().set_num_threads(nt); });
+    std::cout << "resize from a job refused: " << (!resized ? "YES" : "NO") << "\n" << std::endl;
+
+    // per call overhead
+    std::vector<double> v(1024, 1.0);
+    auto tiny = [&v](unsigned int i){ v[i] = std::sqrt(v[i]+1.0); };
+    Profiler profiler;
+    profiler.push("overhead (spawn threads)");
+    for(unsigned int k=0; k<n_calls; ++k) PARALLEL_FOR_spawn_threads(0, v.size(), nt, tiny);
+    double t_spawn = profiler.pop();
+    profiler.push("overhead (thread pool)  ");
+    for(unsigned int k=0; k<n_calls; ++k) PARALLEL_FOR(0, v.size(), 0, tiny);
+    double t_pool = profiler.pop();
+    std::cout << "per call: " << 1e6*t_spawn/n_calls << "us (spawn threads) vs " << 1e6*t_pool/n_calls << "us (thread pool)\n" << std::endl;
+
+    // unbalanced loop
+    std::vector<double> w(20000, 0.0);
+    auto unbalanced = [&w](unsigned int i)
+    {
+        double x = 0;
+        for(unsigned int j=0; j<i; ++j) x += std::sin(j*1e-3);
+        w[i] = x;
+    };
+    profiler.push("unbalanced (spawn threads)");
+    PARALLEL_FOR_spawn_threads(0, w.size(), nt, unbalanced);
+    profiler.pop();
+    profiler.push("unbalanced (static)       ");
+    PARALLEL_FOR(0, w.size(), 0, unbalanced, PARALLEL_STATIC);
+    profiler.pop();
+    profiler.push("unbalanced (dynamic)      ");
+    PARALLEL_FOR(0, w.size(), 0, unbalanced, PARALLEL_DYNAMIC);
+    profiler.pop();
+    profiler.push("unbalanced (guided)       ");
+    PARALLEL_FOR(0, w.size(), 0, unbalanced, PARALLEL_GUIDED);
+    profiler.pop();
+
+    // reduction
+    profiler.push("reduce");
+    double sum = PARALLEL_REDUCE(0, w.size(), 0, 0.0, [&w](unsigned int i, double & acc){ acc += w[i]; },
+                                                      [](double a, double b){ return a+b; });
+    profiler.pop();
+    std::cout << "\nsum: " << sum << std::endl;
+    return resized ? 1 : 0;
+}
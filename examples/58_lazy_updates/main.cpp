@@ -0,0 +1,79 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/profiler.h>
+#include <random>
+
+/* Benchmark: lazy recomputation of normals and bounding box. A brush displaces
+ * the one ring of a random vertex and splits one of its edges, many times. After
+ * each stroke normals must be up to date (e.g. for rendering): the eager path calls
+ * update_normals() and update_bbox() on the whole mesh, the lazy path marks the
+ * touched vertices as dirty and refreshes only them.
+ *
+ * usage:
+ *      lazy_updates [mesh] [num_strokes]
+*/
+
+using namespace cinolib;
+
+template<class Edit>
+void run_strokes(Trimesh<> & m, const unsigned int n, const Edit & edit)
+{
+    std::mt19937 rng(0);
+    double diag = m.bbox().diag();
+    for(unsigned int i=0; i<n; ++i)
+    {
+        unsigned int vid = rng() % m.num_verts();
+        double       h   = 1e-3 * diag * ((rng()%2) ? 1 : -1);
+        edit(vid, h, rng());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n = (argc>=3) ? atoi(argv[2]) : 1000;
+
+    Trimesh<> m_eager(s.c_str());
+    Trimesh<> m_lazy (s.c_str());
+    Profiler profiler;
+
+    profiler.push("eager updates");
+    run_strokes(m_eager, n, [&](const unsigned int vid, const double h, const unsigned int r)
+    {
+        vec3d n = m_eager.vert_data(vid).normal;
+        for(unsigned int nbr : m_eager.vert_ordered_verts_link(vid)) m_eager.vert(nbr) += n*(0.5*h);
+        m_eager.vert(vid) += n*h;
+        std::vector<unsigned int> e = m_eager.adj_v2e(vid);
+        m_eager.edge_split(e.at(r%e.size()), 0.5);
+        m_eager.update_normals();
+        m_eager.update_bbox();
+    });
+    profiler.pop();
+
+    profiler.push("lazy updates");
+    m_lazy.lazy_updates_begin();
+    run_strokes(m_lazy, n, [&](const unsigned int vid, const double h, const unsigned int r)
+    {
+        vec3d n = m_lazy.vert_data(vid).normal;
+        for(unsigned int nbr : m_lazy.vert_ordered_verts_link(vid))
+        {
+            m_lazy.vert(nbr) += n*(0.5*h);
+            m_lazy.vert_set_dirty(nbr);
+        }
+        m_lazy.vert(vid) += n*h;
+        m_lazy.vert_set_dirty(vid);
+        std::vector<unsigned int> e = m_lazy.adj_v2e(vid);
+        m_lazy.edge_split(e.at(r%e.size()), 0.5);
+        m_lazy.refresh();
+    });
+    m_lazy.lazy_updates_end();
+    profiler.pop();
+
+    double max_err = 0;
+    for(unsigned int vid=0; vid<m_eager.num_verts(); ++vid)
+    {
+        max_err = std::max(max_err, m_eager.vert_data(vid).normal.dist(m_lazy.vert_data(vid).normal));
+    }
+    std::cout << "\n" << n << " strokes, " << m_lazy.num_verts() << "V / " << m_lazy.num_polys() << "P" << std::endl;
+    std::cout << "max difference between eager and lazy vertex normals: " << max_err << std::endl;
+    return 0;
+}
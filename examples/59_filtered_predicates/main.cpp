@@ -0,0 +1,85 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/predicates.h>
+#include <cinolib/find_intersections.h>
+#include <cinolib/profiler.h>
+#include <random>
+
+/* Benchmark: filtered geometric predicates. The plain orient3d (exact if
+ * CINOLIB_USES_EXACT_PREDICATES is defined, as in these examples) is compared
+ * with its filtered version and with the batched version, which processes four
+ * points at a time if AVX2 is enabled (-DCINOLIB_USES_AVX2=ON, or -mavx2 in
+ * the CXXFLAGS). Then, find_intersections is run on the union of a mesh with a
+ * shifted copy of itself.
+ * The example also checks a few 2D triangle/triangle intersection cases.
+ *
+ * usage:
+ *      filtered_predicates [mesh] [num_points]
+*/
+
+int main(int argc, char **argv)
+{
+    using namespace cinolib;
+
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n = (argc>=3) ? atoi(argv[2]) : 10000000;
+
+    // random points, half of them (almost) on the plane of the reference triangle
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> U(-1,1);
+    vec3d a{U(rng),U(rng),U(rng)}, b{U(rng),U(rng),U(rng)}, c{U(rng),U(rng),U(rng)};
+    std::vector<double> pts(3*n);
+    for(unsigned int i=0; i<n; ++i)
+    {
+        vec3d p = (i%2) ? a + (b-a)*U(rng) + (c-a)*U(rng) : vec3d{U(rng),U(rng),U(rng)};
+        pts[3*i+0] = p[0];
+        pts[3*i+1] = p[1];
+        pts[3*i+2] = p[2];
+    }
+    std::vector<double> res(n);
+    Profiler profiler;
+
+    profiler.push("orient3d");
+    for(unsigned int i=0; i<n; ++i) res[i] = orient3d(a.ptr(), b.ptr(), c.ptr(), &pts[3*i]);
+    profiler.pop();
+    unsigned int n_pos = 0;
+    for(double r : res) if(r>0) ++n_pos;
+
+    profiler.push("orient3d_filtered");
+    for(unsigned int i=0; i<n; ++i) res[i] = orient3d_filtered(a.ptr(), b.ptr(), c.ptr(), &pts[3*i]);
+    profiler.pop();
+    unsigned int n_pos_filtered = 0;
+    for(double r : res) if(r>0) ++n_pos_filtered;
+
+    profiler.push("orient3d_batch");
+    orient3d_batch(a.ptr(), b.ptr(), c.ptr(), pts.data(), n, res.data());
+    profiler.pop();
+    unsigned int n_pos_batch = 0;
+    for(double r : res) if(r>0) ++n_pos_batch;
+
+    std::cout << "\npositive orientations: " << n_pos << " " << n_pos_filtered << " " << n_pos_batch << "\n" << std::endl;
+
+    // 2D triangle/triangle tests (overlapping, nested and disjoint)
+    bool ok_2d = triangle_triangle_intersect_2d(vec2d{0,0},     vec2d{2,0},   vec2d{0,2},
+                                                vec2d{0.5,0.5}, vec2d{3,0.5}, vec2d{0.5,3}) == INTERSECT &&
+                 triangle_triangle_intersect_2d(vec2d{0,0},     vec2d{4,0},   vec2d{0,4},
+                                                vec2d{0.5,0.5}, vec2d{1,0.5}, vec2d{0.5,1}) == INTERSECT &&
+                 triangle_triangle_intersect_2d(vec2d{0,0},     vec2d{1,0},   vec2d{0,1},
+                                                vec2d{2,2},     vec2d{3,2},   vec2d{2,3}) == DO_NOT_INTERSECT;
+    std::cout << "2D triangle/triangle tests: " << (ok_2d ? "OK" : "FAILED") << "\n" << std::endl;
+
+    Trimesh<> m(s.c_str());
+    std::vector<vec3d>        verts = m.vector_verts();
+    std::vector<unsigned int> tris  = serialized_vids_from_polys(m.vector_polys());
+    unsigned int nv = verts.size();
+    unsigned int nt = tris.size();
+    vec3d shift = vec3d{0.3,0.1,0.05} * m.bbox().diag();
+    for(unsigned int i=0; i<nv; ++i) verts.push_back(verts.at(i) + shift);
+    for(unsigned int i=0; i<nt; ++i) tris.push_back(tris.at(i) + nv);
+
+    std::set<ipair> intersections;
+    profiler.push("find_intersections");
+    find_intersections(verts, tris, intersections);
+    profiler.pop();
+    std::cout << intersections.size() << " pairs of intersecting triangles" << std::endl;
+    return ok_2d ? 0 : 1;
+}
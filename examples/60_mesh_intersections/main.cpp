@@ -0,0 +1,96 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/find_intersections.h>
+#include <cinolib/octree.h>
+#include <cinolib/profiler.h>
+#include <cmath>
+#include <mutex>
+
+/* Benchmark: detection of self intersections and of intersections between two
+ * meshes. The input mesh is augmented with a fan of long and thin triangles that
+ * cross it (as often found in CAD exports), and self intersections are found with
+ * the BVH based engine and with the previous approach, which tested all pairs of
+ * triangles within each leaf of an octree. Then, intersections between the input
+ * mesh and a shifted copy of itself are computed.
+ *
+ * usage:
+ *      mesh_intersections [mesh] [num_slivers]
+*/
+
+using namespace cinolib;
+
+// previous approach: all pairs of triangles inside each octree leaf
+void find_intersections_octree(const std::vector<vec3d>        & verts,
+                               const std::vector<unsigned int> & tris,
+                                     std::set<ipair>           & intersections)
+{
+    Octree o(8,1000);
+    o.build_from_vectors(verts, tris);
+    std::mutex mutex;
+    PARALLEL_FOR(0, o.leaves.size(), 1, [&](unsigned int i)
+    {
+        auto & leaf = o.leaves.at(i);
+        if(leaf->item_indices.empty()) return;
+        for(unsigned int j=0;   j<leaf->item_indices.size()-1; ++j)
+        for(unsigned int k=j+1; k<leaf->item_indices.size();   ++k)
+        {
+            unsigned int tid0 = leaf->item_indices.at(j);
+            unsigned int tid1 = leaf->item_indices.at(k);
+            auto T0 = o.items.at(tid0);
+            auto T1 = o.items.at(tid1);
+            if(T0->aabb.intersects_box(T1->aabb))
+            {
+                const Triangle *t0 = dynamic_cast<Triangle*>(T0);
+                const Triangle *t1 = dynamic_cast<Triangle*>(T1);
+                if(t0->intersects_triangle(t1->v,true))
+                {
+                    std::lock_guard<std::mutex> guard(mutex);
+                    intersections.insert(unique_pair(tid0,tid1));
+                }
+            }
+        }
+    });
+}
+
+int main(int argc, char **argv)
+{
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n = (argc>=3) ? atoi(argv[2]) : 1000;
+
+    Trimesh<> m(s.c_str());
+    std::vector<vec3d>        verts = m.vector_verts();
+    std::vector<unsigned int> tris  = serialized_vids_from_polys(m.vector_polys());
+
+    AABB  bb = m.bbox();
+    vec3d c  = bb.center();
+    for(unsigned int i=0; i<n; ++i)
+    {
+        double a0 = 2*M_PI*i/n;
+        double a1 = 2*M_PI*(i+1)/n;
+        unsigned int off = verts.size();
+        verts.push_back(c + vec3d{0, 0, -bb.delta_z()});
+        verts.push_back(c + vec3d{0.4*bb.delta_x()*cos(a0), 0.4*bb.delta_y()*sin(a0), bb.delta_z()});
+        verts.push_back(c + vec3d{0.4*bb.delta_x()*cos(a1), 0.4*bb.delta_y()*sin(a1), bb.delta_z()});
+        tris.push_back(off);
+        tris.push_back(off+1);
+        tris.push_back(off+2);
+    }
+    std::cout << tris.size()/3 << " triangles (" << n << " slivers)\n" << std::endl;
+
+    Profiler profiler;
+    std::set<ipair> octree_pairs, bvh_pairs, mesh_pairs;
+    profiler.push("self intersections (octree leaves)");
+    find_intersections_octree(verts, tris, octree_pairs);
+    profiler.pop();
+    profiler.push("self intersections (BVH)");
+    find_intersections(verts, tris, bvh_pairs);
+    profiler.pop();
+    std::cout << octree_pairs.size() << " / " << bvh_pairs.size() << " intersecting pairs" << (octree_pairs==bvh_pairs ? " (same result)\n" : " (DIFFERENT RESULTS)\n") << std::endl;
+
+    Trimesh<> m1 = m;
+    m1.translate(vec3d{0.3,0.1,0.05} * bb.diag());
+    profiler.push("mesh vs mesh intersections (BVH)");
+    find_intersections(m, m1, mesh_pairs);
+    profiler.pop();
+    std::cout << mesh_pairs.size() << " pairs of intersecting triangles between the two meshes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/octree.h>
+#include <cinolib/geodesics.h>
+#include <cinolib/find_intersections.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/trace_profiler.h>
+#include <cmath>
+#include <iostream>
+
+/* Instruments a small pipeline with the trace profiler: mesh loading, octree
+ * construction, self intersections and heat geodesics are annotated inside the
+ * library, while the loop below shows user defined zones, counters and gauges.
+ * All events are exported in the Chrome trace format (open the output file in
+ * chrome://tracing or https://ui.perfetto.dev) and summarized in a table.
+ * Finally, the cost of an empty zone is measured, with recording on and off.
+ *
+ * NOTE: zones are compiled only if CINOLIB_USES_PROFILER is defined (see the
+ * CMakeLists of this example)
+ *
+ * usage:
+ *      trace_profiler [mesh] [trace.json]
+*/
+
+using namespace cinolib;
+
+int main(int argc, char **argv)
+{
+    std::string s   = (argc>1) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    std::string out = (argc>2) ? std::string(argv[2]) : "trace.json";
+
+    TraceProfiler & profiler = TraceProfiler::instance();
+    CINO_PROFILE_THREAD("main");
+
+    Trimesh<> m(s.c_str());
+
+    Octree o;
+    o.build_from_mesh_polys(m);
+
+    std::set<ipair> intersections;
+    find_intersections(m, intersections);
+    std::cout << intersections.size() << " pairs of intersecting triangles" << std::endl;
+
+    ScalarField dist = compute_geodesics(m, {0});
+    std::cout << "max geodesic distance: " << dist.maxCoeff() << std::endl;
+
+    {
+        CINO_PROFILE_ZONE("vertex queries");
+        std::atomic<unsigned int> done(0);
+        PARALLEL_FOR(0, m.num_verts(), 1000, [&](unsigned int vid)
+        {
+            CINO_PROFILE_ZONE("closest point");
+            unsigned int id;
+            vec3d        p;
+            double       d;
+            o.closest_point(m.vert(vid) + vec3d{0.01,0.01,0.01}, id, p, d);
+            if(++done % 1000 == 0) CINO_PROFILE_GAUGE("queries done", done.load());
+        });
+        CINO_PROFILE_COUNTER("queries", m.num_verts());
+    }
+
+    profiler.report();
+    if(profiler.write_chrome_trace(out.c_str()))
+    {
+        std::cout << profiler.num_events() << " events written to " << out << std::endl;
+    }
+
+    // overhead of an empty zone, when recording is on and off
+    const unsigned int n = 1000000;
+    for(bool on : {true, false})
+    {
+        profiler.clear();
+        profiler.set_enabled(on);
+        uint64_t t0 = profiler.now();
+        for(unsigned int i=0; i<n; ++i)
+        {
+            CINO_PROFILE_ZONE("empty");
+        }
+        uint64_t t1 = profiler.now();
+        std::cout << "empty zone (recording " << (on ? "on) : " : "off): ") << double(t1-t0)/n << "ns" << std::endl;
+    }
+    profiler.set_enabled(true);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <cinolib/meshes/trimesh.h>
+
+/* Check: frozen (CSR) adjacency. Freezing a mesh must not change any of its
+ * relations, and appending meshes with operator+= must give the same result
+ * regardless of which operand is frozen (the destination is thawed, the source
+ * is read through its adj_*_span views). Operations that do not change the
+ * connectivity, such as flipping the winding order of a polygon, must not thaw it.
+ *
+ * usage:
+ *      frozen_adjacency [mesh]
+*/
+
+using namespace cinolib;
+
+bool same_topology(const Trimesh<> & a, const Trimesh<> & b)
+{
+    if(a.num_verts()!=b.num_verts() || a.num_edges()!=b.num_edges() || a.num_polys()!=b.num_polys()) return false;
+    for(unsigned int vid=0; vid<a.num_verts(); ++vid)
+    {
+        if(a.adj_v2v_span(vid)!=b.adj_v2v_span(vid) || a.adj_v2e_span(vid)!=b.adj_v2e_span(vid) || a.adj_v2p_span(vid)!=b.adj_v2p_span(vid)) return false;
+    }
+    for(unsigned int eid=0; eid<a.num_edges(); ++eid)
+    {
+        if(a.adj_e2p_span(eid)!=b.adj_e2p_span(eid)) return false;
+    }
+    for(unsigned int pid=0; pid<a.num_polys(); ++pid)
+    {
+        if(a.adj_p2v(pid)!=b.adj_p2v(pid) || a.adj_p2e_span(pid)!=b.adj_p2e_span(pid) || a.adj_p2p_span(pid)!=b.adj_p2p_span(pid)) return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    std::string s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+
+    Trimesh<> ref(s.c_str());
+    Trimesh<> frozen = ref;
+    size_t mem_vecs = frozen.adj_memory_usage();
+    frozen.adj_freeze();
+    size_t mem_csr  = frozen.adj_memory_usage();
+    bool ok = same_topology(ref, frozen);
+
+    std::cout << "\nadjacency memory (vectors) : " << mem_vecs/1024 << "KB" << std::endl;
+    std::cout << "adjacency memory (CSR)     : " << mem_csr /1024 << "KB" << std::endl;
+    std::cout << "freeze preserves relations : " << (ok ? "YES" : "NO") << std::endl;
+
+    // operations that do not edit connectivity must not thaw the mesh,
+    // otherwise the view being iterated would be released
+    Trimesh<> flipped = frozen;
+    for(unsigned int pid : flipped.adj_v2p_span(0)) flipped.poly_flip_winding_order(pid);
+    bool still_frozen = flipped.adj_is_frozen();
+    ok = ok && still_frozen;
+    std::cout << "flip keeps the mesh frozen : " << (still_frozen ? "YES" : "NO") << std::endl;
+
+    // reference append, both operands mutable
+    Trimesh<> sum_ref = ref;
+    sum_ref += ref;
+
+    for(unsigned int i=0; i<3; ++i)
+    {
+        bool a_frozen = (i!=1);
+        bool b_frozen = (i!=0);
+        Trimesh<> a = ref;
+        Trimesh<> b = ref;
+        if(a_frozen) a.adj_freeze();
+        if(b_frozen) b.adj_freeze();
+        a += b;
+        bool same = same_topology(sum_ref, a);
+        ok = ok && same;
+        std::cout << "append (a " << (a_frozen ? "frozen " : "mutable") << ", b "
+                  << (b_frozen ? "frozen " : "mutable") << "): " << (same ? "YES" : "NO") << std::endl;
+    }
+    std::cout << std::endl;
+
+    return ok ? 0 : 1;
+}
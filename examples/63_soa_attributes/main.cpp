@@ -0,0 +1,83 @@
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/meshes/tetmesh.h>
+#include <cinolib/meshes/mesh_slicer.h>
+#include <cinolib/how_many_seconds.h>
+
+/* Check and benchmark: array of structs (default) vs structure of arrays storage
+ * of the vertex and polygon attributes. The same mesh is loaded with both layouts,
+ * and the loops that touch a single attribute of all the elements (gather normals
+ * and labels, copy xyz to uvw, slice by label/quality) are run on both. Results
+ * must be identical.
+ *
+ * usage:
+ *      soa_attributes [mesh] [num_rounds]
+*/
+
+using namespace cinolib;
+
+typedef Trimesh<> TrimeshAoS;
+typedef Trimesh<Mesh_std_attributes, Vert_soa_attributes, Edge_std_attributes, Polygon_soa_attributes> TrimeshSoA;
+
+template<class Mesh>
+double run(Mesh & m, const unsigned int n, std::vector<vec3d> & normals, std::vector<int> & labels, std::vector<bool> & hidden)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+    MeshSlicer slicer;
+    slicer.L_filter = 1;
+    for(unsigned int i=0; i<n; ++i)
+    {
+        normals = m.vector_vert_normals();
+        labels  = m.vector_poly_labels();
+        m.copy_xyz_to_uvw(UVW_param);
+        slicer.slice(m);
+    }
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    hidden.clear();
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) hidden.push_back(m.poly_data(pid).flags[HIDDEN]);
+    return how_many_seconds(t0,t1);
+}
+
+int main(int argc, char **argv)
+{
+    std::string  s = (argc>=2) ? std::string(argv[1]) : std::string(DATA_PATH) + "/bunny.obj";
+    unsigned int n = (argc>=3) ? atoi(argv[2]) : 100;
+
+    TrimeshAoS m_aos(s.c_str());
+    TrimeshSoA m_soa(s.c_str());
+
+    // some labels and some uvw to overwrite
+    for(unsigned int pid=0; pid<m_aos.num_polys(); ++pid)
+    {
+        m_aos.poly_data(pid).label = pid%3;
+        m_soa.poly_data(pid).label = pid%3;
+    }
+
+    std::vector<vec3d> n_aos, n_soa;
+    std::vector<int>   l_aos, l_soa;
+    std::vector<bool>  h_aos, h_soa;
+    double t_aos = run(m_aos, n, n_aos, l_aos, h_aos);
+    double t_soa = run(m_soa, n, n_soa, l_soa, h_soa);
+
+    bool same = (n_aos==n_soa && l_aos==l_soa && h_aos==h_soa);
+    for(unsigned int vid=0; same && vid<m_aos.num_verts(); ++vid)
+    {
+        same = (m_aos.vert_data(vid).uvw == m_soa.vert_data(vid).uvw);
+    }
+
+    // polyhedral meshes (AoS only) go through the same code path
+    Tetmesh<> tm(std::string(std::string(DATA_PATH) + "/sphere.mesh").c_str());
+    MeshSlicer slicer;
+    slicer.Z_thresh = 0.5;
+    slicer.slice(tm);
+    unsigned int n_hidden = 0;
+    for(unsigned int pid=0; pid<tm.num_polys(); ++pid) if(tm.poly_data(pid).flags[HIDDEN]) ++n_hidden;
+
+    std::cout << "\n" << n << " rounds on " << m_aos.num_verts() << " verts / " << m_aos.num_polys() << " polys" << std::endl;
+    std::cout << "array of structs   : " << t_aos << "s" << std::endl;
+    std::cout << "structure of arrays: " << t_soa << "s (speedup " << t_aos/t_soa << "x)" << std::endl;
+    std::cout << "same results       : " << (same ? "YES" : "NO") << std::endl;
+    std::cout << "sliced tetmesh     : " << n_hidden << "/" << tm.num_polys() << " hidden\n" << std::endl;
+
+    return same ? 0 : 1;
+}
@@ -37,7 +37,7 @@
 #define CINO_OPTIMAL_BUILD_DIR_H
 
 #include <cinolib/cino_inline.h>
-#include <cinolib/meshes/drawable_trimesh.h>
+#include <cinolib/meshes/trimesh.h>
 #include <unordered_set>
 
 namespace cinolib
@@ -64,7 +64,8 @@ namespace cinolib
  * evaluated. The output result is the direction that minimizes the energy.
  *
  * Users can choose how many directions should be tested, and what is the importance of
- * each metric in the global energy.
+ * each metric in the global energy. The shadow area is computed with a software
+ * rasterizer, hence no OpenGL context is needed.
  *
  * Forbidden dirs: users can indicate one or more build directions that are forbidden.
  * These will not be evaluated by the algorithm. Forbidden dirs are represented by a
@@ -101,8 +102,8 @@ struct OptimalBuildDirOptions
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
-                        const OptimalBuildDirOptions   & opt);
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>       & m,
+                        const OptimalBuildDirOptions & opt);
 }
 
 #include "optimal_build_dir.tpp"
@@ -46,8 +46,8 @@ namespace cinolib
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
-                        const OptimalBuildDirOptions   & opt)
+vec3d optimal_build_dir(const Trimesh<M,V,E,P>       & m,
+                        const OptimalBuildDirOptions & opt)
 {
     // evenly sample the unit sphere to produce
     // a set of candidate build directions
@@ -55,10 +55,10 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
     sphere_coverage(opt.n_dirs, dirs);
 
     // cache everything that can be cached to speed up computation
-    GLFWwindow *GL_context = create_offline_GL_context(opt.buffer_size, opt.buffer_size);
-    u_int8_t   *data       = new u_int8_t[opt.buffer_size*opt.buffer_size];
-    Octree octree;
-    octree.build_from_mesh_polys(m);
+    Rasterizer  rasterizer(opt.buffer_size, opt.buffer_size);
+    u_int8_t   *data = new u_int8_t[opt.buffer_size*opt.buffer_size];
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
 
     // compute scores for all candidate directions. scores are stored separately because this will
     // allow to normalize them in the same range and combine them in a meaningful way...
@@ -83,7 +83,7 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
 
         // NOTE: this call is 90% of the computational cost
         std::vector<std::pair<unsigned int,unsigned int>> polys_hanging;
-        overhangs(m, opt.overhang_threshold, dirs[i], polys_hanging, octree);
+        overhangs(m, opt.overhang_threshold, dirs[i], polys_hanging, bvh);
 
         // projection of the "lowest" mesh vertex along the build direction
         // this is used further down to estimate the volume of support structures
@@ -91,7 +91,7 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
         float floor;
 
         h[i] = (opt.w_height         >0) ? height_along_build_dir(m, dirs[i], floor) : 0.f;
-        a[i] = (opt.w_shadow_area    >0) ? shadow_on_build_platform(m, dirs[i], opt.buffer_size, data, GL_context) : 0.f;
+        a[i] = (opt.w_shadow_area    >0) ? shadow_on_build_platform(m, dirs[i], opt.buffer_size, data, rasterizer) : 0.f;
         c[i] = (opt.w_support_contact>0) ? supports_contact_area(m, polys_hanging) : 0.f;
         v[i] = (opt.w_support_volume >0) ? supports_volume(m, dirs[i], floor, polys_hanging) : 0.f;
 
@@ -116,7 +116,6 @@ vec3d optimal_build_dir(const DrawableTrimesh<M,V,E,P> & m,
     }
 
     // release memory
-    destroy_offline_GL_context(GL_context);
     delete[] data;
 
     // normalize all scores in [0,1]
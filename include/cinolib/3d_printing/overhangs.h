@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/trimesh.h>
 #include <cinolib/octree.h>
+#include <cinolib/bvh.h>
 
 namespace cinolib
 {
@@ -78,7 +79,7 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 // in case the function is called multiple times, it is convenient to
-// pay the cost for building the octree just once
+// pay the cost for building the octree (or the BVH) just once
 //
 template<class M, class V, class E, class P>
 CINO_INLINE
@@ -87,6 +88,14 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
                const vec3d                             & build_dir,
                      std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
                const Octree                            & octree); // cached
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void overhangs(const Trimesh<M,V,E,P>                  & m,
+               const float                               thresh, // degrees
+               const vec3d                             & build_dir,
+                     std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
+               const BVH                               & bvh); // cached
 }
 
 #include "overhangs.tpp"
@@ -35,6 +35,7 @@
 *********************************************************************************/
 #include <cinolib/3d_printing/overhangs.h>
 #include <cinolib/parallel_for.h>
+#include <cinolib/bvh.h>
 #include <cinolib/octree.h>
 #include <cinolib/find_intersections.h>
 #include <mutex>
@@ -63,13 +64,15 @@ void overhangs(const Trimesh<M,V,E,P>  & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-template<class M, class V, class E, class P>
+// shared by the Octree and BVH versions: any spatial data structure
+// exposing intersects_ray(origin, dir, sorted_hits) will do
+template<class M, class V, class E, class P, class SpatialIndex>
 CINO_INLINE
-void overhangs(const Trimesh<M,V,E,P>                  & m,
-               const float                               thresh, // degrees
-               const vec3d                             & build_dir,
-                     std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
-               const Octree                            & octree) // cached
+void overhangs_with_supports(const Trimesh<M,V,E,P>                  & m,
+                             const float                               thresh, // degrees
+                             const vec3d                             & build_dir,
+                                   std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
+                             const SpatialIndex                      & index)
 {
     // find overhanging triangles
     std::vector<unsigned int> tmp;
@@ -82,7 +85,7 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
         unsigned int pid  = tmp[i];
         auto pair = std::make_pair(pid,pid);
         std::set<std::pair<double,unsigned int>> hits;
-        if(octree.intersects_ray(m.poly_centroid(pid), -build_dir, hits))
+        if(index.intersects_ray(m.poly_centroid(pid), -build_dir, hits))
         {
             auto hit = hits.begin();
             if(hit->second==pid) ++hit; // skip the first hit, it's the starting polygon
@@ -101,6 +104,32 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+void overhangs(const Trimesh<M,V,E,P>                  & m,
+               const float                               thresh, // degrees
+               const vec3d                             & build_dir,
+                     std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
+               const Octree                            & octree) // cached
+{
+    overhangs_with_supports(m, thresh, build_dir, polys_hanging, octree);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void overhangs(const Trimesh<M,V,E,P>                  & m,
+               const float                               thresh, // degrees
+               const vec3d                             & build_dir,
+                     std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging,
+               const BVH                               & bvh) // cached
+{
+    overhangs_with_supports(m, thresh, build_dir, polys_hanging, bvh);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void overhangs(const Trimesh<M,V,E,P>                  & m,
@@ -108,9 +137,9 @@ void overhangs(const Trimesh<M,V,E,P>                  & m,
                const vec3d                             & build_dir,
                      std::vector<std::pair<unsigned int,unsigned int>> & polys_hanging)
 {
-    Octree octree;
-    octree.build_from_mesh_polys(m);
-    overhangs(m, thresh, build_dir, polys_hanging, octree);
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+    overhangs(m, thresh, build_dir, polys_hanging, bvh);
 }
 
 }
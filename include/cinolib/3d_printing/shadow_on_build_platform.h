@@ -36,8 +36,12 @@
 #ifndef CINO_SHADOW_ON_BUILD_PLATFORM_H
 #define CINO_SHADOW_ON_BUILD_PLATFORM_H
 
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/rasterizer.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/meshes/drawable_trimesh.h>
 #include <cinolib/gl/gl_glfw.h>
+#endif
 
 namespace cinolib
 {
@@ -51,9 +55,12 @@ namespace cinolib
  * pixel in the image.
  *
  * In case the method is called multiple times it is conveniente to pass
- * a GL context so as to amortize the cost of initialization.
+ * a GL context so as to amortize the cost of initialization. The versions
+ * that take a Rasterizer do not need OpenGL, and can run on headless machines.
 */
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,         //
@@ -71,6 +78,17 @@ float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,           //
                                      uint8_t                  * data,        //
                                      GLFWwindow               * GL_context); // cached for amortized computation
 
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+float shadow_on_build_platform(const Trimesh<M,V,E,P> & m,         //
+                               const vec3d            & build_dir, //
+                               const unsigned int       img_size,  // frame buffer will be img_size x img_size
+                                     uint8_t          * data,      //
+                                     Rasterizer       & r);        // cached for amortized computation
 
 }
 
@@ -35,11 +35,15 @@
 *********************************************************************************/
 #include <cinolib/3d_printing/shadow_on_build_platform.h>
 #include <cinolib/cast_shadow.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/gl/offline_gl_context.h>
+#endif
 
 namespace cinolib
 {
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,         //
@@ -77,4 +81,20 @@ float shadow_on_build_platform(const DrawableTrimesh<M,V,E,P> & m,          //
     return (float)shadow_pixels/(img_size*img_size);
 }
 
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+float shadow_on_build_platform(const Trimesh<M,V,E,P> & m,         //
+                               const vec3d            & build_dir, //
+                               const unsigned int       img_size,  // frame buffer will be img_size x img_size
+                                     uint8_t          * data,      //
+                                     Rasterizer       & r)         // cached for amortized computation
+{
+    cast_shadow(m, build_dir, img_size, img_size, data, r);
+    return (float)r.num_covered_pixels()/(img_size*img_size);
+}
+
 }
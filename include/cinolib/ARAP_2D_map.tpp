@@ -91,7 +91,7 @@ void ARAP_2D_mapping(const Trimesh<M,V,E,P> & m, ARAP_2D_map_data & data)
         std::vector<Entry> entries;
         for(unsigned int vid=0; vid<m.num_verts()-1; ++vid)
         {
-            for(unsigned int nbr : m.adj_v2v(vid))
+            for(unsigned int nbr : m.adj_v2v_span(vid))
             {
                 int eid = m.edge_id(vid,nbr);
                 assert(eid>=0);
@@ -139,10 +139,10 @@ void ARAP_2D_mapping(const Trimesh<M,V,E,P> & m, ARAP_2D_map_data & data)
         Eigen::VectorXd rhs_v = Eigen::VectorXd::Zero(m.num_verts()-1);
         for(unsigned int vid=0; vid<m.num_verts()-1; ++vid)
         {
-            for(unsigned int nbr : m.adj_v2v(vid))
+            for(unsigned int nbr : m.adj_v2v_span(vid))
             {
                 int eid = m.edge_id(vid,nbr);
-                for(unsigned int pid : m.adj_e2p(eid))
+                for(unsigned int pid : m.adj_e2p_span(eid))
                 {
                     unsigned int i = m.poly_vert_offset(pid,vid);
                     unsigned int j = m.poly_vert_offset(pid,nbr);
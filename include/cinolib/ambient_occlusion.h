@@ -36,9 +36,10 @@
 #ifndef CINO_AMBIENT_OCCLUSION_H
 #define CINO_AMBIENT_OCCLUSION_H
 
-#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
-
 #include <cinolib/cino_inline.h>
+#include <cinolib/rasterizer.h>
+#include <cinolib/bvh.h>
+#include <cinolib/min_max_inf.h>
 #include <sys/types.h>
 
 namespace cinolib
@@ -50,6 +51,8 @@ namespace cinolib
  * and visibility is checked for each render using the Z-buffer
 */
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class Mesh>
 CINO_INLINE
 void ambient_occlusion_srf_meshes(      Mesh & m,
@@ -63,9 +66,64 @@ CINO_INLINE
 void ambient_occlusion_vol_meshes(      Mesh & m,
                                   const int    buffer_size = 350,
                                   const unsigned int   sample_dirs = 256);
+
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// GL-free versions: renders are done on the CPU by the rasterizer r,
+// whose size plays the role of the buffer size of the GL versions
+
+template<class Mesh>
+CINO_INLINE
+void ambient_occlusion_srf_meshes(      Mesh         & m,
+                                        Rasterizer   & r,
+                                  const unsigned int   sample_dirs = 32);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void ambient_occlusion_vol_meshes(      Mesh         & m,
+                                        Rasterizer   & r,
+                                  const unsigned int   sample_dirs = 256);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Ray traced ambient occlusion for surface meshes. For each (visible) polygon,
+ * cosine weighted rays are shot from the centroid over the hemisphere around
+ * its normal, and the AO value is the fraction of rays that do not hit the mesh.
+ * Directions are taken from a 2D low discrepancy sequence (hence stratified), and
+ * rays are cast in rounds: after min_rays, polygons whose estimate has a standard
+ * error below tolerance stop shooting rays. Results are deterministic for a given
+ * seed, and do not depend on the number of threads or on any buffer resolution.
+ * Rays of each round are traced in batches, sorted so that rays with the same
+ * sample index from nearby polygons are next to each other (see BVH::intersects_rays_any)
+*/
+
+struct AmbientOcclusionOptions
+{
+    unsigned int min_rays  = 32;         // rays per polygon before checking convergence
+    unsigned int max_rays  = 256;        // rays per polygon (upper bound)
+    unsigned int rays_step = 32;         // rays per polygon shot at each refinement round
+    double       tolerance = 0.04;       // target standard error of the AO estimate
+    double       max_dist  = inf_double; // occluders farther than this are ignored (in units of the bbox diagonal)
+    unsigned int seed      = 0;          // random rotation of the sequence of directions
+    bool         normalize = true;       // stretch AO values in [0,1], as the Z-buffer based versions do
+};
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_ray_traced(      AbstractPolygonMesh<M,V,E,P> & m,
+                                  const AmbientOcclusionOptions      & opt = AmbientOcclusionOptions());
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_ray_traced(      AbstractPolygonMesh<M,V,E,P> & m,
+                                  const BVH                          & bvh, // cached (visible polygons only)
+                                  const AmbientOcclusionOptions      & opt = AmbientOcclusionOptions());
 }
 
 #include "ambient_occlusion.tpp"
 
-#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
 #endif // CINO_AMBIENT_OCCLUSION_H
@@ -34,17 +34,22 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/ambient_occlusion.h>
-#include <cinolib/gl/gl_glfw.h>
-#include <cinolib/gl/glproject.h>
-#include <cinolib/gl/glunproject.h>
 #include <cinolib/sphere_coverage.h>
 #include <cinolib/meshes/meshes.h>
 #include <cinolib/parallel_for.h>
+#include <random>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+#include <cinolib/gl/gl_glfw.h>
+#include <cinolib/gl/glproject.h>
+#include <cinolib/gl/glunproject.h>
 #include <cinolib/gl/offline_gl_context.h>
+#endif
 
 namespace cinolib
 {
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class Mesh>
 CINO_INLINE
 void ambient_occlusion_srf_meshes(      Mesh & m,
@@ -218,4 +223,247 @@ void ambient_occlusion_vol_meshes(      Mesh & m,
     }
 }
 
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void ambient_occlusion_srf_meshes(      Mesh         & m,
+                                        Rasterizer   & r,
+                                  const unsigned int   sample_dirs)
+{
+    std::vector<float> ao(m.num_polys(),0);
+    std::vector<vec3d> dirs;
+    sphere_coverage(sample_dirs, dirs);
+
+    int w = r.width();
+    int h = r.height();
+
+    for(vec3d dir : dirs)
+    {
+        // for each POV render on a buffer, and do a visibility check
+        // by reading values from the Z buffer and comparing with the actual depth
+        r.set_view(dir, m.centroid(), 2.0/m.bbox().diag());
+        r.clear();
+        r.draw(m);
+        const std::vector<float> & z_buffer = r.z_buffer();
+
+        // accumulate AO values, weighting views with the dot between
+        // local surface normal and ray direction
+        PARALLEL_FOR(0, m.num_polys(), 1000, [&](const unsigned int pid)
+        {
+            if(!m.poly_data(pid).flags[HIDDEN])
+            {
+                vec2d  pp;
+                double depth;
+                r.project(m.poly_centroid(pid), pp, depth);
+                int x = std::min(std::max(int(pp.x()), 0), w-1);
+                int y = std::min(std::max(int(pp.y()), 0), h-1);
+
+                if(z_buffer[w*y+x]+0.0025 > depth)
+                {
+                    double diff = std::max(-dir.dot(m.poly_data(pid).normal), 0.0);
+                    ao[pid] += diff;
+                }
+            }
+        });
+    }
+
+    // apply AO
+    auto min_max = std::minmax_element(ao.begin(), ao.end());
+    auto min     = *min_max.first;
+    auto max     = *min_max.second;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        m.poly_data(pid).AO = (m.poly_data(pid).flags[HIDDEN]) ? 1.0 : (ao[pid]-min)/max;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void ambient_occlusion_vol_meshes(      Mesh         & m,
+                                        Rasterizer   & r,
+                                  const unsigned int   sample_dirs)
+{
+    std::vector<float> ao(m.num_faces(),0);
+    std::vector<uint8_t> face_visible(m.num_faces(),false); // not bool: written in parallel
+    std::vector<vec3d> dirs;
+    sphere_coverage(sample_dirs, dirs);
+
+    int w = r.width();
+    int h = r.height();
+
+    for(vec3d dir : dirs)
+    {
+        // for each POV render on a buffer, and do a visibility check
+        // by reading values from the Z buffer and comparing with the actual depth
+        r.set_view(dir, m.centroid(), 2.0/m.bbox().diag());
+        r.clear();
+        r.draw(m);
+        const std::vector<float> & z_buffer = r.z_buffer();
+
+        // accumulate AO values, weighting views with the dot between
+        // local surface normal and ray direction
+        PARALLEL_FOR(0, m.num_faces(), 1000, [&](const unsigned int fid)
+        {
+            unsigned int pid_beneath;
+            if(m.face_is_visible(fid, pid_beneath))
+            {
+                face_visible.at(fid) = true;
+                vec2d  pp;
+                double depth;
+                r.project(m.face_centroid(fid), pp, depth);
+                int x = std::min(std::max(int(pp.x()), 0), w-1);
+                int y = std::min(std::max(int(pp.y()), 0), h-1);
+
+                if(z_buffer[w*y+x]+0.0025 > depth)
+                {
+                    double diff = std::max(-dir.dot(m.poly_face_normal(pid_beneath,fid)), 0.0);
+                    ao[fid] += diff;
+                }
+            }
+        });
+    }
+
+    // apply AO
+    auto min_max = std::minmax_element(ao.begin(), ao.end());
+    auto min     = *min_max.first;
+    auto max     = *min_max.second;
+    for(unsigned int fid=0; fid<m.num_faces(); ++fid)
+    {
+        m.face_data(fid).AO = (face_visible.at(fid)) ? (ao[fid]-min)/max : 1.0;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_ray_traced(      AbstractPolygonMesh<M,V,E,P> & m,
+                                  const AmbientOcclusionOptions      & opt)
+{
+    BVH bvh;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(m.poly_data(pid).flags[HIDDEN]) continue;
+        const std::vector<unsigned int> & tris = m.poly_tessellation(pid);
+        for(unsigned int i=0; i<tris.size(); i+=3)
+        {
+            bvh.push_triangle(pid, { m.vert(tris.at(i)), m.vert(tris.at(i+1)), m.vert(tris.at(i+2)) });
+        }
+    }
+    bvh.build();
+    ambient_occlusion_ray_traced(m, bvh, opt);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void ambient_occlusion_ray_traced(      AbstractPolygonMesh<M,V,E,P> & m,
+                                  const BVH                          & bvh,
+                                  const AmbientOcclusionOptions      & opt)
+{
+    assert(opt.rays_step>0 && opt.min_rays<=opt.max_rays);
+
+    double diag  = m.bbox().diag();
+    double max_t = opt.max_dist * diag;
+    double eps   = 1e-5 * diag; // offset of the ray origins from the surface
+
+    // ray origins and local frames (Duff et al., Building an Orthonormal Basis, Revisited, JCGT 2017)
+    std::vector<vec3d> org(m.num_polys()), tu(m.num_polys()), tv(m.num_polys());
+    std::vector<unsigned int> active;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(m.poly_data(pid).flags[HIDDEN]) continue;
+        const vec3d & n = m.poly_data(pid).normal;
+        if(!(n.norm()>0)) continue; // degenerate polygon
+        double sign = std::copysign(1.0, n.z());
+        double a    = -1.0/(sign + n.z());
+        double b    = n.x()*n.y()*a;
+        tu.at(pid)  = vec3d{1.0 + sign*n.x()*n.x()*a, sign*b, -sign*n.x()};
+        tv.at(pid)  = vec3d{b, sign + n.y()*n.y()*a, -n.y()};
+        org.at(pid) = m.poly_centroid(pid) + n*eps;
+        active.push_back(pid);
+    }
+
+    // directions come from the R2 sequence (Roberts 2018), randomly shifted
+    std::mt19937 rng(opt.seed);
+    std::uniform_real_distribution<double> unif(0,1);
+    double shift[2] = { unif(rng), unif(rng) };
+
+    std::vector<unsigned int> n_rays(m.num_polys(),0), n_free(m.num_polys(),0);
+    std::vector<vec3d> p, d;
+    std::vector<bool>  occluded;
+    unsigned int shot = 0; // rays already shot from each active polygon
+    while(!active.empty())
+    {
+        unsigned int k = std::min((shot==0) ? opt.min_rays : opt.rays_step, opt.max_rays-shot);
+        if(k==0) break;
+
+        // sample major order: rays with the same sample index shot from
+        // nearby polygons have similar origins and directions
+        unsigned int na = active.size();
+        p.resize(k*na);
+        d.resize(k*na);
+        PARALLEL_FOR(0, k*na, 1000, [&](const unsigned int i)
+        {
+            unsigned int pid = active.at(i%na);
+            unsigned int s   = shot + i/na;
+            double u   = std::fmod(shift[0] + s*0.7548776662466927, 1.0);
+            double v   = std::fmod(shift[1] + s*0.5698402909980532, 1.0);
+            double r   = std::sqrt(u);
+            double phi = 2.0*M_PI*v;
+            // cosine weighted sample of the hemisphere
+            p.at(i) = org.at(pid);
+            d.at(i) = tu.at(pid) * (r*std::cos(phi)) +
+                      tv.at(pid) * (r*std::sin(phi)) +
+                      m.poly_data(pid).normal * std::sqrt(std::max(0.0, 1.0-u));
+        });
+        bvh.intersects_rays_any(p, d, occluded, max_t);
+
+        for(unsigned int i=0; i<k*na; ++i)
+        {
+            if(!occluded.at(i)) ++n_free.at(active.at(i%na));
+        }
+        for(unsigned int pid : active) n_rays.at(pid) += k;
+        shot += k;
+
+        // keep refining only the polygons whose estimate is still noisy
+        std::vector<unsigned int> tmp;
+        for(unsigned int pid : active)
+        {
+            double ao = double(n_free.at(pid))/shot;
+            double se = std::sqrt(ao*(1.0-ao)/shot);
+            if(se >= opt.tolerance) tmp.push_back(pid);
+        }
+        active.swap(tmp);
+    }
+
+    // apply AO
+    double min =  inf_double;
+    double max = -inf_double;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(n_rays.at(pid)==0) continue;
+        double ao = double(n_free.at(pid))/n_rays.at(pid);
+        min = std::min(min, ao);
+        max = std::max(max, ao);
+    }
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        if(n_rays.at(pid)==0)
+        {
+            m.poly_data(pid).AO = 1.0;
+            continue;
+        }
+        double ao = double(n_free.at(pid))/n_rays.at(pid);
+        if(opt.normalize && max>min) ao = (ao-min)/(max-min);
+        m.poly_data(pid).AO = ao;
+    }
+}
+
 }
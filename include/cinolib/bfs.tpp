@@ -89,7 +89,7 @@ void bfs(const AbstractMesh<M,V,E,P>    & m,
         unsigned int vid = q.front();
         q.pop();
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             if (DOES_NOT_CONTAIN(visited,nbr))
             {
@@ -120,7 +120,7 @@ void bfs(const AbstractMesh<M,V,E,P>    & m,
         unsigned int vid = q.front();
         q.pop();
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             if (!mask.at(nbr) && DOES_NOT_CONTAIN(visited,nbr))
             {
@@ -151,7 +151,7 @@ void bfs_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
         unsigned int vid = q.front();
         q.pop();
 
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(m.edge_is_on_srf(eid))
             {
@@ -186,7 +186,7 @@ void bfs_on_dual(const AbstractMesh<M,V,E,P>    & m,
         unsigned int pid = q.front();
         q.pop();
 
-        for(unsigned int nbr : m.adj_p2p(pid))
+        for(unsigned int nbr : m.adj_p2p_span(pid))
         {
             if (!mask.at(nbr) && DOES_NOT_CONTAIN(visited,nbr))
             {
@@ -219,7 +219,7 @@ void bfs_on_dual_w_edge_barriers(const AbstractPolygonMesh<M,V,E,P> & m,
         unsigned int pid = q.front();
         q.pop();
 
-        for(unsigned int nbr : m.adj_p2p(pid))
+        for(unsigned int nbr : m.adj_p2p_span(pid))
         {
             unsigned int eid = m.edge_shared(pid,nbr);
             if (!mask_edges.at(eid) && DOES_NOT_CONTAIN(visited,nbr))
@@ -0,0 +1,1403 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/bvh.h>
+#include <cinolib/how_many_seconds.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/trace_profiler.h>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+#include <thread>
+
+namespace cinolib
+{
+
+// squared distance between point p and the bounding box of a node
+CINO_INLINE
+static double node_dist_sqrd(const BVHNode & node, const vec3d & p)
+{
+    double d = 0.0;
+    for(int i=0; i<3; ++i)
+    {
+        double delta = std::max(0.0, std::max(node.min[i]-p[i], p[i]-node.max[i]));
+        d += delta*delta;
+    }
+    return d;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static bool node_contains(const BVHNode & node, const vec3d & p)
+{
+    return p[0]>=node.min[0] && p[0]<=node.max[0] &&
+           p[1]>=node.min[1] && p[1]<=node.max[1] &&
+           p[2]>=node.min[2] && p[2]<=node.max[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static bool node_intersects_box(const BVHNode & node, const AABB & b)
+{
+    return node.min[0]<=b.max[0] && node.max[0]>=b.min[0] &&
+           node.min[1]<=b.max[1] && node.max[1]>=b.min[1] &&
+           node.min[2]<=b.max[2] && node.max[2]>=b.min[2];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// slab test between a ray (or line) and the bounding box of a node, restricted to the
+// parameter interval [t_min,t_max]. Same logic of AABB::intersects_ray, but with the
+// inverse of the ray direction computed once per query
+CINO_INLINE
+static bool node_intersects_ray(const BVHNode & node,
+                                const vec3d   & p,
+                                const vec3d   & inv_dir,
+                                const bool      parallel[3],
+                                double          t_min,
+                                double          t_max,
+                                double        & t_entry)
+{
+    for(int i=0; i<3; ++i)
+    {
+        if(parallel[i])
+        {
+            if(p[i]<node.min[i] || p[i]>node.max[i]) return false;
+        }
+        else
+        {
+            double t_near = (node.min[i] - p[i]) * inv_dir[i];
+            double t_far  = (node.max[i] - p[i]) * inv_dir[i];
+            if(t_near > t_far) std::swap(t_near, t_far);
+            t_min = std::max(t_min, t_near);
+            t_max = std::min(t_max, t_far);
+            if(t_min>t_max) return false;
+        }
+    }
+    t_entry = t_min;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// spreads the 21 lowest bits of x, interleaving them with two zero bits (used to make 63 bit Morton codes)
+CINO_INLINE
+static uint64_t morton_spread(uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x <<  8) & 0x100f00f00f00f00f;
+    x = (x | x <<  4) & 0x10c30c30c30c30c3;
+    x = (x | x <<  2) & 0x1249249249249249;
+    return x;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+static double box_area(const vec3d & min, const vec3d & max)
+{
+    vec3d d = max - min;
+    return 2.0 * (d[0]*d[1] + d[1]*d[2] + d[2]*d[0]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+BVH::BVH(const unsigned int items_per_leaf)
+: items_per_leaf(std::max(1u,items_per_leaf))
+{}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::clear()
+{
+    nodes.clear();
+    items.clear();
+    points.clear();
+    spheres.clear();
+    segments.clear();
+    triangles.clear();
+    tets.clear();
+    tree_depth = 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_point(const unsigned int id, const vec3d & v)
+{
+    items.push_back({POINT, static_cast<unsigned int>(points.size())});
+    points.emplace_back(id,v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_sphere(const unsigned int id, const vec3d & c, const double r)
+{
+    items.push_back({SPHERE, static_cast<unsigned int>(spheres.size())});
+    spheres.emplace_back(id,c,r);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_segment(const unsigned int id, const std::vector<vec3d> & v)
+{
+    items.push_back({SEGMENT, static_cast<unsigned int>(segments.size())});
+    segments.emplace_back(id,v.data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_triangle(const unsigned int id, const std::vector<vec3d> & v)
+{
+    items.push_back({TRIANGLE, static_cast<unsigned int>(triangles.size())});
+    triangles.emplace_back(id,v.data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::push_tetrahedron(const unsigned int id, const std::vector<vec3d> & v)
+{
+    items.push_back({TETRAHEDRON, static_cast<unsigned int>(tets.size())});
+    tets.emplace_back(id,v.data());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::build()
+{
+    CINO_PROFILE_ZONE("BVH::build");
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    nodes.clear();
+    tree_depth = 0;
+    if(items.empty()) return;
+
+    unsigned int n = static_cast<unsigned int>(items.size());
+    std::vector<BuildItem> build_items(n);
+    PARALLEL_FOR(0, n, 10000, [&](const unsigned int i)
+    {
+        const AABB & b = item_aabb(i);
+        build_items[i].min      = b.min;
+        build_items[i].max      = b.max;
+        build_items[i].centroid = (b.min + b.max) * 0.5;
+    });
+
+    std::vector<unsigned int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+
+    // TOP LEVELS: split breadth first until there are enough independent sub-trees
+    // to keep all threads busy. Small ranges are directly deferred to the parallel phase
+    struct Task
+    {
+        unsigned int node, begin, end, depth;
+    };
+    std::vector<Task> tasks;
+    std::queue<Task>  q;
+    const unsigned int max_tasks = 8 * std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int min_range = 4096;
+
+    nodes.reserve(2*n/items_per_leaf + 1);
+    nodes.emplace_back();
+    q.push({0, 0, n, 1});
+    while(!q.empty())
+    {
+        Task task = q.front();
+        q.pop();
+
+        if(task.end-task.begin<=min_range || task.depth>=max_depth || q.size()+tasks.size()>=max_tasks)
+        {
+            tasks.push_back(task);
+            continue;
+        }
+
+        make_node(nodes.at(task.node), task.begin, task.end, order, build_items);
+
+        unsigned int mid;
+        if(!split(task.begin, task.end, order, build_items, mid))
+        {
+            nodes.at(task.node).first = task.begin;
+            nodes.at(task.node).count = task.end - task.begin;
+            tree_depth = std::max(tree_depth, task.depth);
+            continue;
+        }
+
+        unsigned int child = static_cast<unsigned int>(nodes.size());
+        nodes.at(task.node).first = child;
+        nodes.emplace_back();
+        nodes.emplace_back();
+        q.push({child,   task.begin, mid,      task.depth+1});
+        q.push({child+1, mid,        task.end, task.depth+1});
+    }
+
+    // WORK IN PARALLEL ON EACH SUB-TREE
+    // Sub-trees are built in private node arrays (tasks operate on disjoint
+    // ranges of items), and are merged into the global array afterwards
+    std::vector<std::vector<BVHNode>> sub_trees(tasks.size());
+    std::vector<unsigned int>         sub_depth(tasks.size());
+    PARALLEL_FOR(0, tasks.size(), 1, [&](const unsigned int i)
+    {
+        const Task & task = tasks.at(i);
+        sub_depth.at(i) = build_subtree(sub_trees.at(i), task.begin, task.end, task.depth, order, build_items);
+    });
+
+    for(unsigned int i=0; i<tasks.size(); ++i)
+    {
+        // local node 0 replaces the placeholder, all other nodes are appended
+        unsigned int offset = static_cast<unsigned int>(nodes.size()) - 1;
+        for(BVHNode & node : sub_trees.at(i))
+        {
+            if(!node.is_leaf()) node.first += offset;
+        }
+        nodes.at(tasks.at(i).node) = sub_trees.at(i).front();
+        nodes.insert(nodes.end(), sub_trees.at(i).begin()+1, sub_trees.at(i).end());
+        tree_depth = std::max(tree_depth, sub_depth.at(i));
+    }
+
+    // sort items (and per type storage) in leaf order, so that
+    // each leaf references a contiguous range of primitives
+    std::vector<BVHItem>     sorted_items(n);
+    std::vector<Point>       sorted_points;    sorted_points.reserve(points.size());
+    std::vector<Sphere>      sorted_spheres;   sorted_spheres.reserve(spheres.size());
+    std::vector<Segment>     sorted_segments;  sorted_segments.reserve(segments.size());
+    std::vector<Triangle>    sorted_triangles; sorted_triangles.reserve(triangles.size());
+    std::vector<Tetrahedron> sorted_tets;      sorted_tets.reserve(tets.size());
+    for(unsigned int i=0; i<n; ++i)
+    {
+        BVHItem item = items.at(order.at(i));
+        switch(item.type)
+        {
+            case POINT       : sorted_points.push_back(points.at(item.index));       item.index = static_cast<unsigned int>(sorted_points.size())-1;    break;
+            case SPHERE      : sorted_spheres.push_back(spheres.at(item.index));     item.index = static_cast<unsigned int>(sorted_spheres.size())-1;   break;
+            case SEGMENT     : sorted_segments.push_back(segments.at(item.index));   item.index = static_cast<unsigned int>(sorted_segments.size())-1;  break;
+            case TRIANGLE    : sorted_triangles.push_back(triangles.at(item.index)); item.index = static_cast<unsigned int>(sorted_triangles.size())-1; break;
+            case TETRAHEDRON : sorted_tets.push_back(tets.at(item.index));           item.index = static_cast<unsigned int>(sorted_tets.size())-1;      break;
+            default: assert(false && "Unsupported item");
+        }
+        sorted_items.at(i) = item;
+    }
+    items.swap(sorted_items);
+    points.swap(sorted_points);
+    spheres.swap(sorted_spheres);
+    segments.swap(sorted_segments);
+    triangles.swap(sorted_triangles);
+    tets.swap(sorted_tets);
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        double t = how_many_seconds(t0,t1);
+        std::cout << ":::::::::::::::::::::::::::::::::::::::::::::::::::" << std::endl;
+        std::cout << "BVH created (" << t << "s)                         " << std::endl;
+        std::cout << "#Items                   : " << items.size()         << std::endl;
+        std::cout << "#Nodes                   : " << nodes.size()         << std::endl;
+        std::cout << "Depth                    : " << tree_depth           << std::endl;
+        std::cout << "Prescribed items per leaf: " << items_per_leaf       << std::endl;
+        std::cout << "Max items per leaf       : " << max_items_per_leaf() << std::endl;
+        std::cout << ":::::::::::::::::::::::::::::::::::::::::::::::::::" << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int BVH::build_subtree(std::vector<BVHNode>         & tree,
+                                const unsigned int             begin,
+                                const unsigned int             end,
+                                const unsigned int             depth,
+                                std::vector<unsigned int>    & order,
+                                const std::vector<BuildItem> & build_items) const
+{
+    struct Task
+    {
+        unsigned int node, begin, end, depth;
+    };
+    std::vector<Task> lifo;
+    unsigned int max_depth_reached = depth;
+
+    tree.reserve(2*(end-begin)/items_per_leaf + 1);
+    tree.emplace_back();
+    lifo.push_back({0, begin, end, depth});
+    while(!lifo.empty())
+    {
+        Task task = lifo.back();
+        lifo.pop_back();
+        max_depth_reached = std::max(max_depth_reached, task.depth);
+
+        make_node(tree.at(task.node), task.begin, task.end, order, build_items);
+
+        unsigned int mid;
+        if(task.depth>=max_depth || !split(task.begin, task.end, order, build_items, mid))
+        {
+            tree.at(task.node).first = task.begin;
+            tree.at(task.node).count = task.end - task.begin;
+            continue;
+        }
+
+        unsigned int child = static_cast<unsigned int>(tree.size());
+        tree.at(task.node).first = child;
+        tree.emplace_back();
+        tree.emplace_back();
+        lifo.push_back({child+1, mid,        task.end, task.depth+1});
+        lifo.push_back({child,   task.begin, mid,      task.depth+1});
+    }
+    return max_depth_reached;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::make_node(BVHNode                         & node,
+                    const unsigned int                begin,
+                    const unsigned int                end,
+                    const std::vector<unsigned int> & order,
+                    const std::vector<BuildItem>    & build_items) const
+{
+    for(int j=0; j<3; ++j)
+    {
+        node.min[j] =  inf_double;
+        node.max[j] = -inf_double;
+    }
+    for(unsigned int i=begin; i<end; ++i)
+    {
+        const BuildItem & it = build_items[order[i]];
+        for(int j=0; j<3; ++j)
+        {
+            node.min[j] = std::min(node.min[j], it.min[j]);
+            node.max[j] = std::max(node.max[j], it.max[j]);
+        }
+    }
+    node.first = 0;
+    node.count = 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// binned SAH split. Items are binned according to the position of their centroid
+// along each axis, and the split that minimizes the Surface Area Heuristic is used.
+// Returns false if the range should become a leaf
+CINO_INLINE
+bool BVH::split(const unsigned int             begin,
+                const unsigned int             end,
+                std::vector<unsigned int>    & order,
+                const std::vector<BuildItem> & build_items,
+                unsigned int                 & mid) const
+{
+    unsigned int n = end - begin;
+    if(n<=items_per_leaf) return false;
+
+    vec3d c_min{ inf_double, inf_double, inf_double};
+    vec3d c_max{-inf_double,-inf_double,-inf_double};
+    for(unsigned int i=begin; i<end; ++i)
+    {
+        c_min = c_min.min(build_items[order[i]].centroid);
+        c_max = c_max.max(build_items[order[i]].centroid);
+    }
+
+    const unsigned int n_bins = 16;
+    double best_cost = inf_double;
+    int    best_axis = -1;
+    int    best_bin  = -1;
+
+    for(int axis=0; axis<3; ++axis)
+    {
+        double extent = c_max[axis] - c_min[axis];
+        if(extent<=0) continue;
+        double scale = n_bins / extent;
+
+        unsigned int count[n_bins] = {};
+        vec3d        b_min[n_bins];
+        vec3d        b_max[n_bins];
+        for(unsigned int b=0; b<n_bins; ++b)
+        {
+            b_min[b] = vec3d{ inf_double, inf_double, inf_double};
+            b_max[b] = vec3d{-inf_double,-inf_double,-inf_double};
+        }
+        for(unsigned int i=begin; i<end; ++i)
+        {
+            const BuildItem & it = build_items[order[i]];
+            unsigned int b = std::min(n_bins-1, static_cast<unsigned int>((it.centroid[axis]-c_min[axis])*scale));
+            ++count[b];
+            b_min[b] = b_min[b].min(it.min);
+            b_max[b] = b_max[b].max(it.max);
+        }
+
+        // sweep from the right to accumulate the cost of the right partitions
+        double       right_cost[n_bins];
+        vec3d        r_min{ inf_double, inf_double, inf_double};
+        vec3d        r_max{-inf_double,-inf_double,-inf_double};
+        unsigned int r_count = 0;
+        for(unsigned int b=n_bins-1; b>0; --b)
+        {
+            r_min    = r_min.min(b_min[b]);
+            r_max    = r_max.max(b_max[b]);
+            r_count += count[b];
+            right_cost[b] = (r_count>0) ? r_count * box_area(r_min,r_max) : 0.0;
+        }
+
+        // sweep from the left, evaluating the split between bins b and b+1
+        vec3d        l_min{ inf_double, inf_double, inf_double};
+        vec3d        l_max{-inf_double,-inf_double,-inf_double};
+        unsigned int l_count = 0;
+        for(unsigned int b=0; b<n_bins-1; ++b)
+        {
+            l_min    = l_min.min(b_min[b]);
+            l_max    = l_max.max(b_max[b]);
+            l_count += count[b];
+            if(l_count==0 || l_count==n) continue;
+            double cost = l_count * box_area(l_min,l_max) + right_cost[b+1];
+            if(cost<best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_bin  = static_cast<int>(b);
+            }
+        }
+    }
+
+    if(best_axis>=0)
+    {
+        double extent = c_max[best_axis] - c_min[best_axis];
+        double scale  = n_bins / extent;
+        auto it = std::partition(order.begin()+begin, order.begin()+end, [&](const unsigned int i)
+        {
+            unsigned int b = std::min(n_bins-1, static_cast<unsigned int>((build_items[i].centroid[best_axis]-c_min[best_axis])*scale));
+            return static_cast<int>(b) <= best_bin;
+        });
+        mid = static_cast<unsigned int>(it - order.begin());
+        if(mid>begin && mid<end) return true;
+    }
+
+    // all centroids coincide (or numerical issues): split in two halves
+    // anyways, so as to keep the number of items per leaf bounded
+    mid = begin + n/2;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int BVH::max_items_per_leaf() const
+{
+    unsigned int max=0;
+    for(const BVHNode & node : nodes) max = std::max(max,node.count);
+    return max;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+AABB BVH::bbox() const
+{
+    if(nodes.empty()) return AABB();
+    return AABB(vec3d{nodes[0].min[0], nodes[0].min[1], nodes[0].min[2]},
+                vec3d{nodes[0].max[0], nodes[0].max[1], nodes[0].max[2]});
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::debug_mode(const bool b)
+{
+    print_debug_info = b;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int BVH::item_id(const unsigned int i) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].id;
+        case SPHERE      : return spheres[item.index].id;
+        case SEGMENT     : return segments[item.index].id;
+        case TRIANGLE    : return triangles[item.index].id;
+        case TETRAHEDRON : return tets[item.index].id;
+        default: assert(false && "Unsupported item");
+    }
+    return 0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const AABB & BVH::item_aabb(const unsigned int i) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].aabb;
+        case SPHERE      : return spheres[item.index].aabb;
+        case SEGMENT     : return segments[item.index].aabb;
+        case TRIANGLE    : return triangles[item.index].aabb;
+        case TETRAHEDRON : return tets[item.index].aabb;
+        default: assert(false && "Unsupported item");
+    }
+    return triangles[item.index].aabb;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d BVH::item_closest_point(const unsigned int i, const vec3d & p) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].Point::point_closest_to(p);
+        case SPHERE      : return spheres[item.index].Sphere::point_closest_to(p);
+        case SEGMENT     : return segments[item.index].Segment::point_closest_to(p);
+        case TRIANGLE    : return triangles[item.index].Triangle::point_closest_to(p);
+        case TETRAHEDRON : return tets[item.index].Tetrahedron::point_closest_to(p);
+        default: assert(false && "Unsupported item");
+    }
+    return p;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::item_contains(const unsigned int i, const vec3d & p, const bool strict) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].Point::contains(p,strict);
+        case SPHERE      : return spheres[item.index].Sphere::contains(p,strict);
+        case SEGMENT     : return segments[item.index].Segment::contains(p,strict);
+        case TRIANGLE    : return triangles[item.index].Triangle::contains(p,strict);
+        case TETRAHEDRON : return tets[item.index].Tetrahedron::contains(p,strict);
+        default: assert(false && "Unsupported item");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::item_intersects_ray(const unsigned int i, const vec3d & p, const vec3d & dir, const bool line, double & t) const
+{
+    const BVHItem & item = items[i];
+    vec3d pos;
+    if(line)
+    {
+        switch(item.type)
+        {
+            case POINT       : return points[item.index].Point::intersects_line(p,dir,t,pos);
+            case SPHERE      : return spheres[item.index].Sphere::intersects_line(p,dir,t,pos);
+            case SEGMENT     : return segments[item.index].Segment::intersects_line(p,dir,t,pos);
+            case TRIANGLE    : return triangles[item.index].Triangle::intersects_line(p,dir,t,pos);
+            case TETRAHEDRON : return tets[item.index].Tetrahedron::intersects_line(p,dir,t,pos);
+            default: assert(false && "Unsupported item");
+        }
+    }
+    else
+    {
+        switch(item.type)
+        {
+            case POINT       : return points[item.index].Point::intersects_ray(p,dir,t,pos);
+            case SPHERE      : return spheres[item.index].Sphere::intersects_ray(p,dir,t,pos);
+            case SEGMENT     : return segments[item.index].Segment::intersects_ray(p,dir,t,pos);
+            case TRIANGLE    : return triangles[item.index].Triangle::intersects_ray(p,dir,t,pos);
+            case TETRAHEDRON : return tets[item.index].Tetrahedron::intersects_ray(p,dir,t,pos);
+            default: assert(false && "Unsupported item");
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::item_intersects_segment(const unsigned int i, const vec3d s[], const bool ignore_if_valid_complex) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].Point::intersects_segment(s,ignore_if_valid_complex);
+        case SPHERE      : return spheres[item.index].Sphere::intersects_segment(s,ignore_if_valid_complex);
+        case SEGMENT     : return segments[item.index].Segment::intersects_segment(s,ignore_if_valid_complex);
+        case TRIANGLE    : return triangles[item.index].Triangle::intersects_segment(s,ignore_if_valid_complex);
+        case TETRAHEDRON : return tets[item.index].Tetrahedron::intersects_segment(s,ignore_if_valid_complex);
+        default: assert(false && "Unsupported item");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::item_intersects_triangle(const unsigned int i, const vec3d t[], const bool ignore_if_valid_complex) const
+{
+    const BVHItem & item = items[i];
+    switch(item.type)
+    {
+        case POINT       : return points[item.index].Point::intersects_triangle(t,ignore_if_valid_complex);
+        case SPHERE      : return spheres[item.index].Sphere::intersects_triangle(t,ignore_if_valid_complex);
+        case SEGMENT     : return segments[item.index].Segment::intersects_triangle(t,ignore_if_valid_complex);
+        case TRIANGLE    : return triangles[item.index].Triangle::intersects_triangle(t,ignore_if_valid_complex);
+        case TETRAHEDRON : return tets[item.index].Tetrahedron::intersects_triangle(t,ignore_if_valid_complex);
+        default: assert(false && "Unsupported item");
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d BVH::closest_point(const vec3d & p) const
+{
+    unsigned int id;
+    vec3d        pos;
+    double       dist;
+    closest_point(p, id, pos, dist);
+    return pos;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::closest_point(const vec3d        & p,          // query point
+                              unsigned int & id,         // id of the item T closest to p
+                              vec3d        & pos,        // point in T closest to p
+                              double       & dist) const // distance between pos and p
+{
+    assert(!nodes.empty());
+
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    double d;
+    id   = item_id(closest_item(p, num_items(), pos, d));
+    dist = std::sqrt(d);
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Closest point\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::closest_points(const std::vector<vec3d>        & p,
+                               std::vector<unsigned int> & ids,
+                               std::vector<vec3d>        & pos,
+                               std::vector<double>       & dist) const
+{
+    unsigned int n = static_cast<unsigned int>(p.size());
+    ids.resize(n);
+    pos.resize(n);
+    dist.resize(n);
+    if(n==0) return;
+    assert(!nodes.empty());
+
+    // sort queries along a Morton curve, so that consecutive queries are close in space
+    AABB  box(p);
+    vec3d delta = box.delta();
+    for(int i=0; i<3; ++i) delta[i] = (delta[i]>0) ? delta[i] : 1.0;
+    std::vector<std::pair<uint64_t,unsigned int>> order(n);
+    PARALLEL_FOR(0, n, 10000, [&](const unsigned int i)
+    {
+        uint64_t code = 0;
+        for(int j=0; j<3; ++j)
+        {
+            double x = (p[i][j] - box.min[j]) / delta[j];
+            code |= morton_spread(static_cast<uint64_t>(x * 2097151.0)) << j;
+        }
+        order[i] = std::make_pair(code,i);
+    });
+    std::sort(order.begin(), order.end());
+
+    // process chunks of consecutive queries in parallel. Within each chunk, the
+    // closest item of the previous query provides a tight initial upper bound
+    const unsigned int chunk    = 256;
+    const unsigned int n_chunks = (n + chunk - 1) / chunk;
+    PARALLEL_FOR(0, n_chunks, 1, [&](const unsigned int c)
+    {
+        unsigned int item = num_items(); // i.e. no hint
+        for(unsigned int k=c*chunk; k<std::min(n,(c+1)*chunk); ++k)
+        {
+            unsigned int i = order[k].second;
+            double       d;
+            item    = closest_item(p[i], item, pos[i], d);
+            ids[i]  = item_id(item);
+            dist[i] = std::sqrt(d);
+        }
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// depth first traversal, visiting the closest child first and pruning
+// all nodes that are farther than the closest item found so far
+CINO_INLINE
+unsigned int BVH::closest_item(const vec3d        & p,
+                               const unsigned int   hint,
+                                     vec3d        & pos,
+                                     double       & dist_sqrd) const
+{
+    assert(!nodes.empty());
+
+    double       best = inf_double;
+    unsigned int item = 0;
+    if(hint<items.size())
+    {
+        item = hint;
+        pos  = item_closest_point(hint,p);
+        best = pos.dist_sqrd(p);
+    }
+
+    unsigned int stack[stack_size];
+    double       stack_dist[stack_size];
+    unsigned int top = 0;
+
+    stack[top]      = 0;
+    stack_dist[top] = node_dist_sqrd(nodes[0],p);
+    ++top;
+
+    while(top>0)
+    {
+        --top;
+        if(stack_dist[top]>=best) continue;
+        const BVHNode & node = nodes[stack[top]];
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                vec3d  q = item_closest_point(i,p);
+                double d = q.dist_sqrd(p);
+                if(d<best)
+                {
+                    best = d;
+                    item = i;
+                    pos  = q;
+                }
+            }
+        }
+        else
+        {
+            unsigned int near = node.first;
+            unsigned int far  = node.first+1;
+            double d_near = node_dist_sqrd(nodes[near],p);
+            double d_far  = node_dist_sqrd(nodes[far], p);
+            if(d_far<d_near)
+            {
+                std::swap(near,   far);
+                std::swap(d_near, d_far);
+            }
+            if(d_far <best) { stack[top] = far;  stack_dist[top] = d_far;  ++top; }
+            if(d_near<best) { stack[top] = near; stack_dist[top] = d_near; ++top; }
+        }
+    }
+
+    dist_sqrd = best;
+    return item;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_EXACT_PREDICATES is defined
+CINO_INLINE
+bool BVH::contains(const vec3d & p, const bool strict, unsigned int & id) const
+{
+    if(nodes.empty()) return false;
+
+    unsigned int stack[stack_size];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    while(top>0)
+    {
+        const BVHNode & node = nodes[stack[--top]];
+        if(!node_contains(node,p)) continue;
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(item_contains(i,p,strict))
+                {
+                    id = item_id(i);
+                    return true;
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.first+1;
+            stack[top++] = node.first;
+        }
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_EXACT_PREDICATES is defined
+CINO_INLINE
+bool BVH::contains(const vec3d & p, const bool strict, std::unordered_set<unsigned int> & ids) const
+{
+    if(nodes.empty()) return false;
+
+    unsigned int stack[stack_size];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    while(top>0)
+    {
+        const BVHNode & node = nodes[stack[--top]];
+        if(!node_contains(node,p)) continue;
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(item_contains(i,p,strict)) ids.insert(item_id(i));
+            }
+        }
+        else
+        {
+            stack[top++] = node.first+1;
+            stack[top++] = node.first;
+        }
+    }
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// depth first traversal, visiting the closest child first and pruning all
+// nodes that are entered by the ray after the closest hit found so far
+CINO_INLINE
+bool BVH::intersects_ray_or_line(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id, const bool line) const
+{
+    if(nodes.empty()) return false;
+
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    vec3d inv_dir;
+    bool  parallel[3];
+    for(int i=0; i<3; ++i)
+    {
+        parallel[i] = std::fabs(dir[i]) < 1e-15;
+        inv_dir[i]  = parallel[i] ? 0.0 : 1.0/dir[i];
+    }
+
+    const double t_lo = line ? -max_double : 0.0;
+    double best  = inf_double;
+    bool   found = false;
+
+    unsigned int stack[stack_size];
+    double       stack_t[stack_size];
+    unsigned int top = 0;
+
+    double t;
+    if(node_intersects_ray(nodes[0], p, inv_dir, parallel, t_lo, best, t))
+    {
+        stack[top]   = 0;
+        stack_t[top] = t;
+        ++top;
+    }
+
+    while(top>0)
+    {
+        --top;
+        if(stack_t[top]>best) continue;
+        const BVHNode & node = nodes[stack[top]];
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(item_intersects_ray(i, p, dir, line, t) && t<best)
+                {
+                    best  = t;
+                    id    = item_id(i);
+                    found = true;
+                }
+            }
+        }
+        else
+        {
+            double t_near, t_far;
+            unsigned int near = node.first;
+            unsigned int far  = node.first+1;
+            bool hit_near = node_intersects_ray(nodes[near], p, inv_dir, parallel, t_lo, best, t_near);
+            bool hit_far  = node_intersects_ray(nodes[far],  p, inv_dir, parallel, t_lo, best, t_far);
+            if(hit_near && hit_far && t_far<t_near)
+            {
+                std::swap(near, far);
+                std::swap(t_near, t_far);
+            }
+            else if(!hit_near && hit_far)
+            {
+                std::swap(near, far);
+                std::swap(t_near, t_far);
+                std::swap(hit_near, hit_far);
+            }
+            if(hit_far)  { stack[top] = far;  stack_t[top] = t_far;  ++top; }
+            if(hit_near) { stack[top] = near; stack_t[top] = t_near; ++top; }
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects ray\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    if(found) min_t = best;
+    return found;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id) const
+{
+    return intersects_ray_or_line(p, dir, min_t, id, false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::intersects_line(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id) const
+{
+    return intersects_ray_or_line(p, dir, min_t, id, true);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BVH::intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,unsigned int>> & all_hits) const
+{
+    if(nodes.empty()) return false;
+
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    vec3d inv_dir;
+    bool  parallel[3];
+    for(int i=0; i<3; ++i)
+    {
+        parallel[i] = std::fabs(dir[i]) < 1e-15;
+        inv_dir[i]  = parallel[i] ? 0.0 : 1.0/dir[i];
+    }
+
+    unsigned int stack[stack_size];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    double t;
+    while(top>0)
+    {
+        const BVHNode & node = nodes[stack[--top]];
+        if(!node_intersects_ray(node, p, inv_dir, parallel, 0.0, inf_double, t)) continue;
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(item_intersects_ray(i, p, dir, false, t))
+                {
+                    all_hits.insert(std::make_pair(t,item_id(i)));
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.first+1;
+            stack[top++] = node.first;
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects ray\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !all_hits.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::items_overlapping(const AABB & b, std::vector<unsigned int> & list) const
+{
+    if(nodes.empty()) return;
+
+    unsigned int stack[stack_size];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    while(top>0)
+    {
+        const BVHNode & node = nodes[stack[--top]];
+        if(!node_intersects_box(node,b)) continue;
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(item_aabb(i).intersects_box(b)) list.push_back(i);
+            }
+        }
+        else
+        {
+            stack[top++] = node.first+1;
+            stack[top++] = node.first;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_EXACT_PREDICATES is defined
+CINO_INLINE
+bool BVH::intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<unsigned int> & ids) const
+{
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<unsigned int> candidates;
+    items_overlapping(AABB({t[0],t[1],t[2]}), candidates);
+
+    for(unsigned int i : candidates)
+    {
+        if(item_intersects_triangle(i, t, ignore_if_valid_complex))
+        {
+            ids.insert(item_id(i));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects triangle\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// this query becomes exact if CINOLIB_USES_EXACT_PREDICATES is defined
+CINO_INLINE
+bool BVH::intersects_segment(const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<unsigned int> & ids) const
+{
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<unsigned int> candidates;
+    items_overlapping(AABB(s[0],s[1]), candidates);
+
+    for(unsigned int i : candidates)
+    {
+        if(item_intersects_segment(i, s, ignore_if_valid_complex))
+        {
+            ids.insert(item_id(i));
+        }
+    }
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects segment\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// WARNING: this function may return false positives because it only checks intersection between
+// the box b and the AABB of the items in the tree. This is a partial result that it is useful for
+// some of the queries above, where a more expensive test between the geometric entity approximated
+// by box b and the actual items will be performed
+CINO_INLINE
+bool BVH::intersects_box(const AABB & b, std::unordered_set<unsigned int> & ids) const
+{
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    std::vector<unsigned int> candidates;
+    items_overlapping(b, candidates);
+    for(unsigned int i : candidates) ids.insert(item_id(i));
+
+    if(print_debug_info)
+    {
+        Time::time_point t1 = Time::now();
+        std::cout << "Intersects box\t" << how_many_seconds(t0,t1) << " seconds" << std::endl;
+    }
+
+    return !ids.empty();
+}
+
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::intersects_rays(const std::vector<vec3d>  & p,
+                          const std::vector<vec3d>  & dir,
+                                std::vector<double> & t,
+                                std::vector<int>    & ids) const
+{
+    assert(p.size()==dir.size());
+    unsigned int n = static_cast<unsigned int>(p.size());
+    t.assign(n, inf_double);
+    ids.assign(n, -1);
+    if(nodes.empty()) return;
+
+    unsigned int n_packets = (n + packet_size - 1) / packet_size;
+    PARALLEL_FOR(0, n_packets, 16, [&](const unsigned int i)
+    {
+        unsigned int first = i * packet_size;
+        trace_packet(&p[first], &dir[first], std::min(packet_size, n-first), false, &t[first], &ids[first]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BVH::intersects_rays_any(const std::vector<vec3d> & p,
+                              const std::vector<vec3d> & dir,
+                                    std::vector<bool>  & occluded,
+                              const double               max_t) const
+{
+    assert(p.size()==dir.size());
+    unsigned int n = static_cast<unsigned int>(p.size());
+    occluded.assign(n, false);
+    if(nodes.empty()) return;
+
+    // std::vector<bool> is not safe for concurrent writes. Use plain ints while tracing
+    std::vector<double> t(n, max_t);
+    std::vector<int>    ids(n, -1);
+    unsigned int n_packets = (n + packet_size - 1) / packet_size;
+    PARALLEL_FOR(0, n_packets, 16, [&](const unsigned int i)
+    {
+        unsigned int first = i * packet_size;
+        trace_packet(&p[first], &dir[first], std::min(packet_size, n-first), true, &t[first], &ids[first]);
+    });
+    for(unsigned int i=0; i<n; ++i) occluded[i] = (ids[i]>=0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Traces a packet of (at most) packet_size rays. Ray data is stored in a structure
+// of arrays layout, and box and triangle tests are written as branch free loops over
+// the packet lanes, so that the compiler can map them onto SIMD instructions. On input
+// t contains the maximum parameter for each ray. On output, t and ids contain the closest
+// hit (any_hit=false) or the first hit found (any_hit=true). Lanes with no hits have id -1
+CINO_INLINE
+void BVH::trace_packet(const vec3d        * p,
+                       const vec3d        * dir,
+                       const unsigned int   n,
+                       const bool           any_hit,
+                             double       * t,
+                             int          * ids) const
+{
+    const unsigned int K = packet_size;
+    assert(n>0 && n<=K);
+
+    // incoherent rays would visit (almost) the union of the nodes visited by each ray.
+    // Packets with rays pointing in clearly different directions are traced one by one
+    bool coherent = true;
+    for(unsigned int l=1; l<n && coherent; ++l) coherent = dir[l].dot(dir[0]) > 0.9*dir[l].norm()*dir[0].norm();
+    if(!coherent)
+    {
+        for(unsigned int l=0; l<n; ++l)
+        {
+            double       tt;
+            unsigned int id;
+            ids[l] = -1;
+            if(intersects_ray_or_line(p[l], dir[l], tt, id, false) && tt<=t[l])
+            {
+                ids[l] = static_cast<int>(id);
+                if(!any_hit) t[l] = tt;
+            }
+        }
+        return;
+    }
+
+    // unused lanes replicate the first ray, but have a negative max parameter, so they never hit anything
+    double ox[K], oy[K], oz[K], dx[K], dy[K], dz[K], ix[K], iy[K], iz[K], best[K];
+    int    hit[K];
+    for(unsigned int l=0; l<K; ++l)
+    {
+        unsigned int r = (l<n) ? l : 0;
+        ox[l] = p[r][0];   oy[l] = p[r][1];   oz[l] = p[r][2];
+        dx[l] = dir[r][0]; dy[l] = dir[r][1]; dz[l] = dir[r][2];
+        // for rays parallel to an axis a huge (but finite) inverse avoids NaNs in the slab test
+        ix[l] = (std::fabs(dx[l])<1e-15) ? 1e300 : 1.0/dx[l];
+        iy[l] = (std::fabs(dy[l])<1e-15) ? 1e300 : 1.0/dy[l];
+        iz[l] = (std::fabs(dz[l])<1e-15) ? 1e300 : 1.0/dz[l];
+        best[l] = (l<n) ? t[l] : -1.0;
+        hit[l]  = -1;
+    }
+    unsigned int n_active = n;
+
+    auto packet_hits_node = [&](const BVHNode & node) -> bool
+    {
+        bool any = false;
+        for(unsigned int l=0; l<K; ++l)
+        {
+            double t0x = (node.min[0]-ox[l])*ix[l], t1x = (node.max[0]-ox[l])*ix[l];
+            double t0y = (node.min[1]-oy[l])*iy[l], t1y = (node.max[1]-oy[l])*iy[l];
+            double t0z = (node.min[2]-oz[l])*iz[l], t1z = (node.max[2]-oz[l])*iz[l];
+            double t_near = std::max(std::max(std::min(t0x,t1x), std::min(t0y,t1y)), std::max(std::min(t0z,t1z), 0.0));
+            double t_far  = std::min(std::min(std::max(t0x,t1x), std::max(t0y,t1y)), std::min(std::max(t0z,t1z), best[l]));
+            any |= (t_near<=t_far);
+        }
+        return any;
+    };
+
+    // Moller-Trumbore for all lanes at once (same arithmetic of Moller_Trumbore_intersection)
+    auto packet_hits_triangle = [&](const Triangle & tri)
+    {
+        const double EPSILON = 0.0000001;
+        const vec3d  e0 = tri.v[1] - tri.v[0];
+        const vec3d  e1 = tri.v[2] - tri.v[0];
+        const vec3d  v0 = tri.v[0];
+        for(unsigned int l=0; l<K; ++l)
+        {
+            double px = dy[l]*e1[2] - dz[l]*e1[1];
+            double py = dz[l]*e1[0] - dx[l]*e1[2];
+            double pz = dx[l]*e1[1] - dy[l]*e1[0];
+            double det = e0[0]*px + e0[1]*py + e0[2]*pz;
+            double inv = 1.0/det;
+            double tx = ox[l]-v0[0];
+            double ty = oy[l]-v0[1];
+            double tz = oz[l]-v0[2];
+            double u  = (tx*px + ty*py + tz*pz) * inv;
+            double qx = ty*e0[2] - tz*e0[1];
+            double qy = tz*e0[0] - tx*e0[2];
+            double qz = tx*e0[1] - ty*e0[0];
+            double v  = (dx[l]*qx + dy[l]*qy + dz[l]*qz) * inv;
+            double tt = (e1[0]*qx + e1[1]*qy + e1[2]*qz) * inv;
+            bool ok = std::fabs(det)>=EPSILON && u>=0.0 && u<=1.0 && v>=0.0 && v+u<=1.0 && tt>=0.0 &&
+                      (any_hit ? tt<=best[l] : tt<best[l]);
+            best[l] = ok ? tt : best[l];
+            hit[l]  = ok ? static_cast<int>(tri.id) : hit[l];
+        }
+    };
+
+    unsigned int stack[stack_size];
+    unsigned int top = 0;
+    stack[top++] = 0;
+
+    while(top>0 && n_active>0)
+    {
+        // the box is tested when the node is popped, so that hits found in
+        // the meantime are used to cull as many nodes as possible
+        const BVHNode & node = nodes[stack[--top]];
+        if(!packet_hits_node(node)) continue;
+
+        if(node.is_leaf())
+        {
+            for(unsigned int i=node.first; i<node.first+node.count; ++i)
+            {
+                if(items[i].type==TRIANGLE)
+                {
+                    packet_hits_triangle(triangles[items[i].index]);
+                }
+                else
+                {
+                    for(unsigned int l=0; l<n; ++l)
+                    {
+                        double tt;
+                        if(best[l]>=0 && item_intersects_ray(i, p[l], dir[l], false, tt) && (any_hit ? tt<=best[l] : tt<best[l]))
+                        {
+                            best[l] = tt;
+                            hit[l]  = static_cast<int>(item_id(i));
+                        }
+                    }
+                }
+                if(any_hit)
+                {
+                    // lanes that found a hit retire (a negative max parameter culls everything)
+                    n_active = 0;
+                    for(unsigned int l=0; l<n; ++l)
+                    {
+                        if(hit[l]>=0) best[l] = -1.0;
+                        else          ++n_active;
+                    }
+                    if(n_active==0) break;
+                }
+            }
+        }
+        else
+        {
+            // visit first the child that comes first along the direction of the first active ray
+            unsigned int near = node.first;
+            unsigned int far  = node.first+1;
+            unsigned int r    = 0;
+            while(r+1<n && best[r]<0) ++r;
+            double d = 0.0;
+            d += (nodes[far].min[0]+nodes[far].max[0]-nodes[near].min[0]-nodes[near].max[0]) * dx[r];
+            d += (nodes[far].min[1]+nodes[far].max[1]-nodes[near].min[1]-nodes[near].max[1]) * dy[r];
+            d += (nodes[far].min[2]+nodes[far].max[2]-nodes[near].min[2]-nodes[near].max[2]) * dz[r];
+            if(d<0) std::swap(near,far);
+            stack[top++] = far;
+            stack[top++] = near;
+        }
+    }
+
+    for(unsigned int l=0; l<n; ++l)
+    {
+        ids[l] = hit[l];
+        if(!any_hit && hit[l]>=0) t[l] = best[l];
+    }
+}
+
+}
@@ -0,0 +1,355 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BVH_H
+#define CINO_BVH_H
+
+#include <cinolib/geometry/point.h>
+#include <cinolib/geometry/sphere.h>
+#include <cinolib/geometry/segment.h>
+#include <cinolib/geometry/triangle.h>
+#include <cinolib/geometry/tetrahedron.h>
+#include <cinolib/meshes/meshes.h>
+#include <unordered_set>
+#include <set>
+#include <cassert>
+
+namespace cinolib
+{
+
+/* Bounding Volume Hierarchy with the same query surface of the Octree, but
+ * designed for throughput:
+ *
+ *  - nodes live in a single linear array. Inner nodes store the index of their
+ *    first child (the second child is always next to it) and leaves store a
+ *    contiguous range of items
+ *  - items are stored in homogeneous, per primitive type arrays, sorted in leaf
+ *    order after the build. Primitive tests are dispatched with a switch on the
+ *    item type and non virtual calls
+ *  - the tree is built top-down with a binned Surface Area Heuristic, and
+ *    sub-trees are built in parallel
+ *
+ * Ref: On fast Construction of SAH-based Bounding Volume Hierarchies
+ *      I. Wald, Symposium on Interactive Ray Tracing, 2007
+ *
+ * Usage:
+ *
+ *  i)   Create an empty BVH
+ *  ii)  Use the push_segment/triangle/tetrahedron facilities to populate it
+ *  iii) Call build to make the tree
+*/
+
+struct BVHNode
+{
+    double       min[3];
+    double       max[3];
+    unsigned int first = 0; // inner nodes: index of the first child. Leaves: index of the first item
+    unsigned int count = 0; // number of items in the leaf (zero for inner nodes)
+
+    bool is_leaf() const { return count>0; }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct BVHItem
+{
+    ItemType     type;
+    unsigned int index; // position in the array of items of the same type
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class BVH
+{
+    public:
+
+        explicit BVH(const unsigned int items_per_leaf = 4);
+
+        virtual ~BVH() {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void push_point      (const unsigned int id, const vec3d & v);
+        void push_sphere     (const unsigned int id, const vec3d & c, const double r);
+        void push_segment    (const unsigned int id, const std::vector<vec3d> & v);
+        void push_triangle   (const unsigned int id, const std::vector<vec3d> & v);
+        void push_tetrahedron(const unsigned int id, const std::vector<vec3d> & v);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build();
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_polys(const AbstractPolygonMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            triangles.reserve(m.num_polys());
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+            {
+                for(unsigned int i=0; i<m.poly_tessellation(pid).size()/3; ++i)
+                {
+                    vec3d v0 = m.vert(m.poly_tessellation(pid).at(3*i+0));
+                    vec3d v1 = m.vert(m.poly_tessellation(pid).at(3*i+1));
+                    vec3d v2 = m.vert(m.poly_tessellation(pid).at(3*i+2));
+                    push_triangle(pid, {v0,v1,v2});
+                }
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class F, class P>
+        void build_from_mesh_polys(const AbstractPolyhedralMesh<M,V,E,F,P> & m)
+        {
+            assert(items.empty());
+            tets.reserve(m.num_polys());
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+            {
+                switch(m.mesh_type())
+                {
+                    case TETMESH : push_tetrahedron(pid, m.poly_verts(pid)); break;
+                    default: assert(false && "Unsupported element");
+                }
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build_from_vectors(const std::vector<vec3d>        & verts,
+                                const std::vector<unsigned int> & tris)
+        {
+            assert(items.empty());
+            triangles.reserve(tris.size()/3);
+            for(unsigned int i=0; i<tris.size(); i+=3)
+            {
+                push_triangle(i/3, { verts.at(tris.at(i  )),
+                                     verts.at(tris.at(i+1)),
+                                     verts.at(tris.at(i+2))});
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_edges(const AbstractMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            segments.reserve(m.num_edges());
+            for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+            {
+                push_segment(eid, m.edge_verts(eid));
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_points(const AbstractMesh<M,V,E,P> & m)
+        {
+            assert(items.empty());
+            points.reserve(m.num_verts());
+            for(unsigned int vid=0; vid<m.num_verts(); ++vid)
+            {
+                push_point(vid, m.vert(vid));
+            }
+            build();
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        unsigned int num_items()          const { return static_cast<unsigned int>(items.size()); }
+        unsigned int num_nodes()          const { return static_cast<unsigned int>(nodes.size()); }
+        unsigned int depth()              const { return tree_depth; }
+        unsigned int max_items_per_leaf() const;
+        AABB         bbox()               const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void debug_mode(const bool b);
+
+        // QUERIES :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // returns pos, id and distance of the item that is closest to query point p
+        // note: differently from the Octree, dist is the actual (not squared) distance
+        void  closest_point(const vec3d & p, unsigned int & id, vec3d & pos, double & dist) const;
+        vec3d closest_point(const vec3d & p) const;
+
+        // returns respectively the first item and the full list of items containing query point p
+        // note: this query becomes exact if CINOLIB_USES_EXACT_PREDICATES is defined
+        bool contains(const vec3d & p, const bool strict, unsigned int & id) const;
+        bool contains(const vec3d & p, const bool strict, std::unordered_set<unsigned int> & ids) const;
+
+        bool intersects_line(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id) const; // first hit
+
+        // returns respectively the first and the full list of intersections
+        // between items in the tree and a ray R(t) := p + t * dir
+        bool intersects_ray(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id) const; // first hit
+        bool intersects_ray(const vec3d & p, const vec3d & dir, std::set<std::pair<double,unsigned int>> & all_hits) const;
+
+        // note: these queries become exact if CINOLIB_USES_EXACT_PREDICATES is defined
+        bool intersects_segment (const vec3d s[], const bool ignore_if_valid_complex, std::unordered_set<unsigned int> & ids) const;
+        bool intersects_triangle(const vec3d t[], const bool ignore_if_valid_complex, std::unordered_set<unsigned int> & ids) const;
+
+        // WARNING: this function may return false positives because it only checks intersection between
+        // the box b and the AABB of the items in the tree. This is a partial result that it is useful for
+        // some of the queries above, where a more expensive test between the geometric entity approximated
+        // by box b and the actual items will be performed
+        bool intersects_box(const AABB & b, std::unordered_set<unsigned int> & ids) const;
+
+        // BATCHED QUERIES :::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // first hit for a batch of rays R_i(t) := p[i] + t * dir[i]. For each ray returns
+        // the parameter t and the id of the first item hit (inf_double and -1 if no item
+        // is hit). Rays are traced in packets of packet_size, which traverse the tree
+        // together and test boxes/triangles for all rays at once. Packets are processed
+        // in parallel. Coherent rays (similar origin and direction) should be stored
+        // next to each other to get the most out of packet traversal
+        void intersects_rays(const std::vector<vec3d>  & p,
+                             const std::vector<vec3d>  & dir,
+                                   std::vector<double> & t,
+                                   std::vector<int>    & ids) const;
+
+        // any hit for a batch of rays: occluded[i] is true if ray R_i(t) := p[i] + t * dir[i]
+        // hits at least one item for t in [0,max_t]. Traversal stops at the first hit
+        void intersects_rays_any(const std::vector<vec3d> & p,
+                                 const std::vector<vec3d> & dir,
+                                       std::vector<bool>  & occluded,
+                                 const double               max_t = inf_double) const;
+
+        static const unsigned int packet_size = 8;
+
+        // closest item for a batch of query points (same output of closest_point). Queries are
+        // sorted along a Morton curve and processed in parallel, in chunks of nearby points. Inside
+        // a chunk, the item closest to the previous query is used to bound the search (warm start)
+        void closest_points(const std::vector<vec3d>        & p,
+                                  std::vector<unsigned int> & ids,
+                                  std::vector<vec3d>        & pos,
+                                  std::vector<double>       & dist) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // nodes of the tree (the root is nodes[0]) and list of items referenced by the leaves
+        std::vector<BVHNode> nodes;
+        std::vector<BVHItem> items;
+
+        // per primitive type storage
+        std::vector<Point>       points;
+        std::vector<Sphere>      spheres;
+        std::vector<Segment>     segments;
+        std::vector<Triangle>    triangles;
+        std::vector<Tetrahedron> tets;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        unsigned int items_per_leaf;     // leaves with at most this many items are never split
+        unsigned int tree_depth = 0;     // actual depth of the tree
+        bool print_debug_info   = false;
+
+        // the depth of the tree is bounded, so that traversal can use a fixed size stack
+        static const unsigned int max_depth  = 60;
+        static const unsigned int stack_size = 64;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        struct BuildItem
+        {
+            vec3d min, max, centroid;
+        };
+
+        unsigned int build_subtree(std::vector<BVHNode>            & tree,
+                                   const unsigned int                begin,
+                                   const unsigned int                end,
+                                   const unsigned int                depth,
+                                   std::vector<unsigned int>       & order,
+                                   const std::vector<BuildItem>    & build_items) const;
+
+        bool split(const unsigned int                begin,
+                   const unsigned int                end,
+                   std::vector<unsigned int>       & order,
+                   const std::vector<BuildItem>    & build_items,
+                   unsigned int                    & mid) const;
+
+        void make_node(BVHNode                         & node,
+                       const unsigned int                begin,
+                       const unsigned int                end,
+                       const std::vector<unsigned int> & order,
+                       const std::vector<BuildItem>    & build_items) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // per item primitives, dispatched on the item type without virtual calls
+        unsigned int item_id                 (const unsigned int i) const;
+        const AABB & item_aabb               (const unsigned int i) const;
+        vec3d        item_closest_point      (const unsigned int i, const vec3d & p) const;
+        bool         item_contains           (const unsigned int i, const vec3d & p, const bool strict) const;
+        bool         item_intersects_ray     (const unsigned int i, const vec3d & p, const vec3d & dir, const bool line, double & t) const;
+        bool         item_intersects_segment (const unsigned int i, const vec3d s[], const bool ignore_if_valid_complex) const;
+        bool         item_intersects_triangle(const unsigned int i, const vec3d t[], const bool ignore_if_valid_complex) const;
+
+        bool intersects_ray_or_line(const vec3d & p, const vec3d & dir, double & min_t, unsigned int & id, const bool line) const; // first hit
+        void items_overlapping     (const AABB & b, std::vector<unsigned int> & list) const; // indices of the items whose AABB overlaps with b
+
+        // closest item to p. If hint is a valid item index, the search starts using the distance
+        // from that item as upper bound. Returns the index of the item, the closest point and its
+        // squared distance from p
+        unsigned int closest_item(const vec3d        & p,
+                                  const unsigned int   hint,
+                                        vec3d        & pos,
+                                        double       & dist_sqrd) const;
+
+        void trace_packet(const vec3d        * p,
+                          const vec3d        * dir,
+                          const unsigned int   n,
+                          const bool           any_hit,
+                                double       * t,
+                                int          * ids) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "bvh.cpp"
+#endif
+
+#endif // CINO_BVH_H
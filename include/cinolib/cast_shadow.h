@@ -37,11 +37,16 @@
 #define CINO_CAST_SHADOW_H
 
 #include <cinolib/geometry/vec_mat.h>
+#include <cinolib/rasterizer.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/gl/gl_glfw.h>
+#endif
 
 namespace cinolib
 {
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class Mesh>
 CINO_INLINE
 void cast_shadow(const Mesh    & m,     // mesh to be rendered
@@ -60,6 +65,20 @@ void cast_shadow(const Mesh       & m,           // mesh to be rendered
                  const unsigned int         h,           // height (must be an EVEN number)
                        uint8_t    * data,        // w x h buffer, 8 bits per pixel
                        GLFWwindow * GL_context); // cached GL context (for amortized calls)
+
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// GL-free version: the shadow is rasterized on the CPU (no size restrictions)
+template<class Mesh>
+CINO_INLINE
+void cast_shadow(const Mesh         & m,     // mesh to be rendered
+                 const vec3d        & dir,   // light direction
+                 const unsigned int   w,     // width
+                 const unsigned int   h,     // height
+                       uint8_t      * data,  // w x h buffer, 8 bits per pixel
+                       Rasterizer   & r);    // cached rasterizer (for amortized calls)
 }
 
 #include "cast_shadow.tpp"
@@ -34,11 +34,16 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/cast_shadow.h>
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
 #include <cinolib/gl/offline_gl_context.h>
+#endif
+#include <algorithm>
 
 namespace cinolib
 {
 
+#ifdef CINOLIB_USES_OPENGL_GLFW_IMGUI
+
 template<class Mesh>
 CINO_INLINE
 void cast_shadow(const Mesh    & m,    // mesh to be rendered
@@ -99,5 +104,24 @@ void cast_shadow(const Mesh       & m,           // mesh to be rendered
     glReadPixels(0, 0, w, h, GL_STENCIL_INDEX, GL_UNSIGNED_BYTE, data);
 }
 
+#endif // CINOLIB_USES_OPENGL_GLFW_IMGUI
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void cast_shadow(const Mesh         & m,     // mesh to be rendered
+                 const vec3d        & dir,   // light direction
+                 const unsigned int   w,     // width
+                 const unsigned int   h,     // height
+                       uint8_t      * data,  // w x h buffer, 8 bits per pixel
+                       Rasterizer   & r)     // cached rasterizer (for amortized calls)
+{
+    if(r.width()!=w || r.height()!=h) r.resize(w,h);
+    r.set_view(dir, m.centroid(), 2.0/m.bbox().diag());
+    r.clear();
+    r.draw(m);
+    std::copy(r.coverage().begin(), r.coverage().end(), data);
 }
 
+}
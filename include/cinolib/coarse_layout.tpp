@@ -65,7 +65,7 @@ void compute_coarse_quad_layout(Quadmesh<M,V,E,P> & m)
 
         m.vert_data(vid).flags[MARKED] = true;
 
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(m.edge_data(eid).flags[MARKED]) continue; // this path was already visited
             m.edge_data(eid).flags[MARKED] = true;
@@ -0,0 +1,154 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_DECIMATE_QEM_H
+#define CINO_DECIMATE_QEM_H
+
+#include <cinolib/meshes/trimesh.h>
+#include <cinolib/geometry/quadric.h>
+#include <cinolib/min_max_inf.h>
+#include <ostream>
+
+namespace cinolib
+{
+
+/* Mesh simplification by iterative edge collapse, as described in:
+ *
+ * Surface Simplification Using Quadric Error Metrics
+ * M.Garland, P.S.Heckbert
+ * SIGGRAPH 1997
+ *
+ * Each vertex stores the quadric of the (area weighted) planes of its incident
+ * triangles. Edges are collapsed in order of increasing quadric error, using a
+ * lazy heap: when an edge changes it is pushed again with a new stamp, and stale
+ * entries are discarded when popped. Collapses that would change the topology or
+ * flip some triangle are rejected.
+ *
+ * Features: edges flagged as CREASE or MARKED (and boundary edges) add constraint
+ * planes to the quadrics of their endpoints. Feature corners (vertices with a
+ * number of feature edges other than two) never move, vertices on feature lines
+ * move only along them, and two feature lines are never merged. NOTE: boundary
+ * edges are MARKED on load, hence they are treated as features by default.
+ *
+ * Attributes: the merged vertex inherits the attributes of the endpoint closest
+ * to its new position, new triangles inherit the attributes of the triangles
+ * they replace, and feature flags are kept along the edges.
+ *
+ * Partitioned mode (num_partitions > 1): the mesh is cut into slabs with a similar
+ * number of triangles. Slabs are decimated in parallel (down to twice their share
+ * of the target), with the vertices at their interface locked. Then they are stitched
+ * back together, and a final serial pass takes care of the interface and of the target.
+*/
+
+struct QEMDecimationOptions
+{
+    unsigned int target_num_polys    = 0;          // stop when the mesh has no more triangles than this
+    double       max_error           = inf_double; // skip collapses with RMS distance from the original planes above this
+    bool         optimal_placement   = true;       // put the new vertex at the quadric minimizer (otherwise, at the best point along the edge)
+    bool         preserve_features   = true;       // CREASE and MARKED edges are features
+    bool         preserve_boundaries = true;       // boundary edges are features
+    double       feature_weight      = 1e3;        // weight of the constraint planes along features
+    unsigned int num_partitions      = 1;          // if >1, decimate this many slabs of the mesh in parallel first
+    bool         verbose             = false;
+};
+
+struct QEMDecimationStats
+{
+    unsigned int collapses      = 0;
+    unsigned int num_polys      = 0;     // triangles in the output mesh
+    double       max_error      = 0;     // highest RMS error of an accepted collapse
+    bool         target_reached = false;
+    double       seconds        = 0;
+};
+
+CINO_INLINE
+std::ostream & operator<<(std::ostream & in, const QEMDecimationStats & stats);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+QEMDecimationStats decimate_QEM(      Trimesh<M,V,E,P>     & m,
+                                const QEMDecimationOptions & opt = QEMDecimationOptions());
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// per vertex quadrics (Q) and sum of the weights of their planes (W)
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_vert_quadrics(const Trimesh<M,V,E,P>     & m,
+                       const QEMDecimationOptions & opt,
+                       std::vector<Quadric>       & Q,
+                       std::vector<double>        & W);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// the actual decimation loop. Per vertex quadrics, weights, lock flags and origin ids
+// are updated along with the mesh: the vertex resulting from a collapse takes the
+// origin (and the lock) of the endpoint it inherits the attributes from
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_collapse_edges(Trimesh<M,V,E,P>           & m,
+                        const QEMDecimationOptions & opt,
+                        const unsigned int           target_num_polys,
+                        std::vector<Quadric>       & Q,
+                        std::vector<double>        & W,
+                        std::vector<bool>          & locked,
+                        std::vector<unsigned int>  & origin,
+                        QEMDecimationStats         & stats);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// partitioned mode (see above). Quadrics are updated to match the decimated mesh
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_decimate_partitions(Trimesh<M,V,E,P>           & m,
+                             const QEMDecimationOptions & opt,
+                             std::vector<Quadric>       & Q,
+                             std::vector<double>        & W,
+                             QEMDecimationStats         & stats);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool QEM_edge_is_feature(const Trimesh<M,V,E,P>     & m,
+                         const QEMDecimationOptions & opt,
+                         const unsigned int           eid);
+}
+
+#include "decimate_QEM.tpp"
+
+#endif // CINO_DECIMATE_QEM_H
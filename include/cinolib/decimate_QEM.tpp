@@ -0,0 +1,476 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/decimate_QEM.h>
+#include <cinolib/how_many_seconds.h>
+#include <cinolib/parallel_for.h>
+#include <queue>
+#include <tuple>
+#include <numeric>
+
+namespace cinolib
+{
+
+CINO_INLINE
+std::ostream & operator<<(std::ostream & in, const QEMDecimationStats & stats)
+{
+    in << "collapses  " << stats.collapses << "\n";
+    in << "triangles  " << stats.num_polys << (stats.target_reached ? " (target reached)" : "") << "\n";
+    in << "max error  " << stats.max_error << "\n";
+    in << "time       " << stats.seconds   << "s\n";
+    return in;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+QEMDecimationStats decimate_QEM(      Trimesh<M,V,E,P>     & m,
+                                const QEMDecimationOptions & opt)
+{
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    QEMDecimationStats stats;
+    std::vector<Quadric> Q;
+    std::vector<double>  W;
+    QEM_vert_quadrics(m, opt, Q, W);
+
+    if(opt.num_partitions>1)
+    {
+        QEM_decimate_partitions(m, opt, Q, W, stats);
+        if(opt.verbose)
+        {
+            std::cout << "decimate_QEM: " << opt.num_partitions << " partitions decimated to "
+                      << m.num_polys() << " triangles [" << how_many_seconds(t0, Time::now()) << "s]" << std::endl;
+        }
+    }
+
+    std::vector<bool>         locked(m.num_verts(), false);
+    std::vector<unsigned int> origin(m.num_verts());
+    std::iota(origin.begin(), origin.end(), 0);
+    QEM_collapse_edges(m, opt, opt.target_num_polys, Q, W, locked, origin, stats);
+
+    stats.num_polys      = m.num_polys();
+    stats.target_reached = (m.num_polys()<=opt.target_num_polys);
+    stats.seconds        = how_many_seconds(t0, Time::now());
+    if(opt.verbose)
+    {
+        std::cout << "decimate_QEM: " << stats.collapses << " collapses, "
+                  << stats.num_polys << " triangles left [" << stats.seconds << "s]" << std::endl;
+    }
+    return stats;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool QEM_edge_is_feature(const Trimesh<M,V,E,P>     & m,
+                         const QEMDecimationOptions & opt,
+                         const unsigned int           eid)
+{
+    if(opt.preserve_boundaries && m.edge_is_boundary(eid)) return true;
+    if(opt.preserve_features && (m.edge_data(eid).flags[CREASE] || m.edge_data(eid).flags[MARKED])) return true;
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_vert_quadrics(const Trimesh<M,V,E,P>     & m,
+                       const QEMDecimationOptions & opt,
+                       std::vector<Quadric>       & Q,
+                       std::vector<double>        & W)
+{
+    Q.assign(m.num_verts(), Quadric());
+    W.assign(m.num_verts(), 0.0);
+
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        vec3d  n    = m.poly_data(pid).normal;
+        double area = m.poly_area(pid);
+        if(n.norm()==0 || area==0) continue;
+        Quadric q(m.poly_vert(pid,0), n, area);
+        for(unsigned int vid : m.adj_p2v(pid))
+        {
+            Q.at(vid) += q;
+            W.at(vid) += area;
+        }
+    }
+
+    // constraint planes through feature edges, orthogonal to their incident triangles
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        if(!QEM_edge_is_feature(m, opt, eid)) continue;
+        vec3d  v0  = m.edge_vert(eid,0);
+        vec3d  v1  = m.edge_vert(eid,1);
+        vec3d  dir = v1 - v0;
+        double len = dir.norm();
+        if(len==0) continue;
+        for(unsigned int pid : m.adj_e2p_span(eid))
+        {
+            vec3d n = dir.cross(m.poly_data(pid).normal);
+            if(n.norm()==0) continue;
+            n.normalize();
+            Quadric q(v0, n, opt.feature_weight*len*len);
+            Q.at(m.edge_vert_id(eid,0)) += q;
+            Q.at(m.edge_vert_id(eid,1)) += q;
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_collapse_edges(Trimesh<M,V,E,P>           & m,
+                        const QEMDecimationOptions & opt,
+                        const unsigned int           target_num_polys,
+                        std::vector<Quadric>       & Q,
+                        std::vector<double>        & W,
+                        std::vector<bool>          & locked,
+                        std::vector<unsigned int>  & origin,
+                        QEMDecimationStats         & stats)
+{
+    assert(Q.size()==m.num_verts() && W.size()==m.num_verts());
+    assert(locked.size()==m.num_verts() && origin.size()==m.num_verts());
+
+    auto num_feature_edges = [&](const unsigned int vid)
+    {
+        unsigned int count = 0;
+        for(unsigned int eid : m.adj_v2e(vid)) if(QEM_edge_is_feature(m, opt, eid)) ++count;
+        return count;
+    };
+
+    // returns the cost of collapsing eid, and where to put the resulting vertex.
+    // Source is the endpoint the vertex will inherit attributes (and origin) from
+    auto evaluate = [&](const unsigned int eid, vec3d & p, unsigned int & source) -> double
+    {
+        unsigned int vid0 = m.edge_vert_id(eid,0);
+        unsigned int vid1 = m.edge_vert_id(eid,1);
+        unsigned int nf0  = num_feature_edges(vid0);
+        unsigned int nf1  = num_feature_edges(vid1);
+        bool fixed0 = locked.at(vid0) || (nf0>0 && nf0!=2); // feature corners never move
+        bool fixed1 = locked.at(vid1) || (nf1>0 && nf1!=2);
+        bool on_feature = QEM_edge_is_feature(m, opt, eid);
+        if(fixed0 && fixed1) return inf_double;
+        if(!on_feature && nf0>0 && nf1>0) return inf_double; // would merge (or pinch) feature lines
+
+        Quadric q = Q.at(vid0) + Q.at(vid1);
+        if(fixed0 || (!on_feature && nf0>0)) { p = m.vert(vid0); source = vid0; } else
+        if(fixed1 || (!on_feature && nf1>0)) { p = m.vert(vid1); source = vid1; } else
+        {
+            if(!opt.optimal_placement || !q.minimizer(p)) p = q.minimizer(m.vert(vid0), m.vert(vid1));
+            source = (p.dist_sqrd(m.vert(vid0)) <= p.dist_sqrd(m.vert(vid1))) ? vid0 : vid1;
+        }
+
+        // locked vertices are shared with other meshes (see QEM_decimate_partitions), which
+        // may connect them as well: never create new edges between two locked vertices
+        if(locked.at(source))
+        {
+            unsigned int other = (source==vid0) ? vid1 : vid0;
+            for(unsigned int nbr : m.adj_v2v(other))
+            {
+                if(nbr!=source && locked.at(nbr) && m.edge_id(source,nbr)<0) return inf_double;
+            }
+        }
+        return q(p);
+    };
+
+    // lazy heap: entries are (cost, edge, stamp). Each time an edge changes its
+    // stamp is incremented and a new entry is pushed, the old one becomes stale
+    typedef std::tuple<double,unsigned int,unsigned int> Entry;
+    std::priority_queue<Entry,std::vector<Entry>,std::greater<Entry>> heap;
+    std::vector<unsigned int> stamp(m.num_edges(), 0);
+    auto push = [&](const unsigned int eid)
+    {
+        if(eid>=stamp.size()) stamp.resize(m.num_edges(), 0);
+        vec3d p;
+        unsigned int source;
+        double cost = evaluate(eid, p, source);
+        ++stamp.at(eid);
+        if(cost<inf_double) heap.emplace(cost, eid, stamp.at(eid));
+    };
+
+    bool batch = !m.batch_edits_open();
+    if(batch) m.batch_edits_begin();
+
+    unsigned int num_polys = 0;
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) if(!m.poly_is_dead(pid)) ++num_polys;
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid) if(!m.edge_is_dead(eid)) push(eid);
+
+    std::vector<std::pair<unsigned int,E>> saved_edges;
+    while(!heap.empty() && num_polys>target_num_polys)
+    {
+        unsigned int eid = std::get<1>(heap.top());
+        unsigned int st  = std::get<2>(heap.top());
+        heap.pop();
+        if(m.edge_is_dead(eid) || st!=stamp.at(eid)) continue;
+
+        vec3d p;
+        unsigned int source;
+        double cost = evaluate(eid, p, source);
+        if(cost==inf_double) continue;
+
+        unsigned int vid0 = m.edge_vert_id(eid,0);
+        unsigned int vid1 = m.edge_vert_id(eid,1);
+        double error = std::sqrt(cost/std::max(W.at(vid0)+W.at(vid1), 1e-30));
+        if(error>opt.max_error) continue;
+
+        // edge_collapse keeps the lower id and re-creates the edges of the other vertex:
+        // save their attributes, as well as the attributes of the source vertex. Edges
+        // shared by the collapsing triangles merge: they take the attributes of the source
+        // side, and are features if any of the two was
+        unsigned int keep = std::min(vid0,vid1);
+        unsigned int gone = std::max(vid0,vid1);
+        saved_edges.clear();
+        for(unsigned int e : m.adj_v2e(gone))
+        {
+            unsigned int nbr = m.vert_opposite_to(e,gone);
+            if(nbr==keep) continue;
+            int e_keep = m.edge_id(keep,nbr);
+            if(e_keep<0) saved_edges.emplace_back(nbr, m.edge_data(e));
+            else
+            {
+                E data = (source==gone) ? m.edge_data(e) : m.edge_data(e_keep);
+                data.flags[CREASE] = m.edge_data(e).flags[CREASE] || m.edge_data(e_keep).flags[CREASE];
+                data.flags[MARKED] = m.edge_data(e).flags[MARKED] || m.edge_data(e_keep).flags[MARKED];
+                saved_edges.emplace_back(nbr, data);
+            }
+        }
+        V keep_data = m.vert_data(keep);
+        if(source!=keep) m.vert_data(keep) = m.vert_data(source);
+
+        unsigned int n_removed = m.adj_e2p(eid).size();
+        if(m.edge_collapse(eid, p, true, true)<0)
+        {
+            m.vert_data(keep) = keep_data;
+            continue;
+        }
+        num_polys -= n_removed;
+        ++stats.collapses;
+        stats.max_error = std::max(stats.max_error, error);
+
+        for(const auto & obj : saved_edges)
+        {
+            int e = m.edge_id(keep, obj.first); assert(e>=0);
+            m.edge_data(e) = obj.second;
+        }
+
+        Q.at(keep)      = Q.at(vid0) + Q.at(vid1);
+        W.at(keep)      = W.at(vid0) + W.at(vid1);
+        locked.at(keep) = locked.at(source);
+        origin.at(keep) = origin.at(source);
+
+        for(unsigned int e : m.adj_v2e(keep)) push(e);
+    }
+
+    if(batch)
+    {
+        std::vector<int> v_map, e_map, p_map;
+        m.compact(v_map, e_map, p_map);
+        m.batch_edits_end();
+
+        auto permute = [&](auto & data)
+        {
+            for(unsigned int vid=0; vid<v_map.size(); ++vid)
+            {
+                if(v_map[vid]>=0) data.at(v_map[vid]) = data.at(vid);
+            }
+            data.resize(m.num_verts());
+        };
+        permute(Q);
+        permute(W);
+        permute(locked);
+        permute(origin);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void QEM_decimate_partitions(Trimesh<M,V,E,P>           & m,
+                             const QEMDecimationOptions & opt,
+                             std::vector<Quadric>       & Q,
+                             std::vector<double>        & W,
+                             QEMDecimationStats         & stats)
+{
+    // slabs orthogonal to the longest side of the bounding box, with the same number of triangles
+    unsigned int axis = 0;
+    vec3d delta = m.bbox().delta();
+    if(delta[1]>delta[axis]) axis = 1;
+    if(delta[2]>delta[axis]) axis = 2;
+    std::vector<unsigned int> pids(m.num_polys());
+    std::iota(pids.begin(), pids.end(), 0);
+    std::vector<double> key(m.num_polys());
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) key[pid] = m.poly_centroid(pid)[axis];
+    std::sort(pids.begin(), pids.end(), [&](const unsigned int a, const unsigned int b) { return key[a]<key[b]; });
+
+    unsigned int n_parts = std::min(opt.num_partitions, m.num_polys());
+    std::vector<unsigned int> part(m.num_polys());
+    for(unsigned int i=0; i<pids.size(); ++i) part[pids[i]] = (unsigned long)i*n_parts/pids.size();
+
+    // vertices shared by triangles in different slabs are locked
+    std::vector<bool> interface(m.num_verts(), false);
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid)
+    {
+        for(unsigned int pid : m.adj_v2p_span(vid))
+        {
+            if(part[pid]!=part[m.adj_v2p_span(vid).front()]) { interface[vid] = true; break; }
+        }
+    }
+
+    // build and decimate each slab. Sub meshes are independent, hence slabs can
+    // be processed in parallel. Vertex origins are global ids, used for stitching
+    std::vector<Trimesh<M,V,E,P>>          subs(n_parts);
+    std::vector<std::vector<Quadric>>      sub_Q(n_parts);
+    std::vector<std::vector<double>>       sub_W(n_parts);
+    std::vector<std::vector<unsigned int>> sub_origin(n_parts);
+    std::vector<QEMDecimationStats>        sub_stats(n_parts);
+    std::vector<std::vector<unsigned int>> part_polys(n_parts);
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) part_polys[part[pid]].push_back(pid);
+
+    PARALLEL_FOR(0, n_parts, 0, [&](const unsigned int i)
+    {
+        std::vector<int>          g2l(m.num_verts(), -1);
+        std::vector<unsigned int> l2g;
+        std::vector<vec3d>        verts;
+        std::vector<std::vector<unsigned int>> polys;
+        for(unsigned int pid : part_polys[i])
+        {
+            std::vector<unsigned int> p;
+            for(unsigned int vid : m.adj_p2v(pid))
+            {
+                if(g2l[vid]<0)
+                {
+                    g2l[vid] = l2g.size();
+                    l2g.push_back(vid);
+                    verts.push_back(m.vert(vid));
+                }
+                p.push_back(g2l[vid]);
+            }
+            polys.push_back(p);
+        }
+        Trimesh<M,V,E,P> & sub = subs[i];
+        sub = Trimesh<M,V,E,P>(verts, polys);
+        for(unsigned int vid=0; vid<sub.num_verts(); ++vid) sub.vert_data(vid) = m.vert_data(l2g[vid]);
+        for(unsigned int pid=0; pid<sub.num_polys(); ++pid) sub.poly_data(pid) = m.poly_data(part_polys[i][pid]);
+        for(unsigned int eid=0; eid<sub.num_edges(); ++eid)
+        {
+            int e = m.edge_id(l2g[sub.edge_vert_id(eid,0)], l2g[sub.edge_vert_id(eid,1)]); assert(e>=0);
+            sub.edge_data(eid) = m.edge_data(e); // also removes the MARKED flag from the cuts
+        }
+
+        std::vector<bool> locked(sub.num_verts());
+        sub_Q[i].resize(sub.num_verts());
+        sub_W[i].resize(sub.num_verts());
+        for(unsigned int vid=0; vid<sub.num_verts(); ++vid)
+        {
+            locked[vid]   = interface[l2g[vid]];
+            sub_Q[i][vid] = Q[l2g[vid]];
+            sub_W[i][vid] = W[l2g[vid]];
+        }
+        sub_origin[i] = l2g;
+        // slabs stop at twice their share of the target: this leaves the final pass enough
+        // freedom around the cuts to match the error of a serial decimation
+        unsigned int target = 2.0*opt.target_num_polys*sub.num_polys()/m.num_polys();
+        QEM_collapse_edges(sub, opt, target, sub_Q[i], sub_W[i], locked, sub_origin[i], sub_stats[i]);
+    });
+
+    // stitch: interface vertices are never removed nor moved, and survive with their
+    // global id as origin in all the slabs that share them. Their quadrics are the
+    // global ones, plus what each slab accumulated on them
+    std::vector<int>          g2n(m.num_verts(), -1);
+    std::vector<vec3d>        verts;
+    std::vector<V>            v_data;
+    std::vector<Quadric>      new_Q;
+    std::vector<double>       new_W;
+    std::vector<std::vector<unsigned int>> polys;
+    std::vector<P>            p_data;
+    for(unsigned int i=0; i<n_parts; ++i)
+    {
+        const Trimesh<M,V,E,P> & sub = subs[i];
+        for(unsigned int vid=0; vid<sub.num_verts(); ++vid)
+        {
+            unsigned int g = sub_origin[i][vid];
+            if(g2n[g]<0)
+            {
+                g2n[g] = verts.size();
+                verts.push_back(sub.vert(vid));
+                v_data.push_back(sub.vert_data(vid));
+                new_Q.push_back(sub_Q[i][vid]);
+                new_W.push_back(sub_W[i][vid]);
+            }
+            else
+            {
+                assert(interface[g]);
+                new_Q[g2n[g]] += sub_Q[i][vid] + Q[g]*(-1.0);
+                new_W[g2n[g]] += sub_W[i][vid] - W[g];
+            }
+        }
+        for(unsigned int pid=0; pid<sub.num_polys(); ++pid)
+        {
+            std::vector<unsigned int> p;
+            for(unsigned int vid : sub.adj_p2v(pid)) p.push_back(g2n[sub_origin[i][vid]]);
+            polys.push_back(p);
+            p_data.push_back(sub.poly_data(pid));
+        }
+        stats.collapses += sub_stats[i].collapses;
+        stats.max_error  = std::max(stats.max_error, sub_stats[i].max_error);
+    }
+
+    Trimesh<M,V,E,P> res(verts, polys);
+    res.mesh_data() = m.mesh_data();
+    for(unsigned int vid=0; vid<res.num_verts(); ++vid) res.vert_data(vid) = v_data[vid];
+    for(unsigned int pid=0; pid<res.num_polys(); ++pid) res.poly_data(pid) = p_data[pid];
+    for(unsigned int i=0; i<n_parts; ++i)
+    {
+        const Trimesh<M,V,E,P> & sub = subs[i];
+        for(unsigned int eid=0; eid<sub.num_edges(); ++eid)
+        {
+            int e = res.edge_id(g2n[sub_origin[i][sub.edge_vert_id(eid,0)]],
+                                g2n[sub_origin[i][sub.edge_vert_id(eid,1)]]); assert(e>=0);
+            res.edge_data(e) = sub.edge_data(eid);
+        }
+    }
+    m = res;
+    Q = new_Q;
+    W = new_W;
+}
+
+}
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/dijkstra.h>
+#include <cinolib/indexed_heap.h>
 #include <cinolib/min_max_inf.h>
 #include <cinolib/stl_container_utilities.h>
 
@@ -42,24 +43,15 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why std::set and not
-// std::unordered_set or std::priority_queue?
+// LITTLE NOTE ON MY DIJKSTRA IMPLEMENTATIONS: why not std::priority_queue?
 //
-// The reason why I am using std::set is that Dijkstra requires priority
-// update, which is supported by none of the STL containers. Options are:
-//
-//  1) remove an element and re-add it with updated priority. In this
-//     case std::set has the best remove performances
-//
-//  2) leave "dead" copies of an element in the container, and just add a
-//     new copy each time its priority needs an update. Regardless the waste
-//     of memory, which is an issue by itself, in this case at each iteration
-//     you need a mechanism that allows you to discard the current element
-//     if it is not the one with the most recent priority...
-//
-// I therefore decided to go for (1).
-// See also:
-// https://stackoverflow.com/questions/649640/how-to-do-an-efficient-priority-update-in-stl-priority-queue
+// Dijkstra requires priority update, which is supported by none of the STL
+// containers. I used to remove and re-insert elements from a std::set, which
+// is now replaced by an indexed heap with native support for decrease-key
+// (see IndexedHeap). Ties are broken as in the std::set, hence the output
+// did not change. For applications that run many queries on the same mesh,
+// see also DijkstraEngine, which avoids per query allocations and supports
+// early termination and parallel batch queries.
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -72,28 +64,21 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -110,28 +95,21 @@ void dijkstra_exhaustive(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(unsigned int vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    for(unsigned int vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap q(dist.size());
+    for(unsigned int vid : sources) q.push(vid, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -148,15 +126,14 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(unsigned int vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    for(unsigned int vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap q(dist.size());
+    for(unsigned int vid : sources) q.push(vid, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(m.edge_is_on_srf(eid))
             {
@@ -165,14 +142,8 @@ void dijkstra_exhaustive_srf_only(const AbstractPolyhedralMesh<M,V,E,F,P> & m,
 
                 if(dist.at(nbr) > new_dist)
                 {
-                    if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                    {
-                        auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                        assert(it!=q.end());
-                        q.erase(it);
-                    }
                     dist.at(nbr) = new_dist;
-                    q.insert(std::make_pair(new_dist,nbr));
+                    q.push(nbr, new_dist);
                 }
             }
         }
@@ -192,15 +163,14 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_verts(), inf_double);
     for(unsigned int vid : sources) dist.at(vid) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    for(unsigned int vid : sources) q.insert(std::make_pair(0.0,vid));
+    IndexedHeap q(dist.size());
+    for(unsigned int vid : sources) q.push(vid, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(mask.at(eid)) continue;
 
@@ -209,14 +179,8 @@ void dijkstra_exhaustive_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -238,13 +202,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -254,21 +217,15 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             double new_dist = dist.at(vid) + m.vert(vid).dist(m.vert(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -293,13 +250,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -309,21 +265,15 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             double new_dist = dist.at(vid) + weights.at(nbr);
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -349,13 +299,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -365,7 +314,7 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             if(mask.at(nbr)) continue;
 
@@ -373,15 +322,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -409,13 +352,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -425,7 +367,7 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             int eid = m.edge_id(vid,nbr);
             assert(eid>=0);
@@ -436,15 +378,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -475,13 +411,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -491,7 +426,7 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             if(mask.at(nbr)) continue;
 
@@ -499,15 +434,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -538,13 +467,12 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -554,7 +482,7 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             int eid = m.edge_id(vid,nbr);
             assert(eid>=0);
@@ -565,15 +493,9 @@ double dijkstra_mask_on_edges(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -605,13 +527,12 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_verts(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -621,7 +542,7 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
             return dist.at(vid);
         }
 
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             if(mask.at(nbr)) continue;
 
@@ -629,15 +550,9 @@ double dijkstra(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -658,28 +573,21 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
     dist = std::vector<double>(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -695,33 +603,26 @@ void dijkstra_exhaustive_on_dual(const AbstractMesh<M,V,E,P> & m,
 {
     dist = std::vector<double>(m.num_polys(), inf_double);
 
-    std::set<std::pair<double,unsigned int>> q;
+    IndexedHeap q(dist.size());
 
     for(unsigned int s : sources)
     {
         dist.at(s) = 0.0;
-        q.insert(std::make_pair(0.0,s));
+        q.push(s, 0.0);
     }
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -743,13 +644,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -759,21 +659,15 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -798,13 +692,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(vid==dest)
         {
@@ -814,7 +707,7 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
             return dist.at(dest);
         }
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             if(mask.at(nbr)) continue;
 
@@ -822,15 +715,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -857,13 +744,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -873,7 +759,7 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
             return dist.at(vid);
         }
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             if(mask.at(nbr)) continue;
 
@@ -881,15 +767,9 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
@@ -915,13 +795,12 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
     std::vector<double> dist(m.num_polys(), inf_double);
     dist.at(source) = 0.0;
 
-    std::set<std::pair<double,unsigned int>> q;
-    q.insert(std::make_pair(0.0,source));
+    IndexedHeap q(dist.size());
+    q.push(source, 0.0);
 
     while(!q.empty())
     {
-        unsigned int vid = q.begin()->second;
-        q.erase(q.begin());
+        unsigned int vid = q.pop();
 
         if(CONTAINS(dest,vid))
         {
@@ -931,21 +810,15 @@ double dijkstra_on_dual(const AbstractMesh<M,V,E,P> & m,
             return dist.at(vid);
         }
 
-        for(unsigned int nbr : m.adj_p2p(vid))
+        for(unsigned int nbr : m.adj_p2p_span(vid))
         {
             double new_dist = dist.at(vid) + m.poly_centroid(vid).dist(m.poly_centroid(nbr));
 
             if(dist.at(nbr) > new_dist)
             {
-                if(dist.at(nbr) < inf_double) // otherwise it won't be found (one order of magnitude faster than initializing the queue with all the elements with inf dist)
-                {
-                    auto it = q.find(std::make_pair(dist.at(nbr),nbr));
-                    assert(it!=q.end());
-                    q.erase(it);
-                }
                 dist.at(nbr) = new_dist;
                 prev.at(nbr) = vid;
-                q.insert(std::make_pair(new_dist,nbr));
+                q.push(nbr, new_dist);
             }
         }
     }
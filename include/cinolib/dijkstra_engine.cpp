@@ -0,0 +1,266 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/dijkstra_engine.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void DijkstraEngine::bind(const std::vector<unsigned int> & offsets,
+                          const std::vector<unsigned int> & nbrs,
+                          const std::vector<double>       & lengths,
+                          const std::vector<unsigned int> & eids)
+{
+    assert(!offsets.empty());
+    assert(offsets.back() == nbrs.size());
+    assert(lengths.size() == nbrs.size());
+    assert(eids.empty() || eids.size() == nbrs.size());
+
+    this->offsets = offsets;
+    this->nbrs    = nbrs;
+    this->lengths = lengths;
+    this->eids    = eids;
+
+    ws.dist.clear();
+    ws.reset(num_nodes());
+    target_flags.assign(num_nodes(), false);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::reset_constraints()
+{
+    node_mask    = nullptr;
+    edge_mask    = nullptr;
+    node_weights = nullptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::Workspace::reset(const unsigned int n)
+{
+    if(dist.size() != n)
+    {
+        dist.assign(n, inf_double);
+        prev.assign(n, -1);
+        q.resize(n);
+    }
+    else
+    {
+        // reset only what the previous query touched
+        for(unsigned int id : touched)
+        {
+            dist[id] = inf_double;
+            prev[id] = -1;
+        }
+        q.clear();
+    }
+    touched.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+int DijkstraEngine::run(      Workspace                 & ws,
+                        const std::vector<unsigned int> & sources,
+                        const std::vector<bool>         * is_target,
+                        const double                      max_dist) const
+{
+    assert(!edge_mask || !eids.empty());
+
+    ws.reset(num_nodes());
+    for(unsigned int s : sources)
+    {
+        assert(s < num_nodes());
+        if(ws.dist[s] == 0.0) continue;
+        ws.dist[s] = 0.0;
+        ws.touched.push_back(s);
+        ws.q.push(s, 0.0);
+    }
+
+    while(!ws.q.empty())
+    {
+        unsigned int vid = ws.q.pop();
+
+        if(is_target && (*is_target)[vid]) return vid;
+
+        double d = ws.dist[vid];
+        for(unsigned int i=offsets[vid]; i<offsets[vid+1]; ++i)
+        {
+            unsigned int nbr = nbrs[i];
+            if(node_mask && (*node_mask)[nbr])    continue;
+            if(edge_mask && (*edge_mask)[eids[i]]) continue;
+
+            double new_dist = d + (node_weights ? (*node_weights)[nbr] : lengths[i]);
+
+            if(ws.dist[nbr] > new_dist && new_dist <= max_dist)
+            {
+                if(ws.dist[nbr] == inf_double) ws.touched.push_back(nbr);
+                ws.dist[nbr] = new_dist;
+                ws.prev[nbr] = vid;
+                ws.q.push(nbr, new_dist);
+            }
+        }
+    }
+    return -1;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::distances(const std::vector<unsigned int> & sources,
+                                     std::vector<double>       & dist,
+                               const double                      max_dist)
+{
+    run(ws, sources, nullptr, max_dist);
+    dist = ws.dist;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double DijkstraEngine::shortest_path(const unsigned int                source,
+                                     const unsigned int                target,
+                                           std::vector<unsigned int> & path)
+{
+    return shortest_path(source, std::vector<unsigned int>(1,target), path);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double DijkstraEngine::shortest_path(const unsigned int                source,
+                                     const std::vector<unsigned int> & targets,
+                                           std::vector<unsigned int> & path)
+{
+    for(unsigned int t : targets) target_flags.at(t) = true;
+    int t = run(ws, {source}, &target_flags, inf_double);
+    for(unsigned int t : targets) target_flags.at(t) = false;
+
+    path.clear();
+    if(t<0) return inf_double;
+    path_to(t, path);
+    return ws.dist[t];
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::update_min_distances(const unsigned int                source,
+                                                std::vector<double>       & min_dist,
+                                                std::vector<unsigned int> * updated)
+{
+    assert(min_dist.size() == num_nodes());
+    assert(source < num_nodes());
+    assert(!edge_mask || !eids.empty());
+
+    ws.reset(num_nodes());
+    ws.dist[source] = 0.0;
+    ws.touched.push_back(source);
+    ws.q.push(source, 0.0);
+
+    while(!ws.q.empty())
+    {
+        unsigned int vid = ws.q.pop();
+        double d = ws.dist[vid];
+        min_dist[vid] = d;
+        if(updated) updated->push_back(vid);
+
+        for(unsigned int i=offsets[vid]; i<offsets[vid+1]; ++i)
+        {
+            unsigned int nbr = nbrs[i];
+            if(node_mask && (*node_mask)[nbr])    continue;
+            if(edge_mask && (*edge_mask)[eids[i]]) continue;
+
+            double new_dist = d + (node_weights ? (*node_weights)[nbr] : lengths[i]);
+
+            // the old sources are closer: by the triangle inequality, so they are for
+            // any other node reached through nbr, hence the front can stop here
+            if(new_dist >= min_dist[nbr]) continue;
+
+            if(ws.dist[nbr] > new_dist)
+            {
+                if(ws.dist[nbr] == inf_double) ws.touched.push_back(nbr);
+                ws.dist[nbr] = new_dist;
+                ws.prev[nbr] = vid;
+                ws.q.push(nbr, new_dist);
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::path_to(const unsigned int v, std::vector<unsigned int> & path) const
+{
+    assert(v < num_nodes());
+    assert(ws.dist.size() == num_nodes() && ws.dist[v] < inf_double);
+    path.clear();
+    int tmp = v;
+    do { path.push_back(tmp); tmp = ws.prev[tmp]; } while (tmp != -1);
+    std::reverse(path.begin(), path.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void DijkstraEngine::distances_batch(const std::vector<unsigned int>      & sources,
+                                           std::vector<std::vector<double>> & dist,
+                                     const double                             max_dist) const
+{
+    dist.resize(sources.size());
+
+    // one workspace per block of sources, so that buffers are reused within each block
+    // (as many as the threads of the pool PARALLEL_FOR runs on, see CINO_NUM_THREADS)
+    unsigned int n_threads = ThreadPool::instance().num_threads();
+    unsigned int n_blocks  = std::min<unsigned int>(n_threads, sources.size());
+    PARALLEL_FOR(0, n_blocks, 2, [&](const unsigned int b)
+    {
+        Workspace local;
+        for(unsigned int i=b; i<sources.size(); i+=n_blocks)
+        {
+            run(local, {sources.at(i)}, nullptr, max_dist);
+            dist.at(i) = local.dist;
+        }
+    });
+}
+
+}
@@ -0,0 +1,204 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_DIJKSTRA_ENGINE_H
+#define CINO_DIJKSTRA_ENGINE_H
+
+#include <vector>
+#include <cinolib/cino_inline.h>
+#include <cinolib/indexed_heap.h>
+#include <cinolib/min_max_inf.h>
+#include <cinolib/meshes/abstract_mesh.h>
+
+namespace cinolib
+{
+
+/* Reusable Dijkstra solver, for applications that run many shortest path
+ * queries on the same mesh. Differently from the dijkstra* free functions,
+ * the graph is bound once (adjacency and edge lengths are stored in flat
+ * arrays) and all the buffers are kept across queries: only the elements
+ * touched by the previous query are reset. Queries can be bounded by a max
+ * distance or stop as soon as a target is reached, and distance fields from
+ * many independent sources can be computed in parallel.
+ *
+ * Optional constraints (node mask, edge mask, per node weights) mirror the
+ * ones of the free functions, and apply to all queries until they are reset.
+ * The engine does not make a copy of them, so they must stay alive.
+*/
+
+class DijkstraEngine
+{
+    public:
+
+        DijkstraEngine() {}
+
+        template<class M, class V, class E, class P>
+        explicit DijkstraEngine(const AbstractMesh<M,V,E,P> & m) { bind(m); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // primal graph: mesh vertices, connected by mesh edges
+        template<class M, class V, class E, class P>
+        void bind(const AbstractMesh<M,V,E,P> & m)
+        {
+            std::vector<unsigned int> offsets(1,0), nbrs, eids;
+            std::vector<double>       lengths;
+            nbrs.reserve(2*m.num_edges());
+            eids.reserve(2*m.num_edges());
+            lengths.reserve(2*m.num_edges());
+            for(unsigned int vid=0; vid<m.num_verts(); ++vid)
+            {
+                for(unsigned int nbr : m.adj_v2v_span(vid))
+                {
+                    nbrs.push_back(nbr);
+                    eids.push_back(m.edge_id(vid,nbr));
+                    lengths.push_back(m.vert(vid).dist(m.vert(nbr)));
+                }
+                offsets.push_back(nbrs.size());
+            }
+            bind(offsets, nbrs, lengths, eids);
+        }
+
+        // dual graph: mesh polygons (or polyhedra), connected by adjacency
+        template<class M, class V, class E, class P>
+        void bind_dual(const AbstractMesh<M,V,E,P> & m)
+        {
+            std::vector<unsigned int> offsets(1,0), nbrs;
+            std::vector<double>       lengths;
+            std::vector<vec3d>        centroids(m.num_polys());
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid) centroids.at(pid) = m.poly_centroid(pid);
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+            {
+                for(unsigned int nbr : m.adj_p2p_span(pid))
+                {
+                    nbrs.push_back(nbr);
+                    lengths.push_back(centroids.at(pid).dist(centroids.at(nbr)));
+                }
+                offsets.push_back(nbrs.size());
+            }
+            bind(offsets, nbrs, lengths);
+        }
+
+        // generic graph in CSR format: the neighbors of node i are nbrs[offsets[i]...offsets[i+1]),
+        // with arc lengths stored in lengths. Edge ids are needed only to use edge masks
+        void bind(const std::vector<unsigned int> & offsets,
+                  const std::vector<unsigned int> & nbrs,
+                  const std::vector<double>       & lengths,
+                  const std::vector<unsigned int> & eids = {});
+
+        unsigned int num_nodes() const { return offsets.empty() ? 0 : (unsigned int)offsets.size()-1; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void set_node_mask   (const std::vector<bool>   * mask)    { node_mask    = mask;    } // if mask[v] = true, paths cannot pass through v
+        void set_edge_mask   (const std::vector<bool>   * mask)    { edge_mask    = mask;    } // if mask[e] = true, paths cannot pass through e
+        void set_node_weights(const std::vector<double> * weights) { node_weights = weights; } // stepping onto v costs weights[v] (instead of the edge length)
+        void reset_constraints();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // distance from the closest source. Nodes farther than max_dist are not
+        // visited, and will have inf_double distance
+        void distances(const std::vector<unsigned int> & sources,
+                             std::vector<double>       & dist,
+                       const double                      max_dist = inf_double);
+
+        // shortest path from source to target (or to the closest of a set of targets).
+        // Returns the path length, or inf_double (and an empty path) if no target is reachable
+        double shortest_path(const unsigned int                source,
+                             const unsigned int                target,
+                                   std::vector<unsigned int> & path);
+
+        double shortest_path(const unsigned int                source,
+                             const std::vector<unsigned int> & targets,
+                                   std::vector<unsigned int> & path);
+
+        // updates a field of distances from a set of sources (e.g. the samples in farthest
+        // point sampling) with a new source. Only the nodes that are closer to the new source
+        // than to the old ones are visited. If updated is not null, ids of the nodes whose
+        // distance decreased are appended to it
+        void update_min_distances(const unsigned int                source,
+                                        std::vector<double>       & min_dist,
+                                        std::vector<unsigned int> * updated = nullptr);
+
+        // shortest path from the closest source to v, as computed by the last query
+        // (v must have been reached by it)
+        void path_to(const unsigned int v, std::vector<unsigned int> & path) const;
+
+        // one distance field per source, computed in parallel. Each field is
+        // the same distances() would return for that source alone
+        void distances_batch(const std::vector<unsigned int>      & sources,
+                                   std::vector<std::vector<double>> & dist,
+                             const double                             max_dist = inf_double) const;
+
+    protected:
+
+        struct Workspace
+        {
+            std::vector<double>       dist;
+            std::vector<int>          prev;
+            std::vector<unsigned int> touched;
+            IndexedHeap               q;
+
+            void reset(const unsigned int n);
+        };
+
+        // runs Dijkstra from sources. If is_target is given, stops at the first target
+        // reached (and returns its id), otherwise returns -1
+        int run(      Workspace                 & ws,
+                const std::vector<unsigned int> & sources,
+                const std::vector<bool>         * is_target,
+                const double                      max_dist) const;
+
+        std::vector<unsigned int> offsets;
+        std::vector<unsigned int> nbrs;
+        std::vector<unsigned int> eids;
+        std::vector<double>       lengths;
+
+        const std::vector<bool>   * node_mask    = nullptr;
+        const std::vector<bool>   * edge_mask    = nullptr;
+        const std::vector<double> * node_weights = nullptr;
+
+        Workspace          ws;
+        std::vector<bool>  target_flags;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "dijkstra_engine.cpp"
+#endif
+
+#endif // CINO_DIJKSTRA_ENGINE_H
@@ -36,6 +36,7 @@
 #include "drawable_octree.h"
 
 #include <cinolib/gl/gl_glfw.h>
+#include <cinolib/trace_profiler.h>
 
 namespace cinolib
 {
@@ -79,6 +80,7 @@ float DrawableOctree::scene_radius() const
 CINO_INLINE
 void DrawableOctree::updateGL()
 {
+    CINO_PROFILE_ZONE("DrawableOctree::updateGL");
     render_list.clear();
     if(this->root==nullptr) return;
     updateGL(this->root);
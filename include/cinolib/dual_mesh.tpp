@@ -130,7 +130,7 @@ void dual_mesh(const AbstractPolyhedralMesh<M,V,E,F,P> & primal,
         std::vector<std::vector<unsigned int>> faces;
 
         // build the faces for the interior part
-        for(unsigned int eid : primal.adj_v2e(vid))
+        for(unsigned int eid : primal.adj_v2e_span(vid))
         {
             std::vector<unsigned int> face = primal.edge_ordered_poly_ring(eid);
             // for surface edges, add the centroid of the two faces incident at it, in the right order
@@ -50,7 +50,7 @@ void export_mesh_from_clusters(const AbstractPolygonMesh<M,V,E,P> & m,
     for(unsigned int eid=0; eid<m.num_edges(); ++eid)
     {
         std::unordered_set<int> labels;
-        for(unsigned int pid : m.adj_e2p(eid)) labels.insert(m.poly_data(pid).label);
+        for(unsigned int pid : m.adj_e2p_span(eid)) labels.insert(m.poly_data(pid).label);
 
         if(m.edge_valence(eid)==labels.size())
         {
@@ -85,7 +85,7 @@ void export_mesh_from_clusters(const AbstractPolygonMesh<M,V,E,P> & m,
             unsigned int prev = poly.at(poly.size()-2);
             unsigned int curr = poly.back();
 
-            for(unsigned int eid : m.adj_v2e(curr))
+            for(unsigned int eid : m.adj_v2e_span(curr))
             {
                 if(m.edge_contains_vert(eid,prev)) continue;
                 if(CONTAINS(edges, eid)) poly.push_back(m.vert_opposite_to(eid, curr));
@@ -51,7 +51,7 @@ void export_visible(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
     for(unsigned int vid=0; vid<m_in.num_verts(); ++vid)
     {
         bool touches_visible = false;
-        for(unsigned int pid : m_in.adj_v2p(vid))
+        for(unsigned int pid : m_in.adj_v2p_span(vid))
         {
             if(!m_in.poly_data(pid).flags[HIDDEN])
             {
@@ -0,0 +1,260 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/fast_winding_number.h>
+#include <cinolib/solid_angle.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/pi.h>
+#include <algorithm>
+#include <numeric>
+
+namespace cinolib
+{
+
+CINO_INLINE
+FastWindingNumber::FastWindingNumber(const double beta, const unsigned int tris_per_leaf)
+    : accuracy(beta)
+    , tris_per_leaf(std::max(1u,tris_per_leaf))
+{
+    assert(beta>1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::clear()
+{
+    tris.clear();
+    tri_centroid.clear();
+    tri_normal.clear();
+    nodes.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::build_from_vectors(const std::vector<vec3d>        & verts,
+                                           const std::vector<unsigned int> & t)
+{
+    clear();
+    unsigned int nt = t.size()/3;
+    if(nt==0) return;
+
+    tris.resize(3*nt);
+    tri_centroid.resize(nt);
+    tri_normal.resize(nt);
+    PARALLEL_FOR(0, nt, 10000, [&](const unsigned int tid)
+    {
+        vec3d v0 = verts.at(t.at(3*tid  ));
+        vec3d v1 = verts.at(t.at(3*tid+1));
+        vec3d v2 = verts.at(t.at(3*tid+2));
+        tris[3*tid  ] = v0;
+        tris[3*tid+1] = v1;
+        tris[3*tid+2] = v2;
+        tri_centroid[tid] = (v0+v1+v2)/3.0;
+        tri_normal[tid]   = 0.5*(v1-v0).cross(v2-v0);
+    });
+
+    nodes.reserve(2*(nt/tris_per_leaf+1));
+    build_node(0,nt);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int FastWindingNumber::build_node(const unsigned int beg, const unsigned int end)
+{
+    unsigned int nid = nodes.size();
+    nodes.emplace_back();
+
+    // expansion terms
+    Node node;
+    node.beg = beg;
+    node.end = end;
+    double area = 0;
+    vec3d  c = vec3d::ZERO(), avg = vec3d::ZERO();
+    for(unsigned int tid=beg; tid<end; ++tid)
+    {
+        double a = tri_normal[tid].norm();
+        c    += a*tri_centroid[tid];
+        avg  += tri_centroid[tid];
+        area += a;
+    }
+    node.center = (area>0) ? c/area : avg/double(end-beg);
+    node.t1     = vec3d::ZERO();
+    node.t2     = mat3d::ZERO();
+    for(unsigned int tid=beg; tid<end; ++tid)
+    {
+        vec3d d = tri_centroid[tid] - node.center;
+        node.t1 += tri_normal[tid];
+        for(unsigned int i=0; i<3; ++i)
+        for(unsigned int j=0; j<3; ++j)
+        {
+            node.t2(i,j) += d[i]*tri_normal[tid][j];
+        }
+        for(unsigned int i=0; i<3; ++i)
+        {
+            node.radius = std::max(node.radius, node.center.dist(tris[3*tid+i]));
+        }
+    }
+
+    if(end-beg > tris_per_leaf)
+    {
+        // median split along the longest side of the box of the centroids
+        vec3d min = tri_centroid[beg];
+        vec3d max = tri_centroid[beg];
+        for(unsigned int tid=beg+1; tid<end; ++tid)
+        {
+            min = min.min(tri_centroid[tid]);
+            max = max.max(tri_centroid[tid]);
+        }
+        vec3d        delta = max - min;
+        unsigned int axis  = (delta[0]>=delta[1] && delta[0]>=delta[2]) ? 0 : (delta[1]>=delta[2]) ? 1 : 2;
+
+        std::vector<unsigned int> order(end-beg);
+        std::iota(order.begin(), order.end(), beg);
+        unsigned int mid = (end-beg)/2;
+        std::nth_element(order.begin(), order.begin()+mid, order.end(), [&](const unsigned int a, const unsigned int b)
+        {
+            return tri_centroid[a][axis] < tri_centroid[b][axis];
+        });
+
+        // apply the permutation to the triangle range
+        std::vector<vec3d> tmp_tris(3*(end-beg)), tmp_c(end-beg), tmp_n(end-beg);
+        for(unsigned int i=0; i<order.size(); ++i)
+        {
+            for(unsigned int j=0; j<3; ++j) tmp_tris[3*i+j] = tris[3*order[i]+j];
+            tmp_c[i] = tri_centroid[order[i]];
+            tmp_n[i] = tri_normal[order[i]];
+        }
+        std::copy(tmp_tris.begin(), tmp_tris.end(), tris.begin()+3*beg);
+        std::copy(tmp_c.begin(), tmp_c.end(), tri_centroid.begin()+beg);
+        std::copy(tmp_n.begin(), tmp_n.end(), tri_normal.begin()+beg);
+
+        node.left  = build_node(beg, beg+mid);
+        node.right = build_node(beg+mid, end);
+    }
+
+    nodes[nid] = node;
+    return nid;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double FastWindingNumber::winding_number(const vec3d & p) const
+{
+    if(nodes.empty()) return 0;
+
+    double w = 0;
+    unsigned int stack[128];
+    unsigned int top = 0;
+    stack[top++] = 0;
+    while(top>0)
+    {
+        const Node & node = nodes[stack[--top]];
+        vec3d  r    = node.center - p;
+        double dist = r.norm();
+        if(dist > accuracy*node.radius)
+        {
+            // far field: Taylor expansion of (x-p)/(4 pi |x-p|^3) around the node center
+            double d3 = dist*dist*dist;
+            double d5 = d3*dist*dist;
+            w += node.t1.dot(r)/d3;
+            w += node.t2.trace()/d3 - 3.0*r.dot(node.t2*r)/d5;
+        }
+        else if(node.left==0)
+        {
+            // near field: exact contribution of each triangle
+            for(unsigned int tid=node.beg; tid<node.end; ++tid)
+            {
+                w += 4*M_PI*solid_angle(tris[3*tid], tris[3*tid+1], tris[3*tid+2], p);
+            }
+        }
+        else
+        {
+            assert(top+2<=128);
+            stack[top++] = node.left;
+            stack[top++] = node.right;
+        }
+    }
+    return w/(4*M_PI);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double FastWindingNumber::winding_number_exact(const vec3d & p) const
+{
+    double w = 0;
+    for(unsigned int i=0; i<tris.size(); i+=3)
+    {
+        w += solid_angle(tris[i], tris[i+1], tris[i+2], p);
+    }
+    return w;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool FastWindingNumber::is_inside(const vec3d & p) const
+{
+    return winding_number(p) > 0.5;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::winding_numbers(const std::vector<vec3d> & points, std::vector<double> & w) const
+{
+    w.resize(points.size());
+    PARALLEL_FOR(0, points.size(), 256, [&](const unsigned int i)
+    {
+        w[i] = winding_number(points[i]);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void FastWindingNumber::is_inside(const std::vector<vec3d> & points, std::vector<bool> & inside) const
+{
+    std::vector<double> w;
+    winding_numbers(points, w);
+    inside.resize(points.size());
+    for(unsigned int i=0; i<points.size(); ++i) inside[i] = (w[i] > 0.5);
+}
+
+}
@@ -0,0 +1,144 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_FAST_WINDING_NUMBER_H
+#define CINO_FAST_WINDING_NUMBER_H
+
+#include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cassert>
+
+namespace cinolib
+{
+
+/* Fast evaluation of generalized winding numbers, as described in:
+ *
+ *     Fast Winding Numbers for Soups and Clouds
+ *     Gavin Barill, Neil Dickson, Ryan Schmidt, David I.W. Levin, Alec Jacobson
+ *     ACM Transactions on Graphics (SIGGRAPH 2018)
+ *
+ * Triangles are organized in a bounding volume hierarchy. Each node stores
+ * the first two terms of the Taylor expansion of its contribution around its
+ * area weighted centroid (the dipole and the quadrupole), which replace the
+ * exact sum of solid angles for query points farther than beta times the node
+ * radius. Larger beta values give more accurate results and slower queries
+ * (error in the order of 1/beta^3). Nodes close to the query are resolved exactly.
+ *
+ * Usage:
+ *
+ *  i)  Create an empty tree, specifying the accuracy (beta)
+ *  ii) Use build_from_vectors/build_from_mesh_polys to make the tree
+ *
+ * Winding numbers are real valued: for a watertight mesh they are close to
+ * one for points inside (if triangles are oriented outwards) and close to
+ * zero for points outside. The exact (brute force) evaluation is still
+ * available as reference, see winding_number_exact.
+*/
+
+class FastWindingNumber
+{
+    public:
+
+        explicit FastWindingNumber(const double       beta          = 2.0,
+                                   const unsigned int tris_per_leaf = 8);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        template<class M, class V, class E, class P>
+        void build_from_mesh_polys(const AbstractPolygonMesh<M,V,E,P> & m)
+        {
+            std::vector<unsigned int> tris;
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+            {
+                const auto & t = m.poly_tessellation(pid);
+                tris.insert(tris.end(), t.begin(), t.end());
+            }
+            build_from_vectors(m.vector_verts(), tris);
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void build_from_vectors(const std::vector<vec3d>        & verts,
+                                const std::vector<unsigned int> & tris);
+        void clear();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double winding_number      (const vec3d & p) const; // approximated with the tree
+        double winding_number_exact(const vec3d & p) const; // sum of all solid angles (reference)
+        bool   is_inside           (const vec3d & p) const; // winding number above 1/2
+
+        // parallel evaluation over a batch of query points
+        void winding_numbers(const std::vector<vec3d> & points, std::vector<double> & w) const;
+        void is_inside      (const std::vector<vec3d> & points, std::vector<bool>   & inside) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double       beta()      const { return accuracy; }
+        unsigned int num_tris()  const { return tris.size()/3; }
+        unsigned int num_nodes() const { return nodes.size(); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        // recursive construction of the subtree spanning triangles [beg,end)
+        unsigned int build_node(const unsigned int beg, const unsigned int end);
+
+        struct Node
+        {
+            vec3d        center;      // area weighted centroid (expansion point)
+            double       radius = 0;  // distance of the farthest triangle vertex from center
+            vec3d        t1;          // dipole: sum of area weighted normals
+            mat3d        t2;          // quadrupole: sum of area weighted (centroid-center) x normal
+            unsigned int beg, end;    // triangles spanned by the node
+            unsigned int left  = 0;   // children (zero for leaves, as the root is not a child)
+            unsigned int right = 0;
+        };
+
+        double                    accuracy;      // far field threshold (beta)
+        unsigned int              tris_per_leaf; // max number of triangles in a leaf
+        std::vector<vec3d>        tris;          // triangle vertices, sorted by tree leaves
+        std::vector<vec3d>        tri_centroid;
+        std::vector<vec3d>        tri_normal;    // area weighted normals
+        std::vector<Node>         nodes;         // nodes[0] is the root
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "fast_winding_number.cpp"
+#endif
+
+#endif // CINO_FAST_WINDING_NUMBER_H
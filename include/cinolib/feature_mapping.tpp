@@ -37,7 +37,7 @@
 #include <cinolib/feature_network.h>
 #include <cinolib/octree.h>
 #include <cinolib/clamp.h>
-#include <cinolib/dijkstra.h>
+#include <cinolib/dijkstra_engine.h>
 #include <cinolib/export_surface.h>
 #include <cinolib/parallel_for.h>
 
@@ -116,6 +116,10 @@ bool feature_mapping(const AbstractPolygonMesh<M1,V1,E1,P1> & m_source,
     o_curves.build_from_mesh_polys(m_target);
     double L = m_target.edge_avg_length();
     std::vector<bool> mask(m_target.num_verts(),false);
+    std::vector<double> w(m_target.num_verts());
+    DijkstraEngine dijkstra(m_target);
+    dijkstra.set_node_weights(&w);
+    dijkstra.set_node_mask(&mask);
     for(auto f : f_source)
     {
         if (f.empty())
@@ -145,7 +149,7 @@ bool feature_mapping(const AbstractPolygonMesh<M1,V1,E1,P1> & m_source,
             samples.push_back(o_curves.closest_point(p));
         }
         // compute a distance fied from the mapped point
-        std::vector<double> w(m_target.num_verts(),inf_double);
+        std::fill(w.begin(), w.end(), inf_double);
         PARALLEL_FOR(0, m_target.num_verts(), 0,[&](const unsigned int vid)
         {
             for(auto p : samples)
@@ -154,7 +158,7 @@ bool feature_mapping(const AbstractPolygonMesh<M1,V1,E1,P1> & m_source,
             }
         });
         std::vector<unsigned int> path;
-        dijkstra(m_target, corners.at(f.front()), corners.at(f.back()), w, mask, path);
+        dijkstra.shortest_path(corners.at(f.front()), corners.at(f.back()), path);
         if(path.size() > 1)
         {
             f_target.push_back(path);
@@ -51,7 +51,7 @@ void feature_network(const AbstractPolygonMesh<M,V,E,P>   & m,
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
     {
         std::vector<unsigned int> incoming_creases;
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(m.edge_data(eid).flags[CREASE]) incoming_creases.push_back(eid);
         }
@@ -94,7 +94,7 @@ void feature_network(const AbstractPolygonMesh<M,V,E,P>   & m,
             if(CONTAINS(seeds,vid)) break;
 
             std::vector<unsigned int> next_pool;
-            for(unsigned int nbr : m.adj_v2v(vid))
+            for(unsigned int nbr : m.adj_v2v_span(vid))
             {
                 int eid = m.edge_id(vid,nbr);
                 assert(eid>=0);
@@ -117,7 +117,7 @@ void feature_network(const AbstractPolygonMesh<M,V,E,P>   & m,
 
     for(unsigned int vid : seeds)
     {
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(!visited.at(eid) && m.edge_data(eid).flags[CREASE])
             {
@@ -35,9 +35,9 @@
 *********************************************************************************/
 #include <cinolib/find_intersections.h>
 #include <cinolib/parallel_for.h>
-#include <cinolib/octree.h>
-#include <cinolib/geometry/triangle.h>
-#include <mutex>
+#include <cinolib/predicates.h>
+#include <cinolib/trace_profiler.h>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -47,33 +47,231 @@ void find_intersections(const std::vector<vec3d> & verts,
                         const std::vector<unsigned int>  & tris,
                               std::set<ipair>    & intersections)
 {
-    Octree o(8,1000); // max 1000 elements per leaf, depth permitting
-    o.build_from_vectors(verts, tris);
-
-    std::mutex mutex;
-    PARALLEL_FOR(0, o.leaves.size(), 1, [&](unsigned int i)
-    {        
-        auto & leaf = o.leaves.at(i);
-        if(leaf->item_indices.empty()) return;
-        for(unsigned int j=0;   j<leaf->item_indices.size()-1; ++j)
-        for(unsigned int k=j+1; k<leaf->item_indices.size();   ++k)
+    BVH bvh;
+    bvh.build_from_vectors(verts, tris);
+
+    std::vector<ipair> hits;
+    find_intersections(bvh, bvh, &tris, hits);
+    intersections.insert(hits.begin(), hits.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void find_intersections(const std::vector<vec3d>        & verts0,
+                        const std::vector<unsigned int> & tris0,
+                        const std::vector<vec3d>        & verts1,
+                        const std::vector<unsigned int> & tris1,
+                              std::set<ipair>           & intersections)
+{
+    BVH bvh0, bvh1;
+    bvh0.build_from_vectors(verts0, tris0);
+    bvh1.build_from_vectors(verts1, tris1);
+
+    std::vector<ipair> hits;
+    find_intersections(bvh0, bvh1, nullptr, hits);
+    intersections.insert(hits.begin(), hits.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void find_intersections(const BVH                       & b0,
+                        const BVH                       & b1,
+                        const std::vector<unsigned int> * tris,
+                              std::vector<ipair>        & intersections)
+{
+    CINO_PROFILE_ZONE("find_intersections");
+    intersections.clear();
+    if(b0.nodes.empty() || b1.nodes.empty()) return;
+
+    const bool self = (&b0 == &b1);
+    if(!self) tris = nullptr;
+
+    auto overlap = [&](const unsigned int n0, const unsigned int n1)
+    {
+        const BVHNode & a = b0.nodes[n0];
+        const BVHNode & b = b1.nodes[n1];
+        return a.min[0]<=b.max[0] && a.max[0]>=b.min[0] &&
+               a.min[1]<=b.max[1] && a.max[1]>=b.min[1] &&
+               a.min[2]<=b.max[2] && a.max[2]>=b.min[2];
+    };
+
+    auto size = [](const BVHNode & n)
+    {
+        return (n.max[0]-n.min[0]) + (n.max[1]-n.min[1]) + (n.max[2]-n.min[2]);
+    };
+
+    auto triangle = [](const BVH & b, const unsigned int i) -> const Triangle &
+    {
+        assert(b.items[i].type == TRIANGLE);
+        return b.triangles[b.items[i].index];
+    };
+
+    auto test = [&](const Triangle & t0, const Triangle & t1, std::vector<ipair> & hits)
+    {
+        if(self && t0.id == t1.id) return;
+        if(!t0.aabb.intersects_box(t1.aabb)) return;
+        const unsigned int *v0 = (tris) ? tris->data() + 3*t0.id : nullptr;
+        const unsigned int *v1 = (tris) ? tris->data() + 3*t1.id : nullptr;
+        if(triangles_intersect(t0, t1, v0, v1))
+        {
+            hits.push_back(self ? unique_pair(t0.id, t1.id) : ipair(t0.id, t1.id));
+        }
+    };
+
+    // A task is a pair of nodes (n0 in b0, n1 in b1). For self intersections, a task (n,n)
+    // means all pairs of items within the sub-tree rooted at n. Returns true if the task
+    // was expanded into sub tasks (appended to list), false if it cannot be expanded or
+    // it can be discarded (in which case keep is set to false)
+    auto expand = [&](const ipair & t, std::vector<ipair> & list, bool & keep)
+    {
+        keep = true;
+        const BVHNode & a = b0.nodes[t.first];
+        const BVHNode & b = b1.nodes[t.second];
+        if(self && t.first == t.second)
+        {
+            if(a.is_leaf()) return false;
+            list.push_back(ipair(a.first,   a.first  ));
+            list.push_back(ipair(a.first+1, a.first+1));
+            list.push_back(ipair(a.first,   a.first+1));
+            return true;
+        }
+        if(!overlap(t.first, t.second)) { keep = false; return false; }
+        if(a.is_leaf() && b.is_leaf()) return false;
+        if(b.is_leaf() || (!a.is_leaf() && size(a) >= size(b)))
         {
-            unsigned int tid0 = leaf->item_indices.at(j);
-            unsigned int tid1 = leaf->item_indices.at(k);
-            auto T0 = o.items.at(tid0);
-            auto T1 = o.items.at(tid1);
-            if(T0->aabb.intersects_box(T1->aabb)) // early reject based on AABB intersection
+            list.push_back(ipair(a.first,   t.second));
+            list.push_back(ipair(a.first+1, t.second));
+        }
+        else
+        {
+            list.push_back(ipair(t.first, b.first  ));
+            list.push_back(ipair(t.first, b.first+1));
+        }
+        return true;
+    };
+
+    // depth first traversal of a task
+    auto visit = [&](const ipair & task, std::vector<ipair> & hits)
+    {
+        std::vector<ipair> stack = { task };
+        while(!stack.empty())
+        {
+            ipair t = stack.back();
+            stack.pop_back();
+            bool keep;
+            if(expand(t, stack, keep) || !keep) continue;
+
+            const BVHNode & a = b0.nodes[t.first];
+            const BVHNode & b = b1.nodes[t.second];
+            if(self && t.first == t.second)
             {
-                const Triangle *t0 = dynamic_cast<Triangle*>(T0);
-                const Triangle *t1 = dynamic_cast<Triangle*>(T1);
-                if(t0->intersects_triangle(t1->v,true)) // precise check (exact if CINOLIB_USES_EXACT_PREDICATES is defined)
+                for(unsigned int i=a.first; i<a.first+a.count; ++i)
+                for(unsigned int j=i+1;     j<a.first+a.count; ++j)
                 {
-                    std::lock_guard<std::mutex> guard(mutex);
-                    intersections.insert(unique_pair(tid0,tid1));
+                    test(triangle(b0,i), triangle(b0,j), hits);
                 }
             }
+            else
+            {
+                for(unsigned int i=a.first; i<a.first+a.count; ++i)
+                for(unsigned int j=b.first; j<b.first+b.count; ++j)
+                {
+                    test(triangle(b0,i), triangle(b1,j), hits);
+                }
+            }
+        }
+    };
+
+    // expand the top levels of the traversal into enough independent tasks to keep all threads busy
+    std::vector<ipair> tasks = { ipair(0,0) };
+    const size_t min_tasks = 64 * ThreadPool::instance().num_threads();
+    bool expanded = true;
+    while(expanded && tasks.size() < min_tasks)
+    {
+        expanded = false;
+        std::vector<ipair> next;
+        next.reserve(3*tasks.size());
+        for(const ipair & t : tasks)
+        {
+            bool keep;
+            if(expand(t, next, keep)) expanded = true; else
+            if(keep) next.push_back(t);
+        }
+        tasks.swap(next);
+    }
+
+    intersections = PARALLEL_REDUCE(0, tasks.size(), 1, std::vector<ipair>(),
+    [&](const unsigned int i, std::vector<ipair> & hits)
+    {
+        visit(tasks[i], hits);
+    },
+    [](std::vector<ipair> a, const std::vector<ipair> & b)
+    {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+    },
+    PARALLEL_DYNAMIC, 1);
+
+    std::sort(intersections.begin(), intersections.end());
+    intersections.erase(std::unique(intersections.begin(), intersections.end()), intersections.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool triangles_intersect(const Triangle     & t0,
+                         const Triangle     & t1,
+                         const unsigned int * v0,
+                         const unsigned int * v1)
+{
+    if(v0 && v1)
+    {
+        // find shared vertices by index
+        bool t0_shared[3] = { false, false, false };
+        bool t1_shared[3] = { false, false, false };
+        unsigned int count = 0;
+        for(unsigned int i=0; i<3; ++i)
+        for(unsigned int j=0; j<3; ++j)
+        {
+            if(v0[i]==v1[j])
+            {
+                t0_shared[i] = t1_shared[j] = true;
+                ++count;
+            }
+        }
+
+        // same triangle (possibly with different winding)
+        if(count==3) return false;
+
+        // shared edge: valid complex unless they are coplanar
+        if(count==2)
+        {
+            unsigned int opp1 = t1_shared[0] ? (t1_shared[1] ? 2 : 1) : 0;
+            if(orient3d_filtered(t0.v[0].ptr(), t0.v[1].ptr(), t0.v[2].ptr(), t1.v[opp1].ptr()) != 0) return false;
+        }
+
+        // shared vertex: valid complex if the other two vertices of a triangle are
+        // strictly at the same side of the plane of the other triangle
+        if(count==1)
+        {
+            double s[2];
+            unsigned int k = 0;
+            for(unsigned int j=0; j<3; ++j)
+            {
+                if(!t1_shared[j]) s[k++] = orient3d_filtered(t0.v[0].ptr(), t0.v[1].ptr(), t0.v[2].ptr(), t1.v[j].ptr());
+            }
+            if((s[0]>0 && s[1]>0) || (s[0]<0 && s[1]<0)) return false;
+            k = 0;
+            for(unsigned int i=0; i<3; ++i)
+            {
+                if(!t0_shared[i]) s[k++] = orient3d_filtered(t1.v[0].ptr(), t1.v[1].ptr(), t1.v[2].ptr(), t0.v[i].ptr());
+            }
+            if((s[0]>0 && s[1]>0) || (s[0]<0 && s[1]<0)) return false;
         }
-    });
+    }
+    return t0.intersects_triangle(t1.v, true);
 }
 
 }
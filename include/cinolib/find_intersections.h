@@ -39,18 +39,27 @@
 #include <cinolib/geometry/vec_mat.h>
 #include <cinolib/meshes/trimesh.h>
 #include <cinolib/ipair.h>
+#include <cinolib/bvh.h>
 #include <set>
 
 namespace cinolib
 {
 
-/* This method puts all the input polygons into an octree, then
- * performs pairwise intersection tests within each leaf, retunrning
- * a set of pairs of intersecting triangles.
+/* These methods find all pairs of intersecting triangles, either within the
+ * same mesh (self intersections) or between two distinct meshes. Triangles are
+ * put into a BVH, and pairs of nodes with overlapping boxes are visited with a
+ * simultaneous traversal of the tree(s), so that each pair of triangles is
+ * tested at most once. The top levels of the traversal are expanded into
+ * independent tasks, which are processed in parallel. Each thread collects its
+ * own hits, which are merged, sorted and deduplicated at the end.
  *
- * The output must be a set and not a vector because triangles will
- * appear in all the leaves that have non empty overlap with it. Therefore,
- * the same intersection can be detected multiple times.
+ * For self intersections, triangles sharing vertices (by index) are tested with
+ * a few orient predicates only, and go through the full triangle-triangle test
+ * only if they are coplanar or fold over each other. Triangles that only share
+ * a vertex or an edge, forming a valid simplicial complex, are not reported.
+ * The same holds for triangles of distinct meshes that share coincident
+ * vertices. Pairs are (tid0,tid1) with tid0<tid1 for self intersections, and
+ * tid0 in the first mesh and tid1 in the second mesh otherwise.
  *
  * IMPORTANT: intersections tests are based on the orient predicates contained
  * in cinolib/predicates.h. These predicates are exact if the symbol
@@ -69,6 +78,45 @@ void find_intersections(const std::vector<vec3d> & verts,
                         const std::vector<unsigned int>  & tris,
                               std::set<ipair>    & intersections);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void find_intersections(const Trimesh<M,V,E,P> & m0,
+                        const Trimesh<M,V,E,P> & m1,
+                        std::set<ipair>        & intersections);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void find_intersections(const std::vector<vec3d>        & verts0,
+                        const std::vector<unsigned int> & tris0,
+                        const std::vector<vec3d>        & verts1,
+                        const std::vector<unsigned int> & tris1,
+                              std::set<ipair>           & intersections);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Pairs of intersecting triangles between the items of two BVHs (made of triangles only),
+// or within the same BVH if &b0==&b1. For self intersections, if tris is not null it must
+// contain the vertex indices of the triangles (item ids), and is used to handle triangles
+// sharing vertices with the fast path described above. Output pairs are sorted and unique
+CINO_INLINE
+void find_intersections(const BVH                       & b0,
+                        const BVH                       & b1,
+                        const std::vector<unsigned int> * tris,
+                              std::vector<ipair>        & intersections);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if triangles t0 and t1 intersect in a way that does not form a valid simplicial complex.
+// If not null, v0 and v1 are their vertex indices, used to skip the full test for adjacent triangles
+CINO_INLINE
+bool triangles_intersect(const Triangle     & t0,
+                         const Triangle     & t1,
+                         const unsigned int * v0 = nullptr,
+                         const unsigned int * v1 = nullptr);
+
 }
 
 #include "find_intersections.tpp"
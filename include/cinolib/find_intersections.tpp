@@ -35,9 +35,6 @@
 *********************************************************************************/
 #include <cinolib/find_intersections.h>
 #include <cinolib/parallel_for.h>
-#include <cinolib/octree.h>
-#include <cinolib/geometry/triangle.h>
-#include <mutex>
 
 namespace cinolib
 {
@@ -51,4 +48,17 @@ void find_intersections(const Trimesh<M,V,E,P> & m,
     find_intersections(m.vector_verts(), tris, intersections);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void find_intersections(const Trimesh<M,V,E,P> & m0,
+                        const Trimesh<M,V,E,P> & m1,
+                        std::set<ipair>        & intersections)
+{
+    auto tris0 = serialized_vids_from_polys(m0.vector_polys());
+    auto tris1 = serialized_vids_from_polys(m1.vector_polys());
+    find_intersections(m0.vector_verts(), tris0, m1.vector_verts(), tris1, intersections);
+}
+
 }
@@ -37,10 +37,12 @@
 #define CINO_GEODESICS_H
 
 #include <vector>
+#include <functional>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <cinolib/scalar_field.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 #include <Eigen/Sparse>
 
 namespace cinolib
@@ -81,13 +83,25 @@ ScalarField compute_geodesics(      Mesh              & m,
 
 struct GeodesicsCache
 {
-    Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>  *heat_flow_cache   = NULL;
-    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> *integration_cache = NULL;
-    Eigen::SparseMatrix<double>                         gradient_matrix;
+    LinearSystemSolver          heat_flow_cache   {SIMPLICIAL_LLT};
+    LinearSystemSolver          integration_cache {SIMPLICIAL_LDLT};
+    Eigen::SparseMatrix<double> gradient_matrix;
 };
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// factorizes the heat flow and integration matrices and computes the gradient matrix.
+// It is called automatically by compute_geodesics_amortized when the cache is empty
+
+template<class Mesh>
+CINO_INLINE
+void init_geodesics_cache(      Mesh           & m,
+                                GeodesicsCache & cache,
+                          const int              laplacian_mode = COTANGENT,
+                          const float            time_scalar = 1.0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class Mesh>
 CINO_INLINE
 ScalarField compute_geodesics_amortized(      Mesh              & m,
@@ -95,6 +109,43 @@ ScalarField compute_geodesics_amortized(      Mesh              & m,
                                         const std::vector<unsigned int> & heat_charges,
                                         const int                 laplacian_mode = COTANGENT,
                                         const float               time_scalar = 1.0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Batched version: computes one geodesic field for each set of heat charges.
+ * Fields are processed in batches of batch_size columns, stored row major: the
+ * heat flow and the integration steps are a single multi column solve per batch
+ * (see LinearSystemSolver), and the sparse products and gradient normalization
+ * touch all the fields of a vertex/element contiguously. Each field is normalized
+ * in [0,1], as in the single source version. Results are either stored as columns
+ * of a dense #verts x #sets matrix, or handed to a callback one field at a time
+ * (in order), so that memory stays bounded when the number of fields is large.
+ * Batches of a few columns (8-32) are the sweet spot: with a single column the
+ * row major layout only adds overhead, with many columns the working set of a
+ * batch no longer fits in cache.
+*/
+
+template<class Mesh>
+CINO_INLINE
+void compute_geodesics_amortized(      Mesh                                   & m,
+                                       GeodesicsCache                         & cache,
+                                 const std::vector<std::vector<unsigned int>> & heat_charges,
+                                       Eigen::MatrixXd                        & geodesics,
+                                 const int                                      laplacian_mode = COTANGENT,
+                                 const float                                    time_scalar = 1.0,
+                                 const unsigned int                             batch_size = 16);
+
+typedef std::function<void(const unsigned int set_id, const ScalarField & geodesics)> geodesics_callback;
+
+template<class Mesh>
+CINO_INLINE
+void compute_geodesics_amortized(      Mesh                                   & m,
+                                       GeodesicsCache                         & cache,
+                                 const std::vector<std::vector<unsigned int>> & heat_charges,
+                                 const geodesics_callback                     & callback,
+                                 const int                                      laplacian_mode = COTANGENT,
+                                 const float                                    time_scalar = 1.0,
+                                 const unsigned int                             batch_size = 16);
 }
 
 #include "geodesics.tpp"
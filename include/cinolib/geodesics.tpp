@@ -39,6 +39,7 @@
 #include <cinolib/laplacian.h>
 #include <cinolib/vertex_mass.h>
 #include <cinolib/linear_solvers.h>
+#include <cinolib/parallel_for.h>
 
 namespace cinolib
 {
@@ -100,6 +101,42 @@ ScalarField compute_geodesics(      Mesh              & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class Mesh>
+CINO_INLINE
+void init_geodesics_cache(      Mesh           & m,
+                                GeodesicsCache & cache,
+                          const int              laplacian_mode,
+                          const float            time_scalar)
+{
+    // optimize position and scale to get better numerical precision
+    double d = m.bbox().diag();
+    vec3d  c = m.bbox().center();
+    m.translate(-c);
+    m.scale(1.0/d);
+
+    // use the squared avg edge length as time step, as suggested in the original paper
+    double time = m.edge_avg_length();
+    time *= time;
+    time *= time_scalar;
+
+    Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+    Eigen::SparseMatrix<double> MM = mass_matrix(m);
+
+    cache.heat_flow_cache.compute(MM - time * L);
+    assert(cache.heat_flow_cache.is_factorized());
+
+    cache.gradient_matrix = gradient_matrix(m);
+
+    cache.integration_cache.compute(-L);
+    assert(cache.integration_cache.is_factorized());
+
+    // restore original scale and position
+    m.scale(d);
+    m.translate(c);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class Mesh>
 CINO_INLINE
 ScalarField compute_geodesics_amortized(      Mesh              & m,
@@ -109,61 +146,120 @@ ScalarField compute_geodesics_amortized(      Mesh              & m,
                                         const float               time_scalar)
 {
     // first call, heavy solve (matrix factorization + gradient matrix)
-    if (cache.heat_flow_cache == NULL)
+    if(!cache.heat_flow_cache.is_factorized())
     {
-        // optimize position and scale to get better numerical precision
-        double d = m.bbox().diag();
-        vec3d  c = m.bbox().center();
-        m.translate(-c);
-        m.scale(1.0/d);
-
-        // use the squared avg edge length as time step, as suggested in the original paper
-        double time = m.edge_avg_length();
-        time *= time;
-        time *= time_scalar;
-
-        Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode);
-        Eigen::SparseMatrix<double> MM  = mass_matrix(m);
-        Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(m.num_verts());
-
-        for(unsigned int vid : heat_charges) rhs[vid] = 1.0;
-
-        ScalarField heat(m.num_verts());
-        cache.heat_flow_cache = new Eigen::SimplicialLLT<Eigen::SparseMatrix<double>>(MM - time * L);
-        assert(cache.heat_flow_cache->info() == Eigen::Success);
-        heat = cache.heat_flow_cache->solve(rhs).eval();
-
-        cache.gradient_matrix = gradient_matrix(m);
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
-
-        ScalarField geodesics(m.num_verts());
-        cache.integration_cache = new Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>(-L);
-        assert(cache.integration_cache->info() == Eigen::Success);
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
-
-        // restore original scale and position
-        m.scale(d);
-        m.translate(c);
-        return geodesics;
+        init_geodesics_cache(m, cache, laplacian_mode, time_scalar);
     }
-    else // solve by back-substitution using pre-factored matrices
+
+    // solve by back-substitution using pre-factored matrices
+    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
+    for(unsigned int vid : heat_charges) rhs[vid] = 1.0;
+    ScalarField heat(m.num_verts());
+    cache.heat_flow_cache.solve(rhs, heat);
+
+    VectorField grad = cache.gradient_matrix * heat;
+    grad.normalize();
+
+    ScalarField geodesics(m.num_verts());
+    cache.integration_cache.solve(cache.gradient_matrix.transpose() * grad, geodesics);
+    geodesics.normalize_in_01();
+
+    return geodesics;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Mesh>
+CINO_INLINE
+void compute_geodesics_amortized(      Mesh                                   & m,
+                                       GeodesicsCache                         & cache,
+                                 const std::vector<std::vector<unsigned int>> & heat_charges,
+                                       Eigen::MatrixXd                        & geodesics,
+                                 const int                                      laplacian_mode,
+                                 const float                                    time_scalar,
+                                 const unsigned int                             batch_size)
+{
+    geodesics.resize(m.num_verts(), heat_charges.size());
+    compute_geodesics_amortized(m, cache, heat_charges, [&](const unsigned int set_id, const ScalarField & f)
     {
-        Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
-        for(unsigned int vid : heat_charges) rhs[vid] = 1.0;
-        ScalarField heat = cache.heat_flow_cache->solve(rhs).eval();
+        geodesics.col(set_id) = f;
+    },
+    laplacian_mode, time_scalar, batch_size);
+}
 
-        VectorField grad = cache.gradient_matrix * heat;
-        grad.normalize();
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        ScalarField geodesics(m.num_verts());
-        geodesics = cache.integration_cache->solve(cache.gradient_matrix.transpose() * grad).eval();
-        geodesics.normalize_in_01();
+template<class Mesh>
+CINO_INLINE
+void compute_geodesics_amortized(      Mesh                                   & m,
+                                       GeodesicsCache                         & cache,
+                                 const std::vector<std::vector<unsigned int>> & heat_charges,
+                                 const geodesics_callback                     & callback,
+                                 const int                                      laplacian_mode,
+                                 const float                                    time_scalar,
+                                 const unsigned int                             batch_size)
+{
+    assert(batch_size > 0);
 
-        return geodesics;
+    if(!cache.heat_flow_cache.is_factorized())
+    {
+        init_geodesics_cache(m, cache, laplacian_mode, time_scalar);
     }
 
+    unsigned int nv = m.num_verts();
+    unsigned int ng = cache.gradient_matrix.rows()/3;
+
+    // fields are stored row major (one row per vertex/gradient component), so that sparse
+    // products and triangular solves update all the fields of a batch contiguously.
+    // Buffers are reused across batches
+    RowMatrixXd rhs, heat, grad, div, dist;
+
+    for(unsigned int beg=0; beg<heat_charges.size(); beg+=batch_size)
+    {
+        unsigned int end = std::min((unsigned int)heat_charges.size(), beg+batch_size);
+        unsigned int k   = end - beg;
+
+        rhs.setZero(nv, k);
+        for(unsigned int i=0; i<k; ++i)
+        {
+            for(unsigned int vid : heat_charges.at(beg+i)) rhs(vid,i) = 1.0;
+        }
+
+        cache.heat_flow_cache.solve(rhs, heat);
+
+        // per element normalization of the gradients (same as VectorField::normalize)
+        grad.noalias() = cache.gradient_matrix * heat;
+        PARALLEL_FOR(0, ng, 1000, [&](const unsigned int pid)
+        {
+            double *gx = grad.row(3*pid  ).data();
+            double *gy = grad.row(3*pid+1).data();
+            double *gz = grad.row(3*pid+2).data();
+            for(unsigned int i=0; i<k; ++i)
+            {
+                double norm = std::sqrt(gx[i]*gx[i] + gy[i]*gy[i] + gz[i]*gz[i]);
+                gx[i] /= norm;
+                gy[i] /= norm;
+                gz[i] /= norm;
+            }
+        });
+
+        div.noalias() = cache.gradient_matrix.transpose() * grad;
+        cache.integration_cache.solve(div, dist);
+
+        // per field normalization in [0,1] (same as ScalarField::normalize_in_01)
+        Eigen::RowVectorXd min   = dist.colwise().minCoeff();
+        Eigen::RowVectorXd delta = dist.colwise().maxCoeff() - min;
+        PARALLEL_FOR(0, nv, 10000, [&](const unsigned int vid)
+        {
+            double *f = dist.row(vid).data();
+            for(unsigned int i=0; i<k; ++i) f[i] = (f[i] - min[i]) / delta[i];
+        });
+
+        for(unsigned int i=0; i<k; ++i)
+        {
+            callback(beg+i, ScalarField(dist.col(i)));
+        }
+    }
 }
 
 }
@@ -0,0 +1,160 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/geometry/quadric.h>
+#include <cmath>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+Quadric::Quadric()
+{
+    std::fill(A, A+6, 0.0);
+    std::fill(b, b+3, 0.0);
+    c = 0.0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Quadric::Quadric(const vec3d & point, const vec3d & normal, const double weight)
+{
+    // (n.x - d)^2 = x^T (n n^T) x - 2 d n^T x + d^2
+    double d = normal.dot(point);
+    A[0] = weight * normal.x() * normal.x();
+    A[1] = weight * normal.x() * normal.y();
+    A[2] = weight * normal.x() * normal.z();
+    A[3] = weight * normal.y() * normal.y();
+    A[4] = weight * normal.y() * normal.z();
+    A[5] = weight * normal.z() * normal.z();
+    b[0] = weight * d * normal.x();
+    b[1] = weight * d * normal.y();
+    b[2] = weight * d * normal.z();
+    c    = weight * d * d;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Quadric & Quadric::operator+=(const Quadric & q)
+{
+    for(int i=0; i<6; ++i) A[i] += q.A[i];
+    for(int i=0; i<3; ++i) b[i] += q.b[i];
+    c += q.c;
+    return *this;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Quadric Quadric::operator+(const Quadric & q) const
+{
+    Quadric res = *this;
+    res += q;
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+Quadric Quadric::operator*(const double s) const
+{
+    Quadric res = *this;
+    for(int i=0; i<6; ++i) res.A[i] *= s;
+    for(int i=0; i<3; ++i) res.b[i] *= s;
+    res.c *= s;
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Quadric::A_times(const vec3d & p) const
+{
+    return vec3d{A[0]*p.x() + A[1]*p.y() + A[2]*p.z(),
+                 A[1]*p.x() + A[3]*p.y() + A[4]*p.z(),
+                 A[2]*p.x() + A[4]*p.y() + A[5]*p.z()};
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double Quadric::operator()(const vec3d & p) const
+{
+    vec3d bb{b[0], b[1], b[2]};
+    return std::max(0.0, p.dot(A_times(p)) - 2.0*bb.dot(p) + c); // clamp round off
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool Quadric::minimizer(vec3d & p) const
+{
+    // solve A p = b with Cramer's rule. The determinant is compared against
+    // the cube of the (average) diagonal, so that the test does not depend on scale
+    double c00 = A[3]*A[5] - A[4]*A[4];
+    double c01 = A[2]*A[4] - A[1]*A[5];
+    double c02 = A[1]*A[4] - A[2]*A[3];
+    double det = A[0]*c00 + A[1]*c01 + A[2]*c02;
+    double tr  = (A[0] + A[3] + A[5])/3.0;
+    if(tr<=0 || std::fabs(det) < 1e-6*tr*tr*tr) return false;
+
+    double c11 = A[0]*A[5] - A[2]*A[2];
+    double c12 = A[1]*A[2] - A[0]*A[4];
+    double c22 = A[0]*A[3] - A[1]*A[1];
+    p = vec3d{c00*b[0] + c01*b[1] + c02*b[2],
+              c01*b[0] + c11*b[1] + c12*b[2],
+              c02*b[0] + c12*b[1] + c22*b[2]} / det;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+vec3d Quadric::minimizer(const vec3d & p0, const vec3d & p1) const
+{
+    // Q(p0 + t*d) is a parabola in t: minimize it and clamp t in [0,1]
+    vec3d  d   = p1 - p0;
+    vec3d  bb{b[0], b[1], b[2]};
+    double den = d.dot(A_times(d));
+    if(den<=0) return (operator()(p0) <= operator()(p1)) ? p0 : p1;
+    double t = (bb.dot(d) - p0.dot(A_times(d))) / den;
+    t = std::min(1.0, std::max(0.0, t));
+    return p0 + t*d;
+}
+
+}
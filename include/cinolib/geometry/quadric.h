@@ -0,0 +1,97 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_QUADRIC_H
+#define CINO_QUADRIC_H
+
+#include <iostream>
+#include <cinolib/geometry/vec_mat.h>
+
+namespace cinolib
+{
+
+// error quadric, as defined in
+//
+// Surface Simplification Using Quadric Error Metrics
+// M.Garland, P.S.Heckbert
+// SIGGRAPH 1997
+//
+// stores the (weighted) sum of the squared distances from a set of planes
+// Q(x) = x^T A x - 2 b^T x + c, with A symmetric 3x3 matrix
+//
+class Quadric
+{
+    public:
+
+        explicit Quadric();                            // null quadric
+        explicit Quadric(const vec3d  & point,         // squared distance from the plane
+                         const vec3d  & normal,        // passing through point and orthogonal
+                         const double   weight = 1.0); // to normal (normal must be unit length)
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        Quadric & operator+=(const Quadric & q);
+        Quadric   operator+ (const Quadric & q) const;
+        Quadric   operator* (const double    s) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        double operator()(const vec3d & p) const; // error at p
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // point of minimum error. Returns false if A is (close to) singular,
+        // i.e. if the minimum is not unique (e.g. all planes are parallel)
+        bool minimizer(vec3d & p) const;
+
+        // point of minimum error along the segment p0-p1
+        vec3d minimizer(const vec3d & p0, const vec3d & p1) const;
+
+    protected:
+
+        double A[6]; // xx, xy, xz, yy, yz, zz
+        double b[3];
+        double c;
+
+        vec3d A_times(const vec3d & p) const;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "quadric.cpp"
+#endif
+
+#endif // CINO_QUADRIC_H
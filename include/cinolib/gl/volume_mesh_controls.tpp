@@ -655,7 +655,7 @@ void VolumeMeshControls<Mesh>::header_manual_digging(const bool open)
                     return false;
                 }
                 for(unsigned int vid : m->adj_p2v(pid_beneath))
-                for(unsigned int pid : m->adj_v2p(vid))
+                for(unsigned int pid : m->adj_v2p_span(vid))
                 {
                     if(m->poly_data(pid).flags[HIDDEN] == false)
                     {
@@ -96,7 +96,7 @@ Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolygonMesh<M,V,E,P> &
         {
             std::vector<std::pair<unsigned int,vec3d>> vert_contr;
             double area=0.f;
-            for(unsigned int pid : m.adj_v2p(vid))
+            for(unsigned int pid : m.adj_v2p_span(vid))
             {
                 area   += std::max(m.poly_area(pid), 1e-5) * 2.0;
                 vec3d n = m.poly_data(pid).normal;
@@ -205,12 +205,12 @@ Eigen::SparseMatrix<double> gradient_matrix(const AbstractPolyhedralMesh<M,V,E,F
         for(unsigned int vid=0;vid<m.num_verts();++vid)
         {
             double total_volume=0;
-            for(unsigned int pid : m.adj_v2p(vid))
+            for(unsigned int pid : m.adj_v2p_span(vid))
             {
                 total_volume += m.poly_volume(pid);
             }
             unsigned int row = 3*vid;
-            for(unsigned int pid : m.adj_v2p(vid))
+            for(unsigned int pid : m.adj_v2p_span(vid))
             {
                 unsigned int col=3*pid;
                 entries.push_back(Entry(row,  col,   m.poly_volume(pid)/total_volume));
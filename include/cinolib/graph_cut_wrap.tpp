@@ -56,7 +56,7 @@ std::vector<int> graph_cut_wrap(const AbstractMesh<M,V,E,P>             & m,
 
         // set graph connectivity
         for(unsigned int pid=0; pid<m.num_polys(); ++pid)
-        for(unsigned int nbr : m.adj_p2p(pid))
+        for(unsigned int nbr : m.adj_p2p_span(pid))
         {
             if (pid > nbr) gc.setNeighbors(pid, nbr);
         }
@@ -106,7 +106,7 @@ std::vector<int> graph_cut_wrap(const AbstractMesh<M,V,E,P>             & m,
 
         // set graph connectivity
         for(unsigned int pid=0; pid<m.num_polys(); ++pid)
-        for(unsigned int nbr : m.adj_p2p(pid))
+        for(unsigned int nbr : m.adj_p2p_span(pid))
         {
             if (pid > nbr) gc.setNeighbors(pid, nbr);
         }
@@ -34,7 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/grid_projector.h>
-#include <cinolib/octree.h>
+#include <cinolib/bvh.h>
 
 namespace cinolib
 {
@@ -54,14 +54,14 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
     };
     std::vector<Proj> targets;
 
-    // prepare octrees for projection
-    Octree o_srf;
-    Octree o_corners;
-    Octree o_lines;
+    // prepare BVHs for projection
+    BVH o_srf;
+    BVH o_corners;
+    BVH o_lines;
     for(unsigned int vid=0; vid<srf.num_verts(); ++vid)
     {
         unsigned int count = 0;
-        for(unsigned int eid : srf.adj_v2e(vid))
+        for(unsigned int eid : srf.adj_v2e_span(vid))
         {
             if(srf.edge_data(eid).flags[CREASE]) ++count;
         }
@@ -83,14 +83,14 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
     o_corners.build();
     o_lines.build();
 
-    // lavel mesh elements to set the target octree for projection
+    // lavel mesh elements to set the target BVH for projection
     enum { CORNER, LINE, REGULAR };
     m.vert_apply_label(REGULAR);
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
     {
         if(!m.vert_is_on_srf(vid)) continue;
         unsigned int count = 0;
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             if(m.edge_data(eid).flags[CREASE]) ++count;
         }
@@ -125,7 +125,7 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
                 else
                 {
                     double sum = 0.0;
-                    for(unsigned int nbr : m.adj_v2v(vid))
+                    for(unsigned int nbr : m.adj_v2v_span(vid))
                     {
                         double w = (m.vert_is_on_srf(nbr)) ? 2.0 : 0.5;
                         p   += w * verts.at(nbr);
@@ -180,7 +180,7 @@ double grid_projector(      Hexmesh<M1,V1,E1,F1,P1> & m,
         do
         {
             all_good = true;
-            for(unsigned int pid : m.adj_v2p(vid))
+            for(unsigned int pid : m.adj_v2p_span(vid))
             {
                 if(!SJ_OK(pid,vid,new_pos))
                 {
@@ -78,6 +78,32 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
                                    const unsigned int                    n = 1,
                                    const int                     laplacian_mode = COTANGENT,
                                    const int                     solver = SIMPLICIAL_LLT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Same as above, but the factorized system is kept in the solver, and reused
+ * by subsequent calls as long as the set of constrained vertices does not
+ * change (their values can change). If the mesh geometry, n or the laplacian
+ * mode change, call solver.clear() to force a new factorization.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
+                         const std::map<unsigned int,double> & bc,
+                               LinearSystemSolver            & solver,
+                         const unsigned int                    n = 1,
+                         const int                     laplacian_mode = COTANGENT);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
+                                   const std::map<unsigned int,vec3d>  & bc,
+                                         LinearSystemSolver            & solver,
+                                   const unsigned int                    n = 1,
+                                   const int                     laplacian_mode = COTANGENT);
 }
 
 #include "harmonic_map.tpp"
@@ -76,40 +76,83 @@ std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
                                    const unsigned int                    n,
                                    const int                     laplacian_mode,
                                    const int                     solver)
+{
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+
+    // the three coordinates are independent: factorize the scalar problem
+    // once and solve it with a three column right hand side
+    LinearSystemSolver s(solver);
+    return harmonic_map_3d(m, bc, s, n, laplacian_mode);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField harmonic_map(const AbstractMesh<M,V,E,P> & m,
+                         const std::map<unsigned int,double> & bc,
+                               LinearSystemSolver            & solver,
+                         const unsigned int                    n,
+                         const int                     laplacian_mode)
 {
     assert(n > 0);
     assert(bc.size() > 0);
     assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
-    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
 
-    ScalarField f(3*m.num_verts());
+    std::vector<unsigned int> dirichlet_dofs;
+    for(auto obj : bc) dirichlet_dofs.push_back(obj.first);
 
-    Eigen::SparseMatrix<double> L   = laplacian(m, laplacian_mode, 3);
-    Eigen::SparseMatrix<double> Ln = -L;
-    Eigen::VectorXd             rhs = Eigen::VectorXd::Zero(3*m.num_verts());
+    if(!solver.is_factorized() || solver.size()!=m.num_verts() || solver.dirichlet_dofs()!=dirichlet_dofs)
+    {
+        Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+        Eigen::SparseMatrix<double> Ln = -L;
+        for(unsigned int i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
+        solver.compute(Ln, dirichlet_dofs);
+    }
 
-    for(unsigned int i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
+    ScalarField f(m.num_verts());
+    solver.solve(Eigen::VectorXd::Zero(m.num_verts()), f, bc);
+    return f;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<vec3d> harmonic_map_3d(const AbstractMesh<M,V,E,P> & m,
+                                   const std::map<unsigned int,vec3d>  & bc,
+                                         LinearSystemSolver            & solver,
+                                   const unsigned int                    n,
+                                   const int                     laplacian_mode)
+{
+    assert(n > 0);
+    assert(bc.size() > 0);
+    assert(laplacian_mode == COTANGENT || laplacian_mode == UNIFORM);
 
-    unsigned int y_off = m.num_verts();
-    unsigned int z_off = m.num_verts() + y_off;
-    std::map<unsigned int,double> bc_1d;
+    std::vector<unsigned int> dirichlet_dofs;
+    Eigen::MatrixXd           bc_vals(bc.size(),3);
     for(auto obj : bc)
     {
-        unsigned int  vid = obj.first;
-        vec3d pos = obj.second;
-        bc_1d[      vid] = pos.x();
-        bc_1d[y_off+vid] = pos.y();
-        bc_1d[z_off+vid] = pos.z();
+        bc_vals.row(dirichlet_dofs.size()) << obj.second.x(), obj.second.y(), obj.second.z();
+        dirichlet_dofs.push_back(obj.first);
     }
 
-    solve_square_system_with_bc(Ln, rhs, f, bc_1d, solver);
+    if(!solver.is_factorized() || solver.size()!=m.num_verts() || solver.dirichlet_dofs()!=dirichlet_dofs)
+    {
+        Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+        Eigen::SparseMatrix<double> Ln = -L;
+        for(unsigned int i=1; i<n; ++i) Ln  = Ln * (-L); // keep it PSD
+        solver.compute(Ln, dirichlet_dofs);
+    }
+
+    Eigen::MatrixXd X;
+    solver.solve(Eigen::MatrixXd::Zero(m.num_verts(),3), X, bc_vals);
 
     std::vector<vec3d> res(m.num_verts());
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
     {
-        res.at(vid) = vec3d{f[vid], f[y_off+vid], f[z_off+vid]};
+        res.at(vid) = vec3d{X(vid,0), X(vid,1), X(vid,2)};
     }
-
     return res;
 }
 
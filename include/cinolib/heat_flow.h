@@ -42,6 +42,7 @@
 #include <cinolib/scalar_field.h>
 #include <cinolib/meshes/abstract_mesh.h>
 #include <cinolib/symbols.h>
+#include <cinolib/linear_solvers.h>
 
 namespace cinolib
 {
@@ -57,6 +58,24 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
                       const double                  time = 1.0,
                       const int                     laplacian_mode = COTANGENT,
                       const bool                    hard_contraint_bcs = false);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Same as above, but the factorized system is kept in the solver, and reused
+ * by subsequent calls. With soft constraints the system does not depend on
+ * the heat charges, hence they can change at every call. With hard constraints
+ * the system is factorized again only when the set of charges changes.
+ * If mesh geometry, time or laplacian mode change, call solver.clear()
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
+                      const std::vector<unsigned int>     & heat_charges,
+                            LinearSystemSolver    & solver,
+                      const double                  time = 1.0,
+                      const int                     laplacian_mode = COTANGENT,
+                      const bool                    hard_contraint_bcs = false);
 }
 
 #include "heat_flow.tpp"
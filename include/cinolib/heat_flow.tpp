@@ -38,6 +38,7 @@
 #include <cinolib/vertex_mass.h>
 #include <cinolib/linear_solvers.h>
 #include <Eigen/Sparse>
+#include <algorithm>
 
 namespace cinolib
 {
@@ -74,4 +75,50 @@ ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
     return heat;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+ScalarField heat_flow(const AbstractMesh<M,V,E,P> & m,
+                      const std::vector<unsigned int>     & heat_charges,
+                            LinearSystemSolver    & solver,
+                      const double                  time,
+                      const int                     laplacian_mode,
+                      const bool                    hard_contraint_bcs)
+{
+    assert(heat_charges.size() > 0);
+
+    std::vector<unsigned int> dirichlet_dofs;
+    if(hard_contraint_bcs)
+    {
+        dirichlet_dofs = heat_charges;
+        std::sort(dirichlet_dofs.begin(), dirichlet_dofs.end());
+        dirichlet_dofs.erase(std::unique(dirichlet_dofs.begin(), dirichlet_dofs.end()), dirichlet_dofs.end());
+    }
+
+    if(!solver.is_factorized() || solver.size()!=m.num_verts() || solver.dirichlet_dofs()!=dirichlet_dofs)
+    {
+        Eigen::SparseMatrix<double> L  = laplacian(m, laplacian_mode);
+        Eigen::SparseMatrix<double> MM = mass_matrix(m);
+        solver.compute(MM - time * L, dirichlet_dofs);
+    }
+
+    ScalarField     heat(m.num_verts());
+    Eigen::VectorXd rhs = Eigen::VectorXd::Zero(m.num_verts());
+
+    if (hard_contraint_bcs) // heat flow as a boundary problem (charges do not lose heat)
+    {
+        std::map<unsigned int,double> bcs;
+        for(unsigned int vid: heat_charges) bcs[vid] = 1.0;
+        solver.solve(rhs, heat, bcs);
+    }
+    else // heat flow as a diffusion problem (charges lose heat)
+    {
+        for(unsigned int vid : heat_charges) rhs[vid] = 1.0;
+        solver.solve(rhs, heat);
+    }
+
+    return heat;
+}
+
 }
@@ -105,7 +105,7 @@ CINO_INLINE
 int find_min_ref(const Polyhedralmesh<M,V,E,F,P> & m, const unsigned int vid)
 {
     int min_ref = max_int;
-    for(unsigned int pid : m.adj_v2p(vid))
+    for(unsigned int pid : m.adj_v2p_span(vid))
     {
         if(m.poly_data(pid).label < min_ref)
         {
@@ -124,7 +124,7 @@ CINO_INLINE
 int find_max_ref(const Polyhedralmesh<M,V,E,F,P> & m, const unsigned int vid)
 {
     int max_ref = -1;
-    for(unsigned int pid : m.adj_v2p(vid))
+    for(unsigned int pid : m.adj_v2p_span(vid))
     {
         if(m.poly_data(pid).label > max_ref)
         {
@@ -149,12 +149,12 @@ void get_transition_verts_direction(const Polyhedralmesh<M,V,E,F,P> & m,
 
     for(unsigned int vid=0; vid<m.num_verts(); vid++)
     {
-        if(transition_verts[vid] && m.adj_v2p(vid).size() == 8)
+        if(transition_verts[vid] && m.adj_v2p_span(vid).size() == 8)
         {
             double length = 0;
-            for(unsigned int eid : m.adj_v2e(vid))
+            for(unsigned int eid : m.adj_v2e_span(vid))
             {
-                if(m.adj_e2p(eid).size() == 4 && m.edge_length(eid) > length)
+                if(m.adj_e2p_span(eid).size() == 4 && m.edge_length(eid) > length)
                 {
                     length = m.edge_length(eid);
                     transition_verts_direction[vid] = edge_orientation(m, vid, eid);
@@ -164,7 +164,7 @@ void get_transition_verts_direction(const Polyhedralmesh<M,V,E,F,P> & m,
         else if(transition_verts[vid])
         {
             double length = 0;
-            for(unsigned int eid : m.adj_v2e(vid))
+            for(unsigned int eid : m.adj_v2e_span(vid))
             {
                 if(m.edge_length(eid) > length && v_map.find(m.edge_sample_at(eid, 0.5)) == v_map.end())
                 {
@@ -191,7 +191,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
     std::set<unsigned int> adj_polys_cluster;
     for(unsigned int vid : t_verts)
     {
-        for(unsigned int pid : m.adj_v2p(vid))
+        for(unsigned int pid : m.adj_v2p_span(vid))
         {
             if(m.poly_data(pid).label == min_ref)
             {
@@ -217,7 +217,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
             std::set<unsigned int> poly_vids_set(poly_verts.begin(), poly_verts.end());
             for(unsigned int t_vert : t_verts)
             {
-                for(unsigned int vid : m.adj_v2v(t_vert))
+                for(unsigned int vid : m.adj_v2v_span(t_vert))
                 {
                     if(m.poly_contains_vert(pid, vid)) poly_vids_set.erase(vid);
                 }
@@ -227,7 +227,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
             assert(poly_vids_set.size() == 1);
 
             conc_vert = *poly_vids_set.begin();
-            for(unsigned int vid : m.adj_v2v(conc_vert))
+            for(unsigned int vid : m.adj_v2v_span(conc_vert))
             {
                 if(m.poly_contains_vert(concave, vid))
                 {
@@ -248,7 +248,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
     {
         SchemeInfo info;
         info.type  = HexTransition::VERT_CENTER;
-        info.scale = m.edge_length(m.adj_p2e(concave)[0]);
+        info.scale = m.edge_length(m.adj_p2e_span(concave)[0]);
 
         unsigned int num_cuts=0;
         for(unsigned int vid : adjs_v)
@@ -259,7 +259,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
 
             vec3d middle = m.edge_sample_at(eid, 0.5);
             int middle_vid = -1;
-            for(unsigned int adj_v : m.adj_v2v(vid))
+            for(unsigned int adj_v : m.adj_v2v_span(vid))
             {
                 if(eps_eq(m.vert(adj_v), middle))
                 {
@@ -270,7 +270,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
             assert(middle_vid != -1);
 
             std::set<unsigned int> refs;
-            for(unsigned int adj : m.adj_v2p(middle_vid))
+            for(unsigned int adj : m.adj_v2p_span(middle_vid))
             {
                 refs.insert(m.poly_data(adj).label);
             }
@@ -306,7 +306,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
     if(t_verts_direction[t_verts[0]] == PLUS_Y || t_verts_direction[t_verts[1]] == PLUS_Y || t_verts_direction[t_verts[2]] == PLUS_Y) lateral_y = PLUS_Y;
 
     //FIND SIDES
-    for(unsigned int pid : m.adj_p2p(concave))
+    for(unsigned int pid : m.adj_p2p_span(concave))
     {
         auto query = poly2scheme.find(pid);
         if(query == poly2scheme.end() ||
@@ -324,14 +324,14 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
                 {
                     bool is_cut = false;
 
-                    for(unsigned int vid : m.adj_v2v(p.first))
+                    for(unsigned int vid : m.adj_v2v_span(p.first))
                     {
                         if(m.poly_contains_vert(pid, vid))
                         {
                             unsigned int eid = m.edge_id(p.first, vid);
                             vec3d middle = m.edge_sample_at(eid, 0.5);
                             int middle_vid = -1;
-                            for(unsigned int adj_v : m.adj_v2v(p.first))
+                            for(unsigned int adj_v : m.adj_v2v_span(p.first))
                             {
                                 if(eps_eq(m.vert(adj_v), middle))
                                 {
@@ -341,7 +341,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
                             }
                             assert(middle_vid != -1);
                             std::set<unsigned int> refs;
-                            for(unsigned int adj : m.adj_v2p(middle_vid))
+                            for(unsigned int adj : m.adj_v2p_span(middle_vid))
                             {
                                 refs.insert(m.poly_data(adj).label);
                             }
@@ -358,7 +358,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
             }
             //info.type = poly2scheme[concave].type == CONC_VERT ? CONC_VERT_LATERAL : CONC_VERT_LATERAL_MR;
             info.scheme_type = SchemeType::CORN_S;
-            info.scale = m.edge_length(m.adj_p2e(concave)[0]);
+            info.scale = m.edge_length(m.adj_p2e_span(concave)[0]);
 
             for(unsigned int vid : m.face_verts_id(m.poly_shared_face(pid, concave)))
             {
@@ -370,7 +370,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
                 {
                     unsigned int curr_ref = m.poly_data(pid).label;
                     std::set<unsigned int> refs;
-                    for(unsigned int adj : m.adj_v2p(vid)){
+                    for(unsigned int adj : m.adj_v2p_span(vid)){
                         if(m.poly_data(adj).label >= curr_ref){
                             refs.insert(m.poly_data(adj).label);
                         }
@@ -392,7 +392,7 @@ void mark_concave_vert(const Polyhedralmesh<M,V,E,F,P>     & m,
             SchemeInfo info;
             info.type        = HexTransition::FLAT;
             info.scheme_type = SchemeType::CORN_S;
-            info.scale       = m.edge_length(m.adj_p2e(concave)[0]);
+            info.scale       = m.edge_length(m.adj_p2e_span(concave)[0]);
             if(m.poly_contains_vert(pid, t_verts[0]))
             {
                 info.orientations.push_back(t_verts_direction[t_verts[0]]);
@@ -428,8 +428,8 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
                        const std::vector<unsigned int>             & t_verts_direction,
                        std::unordered_map<unsigned int,SchemeInfo> & poly2scheme)
 {
-    auto adjs_v1 = m.adj_v2v(t_verts[0]);
-    auto adjs_v2 = m.adj_v2v(t_verts[1]);
+    std::vector<unsigned int> adjs_v1 = m.adj_v2v_span(t_verts[0]);
+    std::vector<unsigned int> adjs_v2 = m.adj_v2v_span(t_verts[1]);
     std::vector<unsigned int> intersection;
     std::sort(adjs_v1.begin(), adjs_v1.end());
     std::sort(adjs_v2.begin(), adjs_v2.end());
@@ -438,7 +438,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
     assert(intersection.size() == 2 || intersection.size() == 1);
 
     int ref = 0;
-    for(unsigned int pid : m.adj_v2p(t_verts[0])){
+    for(unsigned int pid : m.adj_v2p_span(t_verts[0])){
         if(m.poly_contains_vert(pid, t_verts[1])){
             ref = m.poly_data(pid).label;
             break;
@@ -450,7 +450,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
     for(unsigned int vid : intersection)
     {
         std::set<int> refs;
-        for(unsigned int pid : m.adj_v2p(vid))
+        for(unsigned int pid : m.adj_v2p_span(vid))
         {
             if(ref <= m.poly_data(pid).label)
                 refs.insert(m.poly_data(pid).label);
@@ -472,7 +472,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
     int min_ref = find_min_ref(m, conc_edge_vid);
     int orient = -1;
 
-    for(unsigned int pid : m.adj_v2p(conc_edge_vid))
+    for(unsigned int pid : m.adj_v2p_span(conc_edge_vid))
     {
         if(!(m.poly_contains_vert(pid, t_verts[0]) && m.poly_contains_vert(pid, t_verts[1]))) continue;
         if(m.poly_data(pid).label == min_ref)
@@ -481,7 +481,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
             if(query == poly2scheme.end() || query->second.type == HexTransition::FLAT || query->second.type == HexTransition::FLAT_CONVEX){
 
                 int eid_to_check = -1;
-                for(unsigned int eid : m.adj_v2e(conc_edge_vid))
+                for(unsigned int eid : m.adj_v2e_span(conc_edge_vid))
                 {
                     if(m.poly_contains_edge(pid, eid)                                           &&
                        edge_orientation(m, conc_edge_vid, eid) != t_verts_direction[t_verts[0]] &&
@@ -495,7 +495,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
 
                 vec3d middle = m.edge_sample_at(eid_to_check, 0.5);
                 int middle_vid = -1;
-                for(unsigned int adj_v : m.adj_v2v(conc_edge_vid))
+                for(unsigned int adj_v : m.adj_v2v_span(conc_edge_vid))
                 {
                     if(eps_eq(m.vert(adj_v), middle))
                     {
@@ -506,7 +506,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
                 assert(middle_vid != -1);
                 bool is_nested = false;
                 std::set<unsigned int> refs;
-                for(unsigned int adj : m.adj_v2p(middle_vid))
+                for(unsigned int adj : m.adj_v2p_span(middle_vid))
                 {
                     refs.insert(m.poly_data(adj).label);
                 }
@@ -519,7 +519,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
 
                 SchemeInfo info;
                 info.type = is_nested ? HexTransition::EDGE_WB : HexTransition::EDGE;
-                info.scale = m.edge_length(m.adj_p2e(pid)[0]);
+                info.scale = m.edge_length(m.adj_p2e_span(pid)[0]);
                 info.t_verts.push_back(m.vert(conc_edge_vid));
                 info.orientations.push_back(orient);
                 info.scheme_type = SchemeType::CONC_S;
@@ -530,7 +530,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
 
     for(unsigned int i=0; i<t_verts.size(); i++)
     {
-        for(unsigned int pid : m.adj_v2p(t_verts[i]))
+        for(unsigned int pid : m.adj_v2p_span(t_verts[i]))
         {
             if(m.poly_contains_vert(pid, conc_edge_vid) || m.poly_data(pid).label != min_ref) continue;
             if(poly2scheme.find(pid) == poly2scheme.end())
@@ -538,7 +538,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
                 SchemeInfo info;
                 info.type = HexTransition::FLAT;
 
-                for(unsigned int adj : m.adj_p2p(pid))
+                for(unsigned int adj : m.adj_p2p_span(pid))
                 {
                     if(m.poly_contains_vert(adj, t_verts[i])) continue;
 
@@ -553,7 +553,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
                     }
                 }
 
-                info.scale = m.edge_length(m.adj_p2e(pid)[0]);
+                info.scale = m.edge_length(m.adj_p2e_span(pid)[0]);
                 info.t_verts.push_back(m.vert(t_verts[i]));
                 info.orientations.push_back(t_verts_direction[t_verts[i]]);
                 info.orientations.push_back(t_verts_direction[t_verts[(i+1)%t_verts.size()]]);
@@ -567,7 +567,7 @@ void mark_concave_edge(const Polyhedralmesh<M,V,E,F,P>     & m,
 
     for(unsigned int concave : concaves)
     {
-        for(unsigned int adj : m.adj_p2p(concave))
+        for(unsigned int adj : m.adj_p2p_span(concave))
         {
             auto query = poly2scheme.find(adj);
             if(query != poly2scheme.end())
@@ -595,8 +595,8 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
     unsigned int conv_edge_vert = t_verts.back();
     int min_ref = find_min_ref(m, conv_edge_vert);
 
-    auto adj1 = m.adj_v2p(t_verts[0]);
-    auto adj2 = m.adj_v2p(t_verts[1]);
+    std::vector<unsigned int> adj1 = m.adj_v2p_span(t_verts[0]);
+    std::vector<unsigned int> adj2 = m.adj_v2p_span(t_verts[1]);
     std::vector<unsigned int> intersection;
     std::sort(adj1.begin(), adj1.end());
     std::sort(adj2.begin(), adj2.end());
@@ -606,7 +606,7 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
         return;
     }
 
-    for(unsigned int pid : m.adj_v2p(conv_edge_vert))
+    for(unsigned int pid : m.adj_v2p_span(conv_edge_vert))
     {
         if(m.poly_data(pid).label == min_ref)
         {
@@ -619,7 +619,7 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
                 info.type = HexTransition::CONVEX_1;
 
                 int orient = -1;
-                for(unsigned int eid : m.adj_v2e(conv_edge_vert))
+                for(unsigned int eid : m.adj_v2e_span(conv_edge_vert))
                 {
                     if(m.poly_contains_edge(pid, eid)                                            &&
                        edge_orientation(m, conv_edge_vert, eid) != t_verts_direction[t_verts[0]] &&
@@ -633,7 +633,7 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
 
                 info.scheme_type = SchemeType::CONV_S;
                 info.cuts[orient] = true;
-                info.scale = m.edge_length(m.adj_p2e(pid)[0]);
+                info.scale = m.edge_length(m.adj_p2e_span(pid)[0]);
                 info.t_verts.push_back(m.vert(conv_edge_vert));
                 info.orientations.push_back(orient);
                 poly2scheme[pid] = info;
@@ -644,7 +644,7 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
                 {
                     poly2scheme[pid].type = HexTransition::CONVEX_2;
                     int orient = -1;
-                    for(unsigned int eid : m.adj_v2e(conv_edge_vert))
+                    for(unsigned int eid : m.adj_v2e_span(conv_edge_vert))
                     {
                         if(m.poly_contains_edge(pid, eid)                                            &&
                            edge_orientation(m, conv_edge_vert, eid) != t_verts_direction[t_verts[0]] &&
@@ -661,7 +661,7 @@ void mark_convex(const Polyhedralmesh<M,V,E,F,P>     & m,
                 {
                     poly2scheme[pid].type = HexTransition::CONVEX_3;
                     int orient = -1;
-                    for(unsigned int eid : m.adj_v2e(conv_edge_vert))
+                    for(unsigned int eid : m.adj_v2e_span(conv_edge_vert))
                     {
                         if(m.poly_contains_edge(pid, eid)                                            &&
                            edge_orientation(m, conv_edge_vert, eid) != t_verts_direction[t_verts[0]] &&
@@ -691,7 +691,7 @@ void mark_flat(const Polyhedralmesh<M,V,E,F,P>     & m,
 {
     int min_ref = find_min_ref(m, t_vert);
 
-    for(unsigned int pid : m.adj_v2p(t_vert))
+    for(unsigned int pid : m.adj_v2p_span(t_vert))
     {
         if(m.poly_data(pid).label == min_ref)
         {
@@ -700,7 +700,7 @@ void mark_flat(const Polyhedralmesh<M,V,E,F,P>     & m,
                 SchemeInfo info;
                 info.type = HexTransition::FLAT;
 
-                info.scale = m.edge_length(m.adj_p2e(pid)[0]);
+                info.scale = m.edge_length(m.adj_p2e_span(pid)[0]);
                 info.orientations.push_back(orientation[t_vert]);
                 info.t_verts.push_back(m.vert(t_vert));
                 info.scheme_type = SchemeType::FLAT_S;
@@ -714,14 +714,14 @@ void mark_flat(const Polyhedralmesh<M,V,E,F,P>     & m,
             {
                 SchemeInfo info;
                 info.type = HexTransition::FLAT_CONVEX;
-                info.scale = m.edge_length(m.adj_p2e(pid)[0]);
+                info.scale = m.edge_length(m.adj_p2e_span(pid)[0]);
                 info.orientations.push_back(orientation[t_vert]);
                 info.t_verts.push_back(m.vert(t_vert));
                 info.scheme_type = SchemeType::FLAT_S;
                 poly2scheme[pid] = info;
 
                 //ADJSUST ADJACENTS
-                for(unsigned int adj : m.adj_p2p(pid))
+                for(unsigned int adj : m.adj_p2p_span(pid))
                 {
                     auto query = poly2scheme.find(adj);
                     if(query != poly2scheme.end() &&
@@ -756,7 +756,7 @@ void cut_flats(const Polyhedralmesh<M,V,E,F,P>     & m,
         auto p = *poly2scheme.find(id);
         if(p.second.type == HexTransition::FLAT_CONVEX)
         {
-            for(unsigned int adj : m.adj_p2p(p.first))
+            for(unsigned int adj : m.adj_p2p_span(p.first))
             {
                 auto query = poly2scheme.find(adj);
                 if(query != poly2scheme.end() &&
@@ -777,7 +777,7 @@ void cut_flats(const Polyhedralmesh<M,V,E,F,P>     & m,
            p.second.scheme_type == SchemeType::CORN_S)
         {
             unsigned int num_adj_conc_lateral = 0;
-            for(unsigned int adj : m.adj_p2p(p.first))
+            for(unsigned int adj : m.adj_p2p_span(p.first))
             {
                 auto query = poly2scheme.find(adj);
                 if(query != poly2scheme.end()                     &&
@@ -936,7 +936,7 @@ void hex_transition_install(const Polyhedralmesh<M,V,E,F,P> & m_in,
         if(!transition_verts[vid])
         {
             std::vector<unsigned int> adj_t_verts;
-            for(unsigned int adj_v : m_in.adj_v2v(vid))
+            for(unsigned int adj_v : m_in.adj_v2v_span(vid))
             {
                 if(transition_verts[adj_v]) adj_t_verts.push_back(adj_v);
             }
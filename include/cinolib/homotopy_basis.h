@@ -38,6 +38,7 @@
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
 #include <cinolib/meshes/trimesh.h>
+#include <cinolib/dijkstra_engine.h>
 
 namespace cinolib
 {
@@ -155,6 +156,18 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// same as above, reusing a DijkstraEngine already bound to m
+template<class M, class V, class E, class P>
+CINO_INLINE
+double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
+                      const unsigned int                       root,
+                      std::vector<std::vector<unsigned int>> & basis,
+                      std::vector<bool>              & tree,
+                      std::vector<bool>              & cotree,
+                      DijkstraEngine                 & dijkstra);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // globally detaches loops in the homotopy basis
 template<class M, class V, class E, class P>
 CINO_INLINE
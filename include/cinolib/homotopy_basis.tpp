@@ -87,10 +87,27 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
                       std::vector<std::vector<unsigned int>> & basis,
                       std::vector<bool>              & tree,
                       std::vector<bool>              & cotree)
+{
+    DijkstraEngine dijkstra(m);
+    return homotopy_basis(m, root, basis, tree, cotree, dijkstra);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
+                      const unsigned int                       root,
+                      std::vector<std::vector<unsigned int>> & basis,
+                      std::vector<bool>              & tree,
+                      std::vector<bool>              & cotree,
+                      DijkstraEngine                 & dijkstra)
 {
     assert(root<m.num_verts());
+    assert(dijkstra.num_nodes() == m.num_verts());
 
-    shortest_path_tree(m, root, tree);
+    dijkstra.reset_constraints();
+    shortest_path_tree(m, root, tree, dijkstra);
 
     // Compute the cotree as the Maximum Spanning Tree of the dual of M,
     // without considering dual edges that cross edges of primal tree.
@@ -99,13 +116,20 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
     std::vector<float> edge_weights(m.num_edges(),0);
     std::vector<bool>  edge_mask(m.num_edges()); // restrict Dijkstra to the edges in tree only
     for(unsigned int eid=0; eid<m.num_edges(); ++eid) edge_mask.at(eid) = !tree.at(eid);
+
+    // paths to the root are restricted to the tree, hence they are all
+    // encoded in a single Dijkstra run starting from the root
+    std::vector<double> dist_to_root;
+    dijkstra.set_edge_mask(&edge_mask);
+    dijkstra.distances({root}, dist_to_root);
+    dijkstra.reset_constraints();
+
     for(unsigned int eid=0; eid<m.num_edges(); ++eid)
     {
         if(tree.at(eid)) continue;
-        std::vector<unsigned int> tmp;
         edge_weights.at(eid) -= m.edge_length(eid);
-        edge_weights.at(eid) -= dijkstra_mask_on_edges(m, m.edge_vert_id(eid,0), root, edge_mask, tmp);
-        edge_weights.at(eid) -= dijkstra_mask_on_edges(m, m.edge_vert_id(eid,1), root, edge_mask, tmp);
+        edge_weights.at(eid) -= dist_to_root.at(m.edge_vert_id(eid,0));
+        edge_weights.at(eid) -= dist_to_root.at(m.edge_vert_id(eid,1));
     }
     MST_on_dual_mask_on_edges(m, edge_weights, tree, cotree); // use tree as edge mask
 
@@ -122,13 +146,14 @@ double homotopy_basis(AbstractPolygonMesh<M,V,E,P>   & m,
     double length = 0.0;
     for(unsigned int eid : generators)
     {
-        std::vector<unsigned int> e0_to_root, e1_to_root;
+        std::vector<unsigned int> e0_to_root, root_to_e1;
         length += m.edge_length(eid);
-        length += dijkstra_mask_on_edges(m, m.edge_vert_id(eid,0), root, edge_mask, e0_to_root);
-        length += dijkstra_mask_on_edges(m, m.edge_vert_id(eid,1), root, edge_mask, e1_to_root);
-        e1_to_root.pop_back();
-        std::reverse(e1_to_root.begin(), e1_to_root.end());
-        std::copy(e1_to_root.begin(), e1_to_root.end(), std::back_inserter(e0_to_root));
+        length += dist_to_root.at(m.edge_vert_id(eid,0));
+        length += dist_to_root.at(m.edge_vert_id(eid,1));
+        dijkstra.path_to(m.edge_vert_id(eid,0), e0_to_root);
+        dijkstra.path_to(m.edge_vert_id(eid,1), root_to_e1);
+        std::reverse(e0_to_root.begin(), e0_to_root.end());
+        std::copy(root_to_e1.begin()+1, root_to_e1.end(), std::back_inserter(e0_to_root));
         basis.push_back(e0_to_root);
     }
     return length;
@@ -152,9 +177,10 @@ void homotopy_basis(AbstractPolygonMesh<M,V,E,P> & m,
         std::vector<bool>              best_tree;
         std::vector<bool>              best_cotree;
 
+        DijkstraEngine dijkstra(m);
         for(unsigned int vid=0; vid<m.num_verts(); ++vid)
         {
-            double length = homotopy_basis(m, vid, data.loops, data.tree, data.cotree);
+            double length = homotopy_basis(m, vid, data.loops, data.tree, data.cotree, dijkstra);
 
             if(length < best_length)
             {
@@ -198,7 +224,7 @@ void detach_loops(Trimesh<M,V,E,P>  & m,
         if(vid == data.root) continue;
         unsigned int val_1 = 0;
         unsigned int val_2 = 0; // 2 or more
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             switch(m.edge_data(eid).label)
             {
@@ -599,7 +625,7 @@ void detach_loops_postproc(Trimesh<M,V,E,P>  & m,
     // recompute basis
     data.loops.clear();
     m.edge_set_flag(MARKED,false);
-    for(unsigned int eid: m.adj_v2e(data.root))
+    for(unsigned int eid: m.adj_v2e_span(data.root))
     {
         if(m.edge_data(eid).flags[MARKED]) continue;
         if(m.edge_data(eid).label>0)
@@ -613,7 +639,7 @@ void detach_loops_postproc(Trimesh<M,V,E,P>  & m,
             do
             {
                 int next = -1;
-                for(unsigned int eid : m.adj_v2e(curr))
+                for(unsigned int eid : m.adj_v2e_span(curr))
                 {
                     if(m.edge_data(eid).label>0 && !m.edge_data(eid).flags[MARKED])
                     {
@@ -0,0 +1,144 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/indexed_heap.h>
+#include <cassert>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void IndexedHeap::resize(const unsigned int n)
+{
+    heap.clear();
+    pos.assign(n, -1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IndexedHeap::clear()
+{
+    for(const auto & obj : heap) pos[obj.second] = -1;
+    heap.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IndexedHeap::push(const unsigned int id, const double priority)
+{
+    assert(id < pos.size());
+    int i = pos[id];
+    if(i < 0)
+    {
+        heap.emplace_back(priority, id);
+        pos[id] = (int)heap.size()-1;
+        sift_up(heap.size()-1);
+    }
+    else if(priority < heap[i].first)
+    {
+        heap[i].first = priority;
+        sift_up(i);
+    }
+    else
+    {
+        heap[i].first = priority;
+        sift_down(i);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int IndexedHeap::pop()
+{
+    assert(!heap.empty());
+    unsigned int id = heap.front().second;
+    pos[id] = -1;
+    if(heap.size() > 1)
+    {
+        heap.front() = heap.back();
+        pos[heap.front().second] = 0;
+        heap.pop_back();
+        sift_down(0);
+    }
+    else heap.pop_back();
+    return id;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IndexedHeap::sift_up(unsigned int i)
+{
+    std::pair<double,unsigned int> item = heap[i];
+    while(i > 0)
+    {
+        unsigned int parent = (i-1)/D;
+        if(!(item < heap[parent])) break;
+        heap[i] = heap[parent];
+        pos[heap[i].second] = i;
+        i = parent;
+    }
+    heap[i] = item;
+    pos[item.second] = i;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void IndexedHeap::sift_down(unsigned int i)
+{
+    std::pair<double,unsigned int> item = heap[i];
+    unsigned int n = heap.size();
+    for(;;)
+    {
+        unsigned int first = D*i+1;
+        if(first >= n) break;
+        unsigned int last = std::min(first+D, n);
+        unsigned int best = first;
+        for(unsigned int c=first+1; c<last; ++c) if(less(c,best)) best = c;
+        if(!(heap[best] < item)) break;
+        heap[i] = heap[best];
+        pos[heap[i].second] = i;
+        i = best;
+    }
+    heap[i] = item;
+    pos[item.second] = i;
+}
+
+}
@@ -0,0 +1,88 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_INDEXED_HEAP_H
+#define CINO_INDEXED_HEAP_H
+
+#include <vector>
+#include <utility>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Min priority queue of integer ids in [0,n) with decrease-key, realized as
+ * an indexed 4-ary heap. Each id is in the queue at most once: pushing an id
+ * that is already queued updates its priority. Ties are broken in favour of
+ * the smallest id, hence the pop order is exactly the same one would obtain
+ * with a std::set<std::pair<double,unsigned int>>, at a fraction of the cost.
+*/
+
+class IndexedHeap
+{
+    public:
+
+        explicit IndexedHeap(const unsigned int n = 0) { resize(n); }
+
+        void resize(const unsigned int n);
+        void clear();
+
+        bool         empty()                      const { return heap.empty(); }
+        unsigned int size()                       const { return (unsigned int)heap.size(); }
+        bool         contains(const unsigned int id) const { return pos[id] >= 0; }
+
+        void         push(const unsigned int id, const double priority); // insert, or update priority
+        unsigned int pop();                                              // remove and return the id with lowest priority
+        unsigned int top()                        const { return heap.front().second; }
+
+    protected:
+
+        static const unsigned int D = 4;
+
+        bool less(const unsigned int i, const unsigned int j) const { return heap[i] < heap[j]; }
+        void sift_up  (unsigned int i);
+        void sift_down(unsigned int i);
+
+        std::vector<std::pair<double,unsigned int>> heap; // (priority,id)
+        std::vector<int>                            pos;  // position of each id in heap (-1 if not queued)
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "indexed_heap.cpp"
+#endif
+
+#endif // CINO_INDEXED_HEAP_H
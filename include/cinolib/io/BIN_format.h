@@ -0,0 +1,84 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_BIN_FORMAT_H
+#define CINO_BIN_FORMAT_H
+
+#include <stdint.h>
+#include <cstring>
+
+namespace cinolib
+{
+
+/* Layout of the native binary container (.cinobin). The file is a list of
+ * named sections (raw arrays), meant to be memory mapped and consumed as is,
+ * without any parsing:
+ *
+ *   BINHeader                  (64 bytes)
+ *   BINSectionEntry[N]         (32 bytes each, the table of contents)
+ *   section data               (each section starts at a 64 bytes aligned offset)
+ *
+ * Data is stored in the native byte order of the writer. The header contains
+ * a byte order mark, and files written on machines with a different endianness
+ * are rejected. See write_BIN and BINFile (read_BIN.h) for the I/O, and
+ * AbstractPolygonMesh::save_BIN/load_BIN for the sections used to store meshes.
+*/
+
+static const uint32_t BIN_version    = 1;
+static const uint32_t BIN_byte_order = 0x01020304;
+static const uint64_t BIN_alignment  = 64;
+
+struct BINHeader
+{
+    char     magic[8];      // "CINOBIN"
+    uint32_t version;
+    uint32_t byte_order;    // BIN_byte_order, as written by the writer
+    uint64_t num_sections;
+    char     padding[40];
+};
+
+struct BINSectionEntry
+{
+    char     tag[16];       // null terminated section name
+    uint64_t offset;        // from the beginning of the file
+    uint64_t bytes;
+};
+
+static_assert(sizeof(BINHeader)       == 64, "unexpected BIN header size");
+static_assert(sizeof(BINSectionEntry) == 32, "unexpected BIN section entry size");
+
+}
+
+#endif // CINO_BIN_FORMAT_H
@@ -35,6 +35,11 @@
 *********************************************************************************/
 #include <cinolib/io/io_utilities.h>
 #include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <cmath>
+#include <stdint.h>
+#include <string>
 
 namespace cinolib
 {
@@ -108,4 +113,235 @@ bool eat_uint(FILE * f, unsigned int & i)
     return true;
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool read_file_in_memory(const char * filename, std::vector<char> & buffer)
+{
+    buffer.clear();
+    FILE *f = fopen(filename, "rb");
+    if(!f) return false;
+
+    const size_t block = 1<<26;
+    size_t size = 0;
+    while(true)
+    {
+        buffer.resize(size+block);
+        size_t n = fread(buffer.data()+size, 1, block, f);
+        size += n;
+        if(n<block) break;
+    }
+    fclose(f);
+    buffer.resize(size+1);
+    buffer.back() = '\0';
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<size_t> split_in_line_chunks(const std::vector<char> & buffer,
+                                         const size_t              beg,
+                                         const size_t              end,
+                                         const size_t              chunk_size)
+{
+    std::vector<size_t> chunks(1,beg);
+    while(chunks.back()<end)
+    {
+        size_t pos = chunks.back() + chunk_size;
+        if(pos>=end)
+        {
+            chunks.push_back(end);
+            break;
+        }
+        const char *nl = static_cast<const char*>(memchr(buffer.data()+pos, '\n', end-pos));
+        chunks.push_back(nl ? nl-buffer.data()+1 : end);
+    }
+    return chunks;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::string eat_line(const char * & s)
+{
+    const char *beg = s;
+    while(*s!='\n' && *s!='\0') ++s;
+    std::string line(beg, s);
+    if(*s=='\n') ++s;
+    return line;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void eat_blanks(const char * & s)
+{
+    while(*s==' ' || *s=='\t' || *s=='\r' || *s=='\v' || *s=='\f') ++s;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_double(const char * & s, double & d, const bool c_syntax)
+{
+    static const double pow10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10, 1e11,
+                                   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    eat_blanks(s);
+    const char *p = s;
+
+    bool neg = false;
+    if(*p=='+' || *p=='-') neg = (*p++=='-');
+
+    if(!c_syntax || (*p>='0' && *p<='9') || *p=='.')
+    {
+        if(c_syntax && p[0]=='0' && (p[1]=='x' || p[1]=='X'))
+        {
+            // hex float: as scanf, "0x" must be followed by at least one hex digit
+            if(!isxdigit(p[2]) && !(p[2]=='.' && isxdigit(p[3]))) return false;
+            char *end;
+            d = strtod(s, &end);
+            if(*end=='p' || *end=='P')
+            {
+                ++end;
+                if(*end=='+' || *end=='-') ++end;
+            }
+            s = end;
+            return true;
+        }
+
+        uint64_t mant     = 0;
+        int      n_digits = 0;     // significant digits in mant
+        int      exp10    = 0;
+        bool     any      = false; // at least one digit
+        bool     exact    = true;  // false if some non zero digit did not fit in mant
+        for(; *p>='0' && *p<='9'; ++p, any=true)
+        {
+            if(n_digits<19)
+            {
+                mant = mant*10 + (*p-'0');
+                if(mant>0) ++n_digits;
+            }
+            else
+            {
+                ++exp10;
+                if(*p!='0') exact = false;
+            }
+        }
+        if(*p=='.')
+        {
+            for(++p; *p>='0' && *p<='9'; ++p, any=true)
+            {
+                if(n_digits<19)
+                {
+                    mant = mant*10 + (*p-'0');
+                    if(mant>0) ++n_digits;
+                    --exp10;
+                }
+                else if(*p!='0') exact = false;
+            }
+        }
+        if(!any) return false;
+
+        const char *num_end = p; // end of the number, excluding a dangling exponent marker
+        if(*p=='e' || *p=='E')
+        {
+            const char *q = p+1;
+            bool neg_exp = false;
+            if(*q=='+' || *q=='-') neg_exp = (*q++=='-');
+            if(*q>='0' && *q<='9')
+            {
+                int e = 0;
+                for(; *q>='0' && *q<='9'; ++q) if(e<100000) e = e*10 + (*q-'0');
+                exp10 += neg_exp ? -e : e;
+                num_end = q;
+            }
+            else if(!c_syntax) return false; // C++ streams reject "1e", scanf reads it as 1
+            p = q;
+        }
+
+        if(exact && mant<=(uint64_t(1)<<53) && exp10>=-22 && exp10<=22)
+        {
+            d = (exp10<0) ? double(mant)/pow10[-exp10] : double(mant)*pow10[exp10];
+            if(neg) d = -d;
+        }
+        else d = strtod(std::string(s,num_end).c_str(), nullptr); // slow path (long mantissas, large exponents)
+        if(!c_syntax && std::isinf(d)) return false; // C++ streams reject overflows
+        s = p;
+        return true;
+    }
+
+    // infinities and NaNs (as scanf, NaN payloads are not consumed)
+    auto keyword = [&](const char * k)
+    {
+        size_t n = strlen(k);
+        for(size_t i=0; i<n; ++i) if(tolower(p[i])!=k[i]) return false;
+        return true;
+    };
+    if(keyword("nan"))
+    {
+        d = neg ? -NAN : NAN;
+        s = p+3;
+        return true;
+    }
+    if(keyword("inf"))
+    {
+        d = neg ? -INFINITY : INFINITY;
+        s = keyword("infinity") ? p+8 : p+3;
+        return true;
+    }
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_float(const char * & s, float & f)
+{
+    eat_blanks(s);
+    const char *p = s;
+    if(*p=='+' || *p=='-') ++p;
+    if(!((*p>='0' && *p<='9') || (*p=='.' && p[1]>='0' && p[1]<='9'))) return false;
+    char *end;
+    f = strtof(s, &end);
+    if(end==s || std::isinf(f)) return false;
+    s = end;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_int(const char * & s, int & i)
+{
+    eat_blanks(s);
+    const char *p = s;
+    bool neg = false;
+    if(*p=='+' || *p=='-') neg = (*p++=='-');
+    if(*p<'0' || *p>'9') return false;
+    long long val = 0;
+    for(; *p>='0' && *p<='9'; ++p) val = val*10 + (*p-'0');
+    i = static_cast<int>(neg ? -val : val);
+    s = p;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_uint(const char * & s, unsigned int & i)
+{
+    eat_blanks(s);
+    const char *p = s;
+    bool neg = false;
+    if(*p=='+' || *p=='-') neg = (*p++=='-');
+    if(*p<'0' || *p>'9') return false;
+    unsigned int val = 0;
+    for(; *p>='0' && *p<='9'; ++p) val = val*10 + (*p-'0');
+    i = neg ? 0u-val : val;
+    s = p;
+    return true;
+}
+
 }
@@ -37,6 +37,7 @@
 #define CINO_IO_UTILITIES_H
 
 #include <iostream>
+#include <vector>
 #include <cinolib/cino_inline.h>
 
 namespace cinolib
@@ -70,6 +71,67 @@ bool eat_int(FILE * f, int & i);
 CINO_INLINE
 bool eat_uint(FILE * f, unsigned int & i);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Utilities for the parallel parsing of text files kept in memory. Buffers must
+// be null terminated. The eat_* functions below skip leading blanks (but never
+// go past the end of the current line), parse a number and advance the pointer
+// right after it. If no number can be parsed they return false and leave the
+// pointer untouched.
+
+// reads the whole file in memory (in large blocks), and appends a null terminator
+CINO_INLINE
+bool read_file_in_memory(const char * filename, std::vector<char> & buffer);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits the bytes in [beg,end) in chunks of (roughly) chunk_size bytes, made of
+// whole lines. Returns the chunk boundaries (beg, ..., end)
+CINO_INLINE
+std::vector<size_t> split_in_line_chunks(const std::vector<char> & buffer,
+                                         const size_t              beg,
+                                         const size_t              end,
+                                         const size_t              chunk_size = 1<<22);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// returns the line starting at s (without the line terminator) and moves s to the next line
+CINO_INLINE
+std::string eat_line(const char * & s);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// skips blanks other than the line terminator
+CINO_INLINE
+void eat_blanks(const char * & s);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Numbers with at most 19 significant digits and a small exponent (i.e., virtually
+// all numbers found in mesh files) are converted exactly with integer arithmetic
+// plus one floating point operation. All the others go through strtod. Results
+// are therefore always identical to strtod (i.e., to scanf("%lf")). If c_syntax is
+// false, only the decimal syntax accepted by C++ streams is recognized (no hex
+// floats, infinities or NaNs)
+CINO_INLINE
+bool eat_double(const char * & s, double & d, const bool c_syntax = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_float(const char * & s, float & f); // same as strtof (decimal syntax only)
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_int(const char * & s, int & i);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool eat_uint(const char * & s, unsigned int & i); // as C++ streams, a minus sign negates modulo 2^32
+
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
 }
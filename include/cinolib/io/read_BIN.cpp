@@ -0,0 +1,198 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/read_BIN.h>
+#include <cinolib/trace_profiler.h>
+#include <iostream>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool BINFile::open(const char * filename)
+{
+    close();
+
+#ifdef _WIN32
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    if(!f.is_open()) return false;
+    bytes = f.tellg();
+    buffer.resize(bytes);
+    f.seekg(0);
+    if(!f.read(buffer.data(), bytes)) { close(); return false; }
+    base = buffer.data();
+#else
+    int fd = ::open(filename, O_RDONLY);
+    if(fd<0) return false;
+    struct stat st;
+    if(fstat(fd,&st)!=0 || st.st_size==0)
+    {
+        ::close(fd);
+        return false;
+    }
+    bytes = st.st_size;
+    void *ptr = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping stays valid after closing the descriptor
+    if(ptr==MAP_FAILED)
+    {
+        bytes = 0;
+        return false;
+    }
+    base   = static_cast<const char*>(ptr);
+    mapped = true;
+#endif
+
+    // validate the header and the table of contents
+    const BINHeader *header = reinterpret_cast<const BINHeader*>(base);
+    if(bytes<sizeof(BINHeader)                ||
+       strncmp(header->magic,"CINOBIN",8)!=0  ||
+       header->version!=BIN_version           ||
+       header->byte_order!=BIN_byte_order     ||
+       header->num_sections>(bytes-sizeof(BINHeader))/sizeof(BINSectionEntry))
+    {
+        close();
+        return false;
+    }
+    const BINSectionEntry *toc = reinterpret_cast<const BINSectionEntry*>(base + sizeof(BINHeader));
+    for(uint64_t i=0; i<header->num_sections; ++i)
+    {
+        // sections must lie within the file and keep their alignment (they are accessed in place)
+        if(toc[i].offset>bytes || toc[i].bytes>bytes-toc[i].offset || toc[i].offset%BIN_alignment!=0)
+        {
+            close();
+            return false;
+        }
+        std::string tag(toc[i].tag, strnlen(toc[i].tag, sizeof(toc[i].tag)));
+        sections[tag] = std::make_pair(toc[i].offset, toc[i].bytes);
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void BINFile::close()
+{
+#ifndef _WIN32
+    if(mapped) munmap(const_cast<char*>(base), bytes);
+#endif
+    base   = nullptr;
+    bytes  = 0;
+    mapped = false;
+    buffer.clear();
+    sections.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+const void * BINFile::section(const std::string & tag, size_t & bytes) const
+{
+    auto query = sections.find(tag);
+    if(query==sections.end())
+    {
+        bytes = 0;
+        return nullptr;
+    }
+    bytes = query->second.second;
+    return base + query->second.first;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool BIN_valid_csr(const unsigned int * off,
+                   const size_t         n_off,
+                   const unsigned int * idx,
+                   const size_t         n_idx,
+                   const size_t         max_index)
+{
+    if(off==nullptr || n_off==0 || off[0]!=0 || off[n_off-1]!=n_idx) return false;
+    for(size_t i=0; i+1<n_off; ++i)
+    {
+        if(off[i]>off[i+1]) return false;
+    }
+    for(size_t i=0; i<n_idx; ++i)
+    {
+        if(idx[i]>=max_index) return false;
+    }
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void read_BIN(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<unsigned int>> & polys)
+{
+    CINO_PROFILE_ZONE("read_BIN");
+    verts.clear();
+    polys.clear();
+
+    BINFile f;
+    if(!f.open(filename))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_BIN() : couldn't open input file " << filename << std::endl;
+        exit(-1);
+    }
+
+    size_t nv, n_off, n_idx;
+    const vec3d        *v   = f.section<vec3d>("verts", nv);
+    const unsigned int *off = f.section<unsigned int>("poly_offsets", n_off);
+    const unsigned int *idx = f.section<unsigned int>("poly_verts", n_idx);
+
+    if(v==nullptr || !BIN_valid_csr(off, n_off, idx, n_idx, nv))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_BIN() : missing or malformed vertices/polygons in " << filename << std::endl;
+        exit(-1);
+    }
+
+    verts.assign(v, v+nv);
+    polys.resize(n_off-1);
+    for(size_t pid=0; pid+1<n_off; ++pid) polys[pid].assign(idx+off[pid], idx+off[pid+1]);
+}
+
+}
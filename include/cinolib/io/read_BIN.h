@@ -0,0 +1,132 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_READ_BIN_H
+#define CINO_READ_BIN_H
+
+#include <sys/types.h>
+#include <vector>
+#include <string>
+#include <map>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/io/BIN_format.h>
+
+namespace cinolib
+{
+
+/* Read only access to a .cinobin file (see BIN_format.h). The file is memory
+ * mapped, and sections are returned as pointers inside the mapping, with no
+ * copies and no parsing. Pages are loaded lazily by the OS the first time they
+ * are touched. Sections are 64 bytes aligned, therefore they can be safely
+ * reinterpreted as arrays of their original type. On systems without mmap the
+ * whole file is read into a buffer instead. Pointers are valid until the file
+ * is closed (or the BINFile is destroyed).
+*/
+
+class BINFile
+{
+    public:
+
+        explicit BINFile() {}
+        explicit BINFile(const char * filename) { open(filename); }
+        ~BINFile() { close(); }
+
+        BINFile(const BINFile &) = delete;
+        BINFile & operator=(const BINFile &) = delete;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool open(const char * filename); // returns false if the file cannot be opened or is not a valid .cinobin
+        void close();
+        bool is_open() const { return base!=nullptr; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool        has_section(const std::string & tag) const { return sections.find(tag)!=sections.end(); }
+        const void *section    (const std::string & tag, size_t & bytes) const; // nullptr (and zero bytes) if missing
+
+        template<typename T>
+        const T * section(const std::string & tag, size_t & count) const // count = number of items of type T
+        {
+            size_t bytes;
+            const void * ptr = section(tag, bytes);
+            count = bytes/sizeof(T);
+            return static_cast<const T*>(ptr);
+        }
+
+        template<typename T>
+        const T * column(const std::string & tag, const size_t n) const // the section, only if it contains exactly n items of type T
+        {
+            size_t count;
+            const T * ptr = section<T>(tag, count);
+            return (count==n) ? ptr : nullptr;
+        }
+
+    private:
+
+        const char                                        * base  = nullptr;
+        size_t                                              bytes = 0;
+        bool                                                mapped = false;
+        std::vector<char>                                   buffer; // used only if mmap is not available
+        std::map<std::string,std::pair<uint64_t,uint64_t>>  sections; // tag => (offset,bytes)
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// true if off/idx encode a valid CSR relation: n_off-1 lists whose offsets start at
+// zero, never decrease and end at n_idx, and whose indices are all below max_index
+CINO_INLINE
+bool BIN_valid_csr(const unsigned int * off,
+                   const size_t         n_off,
+                   const unsigned int * idx,
+                   const size_t         n_idx,
+                   const size_t         max_index);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// reads vertices and polygons from a .cinobin file (other sections are ignored)
+CINO_INLINE
+void read_BIN(const char                     * filename,
+              std::vector<vec3d>             & verts,
+              std::vector<std::vector<unsigned int>> & polys);
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "read_BIN.cpp"
+#endif
+
+#endif // CINO_READ_BIN
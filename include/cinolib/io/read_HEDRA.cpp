@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_HEDRA.h>
+#include <cinolib/trace_profiler.h>
 #include <iostream>
 
 namespace cinolib
@@ -46,6 +47,7 @@ void read_HEDRA(const char                     * filename,
                 std::vector<std::vector<unsigned int>> & polys,
                 std::vector<std::vector<bool>> & polys_winding)
 {
+    CINO_PROFILE_ZONE("read_HEDRA");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     verts.clear();
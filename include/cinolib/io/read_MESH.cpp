@@ -36,6 +36,7 @@
 #include <cinolib/io/read_MESH.h>
 #include <cinolib/vector_serialization.h>
 #include <cinolib/io/io_utilities.h>
+#include <cinolib/trace_profiler.h>
 #include <iostream>
 #include <cassert>
 #include <unordered_set>
@@ -50,6 +51,7 @@ void read_MESH(const char                     * filename,
                std::vector<int>               & vert_labels,
                std::vector<int>               & poly_labels)
 {
+    CINO_PROFILE_ZONE("read_MESH");
     verts.clear();
     polys.clear();
     vert_labels.clear();
@@ -42,8 +42,11 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_OBJ.h>
+#include <cinolib/io/io_utilities.h>
 #include <cinolib/to_openGL_unified_verts.h>
 #include <cinolib/string_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/trace_profiler.h>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -56,16 +59,28 @@ namespace cinolib
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-// https://stackoverflow.com/questions/9310327/sscanf-optional-column
-//
+// parses a face corner in any of the forms v, v/vt, v//vn, v/vt/vn (same as
+// trying sscanf with formats "%d/%d/%d", "%d/%d", "%d//%d", "%d" in this order)
+// and converts ids to zero based. Missing (or unparsable) ids are set to -1
 CINO_INLINE
-void read_point_id(const char * s, int & v, int & vt, int & vn)
+static void read_point_id(const char * s, const char * end, int & v, int & vt, int & vn)
 {
     v = vt = vn = -1;
-         if(sscanf(s, "%d/%d/%d", &v, &vt, &vn) == 3) { --v; --vt; --vn; }
-    else if(sscanf(s, "%d/%d",    &v, &vt     ) == 2) { --v; --vt;       }
-    else if(sscanf(s, "%d//%d",   &v, &vn     ) == 2) { --v; --vn;       }
-    else if(sscanf(s, "%d",       &v          ) == 1) { --v;             }
+    int a, b, c;
+    if(s>=end || !eat_int(s,a)) return;
+    v = a-1;
+    if(s>=end || *s!='/') return;
+    ++s;
+    if(s<end && *s=='/')
+    {
+        ++s;
+        if(s<end && eat_int(s,c)) vn = c-1;
+    }
+    else if(s<end && eat_int(s,b))
+    {
+        vt = b-1;
+        if(s+1<end && *s=='/' && eat_int(++s,c)) vn = c-1;
+    }
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -132,6 +147,7 @@ void read_OBJ(const char                     * filename,
               std::string                    & specular_path, // path of the image encoding the specular texture component
               std::string                    & normal_path)   // path of the image encoding the normal   texture component
 {
+    CINO_PROFILE_ZONE("read_OBJ");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     pos.clear();
@@ -146,100 +162,195 @@ void read_OBJ(const char                     * filename,
     specular_path.clear();
     normal_path.clear();
 
-    std::ifstream f(filename);
-    if(!f.is_open())
+    std::vector<char> buffer;
+    if(!read_file_in_memory(filename, buffer))
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OBJ() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
-    int fresh_label = 0;
-    std::map<std::string,Color> color_map;
-    Color curr_color = Color::WHITE();     // set WHITE as default color
-    bool has_per_face_color = false;
-    bool has_groups         = false;
-
-    std::string line;
-    while(std::getline(f,line))
+    // The file is split in chunks of whole lines, which are parsed in parallel.
+    // Lines that change the parser state (materials and groups) are rare: they
+    // are just recorded, and replayed in order while merging the chunks
+    struct Chunk
     {
-        switch(line[0])
+        std::vector<vec3d>        pos, tex, nor;
+        std::vector<unsigned int> p_pos, p_tex, p_nor;             // concatenated polygons
+        std::vector<unsigned int> p_pos_end, p_tex_end, p_nor_end; // end of each polygon in the lists above
+        unsigned int              n_faces = 0;                     // number of 'f' lines
+        std::vector<std::pair<std::pair<unsigned int,unsigned int>,std::string>> events; // ((n_faces,#p_pos), line)
+    };
+    std::vector<size_t> bounds = split_in_line_chunks(buffer, 0, buffer.size()-1);
+    std::vector<Chunk>  chunks(bounds.size()-1);
+    PARALLEL_FOR(0, chunks.size(), 2, [&](const unsigned int cid)
+    {
+        Chunk & c = chunks.at(cid);
+        const char *s   = buffer.data() + bounds.at(cid);
+        const char *end = buffer.data() + bounds.at(cid+1);
+        while(s<end)
         {
-            case 'v':
+            switch(*s)
             {
-                // http://stackoverflow.com/questions/16839658/printf-width-specifier-to-maintain-precision-of-floating-point-value
-                //
-                double a, b, c;
-                     if(sscanf(line.data(), "v  %lf %lf %lf", &a, &b, &c) == 3) pos.push_back(vec3d{a,b,c});
-                else if(sscanf(line.data(), "vt %lf %lf %lf", &a, &b, &c) == 3) tex.push_back(vec3d{a,b,c});
-                else if(sscanf(line.data(), "vt %lf %lf %lf", &a, &b, &c) == 2) tex.push_back(vec3d{a,b,0});
-                else if(sscanf(line.data(), "vn %lf %lf %lf", &a, &b, &c) == 3) nor.push_back(vec3d{a,b,c});
-                break;
-            }
+                case 'v':
+                {
+                    // same as sscanf with "v  %lf %lf %lf", "vt %lf %lf %lf" and "vn %lf %lf %lf"
+                    double x[3];
+                    unsigned int n = 0;
+                    const char *p = (s[1]=='t' || s[1]=='n') ? s+2 : s+1;
+                    while(n<3 && eat_double(p, x[n])) ++n;
+                         if(s[1]!='t' && s[1]!='n' && n==3) c.pos.push_back(vec3d{x[0],x[1],x[2]});
+                    else if(s[1]=='t' && n==3)              c.tex.push_back(vec3d{x[0],x[1],x[2]});
+                    else if(s[1]=='t' && n==2)              c.tex.push_back(vec3d{x[0],x[1],0});
+                    else if(s[1]=='n' && n==3)              c.nor.push_back(vec3d{x[0],x[1],x[2]});
+                    break;
+                }
 
-            case 'f':
-            {
-                line = line.substr(1,line.size()-1); // discard the 'f' letter
-                std::istringstream ss(line);
-                std::vector<unsigned int> p_pos, p_tex, p_nor;
-                for(std::string sub_str; ss >> sub_str;)
+                case 'f':
                 {
-                    int v_pos, v_tex, v_nor;
-                    read_point_id(sub_str.c_str(), v_pos, v_tex, v_nor);
-                    if (v_pos >= 0) p_pos.push_back(v_pos);
-                    if (v_tex >= 0) p_tex.push_back(v_tex);
-                    if (v_nor >= 0) p_nor.push_back(v_nor);
+                    const char *p = s+1;
+                    unsigned int n_pos = c.p_pos.size();
+                    unsigned int n_tex = c.p_tex.size();
+                    unsigned int n_nor = c.p_nor.size();
+                    while(true)
+                    {
+                        eat_blanks(p);
+                        if(*p=='\n' || *p=='\0') break;
+                        const char *tok_end = p;
+                        while(*tok_end!='\n' && *tok_end!='\0' && !isspace(*tok_end)) ++tok_end;
+                        int v_pos, v_tex, v_nor;
+                        read_point_id(p, tok_end, v_pos, v_tex, v_nor);
+                        if (v_pos >= 0) c.p_pos.push_back(v_pos);
+                        if (v_tex >= 0) c.p_tex.push_back(v_tex);
+                        if (v_nor >= 0) c.p_nor.push_back(v_nor);
+                        p = tok_end;
+                    }
+                    if (c.p_tex.size() > n_tex) c.p_tex_end.push_back(c.p_tex.size());
+                    if (c.p_nor.size() > n_nor) c.p_nor_end.push_back(c.p_nor.size());
+                    if (c.p_pos.size() > n_pos) c.p_pos_end.push_back(c.p_pos.size());
+                    ++c.n_faces;
+                    break;
                 }
-                if (!p_tex.empty()) poly_tex.push_back(p_tex);
-                if (!p_nor.empty()) poly_nor.push_back(p_nor);
-                if (!p_pos.empty())
+
+                case 'u':
+                case 'm':
+                case 'g':
                 {
-                    poly_pos.push_back(p_pos);
-                    poly_col.push_back(curr_color);
+                    const char *p = s;
+                    c.events.push_back(std::make_pair(std::make_pair(c.n_faces, (unsigned int)c.p_pos_end.size()), eat_line(p)));
+                    break;
                 }
-                poly_lab.push_back(fresh_label);
-                break;
             }
+            const char *nl = static_cast<const char*>(memchr(s, '\n', end-s));
+            s = nl ? nl+1 : end;
+        }
+    });
 
-            case 'u':
+    // merge the chunks
+    size_t n_pos = 0, n_tex = 0, n_nor = 0, np_pos = 0, np_tex = 0, np_nor = 0;
+    std::vector<size_t> off_pos, off_tex, off_nor;
+    for(const Chunk & c : chunks)
+    {
+        off_pos.push_back(np_pos);
+        off_tex.push_back(np_tex);
+        off_nor.push_back(np_nor);
+        n_pos  += c.pos.size();
+        n_tex  += c.tex.size();
+        n_nor  += c.nor.size();
+        np_pos += c.p_pos_end.size();
+        np_tex += c.p_tex_end.size();
+        np_nor += c.p_nor_end.size();
+    }
+    pos.reserve(n_pos);
+    tex.reserve(n_tex);
+    nor.reserve(n_nor);
+    for(const Chunk & c : chunks)
+    {
+        pos.insert(pos.end(), c.pos.begin(), c.pos.end());
+        tex.insert(tex.end(), c.tex.begin(), c.tex.end());
+        nor.insert(nor.end(), c.nor.begin(), c.nor.end());
+    }
+    poly_pos.resize(np_pos);
+    poly_tex.resize(np_tex);
+    poly_nor.resize(np_nor);
+    PARALLEL_FOR(0, chunks.size(), 2, [&](const unsigned int cid)
+    {
+        auto unpack = [](const std::vector<unsigned int> & list, const std::vector<unsigned int> & ends, std::vector<unsigned int> * polys)
+        {
+            unsigned int beg = 0;
+            for(unsigned int i=0; i<ends.size(); ++i)
             {
-                char mat_c[1024];
-                if (sscanf(line.data(), "usemtl %s", mat_c) == 1)
+                polys[i].assign(list.begin()+beg, list.begin()+ends.at(i));
+                beg = ends.at(i);
+            }
+        };
+        const Chunk & c = chunks.at(cid);
+        unpack(c.p_pos, c.p_pos_end, poly_pos.data() + off_pos.at(cid));
+        unpack(c.p_tex, c.p_tex_end, poly_tex.data() + off_tex.at(cid));
+        unpack(c.p_nor, c.p_nor_end, poly_nor.data() + off_nor.at(cid));
+    });
+
+    // replay materials and groups, assigning colors and labels to faces
+    int fresh_label = 0;
+    std::map<std::string,Color> color_map;
+    Color curr_color = Color::WHITE();     // set WHITE as default color
+    bool has_per_face_color = false;
+    bool has_groups         = false;
+    poly_col.reserve(np_pos);
+    for(const Chunk & c : chunks)
+    {
+        unsigned int n_faces = 0;
+        unsigned int n_polys = 0;
+        for(const auto & e : c.events)
+        {
+            poly_lab.insert(poly_lab.end(), e.first.first -n_faces, fresh_label);
+            poly_col.insert(poly_col.end(), e.first.second-n_polys, curr_color);
+            n_faces = e.first.first;
+            n_polys = e.first.second;
+            const std::string & line = e.second;
+            switch(line[0])
+            {
+                case 'u':
                 {
-                    auto query = color_map.find(std::string(mat_c));
-                    if (query != color_map.end())
+                    char mat_c[1024];
+                    if (sscanf(line.data(), "usemtl %s", mat_c) == 1)
                     {
-                        curr_color = query->second;
+                        auto query = color_map.find(std::string(mat_c));
+                        if (query != color_map.end())
+                        {
+                            curr_color = query->second;
+                        }
+                        else std::cerr << "WARNING: could not find material: " << mat_c << std::endl;
                     }
-                    else std::cerr << "WARNING: could not find material: " << mat_c << std::endl;
+                    break;
                 }
-                break;
-            }
 
-            case 'm':
-            {
-                char mtu_c[1024];
-                if(sscanf(line.data(), "mtllib %[^\n]s", mtu_c) == 1)
+                case 'm':
                 {
-                    std::string s0(filename);
-                    std::string s1(mtu_c);
-                    std::string s2 = get_file_path(s0) + get_file_name(s1);
-                    if(read_MTU(s2.c_str(), color_map, diffuse_path, specular_path, normal_path))
+                    char mtu_c[1024];
+                    if(sscanf(line.data(), "mtllib %[^\n]s", mtu_c) == 1)
                     {
-                        has_per_face_color = true;
+                        std::string s0(filename);
+                        std::string s1(mtu_c);
+                        std::string s2 = get_file_path(s0) + get_file_name(s1);
+                        if(read_MTU(s2.c_str(), color_map, diffuse_path, specular_path, normal_path))
+                        {
+                            has_per_face_color = true;
+                        }
                     }
+                    break;
                 }
-                break;
-            }
 
-            case 'g':
-            {
-                has_groups = true;
-                fresh_label++;
-                break;
+                case 'g':
+                {
+                    has_groups = true;
+                    fresh_label++;
+                    break;
+                }
             }
         }
+        poly_lab.insert(poly_lab.end(), c.n_faces-n_faces, fresh_label);
+        poly_col.insert(poly_col.end(), c.p_pos_end.size()-n_polys, curr_color);
     }
-    f.close();
 
     if(!has_per_face_color) poly_col.clear();
     if(!has_groups)         poly_lab.clear();
@@ -34,10 +34,14 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_OFF.h>
+#include <cinolib/io/io_utilities.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/trace_profiler.h>
+#include <algorithm>
 #include <string>
-#include <sstream>
-#include <fstream>
+#include <string.h>
 #include <stdio.h>
+#include <thread>
 
 namespace cinolib
 {
@@ -59,71 +63,162 @@ void read_OFF(const char                     * filename,
               std::vector<std::vector<unsigned int>> & polys,
               std::vector<Color>             & poly_colors)
 {
+    CINO_PROFILE_ZONE("read_OFF");
     verts.clear();
     polys.clear();
     poly_colors.clear();
 
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
-    std::ifstream f(filename);
-    if(!f.is_open())
+    std::vector<char> buffer;
+    if(!read_file_in_memory(filename, buffer))
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : read_OFF() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
-    std::string line;
-    unsigned int        nv, np, ne;
+    const char  *s   = buffer.data();
+    const char  *eof = buffer.data() + buffer.size()-1;
+    std::string  line;
+    unsigned int nv, np, ne;
 
     // read header and number of elements
-    do getline(f, line, '\n'); while(line.find("OFF")==std::string::npos);
-    do getline(f, line, '\n'); while(sscanf(line.c_str(), "%d %d %d\n", &nv, &np, &ne)!=3);
+    do line = eat_line(s); while(line.find("OFF")==std::string::npos && s<eof);
+    do line = eat_line(s); while(sscanf(line.c_str(), "%d %d %d\n", &nv, &np, &ne)!=3 && s<eof);
 
-    // read verts
-    for(unsigned int i=0; i<nv; ++i)
+    // The body is split in chunks of whole lines, parsed in parallel. As in a
+    // serial read, lines that do not begin with three numbers are skipped, and
+    // the first nv valid lines are the vertices. Chunks are processed in waves,
+    // until the chunk containing the last vertex is found
+    std::vector<size_t> bounds = split_in_line_chunks(buffer, s-buffer.data(), buffer.size()-1);
+    std::vector<std::vector<vec3d>> chunk_verts(bounds.size()-1);
+    auto next_line = [&](const char * p, const char * end)
     {
-        getline(f, line, '\n');
-        std::stringstream ss(line);
-
-        double x, y, z;
-        if(ss >> x >> y >> z)
+        const char *nl = static_cast<const char*>(memchr(p, '\n', end-p));
+        return nl ? nl+1 : end;
+    };
+    unsigned int wave  = 2*std::max(1u, std::thread::hardware_concurrency());
+    unsigned int last  = chunk_verts.size(); // chunk containing the last vertex
+    size_t       count = 0;                  // valid lines in the chunks before it
+    for(unsigned int beg=0; nv>0 && last==chunk_verts.size() && beg<chunk_verts.size(); beg+=wave)
+    {
+        unsigned int end = std::min((unsigned int)chunk_verts.size(), beg+wave);
+        PARALLEL_FOR(beg, end, 2, [&](const unsigned int cid)
         {
-            verts.push_back(vec3d{x,y,z});
+            const char *p    = buffer.data() + bounds.at(cid);
+            const char *cend = buffer.data() + bounds.at(cid+1);
+            while(p<cend)
+            {
+                double x, y, z;
+                if(eat_double(p,x,false) && eat_double(p,y,false) && eat_double(p,z,false))
+                {
+                    chunk_verts.at(cid).push_back(vec3d{x,y,z});
+                }
+                p = next_line(p,cend);
+            }
+        });
+        for(unsigned int cid=beg; cid<end; ++cid)
+        {
+            if(count+chunk_verts.at(cid).size()>=nv)
+            {
+                last = cid;
+                break;
+            }
+            count += chunk_verts.at(cid).size();
         }
-        else --i;
     }
 
-    // read polys
-    for(unsigned int i=0; i<np; ++i)
+    verts.reserve(nv);
+    for(unsigned int cid=0; cid<chunk_verts.size() && cid<=last && verts.size()<nv; ++cid)
     {
-        getline(f, line, '\n');
-        std::stringstream ss(line);
+        size_t n = std::min(chunk_verts.at(cid).size(), nv-verts.size());
+        verts.insert(verts.end(), chunk_verts.at(cid).begin(), chunk_verts.at(cid).begin()+n);
+    }
+
+    // polygons begin right after the line of the last vertex
+    if(last<chunk_verts.size())
+    {
+        s = buffer.data() + bounds.at(last);
+        for(size_t n=nv-count; n>0; s=next_line(s,eof))
+        {
+            const char *p = s;
+            double x;
+            if(eat_double(p,x,false) && eat_double(p,x,false) && eat_double(p,x,false)) --n;
+        }
+    }
+    else if(nv>0) s = eof;
+    std::vector<std::vector<vec3d>>().swap(chunk_verts);
 
-        unsigned int n_corners;
-        if(ss >> n_corners)
+    // read polys (lines that do not begin with a number are skipped)
+    struct Chunk
+    {
+        std::vector<unsigned int> vids;
+        std::vector<unsigned int> ends;      // end of each polygon in vids
+        std::vector<Color>        colors;
+        std::vector<unsigned int> color_pid; // local index of the polygon of each color
+    };
+    bounds = split_in_line_chunks(buffer, s-buffer.data(), buffer.size()-1);
+    std::vector<Chunk> chunks(bounds.size()-1);
+    PARALLEL_FOR(0, chunks.size(), 2, [&](const unsigned int cid)
+    {
+        Chunk & c = chunks.at(cid);
+        const char *p    = buffer.data() + bounds.at(cid);
+        const char *cend = buffer.data() + bounds.at(cid+1);
+        while(p<cend)
         {
-            unsigned int vid;
-            std::vector<unsigned int> p;
-            for(unsigned int j=0; j<n_corners; ++j)
+            unsigned int n_corners;
+            if(eat_uint(p, n_corners))
             {
-                ss >> vid;
-                p.push_back(vid);
-            }
-            polys.push_back(p);
+                // as with C++ streams, after the first failed read all
+                // subsequent ids are zero, and no attributes are read
+                bool ok = true;
+                for(unsigned int j=0; j<n_corners; ++j)
+                {
+                    unsigned int vid = 0;
+                    if(ok) ok = eat_uint(p, vid);
+                    c.vids.push_back(ok ? vid : 0);
+                }
+                c.ends.push_back(c.vids.size());
 
-            float val;
-            std::vector<float> attr;
-            while(ss >> val) attr.push_back(val);
+                float val;
+                std::vector<float> attr;
+                while(ok && eat_float(p,val)) attr.push_back(val);
 
-            switch(attr.size())
-            {
-                case 1 : break; // TODO: READ LABEL (cast to int)!!!
-                case 3 : poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2))); break;
-                case 4 : poly_colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2), attr.at(3))); break;
-                default: break;
+                switch(attr.size())
+                {
+                    case 1 : break; // TODO: READ LABEL (cast to int)!!!
+                    case 3 : c.colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2)));               c.color_pid.push_back(c.ends.size()-1); break;
+                    case 4 : c.colors.push_back(Color(attr.at(0), attr.at(1), attr.at(2), attr.at(3)));   c.color_pid.push_back(c.ends.size()-1); break;
+                    default: break;
+                }
             }
+            p = next_line(p,cend);
+        }
+    });
+
+    // merge chunks, up to np polygons
+    std::vector<size_t> offset(chunks.size()+1,0);
+    for(unsigned int cid=0; cid<chunks.size(); ++cid)
+    {
+        offset.at(cid+1) = std::min((size_t)np, offset.at(cid)+chunks.at(cid).ends.size());
+    }
+    polys.resize(offset.back());
+    PARALLEL_FOR(0, chunks.size(), 2, [&](const unsigned int cid)
+    {
+        const Chunk & c = chunks.at(cid);
+        unsigned int beg = 0;
+        for(size_t i=0; i<offset.at(cid+1)-offset.at(cid); ++i)
+        {
+            polys.at(offset.at(cid)+i).assign(c.vids.begin()+beg, c.vids.begin()+c.ends.at(i));
+            beg = c.ends.at(i);
+        }
+    });
+    for(unsigned int cid=0; cid<chunks.size(); ++cid)
+    {
+        for(unsigned int i=0; i<chunks.at(cid).colors.size(); ++i)
+        {
+            if(offset.at(cid)+chunks.at(cid).color_pid.at(i) < offset.at(cid+1)) poly_colors.push_back(chunks.at(cid).colors.at(i));
         }
-        else --i;
     }
 }
 
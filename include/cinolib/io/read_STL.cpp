@@ -43,7 +43,13 @@
 *********************************************************************************/
 #include <cinolib/io/read_STL.h>
 #include <cinolib/io/io_utilities.h>
-#include <map>
+#include <cinolib/vertex_welder.h>
+#include <cinolib/trace_profiler.h>
+#include <fstream>
+#include <string.h>
+#include <ctype.h>
+#include <algorithm>
+#include <cstdint>
 #include <cassert>
 
 namespace cinolib
@@ -68,135 +74,186 @@ void read_STL(const char         * filename,
               std::vector<unsigned int>  & tris,
               const bool           merge_duplicated_verts)
 {
-    // https://en.wikipedia.org/wiki/STL_(file_format)
-
+    CINO_PROFILE_ZONE("read_STL");
     verts.clear();
     normals.clear();
     tris.clear();
 
+    VertexWelder welder;
+    stream_STL(filename, [&](const std::vector<vec3d> & tri_verts, const std::vector<vec3d> & tri_normals)
+    {
+        normals.insert(normals.end(), tri_normals.begin(), tri_normals.end());
+        for(const vec3d & v : tri_verts)
+        {
+            if(merge_duplicated_verts)
+            {
+                tris.push_back(welder.weld(v));
+            }
+            else
+            {
+                tris.push_back(verts.size());
+                verts.push_back(v);
+            }
+        }
+    });
+    if(merge_duplicated_verts) verts = welder.verts();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+size_t stream_STL(const char               * filename,
+                  const STL_batch_callback & callback,
+                  const unsigned int         batch_size)
+{
+    // https://en.wikipedia.org/wiki/STL_(file_format)
+
+    assert(batch_size>0);
+
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
-    FILE *fp = fopen(filename, "r");
+    FILE *fp = fopen(filename, "rb");
     if(!fp)
     {
         std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
         exit(-1);
     }
 
-    std::map<vec3d,unsigned int> vmap;
+    std::vector<vec3d> tri_verts;
+    std::vector<vec3d> tri_normals;
+    tri_verts.reserve(3*batch_size);
+    tri_normals.reserve(batch_size);
+    size_t count = 0;
+
+    auto flush = [&]()
+    {
+        if(tri_normals.empty()) return;
+        callback(tri_verts, tri_normals);
+        count += tri_normals.size();
+        tri_verts.clear();
+        tri_normals.clear();
+    };
 
-    /* This is a horrible trick to cope with the fact that in Thingi10K
-     * binary files start with the header of ASCII files even if they shouldn't.
-     * As a result it becomes messy to figure out whether a file is binary or not.
-     * I assume it is, then I try to parse it as if it was ASCII first, and if I fail
-     * then I know that is indeed binary.
+    /* A binary file is 84 bytes of header plus 50 bytes per triangle, hence
+     * if the size matches the triangle count stored in the header there is
+     * no need to look any further. Otherwise, to cope with the fact that in
+     * Thingi10K binary files start with the header of ASCII files even if they
+     * shouldn't, I try to parse the file as if it was ASCII first, and if I
+     * find no facet then I know that is indeed binary.
     */
-    bool is_binary = true;
+    unsigned char header[84];
+    bool has_header = (fread(header, 1, 84, fp)==84);
+    uint32_t nt = 0;
+    if(has_header) memcpy(&nt, header+80, sizeof(uint32_t));
+    std::ifstream f(filename, std::ios::binary | std::ios::ate);
+    bool is_binary = has_header && (uint64_t(f.tellg()) == 84 + 50*uint64_t(nt));
+    f.close();
 
-    if(seek_keyword(fp, "solid")) // ASCII file
+    if(!is_binary)
     {
-        while(seek_keyword(fp, "facet"))
-        {
-            is_binary = false;
-
-            vec3d n;
-            if(!seek_keyword(fp, "normal")) assert(false && "could not find keyword NORMAL");
-            if(!eat_double(fp, n.x()))      assert(false && "could not parse x coord");
-            if(!eat_double(fp, n.y()))      assert(false && "could not parse y coord");
-            if(!eat_double(fp, n.z()))      assert(false && "could not parse z coord");
-            normals.push_back(n);
+        rewind(fp);
 
-            if(!seek_keyword(fp, "outer")) assert(false && "could not find keyword OUTER");
-            if(!seek_keyword(fp, "loop"))  assert(false && "could not find keyword LOOP");
+        // whitespace separated tokens, read in blocks of constant size
+        std::vector<char> buf(1<<20);
+        size_t beg = 0, end = 0;
+        auto next_token = [&](std::string & tok) -> bool
+        {
+            tok.clear();
+            for(;;)
+            {
+                while(beg<end && isspace((unsigned char)buf[beg])) ++beg;
+                if(beg<end) break;
+                beg = 0;
+                end = fread(buf.data(), 1, buf.size(), fp);
+                if(end==0) return false;
+            }
+            for(;;)
+            {
+                size_t i = beg;
+                while(i<end && !isspace((unsigned char)buf[i])) ++i;
+                tok.append(buf.data()+beg, i-beg);
+                beg = i;
+                if(beg<end) return true;
+                beg = 0;
+                end = fread(buf.data(), 1, buf.size(), fp);
+                if(end==0) return true;
+            }
+        };
+        std::string tok;
+        auto seek_token = [&](const char * keyword) -> bool
+        {
+            while(next_token(tok)) if(tok==keyword) return true;
+            return false;
+        };
+        auto read_vec3d = [&](vec3d & p)
+        {
             for(int i=0; i<3; ++i)
             {
-                vec3d v;
-                if(!seek_keyword(fp, "vertex")) assert(false && "could not find keyword VERTEX");
-                if(!eat_double(fp, v.x()))      assert(false && "could not parse x coord");
-                if(!eat_double(fp, v.y()))      assert(false && "could not parse y coord");
-                if(!eat_double(fp, v.z()))      assert(false && "could not parse z coord");
+                if(!next_token(tok)) assert(false && "could not parse coordinate");
+                const char *s = tok.c_str();
+                if(!eat_double(s, p[i])) assert(false && "could not parse coordinate");
+            }
+        };
 
-                if(merge_duplicated_verts)
-                {
-                    auto it = vmap.find(v);
-                    if(it == vmap.end())
-                    {
-                        unsigned int fresh_id = vmap.size();
-                        vmap[v] = fresh_id;
-                        verts.push_back(v);
-                        tris.push_back(fresh_id);
-                    }
-                    else tris.push_back(it->second);
-                }
-                else
+        bool found_facet = false;
+        if(seek_token("solid"))
+        {
+            while(seek_token("facet"))
+            {
+                found_facet = true;
+
+                vec3d n;
+                if(!seek_token("normal")) assert(false && "could not find keyword NORMAL");
+                read_vec3d(n);
+                tri_normals.push_back(n);
+
+                if(!seek_token("outer")) assert(false && "could not find keyword OUTER");
+                if(!seek_token("loop"))  assert(false && "could not find keyword LOOP");
+                for(int i=0; i<3; ++i)
                 {
-                    tris.push_back(verts.size());
-                    verts.push_back(v);
+                    vec3d v;
+                    if(!seek_token("vertex")) assert(false && "could not find keyword VERTEX");
+                    read_vec3d(v);
+                    tri_verts.push_back(v);
                 }
+                if(!seek_token("endloop"))  assert(false && "could not find keyword ENDLOOP");
+                if(!seek_token("endfacet")) assert(false && "could not find keyword ENDFACET");
+
+                if(tri_normals.size()==batch_size) flush();
             }
-            if(!seek_keyword(fp, "endloop"))  assert(false && "could not find keyword ENDLOOP");
-            if(!seek_keyword(fp, "endfacet")) assert(false && "could not find keyword ENDFACET");
         }
+        flush();
+        is_binary = !found_facet && has_header;
+        if(is_binary) fseek(fp, 84, SEEK_SET);
     }
-    fclose(fp);
 
     if(is_binary)
     {
-        // open the file in binary mode
-        FILE *fp = fopen(filename, "rb");
-        if(!fp)
+        // triangles are 50 bytes each: normal (3 floats), verts (9 floats), attribute (uint16)
+        std::vector<unsigned char> buf(50*size_t(batch_size));
+        for(uint32_t i=0; i<nt;)
         {
-            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : couldn't open input file " << filename << std::endl;
-            exit(-1);
-        }
-
-        // read header
-        char header[80];
-        if(fread(header, 1, 80, fp)!=80) assert(false && "error reading STL binary header");
-
-        // read triangles
-        unsigned int nt;
-        if(fread(&nt, sizeof(unsigned int), 1, fp)!=1) assert(false && "error reading number of triangles");
-        for(unsigned int i=0; i<nt; ++i)
-        {
-            // read normal
-            float nf[3];
-            if(fread(&nf, sizeof(float), 3, fp)!=3) assert(false && "error reading normal");
-            vec3d n{nf[0], nf[1], nf[2]};
-            normals.push_back(n);
-
-            // read verts
-            for(int j=0; j<3; ++j)
+            uint32_t n = std::min(nt-i, batch_size);
+            if(fread(buf.data(), 50, n, fp)!=n)
             {
-                float vf[3];
-                if(fread(&vf, sizeof(float), 3, fp)!=3) assert(false && "error reading vertex");
-
-                vec3d v{vf[0], vf[1], vf[2]};                
-                if(merge_duplicated_verts)
-                {
-                    auto it = vmap.find(v);
-                    if(it == vmap.end())
-                    {
-                        unsigned int fresh_id = vmap.size();
-                        vmap[v] = fresh_id;
-                        verts.push_back(v);
-                        tris.push_back(fresh_id);
-                    }
-                    else tris.push_back(it->second);
-                }
-                else
-                {
-                    tris.push_back(verts.size());
-                    verts.push_back(v);
-                }
+                std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_STL() : truncated binary file " << filename << std::endl;
+                break;
             }
-
-            // read (and discard) attribute
-            unsigned short attribute;
-            if(fread(&attribute, sizeof(unsigned short), 1, fp)!=1) assert(false && "error reading attribute");
+            for(uint32_t j=0; j<n; ++j)
+            {
+                float f[12];
+                memcpy(f, buf.data()+50*j, 12*sizeof(float));
+                tri_normals.push_back(vec3d{f[0], f[1],  f[2]});
+                tri_verts.push_back  (vec3d{f[3], f[4],  f[5]});
+                tri_verts.push_back  (vec3d{f[6], f[7],  f[8]});
+                tri_verts.push_back  (vec3d{f[9], f[10], f[11]});
+            }
+            flush();
+            i += n;
         }
-        fclose(fp);
     }
+    fclose(fp);
+    return count;
 }
 
 }
@@ -37,6 +37,7 @@
 #define CINO_READ_STL_H
 
 #include <vector>
+#include <functional>
 #include <cinolib/geometry/vec_mat.h>
 
 namespace cinolib
@@ -56,6 +57,23 @@ void read_STL(const char         * filename,
               std::vector<vec3d> & normals,
               std::vector<unsigned int>  & tris,
               const bool           merge_duplicated_verts = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Streaming (out-of-core) STL reader. Triangles are parsed in batches of at
+ * most batch_size elements and handed to the callback, which receives three
+ * vertices and one normal per triangle. Memory is bounded by the batch size,
+ * regardless of the file size. Binary and ASCII files are both supported and
+ * automatically detected. Returns the total number of triangles read.
+*/
+
+typedef std::function<void(const std::vector<vec3d> & tri_verts,
+                           const std::vector<vec3d> & tri_normals)> STL_batch_callback;
+
+CINO_INLINE
+size_t stream_STL(const char               * filename,
+                  const STL_batch_callback & callback,
+                  const unsigned int         batch_size = 65536);
 }
 
 #ifndef  CINO_STATIC_LIB
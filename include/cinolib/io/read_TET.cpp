@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_TET.h>
+#include <cinolib/trace_profiler.h>
 #include <iostream>
 
 namespace cinolib
@@ -44,6 +45,7 @@ void read_TET(const char          * filename,
               std::vector<double> & xyz,
               std::vector<unsigned int>  & tets)
 {
+    CINO_PROFILE_ZONE("read_TET");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     FILE *fp = fopen(filename, "r");
@@ -100,6 +102,7 @@ void read_TET(const char                     * filename,
               std::vector<vec3d>             & verts,
               std::vector<std::vector<unsigned int>> & polys)
 {
+    CINO_PROFILE_ZONE("read_TET");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     FILE *fp = fopen(filename, "r");
@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTK.h>
+#include <cinolib/trace_profiler.h>
 #include <iostream>
 
 #ifdef CINOLIB_USES_VTK
@@ -53,6 +54,7 @@ void read_VTK(const char                      * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<unsigned int>> & poly)
 {
+    CINO_PROFILE_ZONE("read_VTK");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
@@ -90,6 +92,7 @@ void read_VTK(const char                      * filename,
                std::vector<double>            & xyz,
                std::vector<std::vector<unsigned int>> & poly)
 {
+    CINO_PROFILE_ZONE("read_VTK");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
@@ -130,6 +133,7 @@ void read_VTK(const char          * filename,
                std::vector<unsigned int>  & tets,
                std::vector<unsigned int>  & hexa)
 {
+    CINO_PROFILE_ZONE("read_VTK");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     vtkSmartPointer<vtkGenericDataObjectReader> reader = vtkSmartPointer<vtkGenericDataObjectReader>::New();
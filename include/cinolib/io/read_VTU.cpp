@@ -34,6 +34,7 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/read_VTU.h>
+#include <cinolib/trace_profiler.h>
 #include <iostream>
 
 #ifdef CINOLIB_USES_VTK
@@ -53,6 +54,7 @@ void read_VTU(const char                      * filename,
                std::vector<vec3d>             & verts,
                std::vector<std::vector<unsigned int>> & poly)
 {
+    CINO_PROFILE_ZONE("read_VTU");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
@@ -90,6 +92,7 @@ void read_VTU(const char                      * filename,
                std::vector<double>            & xyz,
                std::vector<std::vector<unsigned int>> & poly)
 {
+    CINO_PROFILE_ZONE("read_VTU");
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
     vtkSmartPointer<vtkXMLUnstructuredGridReader> reader = vtkSmartPointer<vtkXMLUnstructuredGridReader>::New();
@@ -130,6 +133,7 @@ void read_VTU(const char           * filename,
                std::vector<unsigned int>   & tets,
                std::vector<unsigned int>   & hexa)
 {
+    CINO_PROFILE_ZONE("read_VTU");
 
     setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
 
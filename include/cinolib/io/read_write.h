@@ -41,10 +41,12 @@
 #include <cinolib/io/read_OFF.h>
 #include <cinolib/io/read_IV.h>
 #include <cinolib/io/read_STL.h>
+#include <cinolib/io/read_BIN.h>
 // SURFACE WRITERS
 #include <cinolib/io/write_OBJ.h>
 #include <cinolib/io/write_OFF.h>
 #include <cinolib/io/write_STL.h>
+#include <cinolib/io/write_BIN.h>
 #include <cinolib/io/write_NODE_ELE.h>
 
 
@@ -0,0 +1,123 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/io/write_BIN.h>
+#include <iostream>
+#include <cassert>
+#include <stdio.h>
+
+namespace cinolib
+{
+
+CINO_INLINE
+void write_BIN(const char                    * filename,
+               const std::vector<BINSection> & sections)
+{
+    FILE *fp = fopen(filename, "wb");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_BIN() : couldn't save file " << filename << std::endl;
+        exit(-1);
+    }
+
+    auto align = [](const uint64_t off) { return (off + BIN_alignment - 1) / BIN_alignment * BIN_alignment; };
+
+    BINHeader header;
+    memset(&header, 0, sizeof(BINHeader));
+    strcpy(header.magic, "CINOBIN");
+    header.version      = BIN_version;
+    header.byte_order   = BIN_byte_order;
+    header.num_sections = sections.size();
+
+    std::vector<BINSectionEntry> toc(sections.size());
+    uint64_t offset = align(sizeof(BINHeader) + sections.size()*sizeof(BINSectionEntry));
+    for(size_t i=0; i<sections.size(); ++i)
+    {
+        assert(sections.at(i).tag.size() < sizeof(toc.at(i).tag));
+        memset(toc.at(i).tag, 0, sizeof(toc.at(i).tag));
+        strncpy(toc.at(i).tag, sections.at(i).tag.c_str(), sizeof(toc.at(i).tag)-1);
+        toc.at(i).offset = offset;
+        toc.at(i).bytes  = sections.at(i).bytes;
+        offset = align(offset + sections.at(i).bytes);
+    }
+
+    static const char zeros[BIN_alignment] = {};
+    uint64_t written = 0;
+    auto write = [&](const void * data, const uint64_t bytes)
+    {
+        if(bytes>0 && fwrite(data, 1, bytes, fp)!=bytes)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_BIN() : failed writing " << filename << std::endl;
+            exit(-1);
+        }
+        written += bytes;
+    };
+    auto pad = [&]() { write(zeros, align(written)-written); };
+
+    write(&header, sizeof(BINHeader));
+    if(!toc.empty()) write(toc.data(), toc.size()*sizeof(BINSectionEntry));
+    for(const BINSection & s : sections)
+    {
+        pad();
+        write(s.data, s.bytes);
+    }
+    fclose(fp);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void write_BIN(const char                             * filename,
+               const std::vector<vec3d>               & verts,
+               const std::vector<std::vector<unsigned int>> & polys)
+{
+    std::vector<unsigned int> poly_offsets(1,0);
+    std::vector<unsigned int> poly_verts;
+    poly_offsets.reserve(polys.size()+1);
+    for(const auto & p : polys)
+    {
+        poly_verts.insert(poly_verts.end(), p.begin(), p.end());
+        poly_offsets.push_back(poly_verts.size());
+    }
+
+    write_BIN(filename,
+    {
+        { "verts",        verts.data(),        verts.size()*sizeof(vec3d)               },
+        { "poly_offsets", poly_offsets.data(), poly_offsets.size()*sizeof(unsigned int) },
+        { "poly_verts",   poly_verts.data(),   poly_verts.size()*sizeof(unsigned int)   },
+    });
+}
+
+}
@@ -33,7 +33,10 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/io/write_STL.h>
+#include <cinolib/io/write_STL.h>
 #include <iostream>
+#include <cstring>
+#include <cassert>
 
 namespace cinolib
 {
@@ -68,4 +71,110 @@ void write_STL(const char                           * filename,
     fclose(fp);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+STLWriter::STLWriter(const char * filename, const bool binary) : binary(binary)
+{
+    setlocale(LC_NUMERIC, "en_US.UTF-8"); // makes sure "." is the decimal separator
+
+    fp = fopen(filename, binary ? "wb" : "w");
+    if(!fp)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_STL() : couldn't save file " << filename << std::endl;
+        exit(-1);
+    }
+
+    if(binary)
+    {
+        // the triangle count is written when the file is closed
+        char header[84];
+        memset(header, 0, 84);
+        snprintf(header, 80, "binary STL written by cinolib");
+        fwrite(header, 1, 84, fp);
+    }
+    else fprintf(fp, "solid cinolib_mesh\n");
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+STLWriter::~STLWriter()
+{
+    close();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void STLWriter::write(const vec3d & v0, const vec3d & v1, const vec3d & v2)
+{
+    vec3d n = (v1-v0).cross(v2-v0);
+    if(n.norm()>0) n.normalize();
+    write(v0, v1, v2, n);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void STLWriter::write(const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & n)
+{
+    assert(fp);
+    if(binary)
+    {
+        float f[12] = { float(n[0]),  float(n[1]),  float(n[2]),
+                        float(v0[0]), float(v0[1]), float(v0[2]),
+                        float(v1[0]), float(v1[1]), float(v1[2]),
+                        float(v2[0]), float(v2[1]), float(v2[2]) };
+        unsigned char rec[50];
+        memcpy(rec, f, 12*sizeof(float));
+        rec[48] = rec[49] = 0; // attribute byte count
+        fwrite(rec, 1, 50, fp);
+    }
+    else
+    {
+        fprintf(fp, "facet normal %f %f %f\n", n[0], n[1], n[2]);
+        fprintf(fp, "  outer loop\n");
+        fprintf(fp, "    vertex %f %f %f\n", v0[0], v0[1], v0[2]);
+        fprintf(fp, "    vertex %f %f %f\n", v1[0], v1[1], v1[2]);
+        fprintf(fp, "    vertex %f %f %f\n", v2[0], v2[1], v2[2]);
+        fprintf(fp, "  endloop\n");
+        fprintf(fp, "endfacet\n");
+    }
+    ++nt;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void STLWriter::write(const std::vector<vec3d> & tri_verts, const std::vector<vec3d> & tri_normals)
+{
+    assert(tri_verts.size()==3*tri_normals.size());
+    for(size_t i=0; i<tri_normals.size(); ++i)
+    {
+        write(tri_verts.at(3*i), tri_verts.at(3*i+1), tri_verts.at(3*i+2), tri_normals.at(i));
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void STLWriter::close()
+{
+    if(!fp) return;
+    if(binary)
+    {
+        if(nt>UINT32_MAX)
+        {
+            std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : save_STL() : too many triangles for a binary STL (" << nt << ")" << std::endl;
+        }
+        uint32_t count = uint32_t(nt);
+        fseek(fp, 80, SEEK_SET);
+        fwrite(&count, sizeof(uint32_t), 1, fp);
+    }
+    else fprintf(fp, "endsolid cinolib_mesh\n");
+    fclose(fp);
+    fp = nullptr;
+}
+
 }
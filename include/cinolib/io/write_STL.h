@@ -36,7 +36,10 @@
 #define CINO_WRITE_STL_H
 
 #include <vector>
+#include <cstdio>
+#include <cstdint>
 #include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
 
 namespace cinolib
 {
@@ -46,6 +49,36 @@ void write_STL(const char                           * filename,
                const std::vector<double>            & xyz,
                const std::vector<std::vector<unsigned int>> & poly,
                const std::vector<double>            & normals);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Streaming (out-of-core) STL writer. Triangles are appended to the file as
+ * they come, so that arbitrarily large meshes can be written (e.g. while
+ * streaming another STL with stream_STL) without ever storing them. In
+ * binary mode the triangle count is patched in the header when the writer
+ * is closed. If no normal is provided it is computed from the vertices.
+*/
+
+class STLWriter
+{
+    public:
+
+        explicit STLWriter(const char * filename, const bool binary = true);
+        ~STLWriter();
+
+        void write(const vec3d & v0, const vec3d & v1, const vec3d & v2);
+        void write(const vec3d & v0, const vec3d & v1, const vec3d & v2, const vec3d & n);
+        void write(const std::vector<vec3d> & tri_verts, const std::vector<vec3d> & tri_normals);
+        void close();
+
+        uint64_t num_triangles() const { return nt; }
+
+    protected:
+
+        FILE    *fp = nullptr;
+        bool     binary;
+        uint64_t nt = 0;
+};
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -35,6 +35,10 @@
 *********************************************************************************/
 #include <cinolib/linear_solvers.h>
 #include <cinolib/stl_container_utilities.h>
+#include <cinolib/trace_profiler.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <type_traits>
 
 namespace cinolib
 {
@@ -51,48 +55,9 @@ void solve_square_system(const Eigen::SparseMatrix<double> & A,
 {
     assert(A.rows() == A.cols());
 
-    switch (solver)
-    {
-        case SIMPLICIAL_LLT:
-        {
-            Eigen::SimplicialLLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
-            break;
-        }
-
-        case SIMPLICIAL_LDLT:
-        {
-            Eigen::SimplicialLDLT< Eigen::SparseMatrix<double> > solver(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
-            break;
-        }
-
-        case BiCGSTAB:
-        {
-            Eigen::BiCGSTAB< Eigen::SparseMatrix<double> , Eigen::IncompleteLUT<double> > solver;
-            //solver.setMaxIterations(100);
-            solver.setTolerance(1e-5);
-            solver.compute(A);
-            assert(solver.info() == Eigen::Success);
-            x = solver.solve(b).eval();
-            break;
-        }
-
-        case SparseLU:
-        {
-            Eigen::SparseMatrix<double> Ac = A;
-            Ac.makeCompressed();
-            Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > solver;
-            solver.analyzePattern(Ac);
-            solver.factorize(Ac);
-            x = solver.solve(b);
-            break;
-        }
-
-        default: assert(false && "Unknown Solver");
-    }
+    LinearSystemSolver s(A, solver);
+    assert(s.is_factorized());
+    s.solve(b, x);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -104,73 +69,13 @@ void solve_square_system_with_bc(const Eigen::SparseMatrix<double> & A,
                                  const std::map<unsigned int,double>       & bc, // Dirichlet boundary conditions
                                  int   solver)
 {
-    std::vector<int> col_map(A.rows(), -1);
-    unsigned int fresh_id = 0;
-    for(unsigned int col=0; col<A.cols(); ++col)
-    {
-        if (DOES_NOT_CONTAIN(bc, col))
-        {
-            col_map[col] = fresh_id++;
-        }
-    }
-
-    unsigned int size = A.rows() - bc.size();
-
-    std::vector<Entry> Aprime_entries;
-    Eigen::VectorXd    bprime(size);
+    std::vector<unsigned int> dirichlet_dofs;
+    dirichlet_dofs.reserve(bc.size());
+    for(auto obj : bc) dirichlet_dofs.push_back(obj.first);
 
-    for(unsigned int row=0; row<A.rows(); ++row)
-    {
-        if (col_map[row] >= 0)
-        {
-            bprime[ col_map[row] ] = b[row];
-        }
-    }
-
-    //
-    // iterate over the non-zero entries
-    // of sparse matrix A
-    //
-    for (unsigned int i=0; i<A.outerSize(); ++i)
-    {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it)
-        {
-            unsigned int    row = it.row();
-            unsigned int    col = it.col();
-            double val = it.value();
-
-            if (col_map[row] < 0) continue;
-
-            if (col_map[col] < 0)
-            {
-                bprime[ col_map[row] ] -= bc.at(col) * val;
-            }
-            else
-            {
-                Aprime_entries.push_back(Entry(col_map[row], col_map[col], val));
-            }
-        }
-    }
-
-    Eigen::SparseMatrix<double> Aprime(size, size);
-    Aprime.setFromTriplets(Aprime_entries.begin(), Aprime_entries.end());
-
-    Eigen::VectorXd tmp_x(size);
-
-    solve_square_system(Aprime, bprime, tmp_x, solver);
-
-    x.resize(A.cols());
-    for(unsigned int col=0; col<A.cols(); ++col)
-    {
-        if (col_map[col] >= 0)
-        {
-            x[col] = tmp_x[ col_map[col] ];
-        }
-        else
-        {
-            x[col] = bc.at(col);
-        }
-    }
+    LinearSystemSolver s(A, dirichlet_dofs, solver);
+    assert(s.is_factorized());
+    s.solve(b, x, bc);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -237,6 +142,415 @@ void solve_weighted_least_squares_with_bc(const Eigen::SparseMatrix<double> & A,
     solve_square_system_with_bc(AtWA, AtWb, x, bc, solver);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+LinearSystemSolver::LinearSystemSolver(const int solver) : solver(solver)
+{
+    assert(solver == SIMPLICIAL_LLT || solver == SIMPLICIAL_LDLT || solver == SparseLU || solver == BiCGSTAB);
+    //bicgstab.setMaxIterations(100);
+    bicgstab.setTolerance(1e-5);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+LinearSystemSolver::LinearSystemSolver(const Eigen::SparseMatrix<double> & A,
+                                       const int                           solver)
+: LinearSystemSolver(solver)
+{
+    compute(A);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+CINO_INLINE
+LinearSystemSolver::LinearSystemSolver(const Eigen::SparseMatrix<double> & A,
+                                       const std::vector<unsigned int>   & dirichlet_dofs,
+                                       const int                           solver)
+: LinearSystemSolver(solver)
+{
+    compute(A, dirichlet_dofs);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSystemSolver::clear()
+{
+    analyzed   = false;
+    factorized = false;
+    n          = 0;
+    bc_dofs.clear();
+    dof_map.clear();
+    free_dofs.clear();
+    A_ff.resize(0,0);
+    A_fb.resize(0,0);
+    pattern_outer.clear();
+    pattern_inner.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSystemSolver::analyze_pattern(const Eigen::SparseMatrix<double> & A,
+                                         const std::vector<unsigned int>   & dirichlet_dofs)
+{
+    CINO_PROFILE_ZONE("LinearSystemSolver::analyze_pattern");
+    assert(A.rows() == A.cols());
+
+    clear();
+    n = A.rows();
+
+    bc_dofs = dirichlet_dofs;
+    std::sort(bc_dofs.begin(), bc_dofs.end());
+    bc_dofs.erase(std::unique(bc_dofs.begin(), bc_dofs.end()), bc_dofs.end());
+
+    // free dofs are mapped to [0,#free), Dirichlet dofs to [-1,-#bc]
+    dof_map.resize(n, 0);
+    for(unsigned int i=0; i<bc_dofs.size(); ++i)
+    {
+        assert(bc_dofs.at(i) < n);
+        dof_map.at(bc_dofs.at(i)) = -int(i+1);
+    }
+    for(unsigned int dof=0; dof<n; ++dof)
+    {
+        if(dof_map.at(dof) < 0) continue;
+        dof_map.at(dof) = free_dofs.size();
+        free_dofs.push_back(dof);
+    }
+
+    split(A);
+    symbolic();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::factorize(const Eigen::SparseMatrix<double> & A)
+{
+    CINO_PROFILE_ZONE("LinearSystemSolver::factorize");
+    if(!analyzed)
+    {
+        analyze_pattern(A);
+    }
+    else if(A.rows()!=n)
+    {
+        // the size changed: keep the Dirichlet dofs, if they still fit the new matrix
+        if(!bc_dofs.empty() && bc_dofs.back()>=A.rows())
+        {
+            factorized = false;
+            return false;
+        }
+        std::vector<unsigned int> dofs = bc_dofs;
+        analyze_pattern(A, dofs);
+    }
+    else
+    {
+        split(A);
+        bool same_pattern = A_ff.nonZeros() == (int)pattern_inner.size() &&
+                            std::equal(pattern_outer.begin(), pattern_outer.end(), A_ff.outerIndexPtr()) &&
+                            std::equal(pattern_inner.begin(), pattern_inner.end(), A_ff.innerIndexPtr());
+        if(!same_pattern) symbolic();
+    }
+
+    switch(solver)
+    {
+        case SIMPLICIAL_LLT:  llt.factorize(A_ff);      factorized = (llt.info()      == Eigen::Success); break;
+        case SIMPLICIAL_LDLT: ldlt.factorize(A_ff);     factorized = (ldlt.info()     == Eigen::Success); break;
+        case SparseLU:        lu.factorize(A_ff);       factorized = (lu.info()       == Eigen::Success); break;
+        case BiCGSTAB:        bicgstab.factorize(A_ff); factorized = (bicgstab.info() == Eigen::Success); break;
+        default: assert(false && "Unknown Solver");
+    }
+    ++n_factorizations;
+    return factorized;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::compute(const Eigen::SparseMatrix<double> & A,
+                                 const std::vector<unsigned int>   & dirichlet_dofs)
+{
+    std::vector<unsigned int> tmp = dirichlet_dofs;
+    std::sort(tmp.begin(), tmp.end());
+    tmp.erase(std::unique(tmp.begin(), tmp.end()), tmp.end());
+
+    if(!analyzed || A.rows()!=n || tmp!=bc_dofs) analyze_pattern(A, tmp);
+    return factorize(A);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSystemSolver::split(const Eigen::SparseMatrix<double> & A)
+{
+    assert(A.rows() == n && A.cols() == n);
+
+    if(bc_dofs.empty())
+    {
+        A_ff = A;
+        A_ff.makeCompressed();
+        return;
+    }
+
+    std::vector<Entry> ff, fb;
+    ff.reserve(A.nonZeros());
+    for(int i=0; i<A.outerSize(); ++i)
+    {
+        for(Eigen::SparseMatrix<double>::InnerIterator it(A,i); it; ++it)
+        {
+            int row = dof_map[it.row()];
+            int col = dof_map[it.col()];
+            if(row < 0) continue;
+            if(col < 0) fb.push_back(Entry(row, -col-1, it.value()));
+            else        ff.push_back(Entry(row,  col,   it.value()));
+        }
+    }
+    A_ff.resize(free_dofs.size(), free_dofs.size());
+    A_fb.resize(free_dofs.size(), bc_dofs.size());
+    A_ff.setFromTriplets(ff.begin(), ff.end());
+    A_fb.setFromTriplets(fb.begin(), fb.end());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSystemSolver::symbolic()
+{
+    switch(solver)
+    {
+        case SIMPLICIAL_LLT:  llt.analyzePattern(A_ff);      break;
+        case SIMPLICIAL_LDLT: ldlt.analyzePattern(A_ff);     break;
+        case SparseLU:        lu.analyzePattern(A_ff);       break;
+        case BiCGSTAB:        bicgstab.analyzePattern(A_ff); break;
+        default: assert(false && "Unknown Solver");
+    }
+    pattern_outer.assign(A_ff.outerIndexPtr(), A_ff.outerIndexPtr() + A_ff.outerSize() + 1);
+    pattern_inner.assign(A_ff.innerIndexPtr(), A_ff.innerIndexPtr() + A_ff.nonZeros());
+    analyzed   = true;
+    factorized = false;
+    ++n_analysis;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const Eigen::VectorXd & b,
+                                     Eigen::VectorXd & x) const
+{
+    Eigen::MatrixXd X;
+    bool ok = solve(Eigen::MatrixXd(b), X);
+    x = X.col(0);
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const Eigen::VectorXd               & b,
+                                     Eigen::VectorXd               & x,
+                               const std::map<unsigned int,double> & bc) const
+{
+    assert(bc.size() == bc_dofs.size());
+    Eigen::MatrixXd bc_vals(bc_dofs.size(), 1);
+    for(unsigned int i=0; i<bc_dofs.size(); ++i) bc_vals(i,0) = bc.at(bc_dofs.at(i));
+
+    Eigen::MatrixXd X;
+    bool ok = solve(Eigen::MatrixXd(b), X, bc_vals);
+    x = X.col(0);
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const Eigen::MatrixXd & B,
+                                     Eigen::MatrixXd & X) const
+{
+    assert(bc_dofs.empty() && "Dirichlet values are missing");
+    return solve(B, X, Eigen::MatrixXd(0, B.cols()));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const Eigen::MatrixXd & B,
+                                     Eigen::MatrixXd & X,
+                               const Eigen::MatrixXd & bc) const
+{
+    CINO_PROFILE_ZONE("LinearSystemSolver::solve");
+    assert(factorized);
+    assert(B.rows() == n);
+    assert(bc.rows() == (int)bc_dofs.size() && (bc_dofs.empty() || bc.cols() == B.cols()));
+    if(!factorized) return false;
+
+    if(B.cols()>1 && (solver==SIMPLICIAL_LLT || solver==SIMPLICIAL_LDLT))
+    {
+        RowMatrixXd X_r;
+        bool ok = solve(RowMatrixXd(B), X_r, bc);
+        X = X_r;
+        return ok;
+    }
+
+    // move the known (Dirichlet) values to the right hand side
+    Eigen::MatrixXd B_f(free_dofs.size(), B.cols());
+    for(unsigned int i=0; i<free_dofs.size(); ++i) B_f.row(i) = B.row(free_dofs.at(i));
+    if(!bc_dofs.empty()) B_f -= A_fb * bc;
+
+    Eigen::MatrixXd X_f;
+    bool ok = true;
+    if(!free_dofs.empty())
+    {
+        switch(solver)
+        {
+            case SIMPLICIAL_LLT:  X_f = llt.solve(B_f);      ok = (llt.info()      == Eigen::Success); break;
+            case SIMPLICIAL_LDLT: X_f = ldlt.solve(B_f);     ok = (ldlt.info()     == Eigen::Success); break;
+            case SparseLU:        X_f = lu.solve(B_f);       ok = (lu.info()       == Eigen::Success); break;
+            case BiCGSTAB:        X_f = bicgstab.solve(B_f); ok = (bicgstab.info() == Eigen::Success); break;
+            default: assert(false && "Unknown Solver");
+        }
+    }
+
+    X.resize(n, B.cols());
+    for(unsigned int i=0; i<free_dofs.size(); ++i) X.row(free_dofs.at(i)) = X_f.row(i);
+    for(unsigned int i=0; i<bc_dofs.size();   ++i) X.row(bc_dofs.at(i))   = bc.row(i);
+    return ok;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const RowMatrixXd & B,
+                                     RowMatrixXd & X) const
+{
+    assert(bc_dofs.empty() && "Dirichlet values are missing");
+    return solve(B, X, Eigen::MatrixXd(0, B.cols()));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool LinearSystemSolver::solve(const RowMatrixXd     & B,
+                                     RowMatrixXd     & X,
+                               const Eigen::MatrixXd & bc) const
+{
+    assert(factorized);
+    assert(B.rows() == n);
+    assert(bc.rows() == (int)bc_dofs.size() && (bc_dofs.empty() || bc.cols() == B.cols()));
+    if(!factorized) return false;
+
+    // a single rhs gains nothing from the row major substitution
+    if(B.cols()==1 || (solver!=SIMPLICIAL_LLT && solver!=SIMPLICIAL_LDLT))
+    {
+        Eigen::MatrixXd X_c;
+        bool ok = solve(Eigen::MatrixXd(B), X_c, bc);
+        X = X_c;
+        return ok;
+    }
+
+    CINO_PROFILE_ZONE("LinearSystemSolver::solve");
+
+    // move the known (Dirichlet) values to the right hand side
+    RowMatrixXd X_f(free_dofs.size(), B.cols());
+    for(unsigned int i=0; i<free_dofs.size(); ++i) X_f.row(i) = B.row(free_dofs.at(i));
+    if(!bc_dofs.empty()) X_f -= A_fb * bc;
+
+    if(!free_dofs.empty()) cholesky_solve_in_place(X_f);
+
+    X.resize(n, B.cols());
+    for(unsigned int i=0; i<free_dofs.size(); ++i) X.row(free_dofs.at(i)) = X_f.row(i);
+    for(unsigned int i=0; i<bc_dofs.size();   ++i) X.row(bc_dofs.at(i))   = bc.row(i);
+    return (solver==SIMPLICIAL_LLT) ? (llt.info()  == Eigen::Success) :
+                                      (ldlt.info() == Eigen::Success);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void LinearSystemSolver::cholesky_solve_in_place(RowMatrixXd & X) const
+{
+    // same steps of Eigen's simplicial solve (X = P^-1 L^-T D^-1 L^-1 P X), but every
+    // entry of the factor updates a whole row of X. Eigen would rather traverse the
+    // factor once per column. Blocks of columns are independent and run in parallel
+    bool is_llt = (solver==SIMPLICIAL_LLT);
+    const Eigen::SparseMatrix<double> & L = is_llt ? llt.matrixL().nestedExpression() : ldlt.matrixL().nestedExpression();
+    const auto & P    = is_llt ? llt.permutationP()    : ldlt.permutationP();
+    const auto & Pinv = is_llt ? llt.permutationPinv() : ldlt.permutationPinv();
+    Eigen::VectorXd D = is_llt ? Eigen::VectorXd() : ldlt.vectorD(); // vectorD() returns a copy
+    int nf = (int)L.cols();
+
+    if(P.size()>0) X = P * X;
+
+    assert(L.isCompressed());
+    const int    *col_beg = L.outerIndexPtr();
+    const int    *row_id  = L.innerIndexPtr();
+    const double *val     = L.valuePtr();
+    const size_t  ld      = X.cols();
+    const unsigned int block_size = 8;
+
+    // the width of a block of columns is a compile time constant for all but the last block,
+    // so that the row updates are fully unrolled and vectorized
+    auto substitute = [&](double * x, auto w)
+    {
+        // L^-1 (lower triangular, stored by columns, diagonal first)
+        for(int j=0; j<nf; ++j)
+        {
+            int     k  = col_beg[j];
+            double *xj = x + j*ld;
+            if(is_llt)
+            {
+                assert(row_id[k]==j);
+                for(unsigned int c=0; c<w; ++c) xj[c] /= val[k];
+                ++k;
+            }
+            for(; k<col_beg[j+1]; ++k)
+            {
+                double *xi = x + row_id[k]*ld;
+                double  v  = val[k];
+                for(unsigned int c=0; c<w; ++c) xi[c] -= v * xj[c];
+            }
+        }
+
+        // D^-1 (LDLT only)
+        if(!is_llt)
+        {
+            for(int j=0; j<nf; ++j)
+            {
+                double *xj = x + j*ld;
+                for(unsigned int c=0; c<w; ++c) xj[c] /= D[j];
+            }
+        }
+
+        // L^-T
+        for(int j=nf-1; j>=0; --j)
+        {
+            int     k    = col_beg[j];
+            double *xj   = x + j*ld;
+            double  diag = is_llt ? val[k++] : 1.0;
+            double  acc[block_size];
+            for(unsigned int c=0; c<w; ++c) acc[c] = xj[c];
+            for(; k<col_beg[j+1]; ++k)
+            {
+                const double *xi = x + row_id[k]*ld;
+                double        v  = val[k];
+                for(unsigned int c=0; c<w; ++c) acc[c] -= v * xi[c];
+            }
+            for(unsigned int c=0; c<w; ++c) xj[c] = acc[c] / diag;
+        }
+    };
+
+    unsigned int n_blocks = (X.cols() + block_size - 1) / block_size;
+    PARALLEL_FOR(0, n_blocks, 2, [&](const unsigned int block)
+    {
+        unsigned int c0 = block*block_size;
+        unsigned int w  = std::min<unsigned int>(block_size, X.cols()-c0);
+        if(w==block_size) substitute(X.data()+c0, std::integral_constant<unsigned int,block_size>());
+        else              substitute(X.data()+c0, w);
+    });
+
+    if(P.size()>0) X = Pinv * X;
+}
 
 }
@@ -38,6 +38,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
 #include <Eigen/Sparse>
@@ -129,6 +130,124 @@ void solve_weighted_least_squares_with_bc(const Eigen::SparseMatrix<double> & A,
                                           const std::map<unsigned int,double>       & bc, // Dirichlet boundary conditions
                                           int   solver = SIMPLICIAL_LLT);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// dense matrix stored row by row. Used for multiple right hand sides (one per column),
+// as the Cholesky solvers can then update all of them with contiguous accesses
+typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowMatrixXd;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Persistent handle to a factorized linear system, for applications that
+ * solve the same operator multiple times (e.g. with different right hand
+ * sides or different Dirichlet values).
+ *
+ * Degrees of freedom subject to Dirichlet boundary conditions are given at
+ * analysis time and eliminated from the system. Their values are only
+ * given at solve time, hence changing them does not require to factorize
+ * again. Symbolic analysis (which depends only on the sparsity pattern) and
+ * numeric factorization are kept separate: factorize() redoes the symbolic
+ * analysis only if the sparsity pattern of the matrix changed. Multiple
+ * right hand sides can be solved at once, one per column.
+*/
+
+class LinearSystemSolver
+{
+    public:
+
+        explicit LinearSystemSolver(const int solver = SIMPLICIAL_LLT);
+
+        explicit LinearSystemSolver(const Eigen::SparseMatrix<double> & A,
+                                    const int                           solver = SIMPLICIAL_LLT);
+
+        explicit LinearSystemSolver(const Eigen::SparseMatrix<double> & A,
+                                    const std::vector<unsigned int>   & dirichlet_dofs,
+                                    const int                           solver = SIMPLICIAL_LLT);
+
+        LinearSystemSolver(const LinearSystemSolver &) = delete;
+        LinearSystemSolver & operator=(const LinearSystemSolver &) = delete;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void clear();
+
+        // symbolic analysis of A, with the given dofs eliminated
+        void analyze_pattern(const Eigen::SparseMatrix<double> & A,
+                             const std::vector<unsigned int>   & dirichlet_dofs = {});
+
+        // numeric factorization of A. The symbolic analysis is redone only if the
+        // sparsity pattern of A differs from the one of the analyzed matrix. If the
+        // size of A changed the Dirichlet dofs are kept, and false is returned if
+        // some of them do not fit the new matrix
+        bool factorize(const Eigen::SparseMatrix<double> & A);
+
+        // analyze_pattern (if the Dirichlet dofs changed) + factorize
+        bool compute(const Eigen::SparseMatrix<double> & A,
+                     const std::vector<unsigned int>   & dirichlet_dofs = {});
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool solve(const Eigen::VectorXd & b,
+                         Eigen::VectorXd & x) const;
+
+        bool solve(const Eigen::VectorXd               & b,
+                         Eigen::VectorXd               & x,
+                   const std::map<unsigned int,double> & bc) const; // keys must match the Dirichlet dofs
+
+        bool solve(const Eigen::MatrixXd & B,
+                         Eigen::MatrixXd & X) const;
+
+        bool solve(const Eigen::MatrixXd & B,
+                         Eigen::MatrixXd & X,
+                   const Eigen::MatrixXd & bc) const; // one row per Dirichlet dof (in the order of dirichlet_dofs()), one column per rhs
+
+        // with the Cholesky solvers (SIMPLICIAL_LLT, SIMPLICIAL_LDLT) all the right hand sides are
+        // substituted in a single traversal of the factor, rather than one at a time. Column major
+        // matrices with more than one column go through these overloads as well
+        bool solve(const RowMatrixXd & B,
+                         RowMatrixXd & X) const;
+
+        bool solve(const RowMatrixXd     & B,
+                         RowMatrixXd     & X,
+                   const Eigen::MatrixXd & bc) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        int                               solver_type()         const { return solver; }
+        bool                              is_factorized()       const { return factorized; }
+        unsigned int                      size()                const { return n; }
+        const std::vector<unsigned int> & dirichlet_dofs()      const { return bc_dofs; }
+        unsigned int                      num_analysis()        const { return n_analysis; }
+        unsigned int                      num_factorizations()  const { return n_factorizations; }
+
+    protected:
+
+        void split(const Eigen::SparseMatrix<double> & A);
+        void symbolic();
+        void cholesky_solve_in_place(RowMatrixXd & X) const;
+
+        int  solver;
+        bool analyzed   = false;
+        bool factorized = false;
+        unsigned int n  = 0;
+        unsigned int n_analysis       = 0;
+        unsigned int n_factorizations = 0;
+
+        std::vector<unsigned int> bc_dofs;  // eliminated dofs (sorted)
+        std::vector<int>          dof_map;  // dof => free dof (or -1 if Dirichlet)
+        std::vector<unsigned int> free_dofs;
+
+        Eigen::SparseMatrix<double> A_ff;     // free-free block (the one that gets factorized)
+        Eigen::SparseMatrix<double> A_fb;     // free-Dirichlet block (moved to the rhs)
+        std::vector<int>            pattern_outer;
+        std::vector<int>            pattern_inner;
+
+        Eigen::SimplicialLLT <Eigen::SparseMatrix<double>>                                 llt;
+        Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>>                                 ldlt;
+        Eigen::SparseLU      <Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>     lu;
+        Eigen::BiCGSTAB      <Eigen::SparseMatrix<double>, Eigen::IncompleteLUT<double>>   bicgstab;
+};
+
 }
 
 #ifndef  CINO_STATIC_LIB
@@ -67,7 +67,7 @@ void map_to_tetrahedron(const Trimesh<M,V,E,P>   & m,
     for(unsigned int pid=0; pid<m.num_polys(); ++pid)
     {
         // try all tri edges until you find a suitable one....
-        for(unsigned int eid : m.adj_p2e(pid))
+        for(unsigned int eid : m.adj_p2e_span(pid))
         {
             unsigned int vid0 = m.edge_vert_id(eid,0);
             unsigned int vid1 = m.edge_vert_id(eid,1);
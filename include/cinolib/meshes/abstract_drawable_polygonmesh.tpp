@@ -38,6 +38,7 @@
 #include <cinolib/gl/draw_lines_tris.h>
 #include <cinolib/gl/load_texture.h>
 #include <cinolib/color.h>
+#include <cinolib/trace_profiler.h>
 
 namespace cinolib
 {
@@ -72,6 +73,7 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::updateGL()
 {
+    CINO_PROFILE_ZONE("AbstractDrawablePolygonMesh::updateGL");
     updateGL_mesh();
     updateGL_marked();
 }
@@ -91,7 +93,7 @@ void AbstractDrawablePolygonMesh<Mesh>::updateGL_marked()
         if(!this->edge_data(eid).flags[MARKED]) continue;
 
         bool hidden = true;
-        for(unsigned int pid : this->adj_e2p(eid))
+        for(unsigned int pid : this->adj_e2p_span(eid))
         {
             if(!this->poly_data(pid).flags[HIDDEN])
             {
@@ -307,7 +309,7 @@ void AbstractDrawablePolygonMesh<Mesh>::updateGL_mesh()
         for(unsigned int eid=0; eid<this->num_edges(); ++eid)
         {
             bool hidden = true;
-            for(unsigned int pid : this->adj_e2p(eid))
+            for(unsigned int pid : this->adj_e2p_span(eid))
             {
                 if(!this->poly_data(pid).flags[HIDDEN])
                 {
@@ -350,7 +352,7 @@ CINO_INLINE
 void AbstractDrawablePolygonMesh<Mesh>::updateGL_mesh_e(unsigned int eid, unsigned int visible_e_i)
 {
     bool hidden = true;
-    for (unsigned int pid : this->adj_e2p(eid))
+    for (unsigned int pid : this->adj_e2p_span(eid))
     {
         if (!this->poly_data(pid).flags[HIDDEN])
         {
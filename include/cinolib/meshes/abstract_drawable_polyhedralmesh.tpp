@@ -38,6 +38,7 @@
 #include <cinolib/gl/draw_lines_tris.h>
 #include <cinolib/gl/load_texture.h>
 #include <cinolib/color.h>
+#include <cinolib/trace_profiler.h>
 #include <unordered_set>
 #include <algorithm>
 #include <utility>
@@ -78,6 +79,7 @@ template<class Mesh>
 CINO_INLINE
 void AbstractDrawablePolyhedralMesh<Mesh>::updateGL()
 {
+    CINO_PROFILE_ZONE("AbstractDrawablePolyhedralMesh::updateGL");
     updateGL_marked();
     updateGL_in();
     updateGL_out();
@@ -384,7 +386,7 @@ void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_out(std::vector<unsigned int
         if (this->edge_is_on_srf(eid))
         {
             bool hidden = true;
-            for(unsigned int pid : this->adj_e2p(eid))
+            for(unsigned int pid : this->adj_e2p_span(eid))
             {
                 if(!this->poly_data(pid).flags[HIDDEN])
                 {
@@ -884,7 +886,7 @@ void AbstractDrawablePolyhedralMesh<Mesh>::updateGL_e(RenderData& drawlist, unsi
 {
    
     bool hidden = true;
-    for (unsigned int pid : this->adj_e2p(eid))
+    for (unsigned int pid : this->adj_e2p_span(eid))
     {
         if (!this->poly_data(pid).flags[HIDDEN])
         {
@@ -36,6 +36,7 @@
 #ifndef CINO_ABSTRACT_MESH_H
 #define CINO_ABSTRACT_MESH_H
 
+#include <cassert>
 #include <set>
 #include <vector>
 #include <sys/types.h>
@@ -45,6 +46,8 @@
 #include <cinolib/color.h>
 #include <cinolib/symbols.h>
 #include <cinolib/ipair.h>
+#include <cinolib/meshes/compressed_adjacency.h>
+#include <cinolib/meshes/mesh_attributes_soa.h>
 
 typedef enum
 {
@@ -69,16 +72,19 @@ class AbstractMesh
 {
     protected:
 
-        AABB bb;
+        mutable AABB bb;
+        mutable bool bb_dirty = false; // recompute bb at the next access (see bbox)
 
         std::vector<vec3d>             verts;
         std::vector<unsigned int>              edges;
         std::vector<std::vector<unsigned int>> polys; // either polygons or polyhedra
 
-        M              m_data;
-        std::vector<V> v_data;
-        std::vector<E> e_data;
-        std::vector<P> p_data;
+        // per element attributes. Storage is an array of structs (std::vector) by
+        // default, or a structure of arrays for opted-in types (see mesh_attributes_soa.h)
+        M                                  m_data;
+        typename AttributeStorage<V>::type v_data;
+        typename AttributeStorage<E>::type e_data;
+        typename AttributeStorage<P>::type p_data;
 
         std::vector<std::vector<unsigned int>> v2v; // vert to vert adjacency
         std::vector<std::vector<unsigned int>> v2e; // vert to edge adjacency
@@ -87,6 +93,11 @@ class AbstractMesh
         std::vector<std::vector<unsigned int>> p2e; // poly to edge adjacency
         std::vector<std::vector<unsigned int>> p2p; // poly to poly adjacency
 
+        // read only, compressed (CSR) copies of the relations above. They are used
+        // in place of the vectors of vectors when adjacency is frozen (see adj_freeze)
+        bool                adj_frozen = false;
+        CompressedAdjacency v2v_csr, v2e_csr, v2p_csr, e2p_csr, p2e_csr, p2p_csr;
+
     public:
 
         typedef M M_type;
@@ -94,6 +105,10 @@ class AbstractMesh
         typedef E E_type;
         typedef P P_type;
 
+        typedef typename AttributeStorage<V>::type V_storage;
+        typedef typename AttributeStorage<E>::type E_storage;
+        typedef typename AttributeStorage<P>::type P_storage;
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         explicit AbstractMesh() {}
@@ -113,7 +128,7 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                void update_bbox();
+                void update_bbox() const;
         virtual void update_normals() = 0;
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -133,7 +148,7 @@ class AbstractMesh
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         virtual unsigned int verts_per_poly(const unsigned int pid) const = 0;
-        virtual unsigned int edges_per_poly(const unsigned int pid) const { return this->p2e.at(pid).size(); }
+        virtual unsigned int edges_per_poly(const unsigned int pid) const { return this->adj_p2e_span(pid).size(); }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
@@ -143,7 +158,7 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        const AABB                           & bbox()          const { return bb;    }
+        const AABB                           & bbox()          const { if(bb_dirty) update_bbox(); return bb; }
         const std::vector<vec3d>             & vector_verts()  const { return verts; }
               std::vector<vec3d>             & vector_verts()        { return verts; }
         const std::vector<unsigned int>              & vector_edges()  const { return edges; }
@@ -174,20 +189,38 @@ class AbstractMesh
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-                const std::vector<unsigned int> & adj_v2v(const unsigned int vid) const { return v2v.at(vid); }
-                      std::vector<unsigned int> & adj_v2v(const unsigned int vid)       { return v2v.at(vid); }
-                const std::vector<unsigned int> & adj_v2e(const unsigned int vid) const { return v2e.at(vid); }
-                      std::vector<unsigned int> & adj_v2e(const unsigned int vid)       { return v2e.at(vid); }
-                const std::vector<unsigned int> & adj_v2p(const unsigned int vid) const { return v2p.at(vid); }
-                      std::vector<unsigned int> & adj_v2p(const unsigned int vid)       { return v2p.at(vid); }
+        // Adjacency can be frozen, i.e. packed into compressed (CSR) arrays, trading
+        // editability for memory and cache locality. While frozen, the relations are
+        // read through the adj_*_span views (see IndexSpan), which work in both modes.
+        // The std::vector accessors require a mutable mesh: the const ones assert it,
+        // the non const ones thaw the mesh first. Topological editing operations thaw
+        // the mesh as well, invalidating all the views taken before
+                      void                        adj_freeze();
+                      void                        adj_thaw();
+                      bool                        adj_is_frozen() const { return adj_frozen; }
+                      size_t                      adj_memory_usage() const; // in bytes
+
+                const std::vector<unsigned int> & adj_v2v(const unsigned int vid) const { assert(!adj_frozen); return v2v.at(vid); }
+                      std::vector<unsigned int> & adj_v2v(const unsigned int vid)       { adj_thaw();           return v2v.at(vid); }
+                const std::vector<unsigned int> & adj_v2e(const unsigned int vid) const { assert(!adj_frozen); return v2e.at(vid); }
+                      std::vector<unsigned int> & adj_v2e(const unsigned int vid)       { adj_thaw();           return v2e.at(vid); }
+                const std::vector<unsigned int> & adj_v2p(const unsigned int vid) const { assert(!adj_frozen); return v2p.at(vid); }
+                      std::vector<unsigned int> & adj_v2p(const unsigned int vid)       { adj_thaw();           return v2p.at(vid); }
                       std::vector<unsigned int>   adj_e2v(const unsigned int eid) const;
                       std::vector<unsigned int>   adj_e2e(const unsigned int eid) const;
-                const std::vector<unsigned int> & adj_e2p(const unsigned int eid) const { return e2p.at(eid); }
-                      std::vector<unsigned int> & adj_e2p(const unsigned int eid)       { return e2p.at(eid); }
-                const std::vector<unsigned int> & adj_p2e(const unsigned int pid) const { return p2e.at(pid); }
-                      std::vector<unsigned int> & adj_p2e(const unsigned int pid)       { return p2e.at(pid); }
-                const std::vector<unsigned int> & adj_p2p(const unsigned int pid) const { return p2p.at(pid); }
-                      std::vector<unsigned int> & adj_p2p(const unsigned int pid)       { return p2p.at(pid); }
+                const std::vector<unsigned int> & adj_e2p(const unsigned int eid) const { assert(!adj_frozen); return e2p.at(eid); }
+                      std::vector<unsigned int> & adj_e2p(const unsigned int eid)       { adj_thaw();           return e2p.at(eid); }
+                const std::vector<unsigned int> & adj_p2e(const unsigned int pid) const { assert(!adj_frozen); return p2e.at(pid); }
+                      std::vector<unsigned int> & adj_p2e(const unsigned int pid)       { adj_thaw();           return p2e.at(pid); }
+                const std::vector<unsigned int> & adj_p2p(const unsigned int pid) const { assert(!adj_frozen); return p2p.at(pid); }
+                      std::vector<unsigned int> & adj_p2p(const unsigned int pid)       { adj_thaw();           return p2p.at(pid); }
+
+                      IndexSpan                   adj_v2v_span(const unsigned int vid) const { return adj_frozen ? v2v_csr.at(vid) : IndexSpan(v2v.at(vid)); }
+                      IndexSpan                   adj_v2e_span(const unsigned int vid) const { return adj_frozen ? v2e_csr.at(vid) : IndexSpan(v2e.at(vid)); }
+                      IndexSpan                   adj_v2p_span(const unsigned int vid) const { return adj_frozen ? v2p_csr.at(vid) : IndexSpan(v2p.at(vid)); }
+                      IndexSpan                   adj_e2p_span(const unsigned int eid) const { return adj_frozen ? e2p_csr.at(eid) : IndexSpan(e2p.at(eid)); }
+                      IndexSpan                   adj_p2e_span(const unsigned int pid) const { return adj_frozen ? p2e_csr.at(pid) : IndexSpan(p2e.at(pid)); }
+                      IndexSpan                   adj_p2p_span(const unsigned int pid) const { return adj_frozen ? p2p_csr.at(pid) : IndexSpan(p2p.at(pid)); }
         virtual const std::vector<unsigned int> & adj_p2v(const unsigned int pid) const = 0;
         virtual       std::vector<unsigned int> & adj_p2v(const unsigned int pid)       = 0;
 
@@ -195,12 +228,21 @@ class AbstractMesh
 
         const M & mesh_data()               const { return m_data;         }
               M & mesh_data()                     { return m_data;         }
-        const V & vert_data(const unsigned int vid) const { return v_data.at(vid); }
-              V & vert_data(const unsigned int vid)       { return v_data.at(vid); }
-        const E & edge_data(const unsigned int eid) const { return e_data.at(eid); }
-              E & edge_data(const unsigned int eid)       { return e_data.at(eid); }
-        const P & poly_data(const unsigned int pid) const { return p_data.at(pid); }
-              P & poly_data(const unsigned int pid)       { return p_data.at(pid); }
+        typename V_storage::const_reference vert_data(const unsigned int vid) const { return v_data.at(vid); }
+        typename V_storage::reference       vert_data(const unsigned int vid)       { return v_data.at(vid); }
+        typename E_storage::const_reference edge_data(const unsigned int eid) const { return e_data.at(eid); }
+        typename E_storage::reference       edge_data(const unsigned int eid)       { return e_data.at(eid); }
+        typename P_storage::const_reference poly_data(const unsigned int pid) const { return p_data.at(pid); }
+        typename P_storage::reference       poly_data(const unsigned int pid)       { return p_data.at(pid); }
+
+        // whole attribute containers. With a SoA layout (see mesh_attributes_soa.h)
+        // they expose one contiguous column per attribute, e.g. vert_data_storage().normal
+        const V_storage & vert_data_storage() const { return v_data; }
+              V_storage & vert_data_storage()       { return v_data; }
+        const E_storage & edge_data_storage() const { return e_data; }
+              E_storage & edge_data_storage()       { return e_data; }
+        const P_storage & poly_data_storage() const { return p_data; }
+              P_storage & poly_data_storage()       { return p_data; }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
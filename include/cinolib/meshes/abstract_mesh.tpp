@@ -37,6 +37,7 @@
 #include <cinolib/meshes/mesh_attributes.h>
 #include <cinolib/stl_container_utilities.h>
 #include <cinolib/min_max_inf.h>
+#include <cinolib/parallel_for.h>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
@@ -77,6 +78,7 @@ CINO_INLINE
 void AbstractMesh<M,V,E,P>::clear()
 {
     bb.reset();
+    bb_dirty = false;
     //
     verts.clear();
     edges.clear();
@@ -94,6 +96,82 @@ void AbstractMesh<M,V,E,P>::clear()
     e2p.clear();
     p2e.clear();
     p2p.clear();
+    //
+    adj_frozen = false;
+    v2v_csr.clear();
+    v2e_csr.clear();
+    v2p_csr.clear();
+    e2p_csr.clear();
+    p2e_csr.clear();
+    p2p_csr.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::adj_freeze()
+{
+    if(adj_frozen) return;
+
+    // each relation is released right after being compressed, so as to
+    // keep the memory peak as low as possible
+    auto compress = [](std::vector<std::vector<unsigned int>> & rel, CompressedAdjacency & csr)
+    {
+        csr.compress(rel);
+        std::vector<std::vector<unsigned int>>().swap(rel);
+    };
+    compress(v2v, v2v_csr);
+    compress(v2e, v2e_csr);
+    compress(v2p, v2p_csr);
+    compress(e2p, e2p_csr);
+    compress(p2e, p2e_csr);
+    compress(p2p, p2p_csr);
+    adj_frozen = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractMesh<M,V,E,P>::adj_thaw()
+{
+    if(!adj_frozen) return;
+
+    auto decompress = [](CompressedAdjacency & csr, std::vector<std::vector<unsigned int>> & rel)
+    {
+        rel = csr.decompress();
+        csr.clear();
+    };
+    decompress(v2v_csr, v2v);
+    decompress(v2e_csr, v2e);
+    decompress(v2p_csr, v2p);
+    decompress(e2p_csr, e2p);
+    decompress(p2e_csr, p2e);
+    decompress(p2p_csr, p2p);
+    adj_frozen = false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+size_t AbstractMesh<M,V,E,P>::adj_memory_usage() const
+{
+    // approximated: it does not account for the allocator bookkeeping,
+    // which makes vectors of vectors even more expensive than this
+    auto usage = [](const std::vector<std::vector<unsigned int>> & rel)
+    {
+        size_t bytes = rel.capacity()*sizeof(std::vector<unsigned int>);
+        for(const auto & list : rel) bytes += list.capacity()*sizeof(unsigned int);
+        return bytes;
+    };
+    if(adj_frozen)
+    {
+        return v2v_csr.memory_usage() + v2e_csr.memory_usage() + v2p_csr.memory_usage() +
+               e2p_csr.memory_usage() + p2e_csr.memory_usage() + p2p_csr.memory_usage();
+    }
+    return usage(v2v) + usage(v2e) + usage(v2p) + usage(e2p) + usage(p2e) + usage(p2p);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -167,10 +245,14 @@ void AbstractMesh<M,V,E,P>::normalize_bbox()
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void AbstractMesh<M,V,E,P>::update_bbox()
+void AbstractMesh<M,V,E,P>::update_bbox() const
 {
-    bb.reset();
-    bb.push(this->verts);
+    // merge corners componentwise: a thread that got no work keeps an empty
+    // (inverted) box, and AABB::push(AABB) would blow it up to infinity
+    bb = PARALLEL_REDUCE(0, num_verts(), 10000, AABB(),
+                         [this](const unsigned int vid, AABB & b){ b.push(verts[vid]); },
+                         [](AABB a, const AABB & b){ a.min = a.min.min(b.min); a.max = a.max.max(b.max); return a; });
+    bb_dirty = false;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -179,13 +261,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<vec3d> AbstractMesh<M,V,E,P>::vector_vert_normals() const
 {
-    std::vector<vec3d> normals;
-    normals.reserve(num_verts());
-    for(unsigned int vid=0; vid<num_verts(); ++vid)
-    {
-        normals.push_back(vert_data(vid).normal);
-    }
-    return normals;
+    return attribute_normal_column(v_data);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -284,13 +360,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<int> AbstractMesh<M,V,E,P>::vector_poly_labels() const
 {
-    std::vector<int> labels;
-    labels.reserve(num_polys());
-    for(unsigned int pid=0; pid<num_polys(); ++pid)
-    {
-        labels.push_back(poly_data(pid).label);
-    }
-    return labels;
+    return attribute_label_column(p_data);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -366,20 +436,22 @@ void AbstractMesh<M,V,E,P>::copy_xyz_to_uvw(const int mode)
 {
     for(unsigned int vid=0; vid<num_verts(); ++vid)
     {
+        const vec3d & p   = verts[vid];
+              vec3d & uvw = attribute_uvw(v_data, vid);
         switch (mode)
         {
-            case U_param  : vert_data(vid).uvw[0] = vert(vid).x(); break;
-            case V_param  : vert_data(vid).uvw[1] = vert(vid).y(); break;
-            case W_param  : vert_data(vid).uvw[2] = vert(vid).z(); break;
-            case UV_param : vert_data(vid).uvw[0] = vert(vid).x();
-                            vert_data(vid).uvw[1] = vert(vid).y(); break;
-            case UW_param : vert_data(vid).uvw[0] = vert(vid).x();
-                            vert_data(vid).uvw[2] = vert(vid).z(); break;
-            case VW_param : vert_data(vid).uvw[1] = vert(vid).y();
-                            vert_data(vid).uvw[2] = vert(vid).z(); break;
-            case UVW_param: vert_data(vid).uvw[0] = vert(vid).x();
-                            vert_data(vid).uvw[1] = vert(vid).y();
-                            vert_data(vid).uvw[2] = vert(vid).z(); break;
+            case U_param  : uvw[0] = p.x(); break;
+            case V_param  : uvw[1] = p.y(); break;
+            case W_param  : uvw[2] = p.z(); break;
+            case UV_param : uvw[0] = p.x();
+                            uvw[1] = p.y(); break;
+            case UW_param : uvw[0] = p.x();
+                            uvw[2] = p.z(); break;
+            case VW_param : uvw[1] = p.y();
+                            uvw[2] = p.z(); break;
+            case UVW_param: uvw[0] = p.x();
+                            uvw[1] = p.y();
+                            uvw[2] = p.z(); break;
             default: assert(false);
         }
     }
@@ -446,8 +518,8 @@ std::vector<unsigned int> AbstractMesh<M,V,E,P>::adj_e2e(const unsigned int eid)
     std::unordered_set<unsigned int> unique_e_list;
     unsigned int v0 = this->edge_vert_id(eid,0);
     unsigned int v1 = this->edge_vert_id(eid,1);
-    for(unsigned int nbr : this->adj_v2e(v0)) if(nbr != eid) unique_e_list.insert(nbr);
-    for(unsigned int nbr : this->adj_v2e(v1)) if(nbr != eid) unique_e_list.insert(nbr);
+    for(unsigned int nbr : this->adj_v2e_span(v0)) if(nbr != eid) unique_e_list.insert(nbr);
+    for(unsigned int nbr : this->adj_v2e_span(v1)) if(nbr != eid) unique_e_list.insert(nbr);
     std::vector<unsigned int> e_list(unique_e_list.begin(), unique_e_list.end());
     return e_list;
 }
@@ -467,7 +539,7 @@ std::set<unsigned int> AbstractMesh<M,V,E,P>::vert_n_ring(const unsigned int vid
         std::set<unsigned int> next_active_set;
 
         for(unsigned int curr : active_set)
-        for(unsigned int nbr  : adj_v2v(curr))
+        for(unsigned int nbr  : adj_v2v_span(curr))
         {
             if (DOES_NOT_CONTAIN(ring,nbr) && nbr != vid) next_active_set.insert(nbr);
             ring.insert(nbr);
@@ -484,7 +556,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractMesh<M,V,E,P>::verts_are_adjacent(const unsigned int vid0, const unsigned int vid1) const
 {
-    for(unsigned int nbr : adj_v2v(vid0)) if (vid1==nbr) return true;
+    for(unsigned int nbr : adj_v2v_span(vid0)) if (vid1==nbr) return true;
     return false;
 }
 
@@ -520,7 +592,7 @@ void AbstractMesh<M,V,E,P>::vert_weights_uniform(const unsigned int vid, std::ve
 {
     wgts.clear();
     double w = 1.0; // / (double)nbrs.size(); // <= WARNING: makes the matrix non-symmetric!!!!!
-    for(unsigned int nbr : adj_v2v(vid))
+    for(unsigned int nbr : adj_v2v_span(vid))
     {
         wgts.push_back(std::make_pair(nbr,w));
     }
@@ -532,7 +604,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractMesh<M,V,E,P>::vert_is_local_min(const unsigned int vid, const int tex_coord) const
 {
-    for(unsigned int nbr : adj_v2v(vid))
+    for(unsigned int nbr : adj_v2v_span(vid))
     {
         switch (tex_coord)
         {
@@ -551,7 +623,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractMesh<M,V,E,P>::vert_is_local_max(const unsigned int vid, const int tex_coord) const
 {
-    for(unsigned int nbr : adj_v2v(vid))
+    for(unsigned int nbr : adj_v2v_span(vid))
     {
         switch (tex_coord)
         {
@@ -570,8 +642,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int AbstractMesh<M,V,E,P>::vert_valence(const unsigned int vid) const
 {
-    assert(adj_v2v(vid).size() == adj_v2e(vid).size());
-    return adj_v2v(vid).size();
+    assert(adj_v2v_span(vid).size() == adj_v2e_span(vid).size());
+    return adj_v2v_span(vid).size();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -710,7 +782,7 @@ CINO_INLINE
 int AbstractMesh<M,V,E,P>::edge_id(const unsigned int vid0, const unsigned int vid1) const
 {
     assert(vid0 != vid1);
-    for(unsigned int eid : adj_v2e(vid0))
+    for(unsigned int eid : adj_v2e_span(vid0))
     {
         if(edge_contains_vert(eid,vid0) && edge_contains_vert(eid,vid1))
         {
@@ -745,7 +817,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int AbstractMesh<M,V,E,P>::edge_valence(const unsigned int eid) const
 {
-    return this->adj_e2p(eid).size();
+    return this->adj_e2p_span(eid).size();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -829,8 +901,8 @@ CINO_INLINE
 double AbstractMesh<M,V,E,P>::edge_avg_length(const unsigned int vid) const
 {
     double avg = 0;
-    for(unsigned int eid : this->adj_v2e(vid)) avg += edge_length(eid);
-    if(num_edges() > 0) avg/=static_cast<double>(this->adj_v2e(vid).size());
+    for(unsigned int eid : this->adj_v2e_span(vid)) avg += edge_length(eid);
+    if(num_edges() > 0) avg/=static_cast<double>(this->adj_v2e_span(vid).size());
     return avg;
 }
 
@@ -994,7 +1066,7 @@ std::vector<unsigned int> AbstractMesh<M,V,E,P>::poly_v2v(const unsigned int pid
 {
     assert(this->poly_contains_vert(pid,vid));
     std::vector<unsigned int> verts;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if(this->poly_contains_edge(pid,eid)) verts.push_back(this->vert_opposite_to(eid,vid));
     }
@@ -1009,7 +1081,7 @@ std::vector<unsigned int> AbstractMesh<M,V,E,P>::poly_v2e(const unsigned int pid
 {
     assert(this->poly_contains_vert(pid,vid));
     std::vector<unsigned int> edges;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if(this->poly_contains_edge(pid,eid)) edges.push_back(eid);
     }
@@ -1034,7 +1106,7 @@ unsigned int AbstractMesh<M,V,E,P>::poly_edge_id(const unsigned int fid, const u
     assert(poly_contains_vert(fid,vid0));
     assert(poly_contains_vert(fid,vid1));
 
-    for(unsigned int eid : adj_p2e(fid))
+    for(unsigned int eid : adj_p2e_span(fid))
     {
         if (edge_contains_vert(eid,vid0) && edge_contains_vert(eid,vid1)) return eid;
     }
@@ -1049,7 +1121,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractMesh<M,V,E,P>::poly_contains_edge(const unsigned int pid, const unsigned int eid) const
 {
-    for(unsigned int e : adj_p2e(pid)) if (e == eid) return true;
+    for(unsigned int e : adj_p2e_span(pid)) if (e == eid) return true;
     return false;
 }
 
@@ -1059,7 +1131,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractMesh<M,V,E,P>::poly_contains_edge(const unsigned int pid, const unsigned int vid0, const unsigned int vid1) const
 {
-    for(unsigned int eid : adj_p2e(pid))
+    for(unsigned int eid : adj_p2e_span(pid))
     {
         if (edge_contains_vert(eid, vid0) &&
             edge_contains_vert(eid, vid1))
@@ -40,6 +40,8 @@
 #include <cinolib/meshes/mesh_attributes.h>
 #include <cinolib/ipair.h>
 #include <cinolib/symbols.h>
+#include <cstdint>
+#include <cassert>
 
 namespace cinolib
 {
@@ -55,6 +57,17 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         std::vector<std::vector<unsigned int>> poly_triangles; // triangles covering each quad. Useful for
                                                        // robust normal estimation and rendering
 
+        // tombstones of the elements removed while batch edits are open (see batch_edits_begin)
+        bool              batch_edits = false;
+        std::vector<bool> v_dead, e_dead, p_dead;
+        unsigned int      nv_dead = 0, ne_dead = 0, np_dead = 0;
+
+        // elements touched while lazy updates are enabled (see lazy_updates_begin)
+        enum { DIRTY_NORMAL = 0x1, DIRTY_TESSELLATION = 0x2 };
+        bool                      lazy_updates = false;
+        std::vector<uint8_t>      v_dirty, p_dirty;         // per element DIRTY_* flags
+        std::vector<unsigned int> v_dirty_ids, p_dirty_ids; // candidates for refresh (may contain duplicates)
+
     public:
 
         explicit AbstractPolygonMesh() : AbstractMesh<M,V,E,P>() {}
@@ -65,11 +78,19 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
         void load(const char * filename) override;
         void save(const char * filename) const override;
 
+        // native binary format (.cinobin). Besides vertices and polygons, files store edges, the
+        // per element attributes and, optionally, the whole adjacency, so that loading requires
+        // no parsing and no init (the mesh is loaded with frozen adjacency, see adj_freeze)
+        void load_BIN(const char * filename);
+        void save_BIN(const char * filename, const bool with_adjacency = true) const;
+
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
         void clear() override;
         void init(const std::vector<vec3d>             & verts,
                   const std::vector<std::vector<unsigned int>> & polys);
+        void init_incremental(const std::vector<vec3d>             & verts,  // reference construction (one poly_add per polygon).
+                              const std::vector<std::vector<unsigned int>> & polys); // Slower than init(), but yields the same topology
         void init(      std::vector<vec3d>             & pos,       // vertex xyz positions
                         std::vector<vec3d>             & tex,       // vertex uv(w) texture coordinates
                         std::vector<vec3d>             & nor,       // vertex normals
@@ -191,7 +212,67 @@ class AbstractPolygonMesh : public AbstractMesh<M,V,E,P>
               bool                 poly_verts_are_CCW      (const unsigned int pid, const unsigned int curr, const unsigned int prev) const;
               std::vector<vec3d>   poly_vlist              (const unsigned int pid) const;
         const std::vector<unsigned int>  & poly_tessellation       (const unsigned int pid) const;
+              vec3d                poly_normal             (const unsigned int pid) const; // poly_data(pid).normal, refreshed if dirty (see lazy_updates_begin)
               void                 poly_export_element     (const unsigned int pid, std::vector<vec3d> & verts, std::vector<std::vector<unsigned int>> & faces) const override;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        /* Batch edits. Removing an element normally moves the last element of its kind in
+         * its place, patching all the relations of both. While batch edits are open, removed
+         * elements are instead disconnected from the rest of the mesh and marked as dead, so
+         * that the ids of all the other elements do not change. compact() deletes all dead
+         * elements at once, renumbering the survivors (in their original order) with a single
+         * pass over relations and attributes, and returns the old to new maps (-1 for deleted
+         * elements). Elements added during batch edits are appended as usual.
+         *
+         * NOTE: while batch edits are open num_verts/edges/polys also count dead elements,
+         * hence global loops must skip them (vert/edge/poly_is_dead). Local queries and
+         * topological operators (split, collapse, flip...) are safe to use.
+        */
+        void batch_edits_begin();
+        void batch_edits_end(); // compacts the mesh and goes back to immediate removal
+        bool batch_edits_open() const { return batch_edits; }
+        bool vert_is_dead(const unsigned int vid) const { return vid<v_dead.size() && v_dead[vid]; }
+        bool edge_is_dead(const unsigned int eid) const { return eid<e_dead.size() && e_dead[eid]; }
+        bool poly_is_dead(const unsigned int pid) const { return pid<p_dead.size() && p_dead[pid]; }
+        void compact();
+        void compact(std::vector<int> & v_map, std::vector<int> & e_map, std::vector<int> & p_map);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        /* Lazy updates. Edit primitives (poly_add, edge_split, edge_collapse...) normally update
+         * normals and tessellations of the elements they create as they go, while anything else
+         * is left to global updates (update_normals, update_bbox...) that walk the whole mesh.
+         * While lazy updates are enabled, edit primitives only mark the elements they touch
+         * as dirty. refresh() recomputes normals and tessellations of dirty elements only (in
+         * parallel), and the bounding box if any vertex moved or was deleted. Tessellations
+         * and bounding box are also refreshed at their first access (poly_tessellation, bbox).
+         * Code that moves vertices directly (e.g. m.vert(vid) = p) should call vert_set_dirty.
+         *
+         * With eager updates vert_set_dirty only grows the bounding box to include the new
+         * position, so it may stay loose if a vertex moves inwards (update_bbox makes it tight).
+         *
+         * NOTE: normals are plain attributes: call refresh() before reading them. poly_normal
+         * and poly_tessellation update dirty polygons in place, which is not thread safe: they
+         * must not be called on a dirty mesh from parallel loops (PARALLEL_FOR...), refresh() first.
+        */
+        void lazy_updates_begin();
+        void lazy_updates_end(); // refreshes the mesh and goes back to eager updates
+        bool lazy_updates_enabled() const { return lazy_updates; }
+        void refresh();
+        void vert_set_dirty(const unsigned int vid); // vid moved: normals and tessellations around it, and the bbox
+        void poly_set_dirty(const unsigned int pid); // normal and tessellation of pid, and the normals of its verts
+
+    protected:
+
+        bool init_connectivity_bulk       (const std::vector<vec3d>             & verts,
+                                           const std::vector<std::vector<unsigned int>> & polys);
+        void init_connectivity_incremental(const std::vector<vec3d>             & verts,
+                                           const std::vector<std::vector<unsigned int>> & polys);
+        void init_finalize                ();
+
+        void mark_vert_dirty(const unsigned int vid);
+        void mark_poly_dirty(const unsigned int pid, const uint8_t flags = DIRTY_NORMAL | DIRTY_TESSELLATION);
 };
 
 }
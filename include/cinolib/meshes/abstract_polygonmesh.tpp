@@ -43,9 +43,13 @@
 #include <cinolib/how_many_seconds.h>
 #include <cinolib/deg_rad.h>
 #include <unordered_set>
+#include <algorithm>
+#include <atomic>
 #include <cinolib/ANSI_color_codes.h>
 #include <queue>
 #include <cinolib/pi.h>
+#include <cinolib/parallel_for.h>
+#include <cinolib/trace_profiler.h>
 
 namespace cinolib
 {
@@ -56,6 +60,14 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::load(const char * filename)
 {
+    CINO_PROFILE_ZONE("AbstractPolygonMesh::load");
+    std::string str(filename);
+    if(str.size()>=8 && str.substr(str.size()-8,8).compare(".cinobin") == 0)
+    {
+        load_BIN(filename);
+        return;
+    }
+
     this->clear();
     this->mesh_data().filename = std::string(filename);
 
@@ -68,7 +80,6 @@ void AbstractPolygonMesh<M,V,E,P>::load(const char * filename)
     std::vector<Color>             poly_col; // per polygon colors
     std::vector<int>               poly_lab; // per polygon labels
 
-    std::string str(filename);
     std::string filetype = str.substr(str.size()-4,4);
 
     if (filetype.compare(".off") == 0 ||
@@ -103,9 +114,15 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 {
+    std::string str(filename);
+    if(str.size()>=8 && str.substr(str.size()-8,8).compare(".cinobin") == 0)
+    {
+        save_BIN(filename);
+        return;
+    }
+
     std::vector<double> coords = serialized_xyz_from_vec3d(this->verts);
 
-    std::string str(filename);
     std::string filetype = str.substr(str.size()-3,3);
 
     if (filetype.compare("off") == 0 ||
@@ -144,12 +161,278 @@ void AbstractPolygonMesh<M,V,E,P>::save(const char * filename) const
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// sections of a mesh .cinobin file (all indices are unsigned int, lists are in CSR format):
+//
+//  verts                             vertex coordinates (vec3d)
+//  poly_offsets, poly_verts          polygons
+//  tri_offsets,  tri_verts           polygon tessellations
+//  edges                             edge endpoints (pairs of vertex ids)
+//  v_normal, v_color, v_uvw, ...     per element attributes, one section (column) for each field
+//  v2v_offsets,  v2v, ...            adjacency relations (optional)
+//
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::save_BIN(const char * filename, const bool with_adjacency) const
+{
+    static_assert(sizeof(vec3d)==3*sizeof(double), "vec3d is expected to be a tightly packed triplet of doubles");
+    static_assert(sizeof(Color)==4*sizeof(float),  "Color is expected to be a tightly packed quadruplet of floats");
+
+    unsigned int nv = this->num_verts();
+    unsigned int ne = this->num_edges();
+    unsigned int np = this->num_polys();
+
+    std::vector<BINSection> sections;
+    auto add = [&](const std::string & tag, const void * data, const size_t bytes)
+    {
+        sections.push_back({tag, data, bytes});
+    };
+    auto add_csr = [&](const std::string & tag_offsets, const std::string & tag_index, const CompressedAdjacency & csr)
+    {
+        add(tag_offsets, csr.offset.data(), csr.offset.size()*sizeof(unsigned int));
+        add(tag_index,   csr.index.data(),  csr.index.size() *sizeof(unsigned int));
+    };
+
+    CompressedAdjacency p2v(this->polys);
+    CompressedAdjacency tris(poly_triangles);
+    add("verts", this->verts.data(), nv*sizeof(vec3d));
+    add_csr("poly_offsets", "poly_verts", p2v);
+    add_csr("tri_offsets",  "tri_verts",  tris);
+    add("edges", this->edges.data(), this->edges.size()*sizeof(unsigned int));
+
+    // per element attributes, gathered in columns
+    std::vector<vec3d>   v_normal(nv), v_uvw(nv), p_normal(np);
+    std::vector<Color>   v_color(nv), e_color(ne), p_color(np);
+    std::vector<int>     v_label(nv), e_label(ne), p_label(np);
+    std::vector<float>   v_quality(nv), p_quality(np), p_AO(np);
+    std::vector<uint8_t> v_flags(nv), e_flags(ne), p_flags(np);
+    for(unsigned int vid=0; vid<nv; ++vid)
+    {
+        v_normal.at(vid)  = this->vert_data(vid).normal;
+        v_color.at(vid)   = this->vert_data(vid).color;
+        v_uvw.at(vid)     = this->vert_data(vid).uvw;
+        v_label.at(vid)   = this->vert_data(vid).label;
+        v_quality.at(vid) = this->vert_data(vid).quality;
+        v_flags.at(vid)   = static_cast<uint8_t>(this->vert_data(vid).flags.to_ulong());
+    }
+    for(unsigned int eid=0; eid<ne; ++eid)
+    {
+        e_color.at(eid) = this->edge_data(eid).color;
+        e_label.at(eid) = this->edge_data(eid).label;
+        e_flags.at(eid) = static_cast<uint8_t>(this->edge_data(eid).flags.to_ulong());
+    }
+    for(unsigned int pid=0; pid<np; ++pid)
+    {
+        p_normal.at(pid)  = this->poly_data(pid).normal;
+        p_color.at(pid)   = this->poly_data(pid).color;
+        p_label.at(pid)   = this->poly_data(pid).label;
+        p_quality.at(pid) = this->poly_data(pid).quality;
+        p_AO.at(pid)      = this->poly_data(pid).AO;
+        p_flags.at(pid)   = static_cast<uint8_t>(this->poly_data(pid).flags.to_ulong());
+    }
+    add("v_normal",  v_normal.data(),  nv*sizeof(vec3d));
+    add("v_color",   v_color.data(),   nv*sizeof(Color));
+    add("v_uvw",     v_uvw.data(),     nv*sizeof(vec3d));
+    add("v_label",   v_label.data(),   nv*sizeof(int));
+    add("v_quality", v_quality.data(), nv*sizeof(float));
+    add("v_flags",   v_flags.data(),   nv*sizeof(uint8_t));
+    add("e_color",   e_color.data(),   ne*sizeof(Color));
+    add("e_label",   e_label.data(),   ne*sizeof(int));
+    add("e_flags",   e_flags.data(),   ne*sizeof(uint8_t));
+    add("p_normal",  p_normal.data(),  np*sizeof(vec3d));
+    add("p_color",   p_color.data(),   np*sizeof(Color));
+    add("p_label",   p_label.data(),   np*sizeof(int));
+    add("p_quality", p_quality.data(), np*sizeof(float));
+    add("p_AO",      p_AO.data(),      np*sizeof(float));
+    add("p_flags",   p_flags.data(),   np*sizeof(uint8_t));
+
+    // adjacency (stored as is if frozen, compressed on the fly otherwise)
+    CompressedAdjacency tmp[6];
+    if(with_adjacency)
+    {
+        if(!this->adj_frozen)
+        {
+            tmp[0].compress(this->v2v);
+            tmp[1].compress(this->v2e);
+            tmp[2].compress(this->v2p);
+            tmp[3].compress(this->e2p);
+            tmp[4].compress(this->p2e);
+            tmp[5].compress(this->p2p);
+        }
+        add_csr("v2v_offsets", "v2v", this->adj_frozen ? this->v2v_csr : tmp[0]);
+        add_csr("v2e_offsets", "v2e", this->adj_frozen ? this->v2e_csr : tmp[1]);
+        add_csr("v2p_offsets", "v2p", this->adj_frozen ? this->v2p_csr : tmp[2]);
+        add_csr("e2p_offsets", "e2p", this->adj_frozen ? this->e2p_csr : tmp[3]);
+        add_csr("p2e_offsets", "p2e", this->adj_frozen ? this->p2e_csr : tmp[4]);
+        add_csr("p2p_offsets", "p2p", this->adj_frozen ? this->p2p_csr : tmp[5]);
+    }
+
+    write_BIN(filename, sections);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::load_BIN(const char * filename)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+    this->clear();
+    this->mesh_data().filename = std::string(filename);
+
+    BINFile f;
+    if(!f.open(filename))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_BIN() : couldn't open input file (or invalid .cinobin) " << filename << std::endl;
+        exit(-1);
+    }
+
+    // n lists of indices in [0,max_index). Malformed relations are rejected, as
+    // the adj_* accessors would otherwise read out of bounds
+    auto csr = [&](const std::string & tag_offsets, const std::string & tag_index, const size_t n, const size_t max_index, CompressedAdjacency & rel) -> bool
+    {
+        size_t n_off, n_idx;
+        const unsigned int *off = f.section<unsigned int>(tag_offsets, n_off);
+        const unsigned int *idx = f.section<unsigned int>(tag_index,   n_idx);
+        if(n_off!=n+1 || !BIN_valid_csr(off, n_off, idx, n_idx, max_index)) return false;
+        rel.offset.assign(off, off+n_off);
+        rel.index.assign(idx, idx+n_idx);
+        return true;
+    };
+
+    size_t nv, ne;
+    const vec3d        *verts = f.section<vec3d>("verts", nv);
+    const unsigned int *edges = f.section<unsigned int>("edges", ne);
+    ne /= 2;
+
+    size_t n_off;
+    f.section<unsigned int>("poly_offsets", n_off);
+    CompressedAdjacency p2v;
+    if(verts==nullptr || n_off==0 || !csr("poly_offsets", "poly_verts", n_off-1, nv, p2v))
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : load_BIN() : missing or malformed vertices/polygons in " << filename << std::endl;
+        exit(-1);
+    }
+    std::vector<std::vector<unsigned int>> polys = p2v.decompress();
+    size_t np = polys.size();
+
+    // if the file contains the full connectivity use it as is, otherwise rebuild it
+    bool valid_edges   = (edges!=nullptr) && std::all_of(edges, edges+2*ne, [nv](const unsigned int vid){ return vid<nv; });
+    bool has_adjacency = valid_edges &&
+                         csr("v2v_offsets", "v2v", nv, nv, this->v2v_csr) &&
+                         csr("v2e_offsets", "v2e", nv, ne, this->v2e_csr) &&
+                         csr("v2p_offsets", "v2p", nv, np, this->v2p_csr) &&
+                         csr("e2p_offsets", "e2p", ne, np, this->e2p_csr) &&
+                         csr("p2e_offsets", "p2e", np, ne, this->p2e_csr) &&
+                         csr("p2p_offsets", "p2p", np, np, this->p2p_csr);
+    if(has_adjacency)
+    {
+        this->verts.assign(verts, verts+nv);
+        this->edges.assign(edges, edges+2*ne);
+        this->polys.swap(polys);
+        this->adj_frozen = true;
+        this->v_data.resize(nv);
+        this->e_data.resize(ne);
+        this->p_data.resize(np);
+
+        CompressedAdjacency tris;
+        if(csr("tri_offsets", "tri_verts", np, nv, tris)) poly_triangles = tris.decompress();
+        else
+        {
+            poly_triangles.resize(np);
+            update_p_tessellations();
+        }
+        if(this->mesh_data().update_bbox) this->update_bbox();
+    }
+    else
+    {
+        for(auto rel : { &this->v2v_csr, &this->v2e_csr, &this->v2p_csr, &this->e2p_csr, &this->p2e_csr, &this->p2p_csr }) rel->clear();
+        std::vector<vec3d> pos(verts, verts+nv);
+        if(!init_connectivity_bulk(pos, polys))
+        {
+            AbstractMesh<M,V,E,P>::clear();
+            poly_triangles.clear();
+            init_connectivity_incremental(pos, polys);
+            this->mesh_data().filename = std::string(filename);
+        }
+    }
+
+    // attributes can be restored only for elements that kept their ids
+    bool same_edges = has_adjacency || (valid_edges && this->num_edges()==ne && std::equal(edges, edges+2*ne, this->edges.begin()));
+    bool same_polys = (this->num_polys()==np);
+
+    // per element attributes. Missing columns are recomputed (normals, uvw, flags) or left to default
+    const vec3d   *v_normal  = f.column<vec3d>("v_normal", nv);
+    const Color   *v_color   = f.column<Color>("v_color", nv);
+    const vec3d   *v_uvw     = f.column<vec3d>("v_uvw", nv);
+    const int     *v_label   = f.column<int>("v_label", nv);
+    const float   *v_quality = f.column<float>("v_quality", nv);
+    const uint8_t *v_flags   = f.column<uint8_t>("v_flags", nv);
+    const Color   *e_color   = same_edges ? f.column<Color>("e_color", ne)    : nullptr;
+    const int     *e_label   = same_edges ? f.column<int>("e_label", ne)      : nullptr;
+    const uint8_t *e_flags   = same_edges ? f.column<uint8_t>("e_flags", ne)  : nullptr;
+    const vec3d   *p_normal  = same_polys ? f.column<vec3d>("p_normal", np)   : nullptr;
+    const Color   *p_color   = same_polys ? f.column<Color>("p_color", np)    : nullptr;
+    const int     *p_label   = same_polys ? f.column<int>("p_label", np)      : nullptr;
+    const float   *p_quality = same_polys ? f.column<float>("p_quality", np)  : nullptr;
+    const float   *p_AO      = same_polys ? f.column<float>("p_AO", np)       : nullptr;
+    const uint8_t *p_flags   = same_polys ? f.column<uint8_t>("p_flags", np)  : nullptr;
+
+    if(has_adjacency && p_normal==nullptr && this->mesh_data().update_normals) update_p_normals();
+    if(!has_adjacency || v_normal==nullptr || v_uvw==nullptr || e_flags==nullptr) init_finalize();
+
+    PARALLEL_FOR(0, nv, 10000, [&](const unsigned int vid)
+    {
+        if(v_normal ) this->vert_data(vid).normal  = v_normal[vid];
+        if(v_color  ) this->vert_data(vid).color   = v_color[vid];
+        if(v_uvw    ) this->vert_data(vid).uvw     = v_uvw[vid];
+        if(v_label  ) this->vert_data(vid).label   = v_label[vid];
+        if(v_quality) this->vert_data(vid).quality = v_quality[vid];
+        if(v_flags  ) this->vert_data(vid).flags   = v_flags[vid];
+    });
+    PARALLEL_FOR(0, this->num_edges(), 10000, [&](const unsigned int eid)
+    {
+        if(e_color) this->edge_data(eid).color = e_color[eid];
+        if(e_label) this->edge_data(eid).label = e_label[eid];
+        if(e_flags) this->edge_data(eid).flags = e_flags[eid];
+    });
+    PARALLEL_FOR(0, this->num_polys(), 10000, [&](const unsigned int pid)
+    {
+        if(p_normal ) this->poly_data(pid).normal  = p_normal[pid];
+        if(p_color  ) this->poly_data(pid).color   = p_color[pid];
+        if(p_label  ) this->poly_data(pid).label   = p_label[pid];
+        if(p_quality) this->poly_data(pid).quality = p_quality[pid];
+        if(p_AO     ) this->poly_data(pid).AO      = p_AO[pid];
+        if(p_flags  ) this->poly_data(pid).flags   = p_flags[pid];
+    });
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "load mesh\t"     <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_polys() << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::clear()
 {
     AbstractMesh<M,V,E,P>::clear();
     poly_triangles.clear();
+    batch_edits = false;
+    v_dead.clear();
+    e_dead.clear();
+    p_dead.clear();
+    nv_dead = ne_dead = np_dead = 0;
+    lazy_updates = false;
+    v_dirty.clear();
+    p_dirty.clear();
+    v_dirty_ids.clear();
+    p_dirty_ids.clear();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -159,8 +442,57 @@ CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & verts,
                                         const std::vector<std::vector<unsigned int>> & polys)
 {
+    CINO_PROFILE_ZONE("AbstractPolygonMesh::init");
     std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
 
+    // duplicated polygons are discarded by poly_add, shifting the ids of all
+    // subsequent polygons. In that (rare) case resort to the incremental path
+    if(!init_connectivity_bulk(verts, polys))
+    {
+        AbstractMesh<M,V,E,P>::clear();
+        poly_triangles.clear();
+        init_connectivity_incremental(verts, polys);
+    }
+    init_finalize();
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "load mesh\t"     <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_polys() << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::init_incremental(const std::vector<vec3d>             & verts,
+                                                    const std::vector<std::vector<unsigned int>> & polys)
+{
+    std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
+
+    init_connectivity_incremental(verts, polys);
+    init_finalize();
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    std::cout << "load mesh\t"     <<
+                 this->num_verts() << "V / " <<
+                 this->num_edges() << "E / " <<
+                 this->num_polys() << "P  [" <<
+                 how_many_seconds(t0,t1) << "s]" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::init_connectivity_incremental(const std::vector<vec3d>             & verts,
+                                                                 const std::vector<std::vector<unsigned int>> & polys)
+{
+    this->adj_thaw();
     // pre-allocate memory
     unsigned int nv = verts.size();
     unsigned int np = polys.size();
@@ -182,7 +514,224 @@ void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & v
     // initialize mesh connectivity (and normals)
     for(auto v : verts) this->vert_add(v);
     for(auto p : polys) this->poly_add(p);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool AbstractPolygonMesh<M,V,E,P>::init_connectivity_bulk(const std::vector<vec3d>             & verts,
+                                                          const std::vector<std::vector<unsigned int>> & polys)
+{
+    this->adj_thaw();
+    // Builds edges and all adjacency relations at once, without calling poly_add.
+    // Each polygon corner defines a half edge (vid,next_vid). Half edges are bucket
+    // sorted by their smallest endpoint (i.e. a one pass radix sort on the first key)
+    // and then each bucket is sorted by the other endpoint. Runs of equal keys are
+    // the mesh edges. Ids and the order of all adjacency lists are assigned so as to
+    // exactly replicate what the incremental path (poly_add) would produce.
+
+    unsigned int nv = verts.size();
+    unsigned int np = polys.size();
+
+    // half edges (i.e. polygon corners) are indexed as poly_offset[pid]+i
+    std::vector<unsigned int> poly_offset(np+1,0);
+    for(unsigned int pid=0; pid<np; ++pid) poly_offset[pid+1] = poly_offset[pid] + polys[pid].size();
+    unsigned int nh = poly_offset.back();
+
+    std::vector<unsigned int> he_poly(nh);
+    PARALLEL_FOR(0, np, 1000, [&](const unsigned int pid)
+    {
+        for(unsigned int h=poly_offset[pid]; h<poly_offset[pid+1]; ++h) he_poly[h] = pid;
+    });
+
+    auto he_v0 = [&](const unsigned int h) -> unsigned int
+    {
+        return polys[he_poly[h]][h-poly_offset[he_poly[h]]];
+    };
+    auto he_v1 = [&](const unsigned int h) -> unsigned int
+    {
+        unsigned int pid = he_poly[h];
+        unsigned int off = h - poly_offset[pid] + 1;
+        return polys[pid][(off<polys[pid].size()) ? off : 0];
+    };
+
+    // bucket half edges by their smallest endpoint (counting sort, stable wrt h)
+    std::vector<unsigned int> bucket_offset(nv+1,0);
+    for(unsigned int h=0; h<nh; ++h)
+    {
+        assert(he_v0(h)<nv && he_v1(h)<nv);
+        ++bucket_offset[std::min(he_v0(h),he_v1(h))+1];
+    }
+    for(unsigned int vid=0; vid<nv; ++vid) bucket_offset[vid+1] += bucket_offset[vid];
+    std::vector<unsigned int> sorted_he(nh);
+    {
+        std::vector<unsigned int> pos(bucket_offset.begin(), bucket_offset.end()-1);
+        for(unsigned int h=0; h<nh; ++h) sorted_he[pos[std::min(he_v0(h),he_v1(h))]++] = h;
+    }
+
+    // sort buckets by the largest endpoint and flag the first half edge of each run
+    std::vector<unsigned int> he_head(nh);
+    std::vector<char>         is_head(nh,false);
+    PARALLEL_FOR(0, nv, 1000, [&](const unsigned int vid)
+    {
+        auto beg = sorted_he.begin() + bucket_offset[vid];
+        auto end = sorted_he.begin() + bucket_offset[vid+1];
+        std::sort(beg, end, [&](const unsigned int h0, const unsigned int h1)
+        {
+            unsigned int v0 = std::max(he_v0(h0),he_v1(h0));
+            unsigned int v1 = std::max(he_v0(h1),he_v1(h1));
+            return (v0<v1) || (v0==v1 && h0<h1);
+        });
+        for(auto it=beg; it!=end; ++it)
+        {
+            if(it==beg || std::max(he_v0(*it),he_v1(*it)) != std::max(he_v0(*(it-1)),he_v1(*(it-1))))
+            {
+                is_head[*it] = true;
+            }
+            he_head[*it] = is_head[*it] ? *it : he_head[*(it-1)];
+        }
+    });
+
+    // edge ids follow the order of first appearance (as in poly_add)
+    std::vector<unsigned int> head_eid(nh);
+    unsigned int ne = 0;
+    for(unsigned int h=0; h<nh; ++h) if(is_head[h]) head_eid[h] = ne++;
+
+    std::vector<unsigned int> he_edge(nh);
+    PARALLEL_FOR(0, nh, 1000, [&](const unsigned int h)
+    {
+        he_edge[h] = head_eid[he_head[h]];
+    });
+
+    // allocate all the mesh containers at once
+    this->verts = verts;
+    this->polys = polys;
+    this->edges.resize(2*ne);
+    this->v_data.resize(nv);
+    this->e_data.resize(ne);
+    this->p_data.resize(np);
+    this->v2v.resize(nv);
+    this->v2e.resize(nv);
+    this->v2p.resize(nv);
+    this->e2p.resize(ne);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+    this->poly_triangles.resize(np);
+
+    // edges and edge to poly adjacency (half edges in a run are sorted by pid)
+    PARALLEL_FOR(0, nv, 1000, [&](const unsigned int vid)
+    {
+        for(unsigned int i=bucket_offset[vid]; i<bucket_offset[vid+1]; ++i)
+        {
+            unsigned int h   = sorted_he[i];
+            unsigned int eid = he_edge[h];
+            if(is_head[h])
+            {
+                this->edges[2*eid  ] = he_v0(h);
+                this->edges[2*eid+1] = he_v1(h);
+                unsigned int run = 1;
+                while(i+run<bucket_offset[vid+1] && !is_head[sorted_he[i+run]]) ++run;
+                this->e2p[eid].reserve(run);
+            }
+            this->e2p[eid].push_back(he_poly[h]);
+        }
+    });
+
+    // vert to vert/edge adjacency, in edge order
+    std::vector<unsigned int> v_count(nv,0);
+    for(unsigned int vid : this->edges) ++v_count[vid];
+    for(unsigned int vid=0; vid<nv; ++vid)
+    {
+        this->v2v[vid].reserve(v_count[vid]);
+        this->v2e[vid].reserve(v_count[vid]);
+    }
+    for(unsigned int eid=0; eid<ne; ++eid)
+    {
+        unsigned int vid0 = this->edges[2*eid  ];
+        unsigned int vid1 = this->edges[2*eid+1];
+        this->v2v[vid1].push_back(vid0);
+        this->v2v[vid0].push_back(vid1);
+        this->v2e[vid0].push_back(eid);
+        this->v2e[vid1].push_back(eid);
+    }
 
+    // vert to poly adjacency, in poly order
+    std::fill(v_count.begin(), v_count.end(), 0);
+    for(const auto & p : polys) for(unsigned int vid : p) ++v_count[vid];
+    for(unsigned int vid=0; vid<nv; ++vid) this->v2p[vid].reserve(v_count[vid]);
+    for(unsigned int pid=0; pid<np; ++pid)
+    {
+        for(unsigned int vid : polys[pid]) this->v2p[vid].push_back(pid);
+    }
+
+    // poly_add silently skips duplicated polygons. Detect them and abort
+    std::atomic<bool> has_duplicates(false);
+    PARALLEL_FOR(0, np, 1000, [&](const unsigned int pid)
+    {
+        const std::vector<unsigned int> & p = polys[pid];
+        for(unsigned int nbr : this->v2p[p.front()])
+        {
+            if(nbr>=pid) break;
+            const std::vector<unsigned int> & q = polys[nbr];
+            if(q.size()!=p.size()) continue;
+            bool same_verts = true; // same multiset of vertices, without sorting/allocating
+            for(unsigned int vid : q)
+            {
+                if(std::count(q.begin(),q.end(),vid) != std::count(p.begin(),p.end(),vid))
+                {
+                    same_verts = false;
+                    break;
+                }
+            }
+            if(same_verts) has_duplicates.store(true, std::memory_order_relaxed);
+        }
+    });
+    if(has_duplicates.load()) return false;
+
+    // poly to edge/poly adjacency. p2p lists first contain the polygons preceding
+    // pid (in the order in which they are met walking along its edges), followed
+    // by the polygons that come after pid, in ascending order
+    PARALLEL_FOR(0, np, 1000, [&](const unsigned int pid)
+    {
+        std::vector<unsigned int> & adj = this->p2p[pid];
+        unsigned int n_adj = 0;
+        for(unsigned int h=poly_offset[pid]; h<poly_offset[pid+1]; ++h) n_adj += this->e2p[he_edge[h]].size()-1;
+        adj.reserve(n_adj);
+        this->p2e[pid].assign(he_edge.begin()+poly_offset[pid], he_edge.begin()+poly_offset[pid+1]);
+        for(unsigned int eid : this->p2e[pid])
+        for(unsigned int nbr : this->e2p[eid])
+        {
+            if(nbr<pid && DOES_NOT_CONTAIN_VEC(adj,nbr)) adj.push_back(nbr);
+        }
+        auto succ = adj.end() - adj.begin();
+        for(unsigned int eid : this->p2e[pid])
+        for(unsigned int nbr : this->e2p[eid])
+        {
+            if(nbr>pid) adj.push_back(nbr);
+        }
+        std::sort(adj.begin()+succ, adj.end());
+        adj.erase(std::unique(adj.begin()+succ, adj.end()), adj.end());
+    });
+
+    // per poly geometric data
+    PARALLEL_FOR(0, np, 1000, [&](const unsigned int pid)
+    {
+        if(this->mesh_data().update_normals) this->update_p_normal(pid);
+        update_p_tessellation(pid);
+    });
+
+    if(this->mesh_data().update_bbox) this->update_bbox();
+
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::init_finalize()
+{
     if(this->mesh_data().update_normals) this->update_v_normals();
 
     this->copy_xyz_to_uvw(UVW_param);
@@ -191,14 +740,6 @@ void AbstractPolygonMesh<M,V,E,P>::init(const std::vector<vec3d>             & v
     {
         this->edge_data(eid).flags[MARKED] = (this->edge_is_boundary(eid) || !this->edge_is_manifold(eid));
     }
-
-    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
-
-    std::cout << "load mesh\t"     <<
-                 this->num_verts() << "V / " <<
-                 this->num_edges() << "E / " <<
-                 this->num_polys() << "P  [" <<
-                 how_many_seconds(t0,t1) << "s]" << std::endl;
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -346,7 +887,7 @@ CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::update_v_normal(const unsigned int vid)
 {
     vec3d n{0,0,0};
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         n += this->poly_data(pid).normal;
     }
@@ -418,9 +959,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int AbstractPolygonMesh<M,V,E,P>::Euler_characteristic() const
 {
-    unsigned int nv = this->num_verts();
-    unsigned int ne = this->num_edges();
-    unsigned int np = this->num_polys();
+    // dead elements (see batch_edits_begin) do not count
+    unsigned int nv = this->num_verts() - nv_dead;
+    unsigned int ne = this->num_edges() - ne_dead;
+    unsigned int np = this->num_polys() - np_dead;
     return nv - ne + np;
 }
 
@@ -479,7 +1021,7 @@ double AbstractPolygonMesh<M,V,E,P>::mesh_volume() const
             vec3d C    = this->vert(this->poly_tessellation(pid).at(3*i+2));
 
             vec3d OA   = A - O;
-            vec3d n    = this->poly_data(pid).normal;
+            vec3d n    = this->poly_normal(pid);
 
             vol += (n.dot(OA) > 0) ?  tet_unsigned_volume(A,B,C,O)
                                    : -tet_unsigned_volume(A,B,C,O);
@@ -572,12 +1114,12 @@ void AbstractPolygonMesh<M,V,E,P>::vert_ordered_one_ring(const unsigned int vid,
     e_star.clear();
     e_link.clear();
 
-    if (this->adj_v2e(vid).empty()) return;
-    unsigned int curr_e  = this->adj_v2e(vid).front(); assert(edge_is_manifold(curr_e));
+    if (this->adj_v2e_span(vid).empty()) return;
+    unsigned int curr_e  = this->adj_v2e_span(vid).front(); assert(edge_is_manifold(curr_e));
     unsigned int curr_v  = this->vert_opposite_to(curr_e, vid);
-    unsigned int curr_p  = this->adj_e2p(curr_e).front();
+    unsigned int curr_p  = this->adj_e2p_span(curr_e).front();
     // impose CCW winding...
-    if (!this->poly_verts_are_CCW(curr_p, curr_v, vid)) curr_p = this->adj_e2p(curr_e).back();
+    if (!this->poly_verts_are_CCW(curr_p, curr_v, vid)) curr_p = this->adj_e2p_span(curr_e).back();
 
     // If there are boundary edges it is important to start from the right triangle (i.e. right-most),
     // otherwise it will be impossible to cover the entire umbrella
@@ -587,13 +1129,13 @@ void AbstractPolygonMesh<M,V,E,P>::vert_ordered_one_ring(const unsigned int vid,
         assert(b_edges.size() == 2); // otherwise there is no way to cover the whole umbrella walking through adjacent triangles!!!
 
         unsigned int e = b_edges.front();
-        unsigned int p = this->adj_e2p(e).front();
+        unsigned int p = this->adj_e2p_span(e).front();
         unsigned int v = this->vert_opposite_to(e, vid);
 
         if (!this->poly_verts_are_CCW(p, v, vid))
         {
             e = b_edges.back();
-            p = this->adj_e2p(e).front();
+            p = this->adj_e2p_span(e).front();
             v = this->vert_opposite_to(e, vid);
             assert(this->poly_verts_are_CCW(p, v, vid));
         }
@@ -617,12 +1159,12 @@ void AbstractPolygonMesh<M,V,E,P>::vert_ordered_one_ring(const unsigned int vid,
         }
 
         curr_e = this->poly_edge_id(curr_p, vid, v_link.back()); assert(edge_is_manifold(curr_e));
-        curr_p = (this->adj_e2p(curr_e).front() == curr_p) ? this->adj_e2p(curr_e).back() : this->adj_e2p(curr_e).front();
+        curr_p = (this->adj_e2p_span(curr_e).front() == curr_p) ? this->adj_e2p_span(curr_e).back() : this->adj_e2p_span(curr_e).front();
 
         if(edge_is_boundary(curr_e)) e_star.push_back(curr_e);
         else v_link.pop_back();
     }
-    while(e_star.size() < this->adj_v2e(vid).size());
+    while(e_star.size() < this->adj_v2e_span(vid).size());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -631,7 +1173,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::vert_verts_link(const unsigned int vid) const
 {
-    return this->adj_v2v(vid);
+    return this->adj_v2v_span(vid);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -641,8 +1183,8 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::vert_edges_link(const unsigned int vid) const
 {
     std::unordered_set<unsigned int> e_link;
-    for(unsigned int pid : this->adj_v2p(vid))
-    for(unsigned int eid : this->adj_p2e(pid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
+    for(unsigned int eid : this->adj_p2e_span(pid))
     {
         if(!this->edge_contains_vert(eid,vid)) e_link.insert(eid);
     }
@@ -712,7 +1254,7 @@ CINO_INLINE
 double AbstractPolygonMesh<M,V,E,P>::vert_area(const unsigned int vid) const
 {
     double area = 0.0;
-    for(unsigned int pid : this->adj_v2p(vid)) area += poly_area(pid)/static_cast<double>(this->verts_per_poly(pid));
+    for(unsigned int pid : this->adj_v2p_span(vid)) area += poly_area(pid)/static_cast<double>(this->verts_per_poly(pid));
     return area;
 }
 
@@ -731,7 +1273,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::vert_is_boundary(const unsigned int vid) const
 {
-    for(unsigned int eid : this->adj_v2e(vid)) if (edge_is_boundary(eid)) return true;
+    for(unsigned int eid : this->adj_v2e_span(vid)) if (edge_is_boundary(eid)) return true;
     return false;
 }
 
@@ -741,7 +1283,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::vert_is_manifold(const unsigned int vid) const
 {
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if(!this->edge_is_manifold(eid)) return false;
     }
@@ -783,7 +1325,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::vert_boundary_edges(const unsigned int vid) const
 {
     std::vector<unsigned int> b_edges;
-    for(unsigned int eid : this->adj_v2e(vid)) if (edge_is_boundary(eid)) b_edges.push_back(eid);
+    for(unsigned int eid : this->adj_v2e_span(vid)) if (edge_is_boundary(eid)) b_edges.push_back(eid);
     return b_edges;
 }
 
@@ -793,7 +1335,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::vert_is_visible(const unsigned int vid) const
 {
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         if(!this->poly_data(pid).flags[HIDDEN]) return true;
     }
@@ -814,7 +1356,7 @@ void AbstractPolygonMesh<M,V,E,P>::vert_cluster_one_ring(const unsigned int
     clusters.clear();
     std::unordered_set<unsigned int> visited;
 
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         if(CONTAINS(visited, pid)) continue;
         visited.insert(pid);
@@ -830,7 +1372,7 @@ void AbstractPolygonMesh<M,V,E,P>::vert_cluster_one_ring(const unsigned int
             unsigned int pid = q.front();
             q.pop();
 
-            for(unsigned int nbr : this->adj_p2p(pid))
+            for(unsigned int nbr : this->adj_p2p_span(pid))
             {
                 if(!this->poly_contains_vert(nbr,vid)) continue; // not in the umbrella
                 if(CONTAINS(visited,nbr)) continue; // already visited
@@ -858,11 +1400,11 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::vert_adj_visible_polys(const unsigned int vid, const vec3d dir, const double ang_thresh)
 {
     std::vector<unsigned int> nbrs;
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         if(!this->poly_data(pid).flags[HIDDEN])
         {
-            vec3d n = this->poly_data(pid).normal;
+            vec3d n = this->poly_normal(pid);
             if(dir.angle_deg(n) < ang_thresh) nbrs.push_back(pid);
         }
     }
@@ -875,6 +1417,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int AbstractPolygonMesh<M,V,E,P>::vert_add(const vec3d & pos)
 {
+    this->adj_thaw();
     unsigned int vid = this->num_verts();
     //
     this->verts.push_back(pos);
@@ -901,6 +1444,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::vert_merge(const unsigned int vid0, const unsigned int vid1)
 {
+    this->adj_thaw();
     std::vector<unsigned int> old_polys = this->adj_v2p(vid1);
     std::vector<std::vector<unsigned int>> new_polys;
     for(unsigned int pid : old_polys)
@@ -925,15 +1469,30 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_switch_id(const unsigned int vid0, const unsigned int vid1)
 {
+    this->adj_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (vid0 == vid1) return;
 
     std::swap(this->verts.at(vid0),  this->verts.at(vid1));
-    std::swap(this->v_data.at(vid0), this->v_data.at(vid1));
+    attribute_swap(this->v_data, vid0, vid1);
     std::swap(this->v2v.at(vid0),    this->v2v.at(vid1));
     std::swap(this->v2e.at(vid0),    this->v2e.at(vid1));
     std::swap(this->v2p.at(vid0),    this->v2p.at(vid1));
+    if(!v_dead.empty())
+    {
+        if(v_dead.size()<this->num_verts()) v_dead.resize(this->num_verts(), false);
+        bool tmp = v_dead.at(vid0);
+        v_dead.at(vid0) = v_dead.at(vid1);
+        v_dead.at(vid1) = tmp;
+    }
+    if(!v_dirty.empty())
+    {
+        if(v_dirty.size()<this->num_verts()) v_dirty.resize(this->num_verts(), 0);
+        std::swap(v_dirty.at(vid0), v_dirty.at(vid1));
+        if(v_dirty.at(vid0)) v_dirty_ids.push_back(vid0);
+        if(v_dirty.at(vid1)) v_dirty_ids.push_back(vid1);
+    }
 
     std::unordered_set<unsigned int> verts_to_update;
     verts_to_update.insert(this->adj_v2v(vid0).begin(), this->adj_v2v(vid0).end());
@@ -987,6 +1546,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_remove(const unsigned int vid)
 {
+    this->adj_thaw();
     polys_remove(this->adj_v2p(vid));
 }
 
@@ -996,15 +1556,26 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::vert_remove_unreferenced(const unsigned int vid)
 {
+    this->adj_thaw();
     this->v2v.at(vid).clear();
     this->v2e.at(vid).clear();
     this->v2p.at(vid).clear();
+    if(lazy_updates) this->bb_dirty = true;
+    if(batch_edits)
+    {
+        if(v_dead.size()<this->num_verts()) v_dead.resize(this->num_verts(), false);
+        assert(!v_dead.at(vid));
+        v_dead.at(vid) = true;
+        ++nv_dead;
+        return;
+    }
     vert_switch_id(vid, this->num_verts()-1);
     this->verts.pop_back();
     this->v_data.pop_back();
     this->v2v.pop_back();
     this->v2e.pop_back();
     this->v2p.pop_back();
+    if(v_dirty.size()>this->num_verts()) v_dirty.resize(this->num_verts());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1026,10 +1597,10 @@ double AbstractPolygonMesh<M,V,E,P>::edge_dihedral_angle(const unsigned int eid)
     if(!this->edge_is_manifold(eid)) return 0;
     if( this->edge_is_boundary(eid)) return 0;
 
-    unsigned int   pid0 = this->adj_e2p(eid).front();
-    unsigned int   pid1 = this->adj_e2p(eid).back();
-    vec3d  n0   = this->poly_data(pid0).normal;
-    vec3d  n1   = this->poly_data(pid1).normal;
+    unsigned int   pid0 = this->adj_e2p_span(eid).front();
+    unsigned int   pid1 = this->adj_e2p_span(eid).back();
+    vec3d  n0   = this->poly_normal(pid0);
+    vec3d  n1   = this->poly_normal(pid1);
 
     return n0.angle_rad(n1);
 }
@@ -1059,8 +1630,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::edges_share_poly(const unsigned int eid1, const unsigned int eid2) const
 {
-    for(unsigned int pid1 : this->adj_e2p(eid1))
-    for(unsigned int pid2 : this->adj_e2p(eid2))
+    for(unsigned int pid1 : this->adj_e2p_span(eid1))
+    for(unsigned int pid2 : this->adj_e2p_span(eid2))
     {
         if (pid1 == pid2) return true;
     }
@@ -1074,7 +1645,7 @@ CINO_INLINE
 unsigned int AbstractPolygonMesh<M,V,E,P>::edge_shared(const unsigned int pid0, const unsigned int pid1) const
 {
     std::vector<unsigned int> shared_edges;
-    for(unsigned int eid : this->adj_p2e(pid0))
+    for(unsigned int eid : this->adj_p2e_span(pid0))
     {
         if (this->poly_contains_edge(pid1,eid))
         {
@@ -1092,6 +1663,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int AbstractPolygonMesh<M,V,E,P>::edge_add(const unsigned int vid0, const unsigned int vid1)
 {
+    this->adj_thaw();
     assert(this->edge_id(vid0, vid1)==-1); // make sure it doesn't exist already
     assert(vid0 < this->num_verts());
     assert(vid1 < this->num_verts());
@@ -1124,6 +1696,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_switch_id(const unsigned int eid0, const unsigned int eid1)
 {
+    this->adj_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (eid0 == eid1) return;
@@ -1131,7 +1704,14 @@ void AbstractPolygonMesh<M,V,E,P>::edge_switch_id(const unsigned int eid0, const
     for(unsigned int off=0; off<2; ++off) std::swap(this->edges.at(2*eid0+off), this->edges.at(2*eid1+off));
 
     std::swap(this->e2p.at(eid0),    this->e2p.at(eid1));
-    std::swap(this->e_data.at(eid0), this->e_data.at(eid1));
+    attribute_swap(this->e_data, eid0, eid1);
+    if(!e_dead.empty())
+    {
+        if(e_dead.size()<this->num_edges()) e_dead.resize(this->num_edges(), false);
+        bool tmp = e_dead.at(eid0);
+        e_dead.at(eid0) = e_dead.at(eid1);
+        e_dead.at(eid1) = tmp;
+    }
 
     std::unordered_set<unsigned int> verts_to_update;
     verts_to_update.insert(this->edge_vert_id(eid0,0));
@@ -1168,6 +1748,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_remove(const unsigned int eid)
 {
+    this->adj_thaw();
     polys_remove(this->adj_e2p(eid));
 }
 
@@ -1177,7 +1758,16 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::edge_remove_unreferenced(const unsigned int eid)
 {
+    this->adj_thaw();
     this->e2p.at(eid).clear();
+    if(batch_edits)
+    {
+        if(e_dead.size()<this->num_edges()) e_dead.resize(this->num_edges(), false);
+        assert(!e_dead.at(eid));
+        e_dead.at(eid) = true;
+        ++ne_dead;
+        return;
+    }
     edge_switch_id(eid, this->num_edges()-1);
     this->edges.resize(this->edges.size()-2);
     this->e_data.pop_back();
@@ -1193,7 +1783,7 @@ void AbstractPolygonMesh<M,V,E,P>::edge_mark_labeling_boundaries()
     for(unsigned int eid=0; eid<this->num_edges(); ++eid)
     {
         std::unordered_set<int> unique_labels;
-        for(unsigned int pid : this->adj_e2p(eid)) unique_labels.insert(this->poly_data(pid).label);
+        for(unsigned int pid : this->adj_e2p_span(eid)) unique_labels.insert(this->poly_data(pid).label);
         this->edge_data(eid).flags[MARKED] = (unique_labels.size()>=2);
     }
 }
@@ -1207,7 +1797,7 @@ void AbstractPolygonMesh<M,V,E,P>::edge_mark_color_discontinuities()
     for(unsigned int eid=0; eid<this->num_edges(); ++eid)
     {
         std::set<Color> unique_colors;
-        for(unsigned int pid : this->adj_e2p(eid)) unique_colors.insert(this->poly_data(pid).color);
+        for(unsigned int pid : this->adj_e2p_span(eid)) unique_colors.insert(this->poly_data(pid).color);
 
         this->edge_data(eid).flags[MARKED] = (unique_colors.size()>=2);
     }
@@ -1256,7 +1846,7 @@ double AbstractPolygonMesh<M,V,E,P>::poly_angle_at_vert(const unsigned int pid,
     vec3d  v      = this->poly_vert(pid, next) - p;
     double angle  = u.angle_rad(v);
 
-    if((-u).cross(v).dot(this->poly_data(pid).normal)<0)
+    if((-u).cross(v).dot(this->poly_normal(pid))<0)
     {
         angle = 2*M_PI - angle;
     }
@@ -1275,8 +1865,8 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int AbstractPolygonMesh<M,V,E,P>::poly_shared(const unsigned int eid0, const unsigned int eid1) const
 {
-    for(unsigned int pid0 : this->adj_e2p(eid0))
-    for(unsigned int pid1 : this->adj_e2p(eid1))
+    for(unsigned int pid0 : this->adj_e2p_span(eid0))
+    for(unsigned int pid1 : this->adj_e2p_span(eid1))
     {
         if (pid0 == pid1) return pid0;
     }
@@ -1293,7 +1883,7 @@ int AbstractPolygonMesh<M,V,E,P>::poly_id(const std::vector<unsigned int> & vlis
     std::vector<unsigned int> query = SORT_VEC(vlist);
 
     unsigned int vid = vlist.front();
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         if(this->poly_verts_id(pid,true)==query) return pid;
     }
@@ -1307,7 +1897,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::polys_adjacent_along(const unsigned int pid, const unsigned int eid) const
 {
     std::vector<unsigned int> polys;
-    for(unsigned int nbr : this->adj_p2p(pid))
+    for(unsigned int nbr : this->adj_p2p_span(pid))
     {
         if (this->poly_contains_edge(nbr,eid)) polys.push_back(nbr);
     }
@@ -1330,10 +1920,35 @@ std::vector<vec3d> AbstractPolygonMesh<M,V,E,P>::poly_vlist(const unsigned int p
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<class M, class V, class E, class P>
+CINO_INLINE
+vec3d AbstractPolygonMesh<M,V,E,P>::poly_normal(const unsigned int pid) const
+{
+    if(pid<p_dirty.size() && (p_dirty[pid] & DIRTY_NORMAL))
+    {
+        // cached data: logically const, but not thread safe (refresh() before parallel loops)
+        assert(!ThreadPool::in_parallel_region());
+        auto m = const_cast<AbstractPolygonMesh<M,V,E,P>*>(this);
+        m->update_p_normal(pid);
+        m->p_dirty[pid] &= ~DIRTY_NORMAL;
+    }
+    return this->poly_data(pid).normal;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<class M, class V, class E, class P>
 CINO_INLINE
 const std::vector<unsigned int> & AbstractPolygonMesh<M,V,E,P>::poly_tessellation(const unsigned int pid) const
 {
+    if(pid<p_dirty.size() && (p_dirty[pid] & DIRTY_TESSELLATION))
+    {
+        // cached data: logically const, but not thread safe (refresh() before parallel loops)
+        assert(!ThreadPool::in_parallel_region());
+        auto m = const_cast<AbstractPolygonMesh<M,V,E,P>*>(this);
+        m->update_p_tessellation(pid);
+        m->p_dirty[pid] &= ~DIRTY_TESSELLATION;
+    }
     return poly_triangles.at(pid);
 }
 
@@ -1355,11 +1970,11 @@ int AbstractPolygonMesh<M,V,E,P>::poly_opposite_to(const unsigned int eid, const
 {
     assert(this->poly_contains_edge(pid,eid));
     assert(this->edge_is_manifold(eid));
-    assert(!this->adj_e2p(eid).empty());
+    assert(!this->adj_e2p_span(eid).empty());
 
     if (this->edge_is_boundary(eid)) return -1;
-    if (this->adj_e2p(eid).front() != pid) return this->adj_e2p(eid).front();
-    return this->adj_e2p(eid).back();
+    if (this->adj_e2p_span(eid).front() != pid) return this->adj_e2p_span(eid).front();
+    return this->adj_e2p_span(eid).back();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1368,7 +1983,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::polys_are_adjacent(const unsigned int pid0, const unsigned int pid1) const
 {
-    for(unsigned int eid : this->adj_p2e(pid0))
+    for(unsigned int eid : this->adj_p2e_span(pid0))
     for(unsigned int pid : this->polys_adjacent_along(pid0, eid))
     {
         if (pid == pid1) return true;
@@ -1382,7 +1997,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 bool AbstractPolygonMesh<M,V,E,P>::poly_is_boundary(const unsigned int pid) const
 {
-    return (this->adj_p2p(pid).size() < 3);
+    return (this->adj_p2p_span(pid).size() < 3);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1391,15 +2006,30 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_switch_id(const unsigned int pid0, const unsigned int pid1)
 {
+    this->adj_thaw();
     // [28 Aug 2017] Tested on 10K random id switches : PASSED
 
     if (pid0 == pid1) return;
 
     std::swap(this->polys.at(pid0),          this->polys.at(pid1));
-    std::swap(this->p_data.at(pid0),         this->p_data.at(pid1));
+    attribute_swap(this->p_data, pid0, pid1);
     std::swap(this->p2e.at(pid0),            this->p2e.at(pid1));
     std::swap(this->p2p.at(pid0),            this->p2p.at(pid1));
     std::swap(this->poly_triangles.at(pid0), this->poly_triangles.at(pid1));
+    if(!p_dead.empty())
+    {
+        if(p_dead.size()<this->num_polys()) p_dead.resize(this->num_polys(), false);
+        bool tmp = p_dead.at(pid0);
+        p_dead.at(pid0) = p_dead.at(pid1);
+        p_dead.at(pid1) = tmp;
+    }
+    if(!p_dirty.empty())
+    {
+        if(p_dirty.size()<this->num_polys()) p_dirty.resize(this->num_polys(), 0);
+        std::swap(p_dirty.at(pid0), p_dirty.at(pid1));
+        if(p_dirty.at(pid0)) p_dirty_ids.push_back(pid0);
+        if(p_dirty.at(pid1)) p_dirty_ids.push_back(pid1);
+    }
 
     std::unordered_set<unsigned int> verts_to_update;
     verts_to_update.insert(this->adj_p2v(pid0).begin(), this->adj_p2v(pid0).end());
@@ -1447,6 +2077,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int AbstractPolygonMesh<M,V,E,P>::poly_add(const std::vector<unsigned int> & vlist)
 {
+    this->adj_thaw();
     if(poly_id(vlist)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
@@ -1500,8 +2131,13 @@ unsigned int AbstractPolygonMesh<M,V,E,P>::poly_add(const std::vector<unsigned i
         this->p2e.at(pid).push_back(eid);
     }
 
-    if(this->mesh_data().update_normals) this->update_p_normal(pid);
     this->poly_triangles.push_back(std::vector<unsigned int>());
+    if(lazy_updates)
+    {
+        mark_poly_dirty(pid);
+        return pid;
+    }
+    if(this->mesh_data().update_normals) this->update_p_normal(pid);
     update_p_tessellation(pid);
 
     return pid;
@@ -1513,6 +2149,13 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::polys_remove(const std::vector<unsigned int> & pids)
 {
+    this->adj_thaw();
+
+    // removing many polys one by one would relocate (and patch the relations of)
+    // just as many elements: mark them as dead and compact the mesh once instead
+    bool batch = !batch_edits && pids.size()>=64 && pids.size()>this->num_polys()/8;
+    if(batch) batch_edits_begin();
+
     // in order to avoid id conflicts remove all the
     // polys starting from the one with highest id
     //
@@ -1520,6 +2163,8 @@ void AbstractPolygonMesh<M,V,E,P>::polys_remove(const std::vector<unsigned int>
     std::sort(tmp.begin(), tmp.end());
     std::reverse(tmp.begin(), tmp.end());
     for(unsigned int pid : tmp) poly_remove(pid);
+
+    if(batch) batch_edits_end();
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1528,6 +2173,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_remove(const unsigned int pid)
 {
+    this->adj_thaw();
     // [28 Aug 2017] Tested on progressive random removal until almost no polys are left: PASSED
 
     std::set<unsigned int,std::greater<unsigned int>> dangling_verts; // higher ids first
@@ -1536,6 +2182,7 @@ void AbstractPolygonMesh<M,V,E,P>::poly_remove(const unsigned int pid)
     // disconnect from vertices
     for(unsigned int vid : this->adj_p2v(pid))
     {
+        if(lazy_updates) mark_vert_dirty(vid);
         REMOVE_FROM_VEC(this->v2p.at(vid), pid);
         if (this->v2p.at(vid).empty()) dangling_verts.insert(vid);
     }
@@ -1580,15 +2227,26 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::poly_remove_unreferenced(const unsigned int pid)
 {
+    this->adj_thaw();
     this->polys.at(pid).clear();
     this->p2e.at(pid).clear();
     this->p2p.at(pid).clear();
+    if(batch_edits)
+    {
+        this->poly_triangles.at(pid).clear();
+        if(p_dead.size()<this->num_polys()) p_dead.resize(this->num_polys(), false);
+        assert(!p_dead.at(pid));
+        p_dead.at(pid) = true;
+        ++np_dead;
+        return;
+    }
     poly_switch_id(pid, this->num_polys()-1);
     this->polys.pop_back();
     this->p_data.pop_back();
     this->p2e.pop_back();
     this->p2p.pop_back();
     this->poly_triangles.pop_back();
+    if(p_dirty.size()>this->num_polys()) p_dirty.resize(this->num_polys());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -1655,7 +2313,7 @@ CINO_INLINE
 double AbstractPolygonMesh<M,V,E,P>::poly_perimeter(const unsigned int pid) const
 {
     double perimeter = 0.0;
-    for(unsigned int eid : this->adj_p2e(pid)) perimeter += this->edge_length(eid);
+    for(unsigned int eid : this->adj_p2e_span(pid)) perimeter += this->edge_length(eid);
     return perimeter;
 }
 
@@ -1667,6 +2325,11 @@ void AbstractPolygonMesh<M,V,E,P>::poly_flip_winding_order(const unsigned int pi
 {
     std::reverse(this->polys.at(pid).begin(), this->polys.at(pid).end());
 
+    if(lazy_updates)
+    {
+        mark_poly_dirty(pid);
+        return;
+    }
     if(this->mesh_data().update_normals)
     {
         update_p_normal(pid);
@@ -1680,6 +2343,10 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P> & m)
 {
+    // relations are appended to the vectors of vectors, hence this mesh must be mutable.
+    // The other mesh may be frozen: read its relations only through the adj_*_span views
+    this->adj_thaw();
+
     unsigned int nv = this->num_verts();
     unsigned int ne = this->num_edges();
     unsigned int np = this->num_polys();
@@ -1694,11 +2361,11 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
         this->p_data.push_back(m.poly_data(pid));
 
         tmp.clear();
-        for(unsigned int eid : m.p2e.at(pid)) tmp.push_back(ne + eid);
+        for(unsigned int eid : m.adj_p2e_span(pid)) tmp.push_back(ne + eid);
         this->p2e.push_back(tmp);
 
         tmp.clear();
-        for(unsigned int nbr : m.p2p.at(pid)) tmp.push_back(np + nbr);
+        for(unsigned int nbr : m.adj_p2p_span(pid)) tmp.push_back(np + nbr);
         this->p2p.push_back(tmp);
 
         tmp.clear();
@@ -1713,7 +2380,7 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
         this->e_data.push_back(m.edge_data(eid));
 
         tmp.clear();
-        for(unsigned int tid : m.e2p.at(eid)) tmp.push_back(np + tid);
+        for(unsigned int tid : m.adj_e2p_span(eid)) tmp.push_back(np + tid);
         this->e2p.push_back(tmp);
     }
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
@@ -1722,15 +2389,15 @@ void AbstractPolygonMesh<M,V,E,P>::operator+=(const AbstractPolygonMesh<M,V,E,P>
         this->v_data.push_back(m.vert_data(vid));
 
         tmp.clear();
-        for(unsigned int eid : m.v2e.at(vid)) tmp.push_back(ne + eid);
+        for(unsigned int eid : m.adj_v2e_span(vid)) tmp.push_back(ne + eid);
         this->v2e.push_back(tmp);
 
         tmp.clear();
-        for(unsigned int tid : m.v2p.at(vid)) tmp.push_back(np + tid);
+        for(unsigned int tid : m.adj_v2p_span(vid)) tmp.push_back(np + tid);
         this->v2p.push_back(tmp);
 
         tmp.clear();
-        for(unsigned int nbr : m.v2v.at(vid)) tmp.push_back(nv + nbr);
+        for(unsigned int nbr : m.adj_v2v_span(vid)) tmp.push_back(nv + nbr);
         this->v2v.push_back(tmp);
     }
 
@@ -1765,7 +2432,7 @@ std::vector<unsigned int> AbstractPolygonMesh<M,V,E,P>::get_ordered_boundary_ver
     do
     {
         bool found_next = false;
-        for(unsigned int eid : this->adj_v2e(curr))
+        for(unsigned int eid : this->adj_v2e_span(curr))
         {
             if(!this->edge_is_boundary(eid)) continue;
             unsigned int vid = this->vert_opposite_to(eid, curr);
@@ -1798,4 +2465,273 @@ void AbstractPolygonMesh<M,V,E,P>::poly_export_element(const unsigned int pid, s
     faces.push_back(f);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::batch_edits_begin()
+{
+    batch_edits = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::batch_edits_end()
+{
+    compact();
+    batch_edits = false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::compact()
+{
+    std::vector<int> v_map, e_map, p_map;
+    compact(v_map, e_map, p_map);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::compact(std::vector<int> & v_map,
+                                           std::vector<int> & e_map,
+                                           std::vector<int> & p_map)
+{
+    this->adj_thaw();
+
+    // new ids are the prefix sums of the survivors
+    auto make_map = [](const std::vector<bool> & dead, const unsigned int n, std::vector<int> & map)
+    {
+        map.resize(n);
+        int fresh = 0;
+        for(unsigned int i=0; i<n; ++i) map[i] = (i<dead.size() && dead[i]) ? -1 : fresh++;
+        return static_cast<unsigned int>(fresh);
+    };
+    unsigned int nv = make_map(v_dead, this->num_verts(), v_map);
+    unsigned int ne = make_map(e_dead, this->num_edges(), e_map);
+    unsigned int np = make_map(p_dead, this->num_polys(), p_map);
+
+    v_dead.clear();
+    e_dead.clear();
+    p_dead.clear();
+    nv_dead = ne_dead = np_dead = 0;
+    if(nv==this->num_verts() && ne==this->num_edges() && np==this->num_polys()) return;
+
+    // dirty flags follow their elements
+    auto remap_dirty = [](std::vector<uint8_t> & flags, std::vector<unsigned int> & ids, const std::vector<int> & map, const unsigned int n)
+    {
+        if(flags.empty()) return;
+        flags.resize(map.size(), 0);
+        for(unsigned int i=0; i<map.size(); ++i)
+        {
+            if(map[i]>=0 && map[i]!=(int)i) flags[map[i]] = flags[i];
+        }
+        flags.resize(n, 0);
+        std::vector<unsigned int> tmp;
+        for(unsigned int id : ids) if(id<map.size() && map[id]>=0) tmp.push_back(map[id]);
+        ids.swap(tmp);
+    };
+    remap_dirty(v_dirty, v_dirty_ids, v_map, nv);
+    remap_dirty(p_dirty, p_dirty_ids, p_map, np);
+
+    // dead elements are disconnected from the rest of the mesh, hence
+    // survivors only reference survivors, and can be remapped in place
+    auto remap = [](std::vector<unsigned int> & ids, const std::vector<int> & map)
+    {
+        for(unsigned int & id : ids)
+        {
+            assert(map.at(id)>=0);
+            id = map[id];
+        }
+    };
+    PARALLEL_FOR(0, this->num_verts(), 1000, [&](const unsigned int vid)
+    {
+        if(v_map[vid]<0) return;
+        remap(this->v2v[vid], v_map);
+        remap(this->v2e[vid], e_map);
+        remap(this->v2p[vid], p_map);
+    });
+    PARALLEL_FOR(0, this->num_edges(), 1000, [&](const unsigned int eid)
+    {
+        if(e_map[eid]<0) return;
+        this->edges[2*eid  ] = v_map[this->edges[2*eid  ]];
+        this->edges[2*eid+1] = v_map[this->edges[2*eid+1]];
+        remap(this->e2p[eid], p_map);
+    });
+    PARALLEL_FOR(0, this->num_polys(), 1000, [&](const unsigned int pid)
+    {
+        if(p_map[pid]<0) return;
+        remap(this->polys[pid],          v_map);
+        remap(this->poly_triangles[pid], v_map);
+        remap(this->p2e[pid],            e_map);
+        remap(this->p2p[pid],            p_map);
+    });
+
+    // move survivors to their new slots. New ids never exceed the old
+    // ones, hence a forward sweep never overwrites an element to be moved
+    for(unsigned int vid=0; vid<v_map.size(); ++vid)
+    {
+        if(v_map[vid]<0 || v_map[vid]==(int)vid) continue;
+        unsigned int new_vid = v_map[vid];
+        this->verts[new_vid] = this->verts[vid];
+        attribute_swap(this->v_data, new_vid, vid);
+        std::swap(this->v2v[new_vid], this->v2v[vid]);
+        std::swap(this->v2e[new_vid], this->v2e[vid]);
+        std::swap(this->v2p[new_vid], this->v2p[vid]);
+    }
+    for(unsigned int eid=0; eid<e_map.size(); ++eid)
+    {
+        if(e_map[eid]<0 || e_map[eid]==(int)eid) continue;
+        unsigned int new_eid = e_map[eid];
+        this->edges[2*new_eid  ] = this->edges[2*eid  ];
+        this->edges[2*new_eid+1] = this->edges[2*eid+1];
+        attribute_swap(this->e_data, new_eid, eid);
+        std::swap(this->e2p[new_eid], this->e2p[eid]);
+    }
+    for(unsigned int pid=0; pid<p_map.size(); ++pid)
+    {
+        if(p_map[pid]<0 || p_map[pid]==(int)pid) continue;
+        unsigned int new_pid = p_map[pid];
+        attribute_swap(this->p_data, new_pid, pid);
+        std::swap(this->polys[new_pid],          this->polys[pid]);
+        std::swap(this->poly_triangles[new_pid], this->poly_triangles[pid]);
+        std::swap(this->p2e[new_pid],            this->p2e[pid]);
+        std::swap(this->p2p[new_pid],            this->p2p[pid]);
+    }
+
+    this->verts.resize(nv);
+    this->v_data.resize(nv);
+    this->v2v.resize(nv);
+    this->v2e.resize(nv);
+    this->v2p.resize(nv);
+    this->edges.resize(2*ne);
+    this->e_data.resize(ne);
+    this->e2p.resize(ne);
+    this->polys.resize(np);
+    this->p_data.resize(np);
+    this->poly_triangles.resize(np);
+    this->p2e.resize(np);
+    this->p2p.resize(np);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::lazy_updates_begin()
+{
+    lazy_updates = true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::lazy_updates_end()
+{
+    refresh();
+    lazy_updates = false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::refresh()
+{
+    // sorted, unique and valid ids of the elements that are still dirty
+    auto collect = [](std::vector<unsigned int> & ids, const std::vector<uint8_t> & flags, const std::function<bool(unsigned int)> & skip)
+    {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        ids.erase(std::remove_if(ids.begin(), ids.end(), [&](const unsigned int id)
+        {
+            return id>=flags.size() || flags[id]==0 || skip(id);
+        }), ids.end());
+    };
+    p_dirty.resize(this->num_polys(), 0);
+    v_dirty.resize(this->num_verts(), 0);
+    collect(p_dirty_ids, p_dirty, [this](const unsigned int pid){ return poly_is_dead(pid); });
+    collect(v_dirty_ids, v_dirty, [this](const unsigned int vid){ return vert_is_dead(vid); });
+
+    // polygons first, as vertex normals depend on polygon normals
+    bool normals = this->mesh_data().update_normals;
+    PARALLEL_FOR(0, p_dirty_ids.size(), 1000, [&](const unsigned int i)
+    {
+        unsigned int pid = p_dirty_ids[i];
+        if(p_dirty[pid] & DIRTY_TESSELLATION) update_p_tessellation(pid);
+        if((p_dirty[pid] & DIRTY_NORMAL) && normals) update_p_normal(pid);
+        p_dirty[pid] = 0;
+    });
+    PARALLEL_FOR(0, v_dirty_ids.size(), 1000, [&](const unsigned int i)
+    {
+        unsigned int vid = v_dirty_ids[i];
+        if(normals) update_v_normal(vid);
+        v_dirty[vid] = 0;
+    });
+    p_dirty_ids.clear();
+    v_dirty_ids.clear();
+
+    if(this->bb_dirty) this->update_bbox();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::vert_set_dirty(const unsigned int vid)
+{
+    for(unsigned int pid : this->adj_v2p_span(vid)) mark_poly_dirty(pid);
+    mark_vert_dirty(vid);
+    if(lazy_updates) this->bb_dirty = true; // recomputed once, at refresh
+    else
+    {
+        // grow the bbox as vert_add does: a full update_bbox per moved vertex would be O(V)
+        if(this->mesh_data().update_bbox)
+        {
+            this->bb.min = this->bb.min.min(this->vert(vid));
+            this->bb.max = this->bb.max.max(this->vert(vid));
+        }
+        refresh();
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::poly_set_dirty(const unsigned int pid)
+{
+    mark_poly_dirty(pid);
+    if(!lazy_updates) refresh();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::mark_vert_dirty(const unsigned int vid)
+{
+    if(v_dirty.size()<=vid) v_dirty.resize(std::max(vid+1, this->num_verts()), 0);
+    if(v_dirty[vid]==0) v_dirty_ids.push_back(vid);
+    v_dirty[vid] |= DIRTY_NORMAL;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void AbstractPolygonMesh<M,V,E,P>::mark_poly_dirty(const unsigned int pid, const uint8_t flags)
+{
+    if(p_dirty.size()<=pid) p_dirty.resize(std::max(pid+1, this->num_polys()), 0);
+    if(p_dirty[pid]==0) p_dirty_ids.push_back(pid);
+    p_dirty[pid] |= flags;
+    for(unsigned int vid : this->adj_p2v(pid)) mark_vert_dirty(vid);
+}
+
 }
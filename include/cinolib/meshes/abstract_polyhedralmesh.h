@@ -55,7 +55,7 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
         std::vector<std::vector<unsigned int>> faces;              // list of faces (assumed CCW)
         std::vector<std::vector<bool>> polys_face_winding; // true if the face is CCW, false if it is CW
 
-        std::vector<F> f_data;
+        typename AttributeStorage<F>::type f_data;
 
         std::vector<std::vector<unsigned int>> v2f; // vert to face adjacency
         std::vector<std::vector<unsigned int>> e2f; // edge to face adjacency
@@ -69,6 +69,7 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
     public:
 
         typedef F F_type;
+        typedef typename AttributeStorage<F>::type F_storage;
 
         explicit AbstractPolyhedralMesh() : AbstractMesh<M,V,E,P>() {}
         ~AbstractPolyhedralMesh() {}
@@ -166,8 +167,10 @@ class AbstractPolyhedralMesh : public AbstractMesh<M,V,E,P>
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        const F & face_data(const unsigned int fid) const { return f_data.at(fid); }
-              F & face_data(const unsigned int fid)       { return f_data.at(fid); }
+        typename F_storage::const_reference face_data(const unsigned int fid) const { return f_data.at(fid); }
+        typename F_storage::reference       face_data(const unsigned int fid)       { return f_data.at(fid); }
+        const F_storage                   & face_data_storage()                   const { return f_data; }
+              F_storage                   & face_data_storage()                         { return f_data; }
 
         //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
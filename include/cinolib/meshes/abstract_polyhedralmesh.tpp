@@ -42,6 +42,7 @@
 #include <cinolib/ANSI_color_codes.h>
 #include <queue>
 #include <cinolib/standard_elements_tables.h>
+#include <cinolib/trace_profiler.h>
 
 namespace cinolib
 {
@@ -75,6 +76,8 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
                                              const std::vector<std::vector<unsigned int>> & polys,
                                              const std::vector<std::vector<bool>> & polys_face_winding)
 {
+    CINO_PROFILE_ZONE("AbstractPolyhedralMesh::init");
+    this->adj_thaw();
     std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
 
     // pre-allocate memory
@@ -129,6 +132,7 @@ CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>             & verts,
                                              const std::vector<std::vector<unsigned int>> & polys)
 {
+    this->adj_thaw();
     std::chrono::high_resolution_clock::time_point t0 = std::chrono::high_resolution_clock::now();
 
     // pre-allocate memory
@@ -172,6 +176,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::init(const std::vector<vec3d>
                                              const std::vector<int>               & vert_labels,
                                              const std::vector<int>               & poly_labels)
 {
+    this->adj_thaw();
     init(verts, polys);
 
     if(vert_labels.size()==this->num_verts())
@@ -645,6 +650,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::face_split_in_triangles(const unsigned int fid, const vec3d & p)
 {
+    this->adj_thaw();
     assert(this->face_has_no_duplicate_verts(fid));
 
     unsigned int new_vid = this->vert_add(p);
@@ -684,6 +690,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::face_split_along_new_edge(const unsigned int fid, unsigned int vid0, unsigned int vid1)
 {
+    this->adj_thaw();
     assert(this->verts_per_face(fid)>3);
     assert(this->face_contains_vert(fid, vid0));
     assert(this->face_contains_vert(fid, vid1));
@@ -729,6 +736,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::poly_split_along_new_face(const unsigned int pid, const std::vector<unsigned int> & f)
 {
+    this->adj_thaw();
 #ifndef NDEBUG
     for(unsigned int vid : f) assert(this->poly_contains_vert(pid,vid));
 #endif
@@ -817,7 +825,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::vert_verts_link(const unsigned int vid) const
 {
-    return this->adj_v2v(vid);
+    return this->adj_v2v_span(vid);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -827,8 +835,8 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::vert_edges_link(const unsigned int vid) const
 {
     std::unordered_set<unsigned int> e_link;
-    for(unsigned int pid : this->adj_v2p(vid))
-    for(unsigned int eid : this->adj_p2e(pid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
+    for(unsigned int eid : this->adj_p2e_span(pid))
     {
         if(!this->edge_contains_vert(eid,vid)) e_link.insert(eid);
     }
@@ -842,7 +850,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::vert_faces_link(const unsigned int vid) const
 {
     std::unordered_set<unsigned int> f_link;
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     for(unsigned int fid : this->adj_p2f(pid))
     {
         if(!this->face_contains_vert(fid,vid)) f_link.insert(fid);
@@ -857,7 +865,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::edge_verts_link(const unsigned int eid) const
 {
     std::unordered_set<unsigned int> v_link;
-    for(unsigned int pid : this->adj_e2p(eid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
     for(unsigned int vid : this->adj_p2v(pid))
     {
         if(!this->edge_contains_vert(eid,vid)) v_link.insert(vid);
@@ -872,8 +880,8 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::edge_edges_link(const unsigned int eid) const
 {
     std::unordered_set<unsigned int> e_link;
-    for(unsigned int pid : this->adj_e2p(eid))
-    for(unsigned int id :  this->adj_p2e(pid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
+    for(unsigned int id :  this->adj_p2e_span(pid))
     {
         if(!this->edges_are_adjacent(eid,id)) e_link.insert(id);
     }
@@ -890,7 +898,7 @@ std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::edge_faces_link(con
     unsigned int v1 = this->edge_vert_id(eid, 1);
 
     std::unordered_set<unsigned int> f_link;
-    for(unsigned int pid : this->adj_e2p(eid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
     for(unsigned int fid : this->adj_p2f(pid))
     {
         if(!this->face_contains_vert(fid,v0) &&
@@ -929,6 +937,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::edge_split(const unsigned int eid, const vec3d & p)
 {
+    this->adj_thaw();
     unsigned int new_vid = this->vert_add(p);
     unsigned int v0      = this->edge_vert_id(eid, 0);
     unsigned int v1      = this->edge_vert_id(eid, 1);
@@ -1467,7 +1476,7 @@ std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::face_v2e(const unsi
 {
     assert(this->face_contains_vert(fid,vid));
     std::vector<unsigned int> edges;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if (this->face_contains_edge(fid,eid)) edges.push_back(eid);
     }
@@ -1483,7 +1492,7 @@ std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::face_v2v(const unsi
 {
     assert(this->face_contains_vert(fid,vid));
     std::vector<unsigned int> verts;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if (this->face_contains_edge(fid,eid)) verts.push_back(this->vert_opposite_to(eid,vid));
     }
@@ -1641,8 +1650,8 @@ CINO_INLINE
 double AbstractPolyhedralMesh<M,V,E,F,P>::vert_volume(const unsigned int vid) const
 {
     double vol = 0.0;    
-    for(unsigned int pid : this->adj_v2p(vid)) vol += this->poly_volume(pid);
-    vol /= static_cast<double>(this->adj_v2p(vid).size());
+    for(unsigned int pid : this->adj_v2p_span(vid)) vol += this->poly_volume(pid);
+    vol /= static_cast<double>(this->adj_v2p_span(vid).size());
     return vol;
 }
 
@@ -1761,7 +1770,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::vert_adj_srf_edges(const unsigned int vid) const
 {
     std::vector<unsigned int> srf_e;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if (this->edge_is_on_srf(eid)) srf_e.push_back(eid);
     }
@@ -1896,7 +1905,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 bool AbstractPolyhedralMesh<M, V, E, F, P>::edge_is_visible(const unsigned int eid) const
 {
-    for (unsigned int pid : this->adj_e2p(eid))
+    for (unsigned int pid : this->adj_e2p_span(eid))
     {
         if (!this->poly_data(pid).flags[HIDDEN])
         {
@@ -1960,7 +1969,7 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::edge_ordered_poly_ring(const unsigned int eid) const
 {
     std::vector<unsigned int> plist;
-    if (this->adj_e2p(eid).empty()) return plist;
+    if (this->adj_e2p_span(eid).empty()) return plist;
 
     unsigned int curr_f = this->adj_e2f(eid).front();
     unsigned int curr_p = this->adj_f2p(curr_f).front();
@@ -1983,7 +1992,7 @@ std::vector<unsigned int> AbstractPolyhedralMesh<M,V,E,F,P>::edge_ordered_poly_r
             plist.push_back(curr_p);
         }
     }
-    while (plist.size() < this->adj_e2p(eid).size());
+    while (plist.size() < this->adj_e2p_span(eid).size());
 
     return plist;
 }
@@ -2008,6 +2017,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_switch_id(const unsigned int vid0, const unsigned int vid1)
 {
+    this->adj_thaw();
     if(vid0 == vid1) return;
 
     std::swap(this->verts.at(vid0),   this->verts.at(vid1));
@@ -2015,7 +2025,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::vert_switch_id(const unsigned int vid0,
     std::swap(this->v2e.at(vid0),     this->v2e.at(vid1));
     std::swap(this->v2f.at(vid0),     this->v2f.at(vid1));
     std::swap(this->v2p.at(vid0),     this->v2p.at(vid1));
-    std::swap(this->v_data.at(vid0),  this->v_data.at(vid1));
+    attribute_swap(this->v_data, vid0, vid1);
 
     std::unordered_set<unsigned int> verts_to_update;
     verts_to_update.insert(this->adj_v2v(vid0).begin(), this->adj_v2v(vid0).end());
@@ -2082,6 +2092,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_remove(const unsigned int vid)
 {
+    this->adj_thaw();
     polys_remove(this->adj_v2p(vid));
 }
 
@@ -2091,6 +2102,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::vert_remove_unreferenced(const unsigned int vid)
 {
+    this->adj_thaw();
     this->v2v.at(vid).clear();
     this->v2e.at(vid).clear();
     this->v2f.at(vid).clear();
@@ -2110,6 +2122,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::vert_add(const vec3d & pos)
 {
+    this->adj_thaw();
     unsigned int vid = this->num_verts();
     //
     this->verts.push_back(pos);
@@ -2135,13 +2148,14 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_switch_id(const unsigned int eid0, const unsigned int eid1)
 {
+    this->adj_thaw();
     if (eid0 == eid1) return;
 
     for(unsigned int off=0; off<2; ++off) std::swap(this->edges.at(2*eid0+off), this->edges.at(2*eid1+off));
 
     std::swap(this->e2f.at(eid0),     this->e2f.at(eid1));
     std::swap(this->e2p.at(eid0),     this->e2p.at(eid1));
-    std::swap(this->e_data.at(eid0),  this->e_data.at(eid1));
+    attribute_swap(this->e_data, eid0, eid1);
 
     std::unordered_set<unsigned int> verts_to_update;
     verts_to_update.insert(this->edge_vert_id(eid0,0));
@@ -2190,6 +2204,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::edge_add(const unsigned int vid0, const unsigned int vid1)
 {
+    this->adj_thaw();
     assert(this->edge_id(vid0, vid1)==-1); // make sure it doesn't exist already
     assert(vid0 < this->num_verts());
     assert(vid1 < this->num_verts());
@@ -2224,6 +2239,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_remove(const unsigned int eid)
 {
+    this->adj_thaw();
     polys_remove(this->adj_e2p(eid));
 }
 
@@ -2233,6 +2249,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::edge_remove_unreferenced(const unsigned int eid)
 {
+    this->adj_thaw();
     this->e2f.at(eid).clear();
     this->e2p.at(eid).clear();
     edge_switch_id(eid, this->num_edges()-1);
@@ -2253,7 +2270,7 @@ void AbstractPolyhedralMesh<M,V,E,F,P>::face_switch_id(const unsigned int fid0,
     if (fid0 == fid1) return;
 
     std::swap(this->faces.at(fid0),          this->faces.at(fid1));
-    std::swap(this->f_data.at(fid0),         this->f_data.at(fid1));
+    attribute_swap(this->f_data, fid0, fid1);
     std::swap(this->f2e.at(fid0),            this->f2e.at(fid1));
     std::swap(this->f2f.at(fid0),            this->f2f.at(fid1));
     std::swap(this->f2p.at(fid0),            this->f2p.at(fid1));
@@ -2318,6 +2335,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::face_add(const std::vector<unsigned int> & f)
 {
+    this->adj_thaw();
     if(face_id(f)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated face!" << ANSI_fg_color_default << std::endl;
@@ -2385,6 +2403,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::face_remove(const unsigned int fid)
 {
+    this->adj_thaw();
     polys_remove(this->adj_f2p(fid));
 }
 
@@ -2414,10 +2433,11 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_switch_id(const unsigned int pid0, const unsigned int pid1)
 {
+    this->adj_thaw();
     if (pid0 == pid1) return;
 
     std::swap(this->polys.at(pid0),              this->polys.at(pid1));
-    std::swap(this->p_data.at(pid0),             this->p_data.at(pid1));
+    attribute_swap(this->p_data, pid0, pid1);
     std::swap(this->p2v.at(pid0),                this->p2v.at(pid1));
     std::swap(this->p2e.at(pid0),                this->p2e.at(pid1));
     std::swap(this->p2p.at(pid0),                this->p2p.at(pid1));
@@ -2483,6 +2503,7 @@ CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<unsigned int> & flist,
                                                  const std::vector<bool> & fwinding)
 {
+    this->adj_thaw();
     if(poly_id(flist)!=-1)
     {
         std::cout << ANSI_fg_color_red << "WARNING: adding duplicated poly!" << ANSI_fg_color_default << std::endl;
@@ -2556,6 +2577,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int AbstractPolyhedralMesh<M,V,E,F,P>::poly_add(const std::vector<unsigned int> & vlist)
 {
+    this->adj_thaw();
     if(vlist.size()==4) // tetrahedron
     {
         // detect faces
@@ -2759,6 +2781,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::poly_remove_unreferenced(const unsigned int pid)
 {
+    this->adj_thaw();
     this->polys.at(pid).clear();
     this->p2v.at(pid).clear();
     this->p2e.at(pid).clear();
@@ -2779,6 +2802,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M, V, E, F, P>::poly_remove(const unsigned int pid, const bool delete_dangling_elements)
 {
+    this->adj_thaw();
     std::vector<unsigned int> vids, eids, fids;
     poly_dangling_ids(pid, vids, eids, fids);
     poly_disconnect(pid, vids, eids, fids);
@@ -2800,7 +2824,7 @@ std::vector<unsigned int> AbstractPolyhedralMesh<M, V, E, F, P>::poly_dangling_v
     std::vector<unsigned int> vids;
     for (unsigned int vid : this->adj_p2v(pid))
     {
-        if (this->v2p.at(vid).size() == 1) vids.push_back(vid);
+        if (this->adj_v2p_span(vid).size() == 1) vids.push_back(vid);
     }
     std::sort(vids.begin(), vids.end(), std::greater<unsigned int>());
     return vids;
@@ -2813,9 +2837,9 @@ CINO_INLINE
 std::vector<unsigned int> AbstractPolyhedralMesh<M, V, E, F, P>::poly_dangling_eids(const unsigned int pid) const
 {
     std::vector<unsigned int> eids;
-    for (unsigned int eid : this->adj_p2e(pid))
+    for (unsigned int eid : this->adj_p2e_span(pid))
     {
-        if (this->e2p.at(eid).size() == 1) eids.push_back(eid);
+        if (this->adj_e2p_span(eid).size() == 1) eids.push_back(eid);
     }
     std::sort(eids.begin(), eids.end(), std::greater<unsigned int>());
     return eids;
@@ -2853,6 +2877,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M, V, E, F, P>::poly_disconnect(const unsigned int pid, const std::vector<unsigned int>& vids, const std::vector<unsigned int>& eids, const std::vector<unsigned int>& fids)
 {
+    this->adj_thaw();
     // disconnect from vertices
     for (unsigned int vid : this->adj_p2v(pid))
     {
@@ -2912,6 +2937,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void AbstractPolyhedralMesh<M,V,E,F,P>::polys_remove(const std::vector<unsigned int> & pids)
 {
+    this->adj_thaw();
     // in order to avoid id conflicts remove all the
     // polys starting from the one with highest id
     //
@@ -3022,7 +3048,7 @@ bool AbstractPolyhedralMesh<M,V,E,F,P>::poly_fix_orientation()
         unsigned int pid = q.front();
         q.pop();
 
-        for(unsigned int nbr : this->adj_p2p(pid))
+        for(unsigned int nbr : this->adj_p2p_span(pid))
         {
             int fid = this->poly_shared_face(pid,nbr);
             assert(fid>=0);
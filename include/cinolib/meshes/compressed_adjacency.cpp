@@ -0,0 +1,135 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/meshes/compressed_adjacency.h>
+#include <algorithm>
+
+namespace cinolib
+{
+
+CINO_INLINE
+bool operator==(const IndexSpan & s0, const IndexSpan & s1)
+{
+    return s0.size()==s1.size() && std::equal(s0.begin(), s0.end(), s1.begin());
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator!=(const IndexSpan & s0, const IndexSpan & s1)
+{
+    return !(s0==s1);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator==(const IndexSpan & s, const std::vector<unsigned int> & v)
+{
+    return s==IndexSpan(v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator!=(const IndexSpan & s, const std::vector<unsigned int> & v)
+{
+    return !(s==IndexSpan(v));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator==(const std::vector<unsigned int> & v, const IndexSpan & s)
+{
+    return s==IndexSpan(v);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool operator!=(const std::vector<unsigned int> & v, const IndexSpan & s)
+{
+    return !(s==IndexSpan(v));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CompressedAdjacency::compress(const std::vector<std::vector<unsigned int>> & lists)
+{
+    offset.resize(lists.size()+1);
+    offset.shrink_to_fit();
+    offset.front() = 0;
+    for(size_t i=0; i<lists.size(); ++i) offset[i+1] = offset[i] + lists[i].size();
+
+    index.resize(offset.back());
+    index.shrink_to_fit();
+    for(size_t i=0; i<lists.size(); ++i) std::copy(lists[i].begin(), lists[i].end(), index.begin()+offset[i]);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<unsigned int>> CompressedAdjacency::decompress() const
+{
+    std::vector<std::vector<unsigned int>> lists(size());
+    for(unsigned int i=0; i<size(); ++i)
+    {
+        lists[i].assign(index.begin()+offset[i], index.begin()+offset[i+1]);
+    }
+    return lists;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void CompressedAdjacency::clear()
+{
+    offset.clear();
+    index.clear();
+    offset.shrink_to_fit();
+    index.shrink_to_fit();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+size_t CompressedAdjacency::memory_usage() const
+{
+    return sizeof(CompressedAdjacency) + (offset.capacity() + index.capacity())*sizeof(unsigned int);
+}
+
+}
@@ -0,0 +1,151 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_COMPRESSED_ADJACENCY_H
+#define CINO_COMPRESSED_ADJACENCY_H
+
+#include <vector>
+#include <stdexcept>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Read only view over a contiguous list of indices. This is what the adj_*_span
+ * methods of the meshes return. The view may point either inside a plain
+ * std::vector (mutable mesh), or inside the packed arrays of a CompressedAdjacency
+ * (frozen mesh, see AbstractMesh::adj_freeze). It exposes the (read only) subset of
+ * the std::vector interface used across the library, and converts implicitly to
+ * std::vector<unsigned int>, making a copy.
+ *
+ * WARNING: as for references to std::vector, views are invalidated by any operation
+ * that edits the mesh connectivity. Copy them into a std::vector if you need to
+ * retain the adjacency of an element while editing the mesh.
+*/
+
+class IndexSpan
+{
+    public:
+
+        typedef unsigned int         value_type;
+        typedef const unsigned int * iterator;
+        typedef const unsigned int * const_iterator;
+
+        IndexSpan() : b(nullptr), e(nullptr) {}
+        IndexSpan(const unsigned int * beg, const unsigned int * end) : b(beg), e(end) {}
+        IndexSpan(const std::vector<unsigned int> & v) : b(v.data()), e(v.data()+v.size()) {}
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const unsigned int * begin() const { return b; }
+        const unsigned int * end()   const { return e; }
+        const unsigned int * data()  const { return b; }
+        unsigned int         size()  const { return static_cast<unsigned int>(e-b); }
+        bool                 empty() const { return b==e; }
+        const unsigned int & front() const { return *b;     }
+        const unsigned int & back()  const { return *(e-1); }
+
+        const unsigned int & operator[](const unsigned int i) const { return b[i]; }
+        const unsigned int & at(const unsigned int i) const
+        {
+            if(i>=size()) throw std::out_of_range("IndexSpan::at");
+            return b[i];
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        operator std::vector<unsigned int>() const { return std::vector<unsigned int>(b,e); }
+
+    private:
+
+        const unsigned int *b, *e;
+};
+
+CINO_INLINE bool operator==(const IndexSpan & s0, const IndexSpan & s1);
+CINO_INLINE bool operator!=(const IndexSpan & s0, const IndexSpan & s1);
+CINO_INLINE bool operator==(const IndexSpan & s,  const std::vector<unsigned int> & v);
+CINO_INLINE bool operator!=(const IndexSpan & s,  const std::vector<unsigned int> & v);
+CINO_INLINE bool operator==(const std::vector<unsigned int> & v, const IndexSpan & s);
+CINO_INLINE bool operator!=(const std::vector<unsigned int> & v, const IndexSpan & s);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Compressed Sparse Row (CSR) storage for an element-to-element relation.
+ * All the lists are packed in a single array (index), and the list of the
+ * i-th element spans the range [offset[i], offset[i+1]). Compared to a vector
+ * of vectors this saves a heap allocation and a 24 bytes header per element,
+ * and keeps adjacent lists close in memory.
+*/
+
+class CompressedAdjacency
+{
+    public:
+
+        explicit CompressedAdjacency() {}
+        explicit CompressedAdjacency(const std::vector<std::vector<unsigned int>> & lists) { compress(lists); }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void                                   compress  (const std::vector<std::vector<unsigned int>> & lists);
+        std::vector<std::vector<unsigned int>> decompress() const;
+        void                                   clear     ();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        unsigned int size()        const { return offset.empty() ? 0 : static_cast<unsigned int>(offset.size()-1); }
+        size_t       memory_usage() const; // in bytes
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        IndexSpan operator[](const unsigned int i) const { return IndexSpan(index.data()+offset[i], index.data()+offset[i+1]); }
+        IndexSpan at        (const unsigned int i) const
+        {
+            if(i>=size()) throw std::out_of_range("CompressedAdjacency::at");
+            return operator[](i);
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<unsigned int> offset;
+        std::vector<unsigned int> index;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "compressed_adjacency.cpp"
+#endif
+
+#endif // CINO_COMPRESSED_ADJACENCY_H
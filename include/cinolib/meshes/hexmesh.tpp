@@ -229,7 +229,7 @@ CINO_INLINE
 bool Hexmesh<M,V,E,F,P>::vert_is_singular(const unsigned int vid) const
 {
     unsigned int count = 0;
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         if(this->edge_is_singular(eid)) ++count;
     }
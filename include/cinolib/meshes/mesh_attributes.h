@@ -68,6 +68,9 @@ namespace cinolib
  * Tetmesh<M,V,E,F,P>        my_tetmesh;
  * Hexmesh<M,V,E,F,P>        my_hexmesh;
  * Polyhedralmesh<M,V,E,F,P> my_hexmesh;
+ *
+ * Attributes are stored as arrays of structs. For a structure of arrays
+ * layout (one contiguous column per attribute) see mesh_attributes_soa.h
 */
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
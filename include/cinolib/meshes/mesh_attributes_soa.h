@@ -0,0 +1,459 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_MESH_ATTRIBUTES_SOA_H
+#define CINO_MESH_ATTRIBUTES_SOA_H
+
+#include <cinolib/meshes/mesh_attributes.h>
+#include <vector>
+#include <utility>
+
+namespace cinolib
+{
+
+/* Per element attributes (i.e. the V,E,F,P template arguments of a mesh)
+ * are by default stored as an array of structs (std::vector<V>). This is
+ * flexible, but algorithms that only need a single attribute (e.g. all the
+ * vertex normals, or all the poly flags) have to stride over whole structs.
+ *
+ * Vert_soa_attributes and Polygon_soa_attributes carry exactly the same
+ * attributes of Vert_std_attributes and Polygon_std_attributes, but they are
+ * stored as a structure of arrays, with one contiguous column per attribute.
+ * The layout is opt-in, and is selected via template arguments:
+ *
+ * Trimesh<Mesh_std_attributes,
+ *         Vert_soa_attributes,
+ *         Edge_std_attributes,
+ *         Polygon_soa_attributes> m;
+ *
+ * The usual accessors still work (m.vert_data(vid).normal, m.poly_data(pid).flags[MARKED]...)
+ * but return light proxies made of references to the column entries. Columns can be
+ * accessed directly (and without copies) through the attribute storage, e.g.:
+ *
+ * const std::vector<vec3d>          & normals = m.vert_data_storage().normal;
+ * const std::vector<std::bitset<8>> & flags   = m.poly_data_storage().flags;
+ *
+ * NOTE: columns must never be resized individually. Use the mesh
+ * methods to add/remove elements, which keep all columns in sync.
+*/
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct Vert_soa_attributes    : public Vert_std_attributes    {};
+struct Polygon_soa_attributes : public Polygon_std_attributes {};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// Maps an attribute type to the container used to store it. Array of structs is the default
+template<class T>
+struct AttributeStorage
+{
+    typedef std::vector<T> type;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class Vert_soa_storage
+{
+    public:
+
+        typedef Vert_soa_attributes value_type;
+
+        struct const_reference
+        {
+            const vec3d          & normal;
+            const Color          & color;
+            const vec3d          & uvw;
+            const int            & label;
+            const float          & quality;
+            const std::bitset<8> & flags;
+
+            operator value_type() const
+            {
+                value_type v;
+                v.normal  = normal;
+                v.color   = color;
+                v.uvw     = uvw;
+                v.label   = label;
+                v.quality = quality;
+                v.flags   = flags;
+                return v;
+            }
+        };
+
+        struct reference
+        {
+            vec3d          & normal;
+            Color          & color;
+            vec3d          & uvw;
+            int            & label;
+            float          & quality;
+            std::bitset<8> & flags;
+
+            reference & operator=(const reference       & r) { return assign(r); }
+            reference & operator=(const const_reference & r) { return assign(r); }
+            reference & operator=(const value_type      & v) { return assign(v); }
+
+            operator const_reference() const { return { normal, color, uvw, label, quality, flags }; }
+            operator value_type()      const { return const_reference(*this); }
+
+            template<class T>
+            reference & assign(const T & v)
+            {
+                normal  = v.normal;
+                color   = v.color;
+                uvw     = v.uvw;
+                label   = v.label;
+                quality = v.quality;
+                flags   = v.flags;
+                return *this;
+            }
+        };
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<vec3d>          normal;
+        std::vector<Color>          color;
+        std::vector<vec3d>          uvw;
+        std::vector<int>            label;
+        std::vector<float>          quality;
+        std::vector<std::bitset<8>> flags;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::size_t size()  const { return label.size();  }
+        bool        empty() const { return label.empty(); }
+
+        const_reference at(const std::size_t i) const { return { normal.at(i), color.at(i), uvw.at(i), label.at(i), quality.at(i), flags.at(i) }; }
+              reference at(const std::size_t i)       { return { normal.at(i), color.at(i), uvw.at(i), label.at(i), quality.at(i), flags.at(i) }; }
+
+        const_reference operator[](const std::size_t i) const { return { normal[i], color[i], uvw[i], label[i], quality[i], flags[i] }; }
+              reference operator[](const std::size_t i)       { return { normal[i], color[i], uvw[i], label[i], quality[i], flags[i] }; }
+
+        void push_back(const value_type & v)
+        {
+            normal.push_back(v.normal);
+            color.push_back(v.color);
+            uvw.push_back(v.uvw);
+            label.push_back(v.label);
+            quality.push_back(v.quality);
+            flags.push_back(v.flags);
+        }
+
+        void pop_back()
+        {
+            normal.pop_back();
+            color.pop_back();
+            uvw.pop_back();
+            label.pop_back();
+            quality.pop_back();
+            flags.pop_back();
+        }
+
+        void resize(const std::size_t n, const value_type & v = value_type())
+        {
+            normal.resize(n, v.normal);
+            color.resize(n, v.color);
+            uvw.resize(n, v.uvw);
+            label.resize(n, v.label);
+            quality.resize(n, v.quality);
+            flags.resize(n, v.flags);
+        }
+
+        void reserve(const std::size_t n)
+        {
+            normal.reserve(n);
+            color.reserve(n);
+            uvw.reserve(n);
+            label.reserve(n);
+            quality.reserve(n);
+            flags.reserve(n);
+        }
+
+        void clear()
+        {
+            normal.clear();
+            color.clear();
+            uvw.clear();
+            label.clear();
+            quality.clear();
+            flags.clear();
+        }
+
+        void swap(const std::size_t i, const std::size_t j)
+        {
+            std::swap(normal.at(i),  normal.at(j));
+            std::swap(color.at(i),   color.at(j));
+            std::swap(uvw.at(i),     uvw.at(j));
+            std::swap(label.at(i),   label.at(j));
+            std::swap(quality.at(i), quality.at(j));
+            std::swap(flags.at(i),   flags.at(j));
+        }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class Polygon_soa_storage
+{
+    public:
+
+        typedef Polygon_soa_attributes value_type;
+
+        struct const_reference
+        {
+            const vec3d          & normal;
+            const Color          & color;
+            const int            & label;
+            const float          & quality;
+            const float          & AO;
+            const std::bitset<8> & flags;
+
+            operator value_type() const
+            {
+                value_type v;
+                v.normal  = normal;
+                v.color   = color;
+                v.label   = label;
+                v.quality = quality;
+                v.AO      = AO;
+                v.flags   = flags;
+                return v;
+            }
+        };
+
+        struct reference
+        {
+            vec3d          & normal;
+            Color          & color;
+            int            & label;
+            float          & quality;
+            float          & AO;
+            std::bitset<8> & flags;
+
+            reference & operator=(const reference       & r) { return assign(r); }
+            reference & operator=(const const_reference & r) { return assign(r); }
+            reference & operator=(const value_type      & v) { return assign(v); }
+
+            operator const_reference() const { return { normal, color, label, quality, AO, flags }; }
+            operator value_type()      const { return const_reference(*this); }
+
+            template<class T>
+            reference & assign(const T & v)
+            {
+                normal  = v.normal;
+                color   = v.color;
+                label   = v.label;
+                quality = v.quality;
+                AO      = v.AO;
+                flags   = v.flags;
+                return *this;
+            }
+        };
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<vec3d>          normal;
+        std::vector<Color>          color;
+        std::vector<int>            label;
+        std::vector<float>          quality;
+        std::vector<float>          AO;
+        std::vector<std::bitset<8>> flags;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::size_t size()  const { return label.size();  }
+        bool        empty() const { return label.empty(); }
+
+        const_reference at(const std::size_t i) const { return { normal.at(i), color.at(i), label.at(i), quality.at(i), AO.at(i), flags.at(i) }; }
+              reference at(const std::size_t i)       { return { normal.at(i), color.at(i), label.at(i), quality.at(i), AO.at(i), flags.at(i) }; }
+
+        const_reference operator[](const std::size_t i) const { return { normal[i], color[i], label[i], quality[i], AO[i], flags[i] }; }
+              reference operator[](const std::size_t i)       { return { normal[i], color[i], label[i], quality[i], AO[i], flags[i] }; }
+
+        void push_back(const value_type & v)
+        {
+            normal.push_back(v.normal);
+            color.push_back(v.color);
+            label.push_back(v.label);
+            quality.push_back(v.quality);
+            AO.push_back(v.AO);
+            flags.push_back(v.flags);
+        }
+
+        void pop_back()
+        {
+            normal.pop_back();
+            color.pop_back();
+            label.pop_back();
+            quality.pop_back();
+            AO.pop_back();
+            flags.pop_back();
+        }
+
+        void resize(const std::size_t n, const value_type & v = value_type())
+        {
+            normal.resize(n, v.normal);
+            color.resize(n, v.color);
+            label.resize(n, v.label);
+            quality.resize(n, v.quality);
+            AO.resize(n, v.AO);
+            flags.resize(n, v.flags);
+        }
+
+        void reserve(const std::size_t n)
+        {
+            normal.reserve(n);
+            color.reserve(n);
+            label.reserve(n);
+            quality.reserve(n);
+            AO.reserve(n);
+            flags.reserve(n);
+        }
+
+        void clear()
+        {
+            normal.clear();
+            color.clear();
+            label.clear();
+            quality.clear();
+            AO.clear();
+            flags.clear();
+        }
+
+        void swap(const std::size_t i, const std::size_t j)
+        {
+            std::swap(normal.at(i),  normal.at(j));
+            std::swap(color.at(i),   color.at(j));
+            std::swap(label.at(i),   label.at(j));
+            std::swap(quality.at(i), quality.at(j));
+            std::swap(AO.at(i),      AO.at(j));
+            std::swap(flags.at(i),   flags.at(j));
+        }
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<> struct AttributeStorage<Vert_soa_attributes>    { typedef Vert_soa_storage    type; };
+template<> struct AttributeStorage<Polygon_soa_attributes> { typedef Polygon_soa_storage type; };
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// swaps the attributes of two elements, regardless of the storage layout
+template<class T>
+inline void attribute_swap(std::vector<T> & storage, const std::size_t i, const std::size_t j)
+{
+    std::swap(storage.at(i), storage.at(j));
+}
+
+inline void attribute_swap(Vert_soa_storage    & storage, const std::size_t i, const std::size_t j) { storage.swap(i,j); }
+inline void attribute_swap(Polygon_soa_storage & storage, const std::size_t i, const std::size_t j) { storage.swap(i,j); }
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/* Proxy free access to single attributes, regardless of the storage layout. Loops
+ * that touch only one or two attributes of many elements should use these in place
+ * of vert_data()/poly_data(): with SoA storage they read and write the columns
+ * directly, with AoS storage they access the fields of the structs. Each of them
+ * comes in a const (read) and a non-const (read/write) overload. The *_column
+ * variants return a whole column: the column itself for SoA storage (no copies),
+ * a gathered copy for AoS storage.
+*/
+
+template<class T> inline const vec3d          & attribute_normal (const std::vector<T> & s, const std::size_t i) { return s[i].normal;  }
+template<class T> inline       vec3d          & attribute_normal (      std::vector<T> & s, const std::size_t i) { return s[i].normal;  }
+template<class T> inline const Color          & attribute_color  (const std::vector<T> & s, const std::size_t i) { return s[i].color;   }
+template<class T> inline       Color          & attribute_color  (      std::vector<T> & s, const std::size_t i) { return s[i].color;   }
+template<class T> inline const vec3d          & attribute_uvw    (const std::vector<T> & s, const std::size_t i) { return s[i].uvw;     }
+template<class T> inline       vec3d          & attribute_uvw    (      std::vector<T> & s, const std::size_t i) { return s[i].uvw;     }
+template<class T> inline const int            & attribute_label  (const std::vector<T> & s, const std::size_t i) { return s[i].label;   }
+template<class T> inline       int            & attribute_label  (      std::vector<T> & s, const std::size_t i) { return s[i].label;   }
+template<class T> inline const float          & attribute_quality(const std::vector<T> & s, const std::size_t i) { return s[i].quality; }
+template<class T> inline       float          & attribute_quality(      std::vector<T> & s, const std::size_t i) { return s[i].quality; }
+template<class T> inline const float          & attribute_AO     (const std::vector<T> & s, const std::size_t i) { return s[i].AO;      }
+template<class T> inline       float          & attribute_AO     (      std::vector<T> & s, const std::size_t i) { return s[i].AO;      }
+template<class T> inline const std::bitset<8> & attribute_flags  (const std::vector<T> & s, const std::size_t i) { return s[i].flags;   }
+template<class T> inline       std::bitset<8> & attribute_flags  (      std::vector<T> & s, const std::size_t i) { return s[i].flags;   }
+
+inline const vec3d          & attribute_normal (const Vert_soa_storage    & s, const std::size_t i) { return s.normal[i];  }
+inline       vec3d          & attribute_normal (      Vert_soa_storage    & s, const std::size_t i) { return s.normal[i];  }
+inline const vec3d          & attribute_normal (const Polygon_soa_storage & s, const std::size_t i) { return s.normal[i];  }
+inline       vec3d          & attribute_normal (      Polygon_soa_storage & s, const std::size_t i) { return s.normal[i];  }
+inline const Color          & attribute_color  (const Vert_soa_storage    & s, const std::size_t i) { return s.color[i];   }
+inline       Color          & attribute_color  (      Vert_soa_storage    & s, const std::size_t i) { return s.color[i];   }
+inline const Color          & attribute_color  (const Polygon_soa_storage & s, const std::size_t i) { return s.color[i];   }
+inline       Color          & attribute_color  (      Polygon_soa_storage & s, const std::size_t i) { return s.color[i];   }
+inline const vec3d          & attribute_uvw    (const Vert_soa_storage    & s, const std::size_t i) { return s.uvw[i];     }
+inline       vec3d          & attribute_uvw    (      Vert_soa_storage    & s, const std::size_t i) { return s.uvw[i];     }
+inline const int            & attribute_label  (const Vert_soa_storage    & s, const std::size_t i) { return s.label[i];   }
+inline       int            & attribute_label  (      Vert_soa_storage    & s, const std::size_t i) { return s.label[i];   }
+inline const int            & attribute_label  (const Polygon_soa_storage & s, const std::size_t i) { return s.label[i];   }
+inline       int            & attribute_label  (      Polygon_soa_storage & s, const std::size_t i) { return s.label[i];   }
+inline const float          & attribute_quality(const Vert_soa_storage    & s, const std::size_t i) { return s.quality[i]; }
+inline       float          & attribute_quality(      Vert_soa_storage    & s, const std::size_t i) { return s.quality[i]; }
+inline const float          & attribute_quality(const Polygon_soa_storage & s, const std::size_t i) { return s.quality[i]; }
+inline       float          & attribute_quality(      Polygon_soa_storage & s, const std::size_t i) { return s.quality[i]; }
+inline const float          & attribute_AO     (const Polygon_soa_storage & s, const std::size_t i) { return s.AO[i];      }
+inline       float          & attribute_AO     (      Polygon_soa_storage & s, const std::size_t i) { return s.AO[i];      }
+inline const std::bitset<8> & attribute_flags  (const Vert_soa_storage    & s, const std::size_t i) { return s.flags[i];   }
+inline       std::bitset<8> & attribute_flags  (      Vert_soa_storage    & s, const std::size_t i) { return s.flags[i];   }
+inline const std::bitset<8> & attribute_flags  (const Polygon_soa_storage & s, const std::size_t i) { return s.flags[i];   }
+inline       std::bitset<8> & attribute_flags  (      Polygon_soa_storage & s, const std::size_t i) { return s.flags[i];   }
+
+template<class T>
+inline std::vector<vec3d> attribute_normal_column(const std::vector<T> & s)
+{
+    std::vector<vec3d> column;
+    column.reserve(s.size());
+    for(const T & item : s) column.push_back(item.normal);
+    return column;
+}
+
+template<class T>
+inline std::vector<int> attribute_label_column(const std::vector<T> & s)
+{
+    std::vector<int> column;
+    column.reserve(s.size());
+    for(const T & item : s) column.push_back(item.label);
+    return column;
+}
+
+inline const std::vector<vec3d> & attribute_normal_column(const Vert_soa_storage    & s) { return s.normal; }
+inline const std::vector<vec3d> & attribute_normal_column(const Polygon_soa_storage & s) { return s.normal; }
+inline const std::vector<int>   & attribute_label_column (const Vert_soa_storage    & s) { return s.label;  }
+inline const std::vector<int>   & attribute_label_column (const Polygon_soa_storage & s) { return s.label;  }
+
+}
+
+#endif // CINO_MESH_ATTRIBUTES_SOA_H
@@ -49,11 +49,14 @@ void MeshSlicer::slice(AbstractMesh<M,V,E,P> & m)
     double Y_abs_thresh = m.bbox().min[1] + m.bbox().delta()[1] * (Y_thresh);
     double Z_abs_thresh = m.bbox().min[2] + m.bbox().delta()[2] * (Z_thresh);
 
+    // only three attributes are touched: access them without proxies (see mesh_attributes_soa.h)
+    auto & p_data = m.poly_data_storage();
+
     for(unsigned int pid=0; pid<m.num_polys(); ++pid)
     {
         vec3d c = m.poly_centroid(pid);
-        float q = m.poly_data(pid).quality;
-        int   l = m.poly_data(pid).label;
+        float q = attribute_quality(p_data, pid);
+        int   l = attribute_label(p_data, pid);
 
         bool pass_X = (X_leq) ? (c.x() <= X_abs_thresh) : (c.x() >= X_abs_thresh);
         bool pass_Y = (Y_leq) ? (c.y() <= Y_abs_thresh) : (c.y() >= Y_abs_thresh);
@@ -64,7 +67,7 @@ void MeshSlicer::slice(AbstractMesh<M,V,E,P> & m)
         bool b = (mode_AND) ? ( pass_X &&  pass_Y &&  pass_Z &&  pass_L &&  pass_Q)
                             : (!pass_X || !pass_Y || !pass_Z || !pass_L || !pass_Q);
 
-        m.poly_data(pid).flags[HIDDEN] = !b;
+        attribute_flags(p_data, pid)[HIDDEN] = !b;
 
         //std::cout << pass_X << " " << pass_Y << " " << pass_Z << " " << pass_Q << " " << pass_L << std::endl;
     }
@@ -127,7 +127,7 @@ int Quadmesh<M,V,E,P>::vert_next_along_chain(const unsigned int curr, const unsi
     int e1 = this->edge_id(curr, prev);
     assert(e1>=0);
 
-    for(unsigned int e2 : this->adj_v2e(curr))
+    for(unsigned int e2 : this->adj_v2e_span(curr))
     {
         if (!this->edges_share_poly(e1,e2)) return this->vert_opposite_to(e2,curr);
     }
@@ -164,7 +164,7 @@ int Quadmesh<M,V,E,P>::edge_next_along_chain(const unsigned int eid, const unsig
 {
     if(vert_is_singular(vid)) return -1; // walking through a singular vertex is ambiguous...
 
-    for(unsigned int nbr : this->adj_v2e(vid))
+    for(unsigned int nbr : this->adj_v2e_span(vid))
     {
         if (!this->edges_share_poly(eid,nbr)) return nbr;
     }
@@ -201,7 +201,7 @@ CINO_INLINE
 std::vector<unsigned int> Quadmesh<M,V,E,P>::edges_opposite_to(const unsigned int eid) const
 {
     std::vector<unsigned int> res;
-    for(unsigned int pid : this->adj_e2p(eid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
     {
         res.push_back(edge_opposite_to(pid,eid));
     }
@@ -220,7 +220,7 @@ unsigned int Quadmesh<M,V,E,P>::edge_opposite_to(const unsigned int pid, const u
     unsigned int vid0 = this->edge_vert_id(eid,0);
     unsigned int vid1 = this->edge_vert_id(eid,1);
 
-    for(unsigned int e : this->adj_p2e(pid))
+    for(unsigned int e : this->adj_p2e_span(pid))
     {
         if (!this->edge_contains_vert(e,vid0) &&
             !this->edge_contains_vert(e,vid1))
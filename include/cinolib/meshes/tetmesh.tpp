@@ -210,6 +210,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::edge_split(const unsigned int eid, const double lambda)
 {
+    this->adj_thaw();
     return edge_split(eid, this->edge_sample_at(eid,lambda));
 }
 
@@ -219,6 +220,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::edge_split(const unsigned int eid, const vec3d & p)
 {
+    this->adj_thaw();
     assert(this->edge_valence(eid)>0);
 
     unsigned int new_vid = this->vert_add(p);
@@ -355,8 +357,8 @@ bool Tetmesh<M,V,E,F,P>::edge_is_geometrically_collapsible(const unsigned int ei
     unsigned int vid1 = this->edge_vert_id(eid,1);
 
     std::unordered_set<unsigned int> polys_to_test;
-    for(unsigned int pid : this->adj_v2p(vid0)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
-    for(unsigned int pid : this->adj_v2p(vid1)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
+    for(unsigned int pid : this->adj_v2p_span(vid0)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
+    for(unsigned int pid : this->adj_v2p_span(vid1)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
 
     for(unsigned int pid : polys_to_test)
     {
@@ -380,6 +382,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 int Tetmesh<M,V,E,F,P>::edge_collapse(const unsigned int eid, const double lambda, const double topologic_check, const double geometric_check)
 {
+    this->adj_thaw();
     vec3d p = this->edge_sample_at(eid, lambda);
     return edge_collapse(eid, p, topologic_check, geometric_check);
 }
@@ -390,6 +393,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 int Tetmesh<M,V,E,F,P>::edge_collapse(const unsigned int eid, const vec3d & p, const double topologic_check, const double geometric_check)
 {
+    this->adj_thaw();
     if(topologic_check && !edge_is_topologically_collapsible(eid))    return -1;
     if(geometric_check && !edge_is_geometrically_collapsible(eid, p)) return -1;
 
@@ -443,6 +447,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 bool Tetmesh<M,V,E,F,P>::face_flip(const unsigned int fid, bool geometric_check) // 2-to-3 flip
 {
+    this->adj_thaw();
     if(this->adj_f2p(fid).size()!=2) return false;
 
     unsigned int pid0 = this->adj_f2p(fid).front();
@@ -502,6 +507,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 bool Tetmesh<M,V,E,F,P>::edge_flip(const unsigned int eid) // 3-to-2 flip
 {
+    this->adj_thaw();
     // "An edge is topologically unflippable if does not
     //  have exactly three incident faces or the face that
     //  would replace it is already in the complex"
@@ -586,6 +592,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::face_split(const unsigned int fid, const std::vector<double> & bc)
 {
+    this->adj_thaw();
     assert(bc.size()==3);
 
     vec3d p = this->face_vert(fid,0) * bc.at(0) +
@@ -601,6 +608,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::face_split(const unsigned int fid, const vec3d & p)
 {
+    this->adj_thaw();
     unsigned int new_vid = this->vert_add(p);
 
     for(unsigned int pid : this->adj_f2p(fid))
@@ -654,11 +662,11 @@ CINO_INLINE
 void Tetmesh<M,V,E,F,P>::vert_weights_cotangent(const unsigned int vid, std::vector<std::pair<unsigned int,double>> & wgts) const
 {
     wgts.clear();
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         unsigned int   nbr = this->vert_opposite_to(eid, vid);
         double wgt = 0.0;
-        for(unsigned int pid : this->adj_e2p(eid))
+        for(unsigned int pid : this->adj_e2p_span(eid))
         {
             unsigned int   e_opp     = poly_edge_opposite_to(pid, vid, nbr);
             unsigned int   f_opp_vid = poly_face_opposite_to(pid, vid);
@@ -726,6 +734,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 void Tetmesh<M,V,E,F,P>::polys_split(const std::vector<unsigned int> & pids)
 {
+    this->adj_thaw();
     // in order to avoid id conflicts split all the
     // polys starting from the one with highest id
     //
@@ -739,6 +748,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::poly_split(const unsigned int pid, const std::vector<double> & bc)
 {
+    this->adj_thaw();
     assert(bc.size()==4);
 
     vec3d p = this->poly_vert(pid,0) * bc.at(0) +
@@ -755,6 +765,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::poly_split(const unsigned int pid, const vec3d & p)
 {
+    this->adj_thaw();
     unsigned int vid = this->vert_add(p);
     return this->poly_split(pid,vid);
 }
@@ -765,6 +776,7 @@ template<class M, class V, class E, class F, class P>
 CINO_INLINE
 unsigned int Tetmesh<M,V,E,F,P>::poly_split(const unsigned int pid, const unsigned int vid)
 {
+    this->adj_thaw();
     assert(this->vert_valence(vid)==0);
     for(unsigned int fid : this->adj_p2f(pid))
     {        
@@ -808,7 +820,7 @@ int Tetmesh<M,V,E,F,P>::poly_id_from_vids(const std::vector<unsigned int> & vlis
     std::vector<unsigned int> query = SORT_VEC(vlist);
 
     unsigned int vid = vlist.front();
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         if(this->poly_verts_id(pid,true)==query) return pid;
     }
@@ -861,7 +873,7 @@ unsigned int Tetmesh<M,V,E,F,P>::poly_edge_opposite_to(const unsigned int pid, c
     assert(this->poly_contains_vert(pid,vid0));
     assert(this->poly_contains_vert(pid,vid1));
 
-    for(unsigned int eid : this->adj_p2e(pid))
+    for(unsigned int eid : this->adj_p2e_span(pid))
     {
         if (!this->edge_contains_vert(eid,vid0) &&
             !this->edge_contains_vert(eid,vid1))
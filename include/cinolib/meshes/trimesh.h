@@ -100,8 +100,11 @@ class Trimesh : public AbstractPolygonMesh<M,V,E,P>
 
         unsigned int              edge_opposite_to                 (const unsigned int pid, const unsigned int vid) const;
         int               edge_collapse                    (const unsigned int eid, const double lambda = 0.5, const bool topologic_check = true, const bool geometric_check = true);
+        int               edge_collapse                    (const unsigned int eid, const vec3d & p, const bool topologic_check = true, const bool geometric_check = true);
         bool              edge_is_collapsible              (const unsigned int eid, const double lambda) const;
+        bool              edge_is_collapsible              (const unsigned int eid, const vec3d & p) const;
         bool              edge_is_geometrically_collapsible(const unsigned int eid, const double lambda) const;
+        bool              edge_is_geometrically_collapsible(const unsigned int eid, const vec3d & p) const;
         bool              edge_is_topologically_collapsible(const unsigned int eid) const;
         unsigned int              edge_split                       (const unsigned int eid, const double lambda = 0.5);
         unsigned int              edge_split                       (const unsigned int eid, const vec3d & p);
@@ -112,7 +112,7 @@ CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::edge_opposite_to(const unsigned int pid, const unsigned int vid) const
 {
     assert(this->poly_contains_vert(pid, vid));
-    for(unsigned int eid : this->adj_p2e(pid))
+    for(unsigned int eid : this->adj_p2e_span(pid))
     {
         if(!this->edge_contains_vert(eid,vid)) return eid;
     }
@@ -125,9 +125,18 @@ unsigned int Trimesh<M,V,E,P>::edge_opposite_to(const unsigned int pid, const un
 template<class M, class V, class E, class P>
 CINO_INLINE
 bool Trimesh<M,V,E,P>::edge_is_collapsible(const unsigned int eid, const double lambda) const
+{
+    return edge_is_collapsible(eid, this->edge_sample_at(eid, lambda));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool Trimesh<M,V,E,P>::edge_is_collapsible(const unsigned int eid, const vec3d & p) const
 {
     if(!edge_is_topologically_collapsible(eid)) return false;
-    if(!edge_is_geometrically_collapsible(eid, lambda)) return false;
+    if(!edge_is_geometrically_collapsible(eid, p)) return false;
     return true;
 }
 
@@ -174,15 +183,23 @@ bool Trimesh<M,V,E,P>::edge_is_topologically_collapsible(const unsigned int eid)
 template<class M, class V, class E, class P>
 CINO_INLINE
 bool Trimesh<M,V,E,P>::edge_is_geometrically_collapsible(const unsigned int eid, const double lambda) const
+{
+    return edge_is_geometrically_collapsible(eid, this->edge_sample_at(eid, lambda));
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+bool Trimesh<M,V,E,P>::edge_is_geometrically_collapsible(const unsigned int eid, const vec3d & new_vert) const
 {
     // no triangle should flip or collapse
-    vec3d new_vert = this->edge_sample_at(eid, lambda);
     unsigned int  vid0     = this->edge_vert_id(eid,0);
     unsigned int  vid1     = this->edge_vert_id(eid,1);
 
     std::unordered_set<unsigned int> polys_to_test;
-    for(unsigned int pid : this->adj_v2p(vid0)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
-    for(unsigned int pid : this->adj_v2p(vid1)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
+    for(unsigned int pid : this->adj_v2p_span(vid0)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
+    for(unsigned int pid : this->adj_v2p_span(vid1)) if(!this->poly_contains_edge(pid, eid)) polys_to_test.insert(pid);
 
     for(unsigned int pid : polys_to_test)
     {
@@ -196,7 +213,7 @@ bool Trimesh<M,V,E,P>::edge_is_geometrically_collapsible(const unsigned int eid,
         // avoid tiny triangles
         if(triangle_area(v[0], v[1], v[2]) < 1e-10) return false;
         // avoid flips and collapses
-        if(triangle_normal(v[0], v[1], v[2]).dot(this->poly_data(pid).normal) <= 0) return false;
+        if(triangle_normal(v[0], v[1], v[2]).dot(this->poly_normal(pid)) <= 0) return false;
     }
 
     return true;
@@ -208,6 +225,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::vert_split(const unsigned int eid0, const unsigned int eid1)
 {    
+    this->adj_thaw();
     unsigned int v0 = this->vert_shared(eid0, eid1);
     unsigned int v1 = this->vert_add(vec3d{0,0,0});
 
@@ -241,7 +259,9 @@ unsigned int Trimesh<M,V,E,P>::vert_split(const unsigned int eid0, const unsigne
     this->vert(v0) = xyz0;
     this->vert(v1) = xyz1;
 
-    if(this->mesh_data().update_normals)
+    bool eager_normals = this->mesh_data().update_normals && !this->lazy_updates_enabled();
+    if(this->lazy_updates_enabled()) this->vert_set_dirty(v0);
+    if(eager_normals)
     {
         for(unsigned int pid : pids0) this->update_p_normal(pid);
     }
@@ -251,10 +271,10 @@ unsigned int Trimesh<M,V,E,P>::vert_split(const unsigned int eid0, const unsigne
         for(unsigned int & v : v_list) if(v==v0) v = v1;
         unsigned int new_pid = this->poly_add(v_list);
         this->poly_data(new_pid) = this->poly_data(pid);
-        if(this->mesh_data().update_normals) this->update_p_normal(new_pid);
+        if(eager_normals) this->update_p_normal(new_pid);
     }
-    if(this->mesh_data().update_normals) this->update_v_normal(v0);
-    if(this->mesh_data().update_normals) this->update_v_normal(v1);
+    if(eager_normals) this->update_v_normal(v0);
+    if(eager_normals) this->update_v_normal(v1);
     this->polys_remove(pids1);
 
     // tessellate the quad-like hole
@@ -277,8 +297,20 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int Trimesh<M,V,E,P>::edge_collapse(const unsigned int eid, const double lambda, const bool topologic_check, const bool geometric_check)
 {
-    if(topologic_check && !edge_is_topologically_collapsible(eid))         return -1;
-    if(geometric_check && !edge_is_geometrically_collapsible(eid, lambda)) return -1;
+    this->adj_thaw();
+    vec3d p = this->edge_sample_at(eid, lambda);
+    return edge_collapse(eid, p, topologic_check, geometric_check);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+int Trimesh<M,V,E,P>::edge_collapse(const unsigned int eid, const vec3d & p, const bool topologic_check, const bool geometric_check)
+{
+    this->adj_thaw();
+    if(topologic_check && !edge_is_topologically_collapsible(eid))    return -1;
+    if(geometric_check && !edge_is_geometrically_collapsible(eid, p)) return -1;
 
 #ifndef NDEBUG
     int euler_before = this->Euler_characteristic();
@@ -288,7 +320,9 @@ int Trimesh<M,V,E,P>::edge_collapse(const unsigned int eid, const double lambda,
     unsigned int vert_to_remove = this->edge_vert_id(eid,1);
     if (vert_to_remove < vert_to_keep) std::swap(vert_to_keep, vert_to_remove); // remove vert with highest ID
 
-    this->vert(vert_to_keep) = this->edge_sample_at(eid, lambda); // reposition vertex
+    this->vert(vert_to_keep) = p; // reposition vertex
+    if(this->lazy_updates_enabled()) this->vert_set_dirty(vert_to_keep);
+    bool eager_normals = this->mesh_data().update_normals && !this->lazy_updates_enabled();
 
     for(unsigned int pid : this->adj_v2p(vert_to_remove))
     {
@@ -300,9 +334,9 @@ int Trimesh<M,V,E,P>::edge_collapse(const unsigned int eid, const double lambda,
         unsigned int new_pid = this->poly_add(vlist);
 
         this->poly_data(new_pid) = this->poly_data(pid);
-        if(this->mesh_data().update_normals) this->update_p_normal(new_pid);
+        if(eager_normals) this->update_p_normal(new_pid);
     }
-    if(this->mesh_data().update_normals) this->update_v_normal(vert_to_keep);
+    if(eager_normals) this->update_v_normal(vert_to_keep);
 
     this->vert_remove(vert_to_remove);
 
@@ -322,6 +356,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::edge_split(const unsigned int eid, const double lambda)
 {
+    this->adj_thaw();
     return edge_split(eid, this->edge_sample_at(eid,lambda));
 }
 
@@ -331,9 +366,11 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::edge_split(const unsigned int eid, const vec3d & p)
 {
+    this->adj_thaw();
     unsigned int new_vid = this->vert_add(p);
     unsigned int vid0    = this->edge_vert_id(eid,0);
     unsigned int vid1    = this->edge_vert_id(eid,1);
+    bool eager_normals   = this->mesh_data().update_normals && !this->lazy_updates_enabled();
 
     for(unsigned int pid : this->adj_e2p(eid))
     {
@@ -343,10 +380,10 @@ unsigned int Trimesh<M,V,E,P>::edge_split(const unsigned int eid, const vec3d &
         unsigned int new_pid2 = this->poly_add(v_opp, new_vid, vid1);
         this->poly_data(new_pid1) = this->poly_data(pid);
         this->poly_data(new_pid2) = this->poly_data(pid);
-        if(this->mesh_data().update_normals) this->update_p_normal(new_pid1);
-        if(this->mesh_data().update_normals) this->update_p_normal(new_pid2);
+        if(eager_normals) this->update_p_normal(new_pid1);
+        if(eager_normals) this->update_p_normal(new_pid2);
     }
-    if(this->mesh_data().update_normals) this->update_v_normal(new_vid);
+    if(eager_normals) this->update_v_normal(new_vid);
 
     // copy edge data
     int eid0 = this->edge_id(vid0,new_vid); assert(eid0>=0);
@@ -368,16 +405,16 @@ bool Trimesh<M,V,E,P>::edge_is_flippable(const unsigned int eid)
     if(!this->edge_is_manifold(eid)) return false;
 
     // geometric check (if the projected outline is a concave quad, discard the move)
-    assert(this->adj_e2p(eid).size()==2);
-    unsigned int  pid0 = this->adj_e2p(eid).front();
-    unsigned int  pid1 = this->adj_e2p(eid).back();
+    assert(this->adj_e2p_span(eid).size()==2);
+    unsigned int  pid0 = this->adj_e2p_span(eid).front();
+    unsigned int  pid1 = this->adj_e2p_span(eid).back();
     unsigned int  vid0 = this->edge_vert_id(eid,0);
     unsigned int  vid1 = this->edge_vert_id(eid,1);
     unsigned int  opp0 = this->vert_opposite_to(pid0,vid0,vid1);
     unsigned int  opp1 = this->vert_opposite_to(pid1,vid0,vid1);
     if(!this->poly_verts_are_CCW(pid0, vid1, vid0)) std::swap(vid0,vid1);
-    vec3d n0   = this->poly_data(pid0).normal;
-    vec3d n1   = this->poly_data(pid1).normal;
+    vec3d n0   = this->poly_normal(pid0);
+    vec3d n1   = this->poly_normal(pid1);
     if(triangle_area(this->vert(opp0),this->vert(vid0),this->vert(opp1))<1e-5) return false;
     if(triangle_area(this->vert(opp1),this->vert(vid1),this->vert(opp0))<1e-5) return false;
     vec3d n2   = triangle_normal(this->vert(opp0),this->vert(vid0),this->vert(opp1));
@@ -402,7 +439,7 @@ double Trimesh<M,V,E,P>::edge_cotangent_weight(const unsigned int eid) const
     unsigned int   vid1  = this->edge_vert_id(eid,1);
     double count = 0.0;
     double sum   = 0.0;
-    for(unsigned int pid : this->adj_e2p(eid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
     {
         unsigned int   v_opp = this->vert_opposite_to(pid, vid0, vid1);
         double alpha = this->poly_angle_at_vert(pid, v_opp);
@@ -423,6 +460,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int Trimesh<M,V,E,P>::edge_flip(const unsigned int eid, const bool geometric_check)
 {
+    this->adj_thaw();
     if(geometric_check && !edge_is_flippable(eid)) return -1;
 
     assert(this->adj_e2p(eid).size()==2);
@@ -468,7 +506,7 @@ unsigned int Trimesh<M,V,E,P>::poly_edge_id(const unsigned int pid, const unsign
     unsigned int vid0 = this->poly_vert_id(pid, TRI_EDGES[offset][0]);
     unsigned int vid1 = this->poly_vert_id(pid, TRI_EDGES[offset][1]);
 
-    for(unsigned int eid : this->adj_p2e(pid))
+    for(unsigned int eid : this->adj_p2e_span(pid))
     {
         if (this->edge_contains_vert(eid,vid0) &&
             this->edge_contains_vert(eid,vid1))
@@ -485,6 +523,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::poly_split(const unsigned int pid)
 {
+    this->adj_thaw();
     // uses centroid as default split point
     return this->poly_split(pid, this->poly_centroid(pid));
 }
@@ -495,6 +534,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::poly_split(const unsigned int pid, const vec3d & p)
 {
+    this->adj_thaw();
     unsigned int vids[4] =
     {
         this->poly_vert_id(pid, 0),
@@ -560,6 +600,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 unsigned int Trimesh<M,V,E,P>::poly_add(const unsigned int vid0, const unsigned int vid1, const unsigned int vid2)
 {
+    this->adj_thaw();
     std::vector<unsigned int> p = { vid0, vid1, vid2 };
     return this->poly_add(p);
 }
@@ -570,7 +611,7 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 int Trimesh<M,V,E,P>::poly_id(const unsigned int eid0, const unsigned int eid1) const
 {
-    for(unsigned int pid : this->adj_e2p(eid0))
+    for(unsigned int pid : this->adj_e2p_span(eid0))
     {
         if(this->poly_contains_edge(pid, eid1)) return pid;
     }
@@ -615,7 +656,7 @@ CINO_INLINE
 std::vector<unsigned int> Trimesh<M,V,E,P>::vert_link_edges(const unsigned int vid) const
 {
     std::vector<unsigned int> e_link;
-    for(unsigned int pid : this->adj_v2p(vid))
+    for(unsigned int pid : this->adj_v2p_span(vid))
     {
         e_link.push_back(this->edge_opposite_to(pid,vid));
     }
@@ -629,7 +670,7 @@ CINO_INLINE
 std::vector<unsigned int> Trimesh<M,V,E,P>::verts_opposite_to(const unsigned int eid) const
 {
     std::vector<unsigned int> vlist;
-    for(unsigned int pid : this->adj_e2p(eid))
+    for(unsigned int pid : this->adj_e2p_span(eid))
     {
         vlist.push_back(this->vert_opposite_to(pid, this->edge_vert_id(eid,0), this->edge_vert_id(eid,1)));
     }
@@ -666,7 +707,7 @@ CINO_INLINE
 void Trimesh<M,V,E,P>::vert_weights_cotangent(const unsigned int vid, std::vector<std::pair<unsigned int,double>> & wgts) const
 {
     wgts.clear();
-    for(unsigned int eid : this->adj_v2e(vid))
+    for(unsigned int eid : this->adj_v2e_span(vid))
     {
         unsigned int   nbr = this->vert_opposite_to(eid, vid);
         double wgt = this->edge_cotangent_weight(eid);
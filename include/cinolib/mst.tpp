@@ -71,7 +71,7 @@ void MST_on_dual_mask_on_edges(const AbstractPolygonMesh<M,V,E,P> & m,
             tree.at(eid) = true;
         }
 
-        for(unsigned int nbr : m.adj_p2p(pid))
+        for(unsigned int nbr : m.adj_p2p_span(pid))
         {
             if(!dequeued.at(nbr)) // element is still in the queue
             {
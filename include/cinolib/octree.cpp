@@ -41,6 +41,7 @@
 #include <cinolib/geometry/segment.h>
 #include <cinolib/geometry/triangle.h>
 #include <cinolib/geometry/tetrahedron.h>
+#include <cinolib/trace_profiler.h>
 #include <stack>
 #include <numeric>
 
@@ -101,6 +102,7 @@ void Octree::clear()
 CINO_INLINE
 void Octree::build()
 {
+    CINO_PROFILE_ZONE("Octree::build");
     typedef std::chrono::high_resolution_clock Time;
     Time::time_point t0 = Time::now();
 
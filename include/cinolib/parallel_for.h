@@ -37,7 +37,10 @@
 #define CINO_PARALLEL_FOR_H
 
 #include <sys/types.h>
+#include <atomic>
+#include <cstdint>
 #include <cinolib/cino_inline.h>
+#include <cinolib/thread_pool.h>
 
 namespace cinolib
 {
@@ -45,13 +48,19 @@ namespace cinolib
 /* OpenMP-like parallel for loop realized in plain C++11
  * Thanks to Jeremy Dumas for his code (https://ideone.com/Z7zldb)
  *
- * DISCLAIMER: this routine is as good as OpenMP with STATIC scheduling.
- * That is, it works best when computational cost is equally distributed
- * across all threads. In case of unbalanced distribution, performances
- * may degrade, and using the DYNAMIC scheduling of a library such as OpenMP
- * will greatly benefit performances.
+ * Loops run on a persistent pool of threads (see ThreadPool), so no thread
+ * is created at each call. The range is split in one block per thread, and
+ * each thread consumes its own block in chunks. Threads that run out of work
+ * steal chunks from the blocks of the others, so that unbalanced loops
+ * (e.g. octree leaves with very different numbers of items) keep all threads
+ * busy. Chunks can be
  *
- * PARALLEL_FOR has three arguments
+ *     PARALLEL_STATIC : no chunks. Each thread processes its block, no stealing
+ *     PARALLEL_DYNAMIC: chunks of fixed size (chunk_size, or 1/8 of a block if zero)
+ *     PARALLEL_GUIDED : chunks proportional to the remaining work, down to chunk_size.
+ *                       This is the default
+ *
+ * PARALLEL_FOR has three mandatory arguments
  *
  *     beg,end             : define a range of indices
  *     serial_if_less_than : avoid paying the overhead if the range is smaller than...
@@ -75,15 +84,71 @@ namespace cinolib
  *    m.update_p_normal(pid);
  * });
  *
+ * PARALLEL_REDUCE evaluates func(i,acc) for each index, accumulating in
+ * one accumulator per thread (initialized with identity), and returns the
+ * accumulators combined with reduce. E.g., the total area of a mesh is
+ *
+ * double area = PARALLEL_REDUCE(0, m.num_polys(), 1000, 0.0,
+ *                               [&m](int pid, double & a){ a += m.poly_area(pid); },
+ *                               [](double a, double b){ return a+b; });
+ *
+ * Loops issued from inside a parallel loop (or while another thread is using
+ * the pool) are executed serially by the calling thread.
+ *
  * NOTE: if symbol SERIALIZE_PARALLEL_FOR is defined at compilation time,
  * the loop will be executed in standard serial mode.
 */
 
+enum ParallelSchedule
+{
+    PARALLEL_STATIC,
+    PARALLEL_DYNAMIC,
+    PARALLEL_GUIDED,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 template<typename Func>
-inline void PARALLEL_FOR(      unsigned int   beg,
-                               unsigned int   end,
-                         const unsigned int   serial_if_less_than,
-                         const Func & func);
+inline void PARALLEL_FOR(      unsigned int       beg,
+                               unsigned int       end,
+                         const unsigned int       serial_if_less_than,
+                         const Func             & func,
+                         const ParallelSchedule   schedule   = PARALLEL_GUIDED,
+                         const unsigned int       chunk_size = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<typename T, typename Func, typename Reduce>
+inline T PARALLEL_REDUCE(      unsigned int       beg,
+                               unsigned int       end,
+                         const unsigned int       serial_if_less_than,
+                         const T                & identity,
+                         const Func             & func,
+                         const Reduce           & reduce,
+                         const ParallelSchedule   schedule   = PARALLEL_GUIDED,
+                         const unsigned int       chunk_size = 0);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// block of indices initially assigned to a thread. Chunks are claimed by advancing
+// next, by the owner as well as by thieves. Padding avoids false sharing
+struct ParallelForBlock
+{
+    std::atomic<uint64_t> next;
+    uint64_t              end;
+    char                  padding[64-2*sizeof(uint64_t)];
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits [beg,end) in num_threads blocks, and runs the job of each thread of the pool,
+// which calls chunk_func(i0,i1,thread_id) on all the chunks it processes
+template<typename ChunkFunc>
+inline void PARALLEL_FOR_chunks(const unsigned int       beg,
+                                const unsigned int       end,
+                                const ParallelSchedule   schedule,
+                                const unsigned int       chunk_size,
+                                const ChunkFunc        & chunk_func);
 }
 
 
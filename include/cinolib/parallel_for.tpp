@@ -34,67 +34,147 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/parallel_for.h>
-
-
-#include <thread>
+#include <algorithm>
 #include <vector>
-#include <cmath>
 
 namespace cinolib
 {
 
-    template<typename Func>
-    inline void PARALLEL_FOR(unsigned int   beg,
-        unsigned int   end,
-        const unsigned int   serial_if_less_than,
-        const Func& func)
-    {
+template<typename Func>
+inline void PARALLEL_FOR(      unsigned int       beg,
+                               unsigned int       end,
+                         const unsigned int       serial_if_less_than,
+                         const Func             & func,
+                         const ParallelSchedule   schedule,
+                         const unsigned int       chunk_size)
+{
+    if(end<=beg) return;
+
 #ifndef SERIALIZE_PARALLEL_FOR
+    if(end-beg >= serial_if_less_than)
+    {
+        PARALLEL_FOR_chunks(beg, end, schedule, chunk_size, [&func](unsigned int i0, unsigned int i1, unsigned int)
+        {
+            for(unsigned int i=i0; i<i1; ++i) func(i);
+        });
+        return;
+    }
+#endif
+    for(unsigned int i=beg; i<end; ++i) func(i);
+}
 
-        unsigned int n = end - beg + 1;
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-        if (n < serial_if_less_than)
-        {
-            for (unsigned int i = beg; i < end; ++i) func(i);
-        }
-        else
+template<typename T, typename Func, typename Reduce>
+inline T PARALLEL_REDUCE(      unsigned int       beg,
+                               unsigned int       end,
+                         const unsigned int       serial_if_less_than,
+                         const T                & identity,
+                         const Func             & func,
+                         const Reduce           & reduce,
+                         const ParallelSchedule   schedule,
+                         const unsigned int       chunk_size)
+{
+    T acc = identity;
+    if(end<=beg) return acc;
+
+#ifndef SERIALIZE_PARALLEL_FOR
+    if(end-beg >= serial_if_less_than)
+    {
+        // one accumulator per thread, combined in thread order
+        std::vector<T>    thread_acc(ThreadPool::instance().num_threads(), identity);
+        PARALLEL_FOR_chunks(beg, end, schedule, chunk_size, [&](unsigned int i0, unsigned int i1, unsigned int tid)
         {
-            // estimate number of threads in the pool
-            const static unsigned n_threads_hint = std::thread::hardware_concurrency();
-            const static unsigned n_threads = (n_threads_hint == 0u) ? 8u : n_threads_hint;
+            T & a = thread_acc.at(tid);
+            for(unsigned int i=i0; i<i1; ++i) func(i,a);
+        });
+        for(const T & a : thread_acc) acc = reduce(acc,a);
+        return acc;
+    }
+#endif
+    for(unsigned int i=beg; i<end; ++i) func(i,acc);
+    return acc;
+}
 
-            // split the full range into sub ranges of equal size
-            unsigned int slice = (unsigned int)std::round(n / static_cast<double>(n_threads));
-            slice = std::max<unsigned int>(slice, 1);
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-            // helper function that handles a sub range
-            auto subrange_helper = [&func](unsigned int k1, unsigned int k2)
-            {
-                for (unsigned int k = k1; k < k2; ++k) func(k);
-            };
+template<typename ChunkFunc>
+inline void PARALLEL_FOR_chunks(const unsigned int       beg,
+                                const unsigned int       end,
+                                const ParallelSchedule   schedule,
+                                const unsigned int       chunk_size,
+                                const ChunkFunc        & chunk_func)
+{
+    ThreadPool & pool = ThreadPool::instance();
+    unsigned int nt   = pool.num_threads();
 
-            // create pool and launch jobs
-            std::vector<std::thread> pool;
-            pool.reserve(n_threads);
-            unsigned int i1 = beg;
-            unsigned int i2 = std::min(beg + slice, end);
-            for (unsigned int i = 0; i + 1 < n_threads && i1 < end; ++i)
+    // serial execution (single thread, nested loop or busy pool)
+    if(nt==1 || ThreadPool::in_parallel_region())
+    {
+        chunk_func(beg, end, 0);
+        return;
+    }
+
+    uint64_t n = end - beg;
+    std::vector<ParallelForBlock> blocks(nt);
+    for(unsigned int tid=0; tid<nt; ++tid)
+    {
+        blocks[tid].next = beg + (n*tid)/nt;
+        blocks[tid].end  = beg + (n*(tid+1))/nt;
+    }
+
+    // chunk sizes are relative to the size of the blocks
+    uint64_t block_size = std::max<uint64_t>(1, n/nt);
+    uint64_t min_chunk  = (chunk_size>0) ? chunk_size : std::max<uint64_t>(1, block_size/64);
+    uint64_t dyn_chunk  = (chunk_size>0) ? chunk_size : std::max<uint64_t>(1, block_size/8);
+
+    // claims a chunk from a block. Returns false if the block is exhausted
+    auto claim = [&](ParallelForBlock & b, uint64_t & i0, uint64_t & i1)
+    {
+        switch(schedule)
+        {
+            case PARALLEL_STATIC:
             {
-                pool.emplace_back(subrange_helper, i1, i2);
-                i1 = i2;
-                i2 = std::min(i2 + slice, end);
+                i0 = b.next.exchange(b.end);
+                break;
             }
-            if (i1 < end) pool.emplace_back(subrange_helper, i1, end);
-
-            // Wait for jobs to finish
-            for (std::thread& t : pool)
+            case PARALLEL_DYNAMIC:
             {
-                if (t.joinable()) t.join();
+                i0 = b.next.fetch_add(dyn_chunk);
+                break;
+            }
+            case PARALLEL_GUIDED:
+            {
+                i0 = b.next.load();
+                uint64_t c;
+                do
+                {
+                    if(i0>=b.end) return false;
+                    c = std::max(min_chunk, (b.end-i0)/4);
+                }
+                while(!b.next.compare_exchange_weak(i0, i0+c));
+                i1 = std::min(i0+c, b.end);
+                return true;
             }
         }
-#else
-        for (unsigned int i = beg; i < end; ++i) func(i);
-#endif
-    }
+        if(i0>=b.end) return false;
+        i1 = (schedule==PARALLEL_STATIC) ? b.end : std::min(i0+dyn_chunk, b.end);
+        return true;
+    };
+
+    std::function<void(unsigned int)> job = [&](unsigned int tid)
+    {
+        uint64_t i0 = 0, i1 = 0;
+        // own block first, then steal from the others (not with static scheduling)
+        unsigned int n_blocks = (schedule==PARALLEL_STATIC) ? 1 : nt;
+        for(unsigned int k=0; k<n_blocks; ++k)
+        {
+            ParallelForBlock & b = blocks[(tid+k)%nt];
+            while(claim(b,i0,i1)) chunk_func(i0, i1, tid);
+        }
+    };
+
+    if(!pool.run(job)) chunk_func(beg, end, 0);
+}
 
-}
\ No newline at end of file
+}
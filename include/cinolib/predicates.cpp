@@ -37,6 +37,10 @@
 #include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <cmath>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace cinolib
 {
@@ -166,7 +170,7 @@ double orient2d(const vec2d & pa,
                 const vec2d & pb,
                 const vec2d & pc)
 {
-    return orient2d(pa.ptr(), pb.ptr(), pc.ptr());
+    return orient2d_filtered(pa.ptr(), pb.ptr(), pc.ptr());
 }
 
 
@@ -178,7 +182,7 @@ double orient3d(const vec3d & pa,
                 const vec3d & pc,
                 const vec3d & pd)
 {
-    return orient3d(pa.ptr(), pb.ptr(), pc.ptr(), pd.ptr());
+    return orient3d_filtered(pa.ptr(), pb.ptr(), pc.ptr(), pd.ptr());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -189,7 +193,7 @@ double incircle(const vec2d & pa,
                 const vec2d & pc,
                 const vec2d & pd)
 {
-    return incircle(pa.ptr(), pb.ptr(), pc.ptr(), pd.ptr());
+    return incircle_filtered(pa.ptr(), pb.ptr(), pc.ptr(), pd.ptr());
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -206,6 +210,211 @@ double insphere(const vec3d & pa,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+// Semi-static error bounds: if |det| > eps*mx*my(*mz...), where mx,my,mz are the largest
+// absolute coordinate differences along each axis, the sign of the floating point determinant
+// is correct. The bounds follow from Shewchuk's errboundA (orient2d 3eps, orient3d 7eps,
+// incircle 10eps on the permanent), replacing the permanent with its upper bound in terms of
+// mx, my, mz and rounding up. The ranges exclude inputs where underflow or overflow may occur
+const double orient2d_semi_static_eps = 8.8872057372592798e-16; // 8   * DBL_EPSILON/2
+const double orient3d_semi_static_eps = 5.1107127829973299e-15; // 46  * DBL_EPSILON/2
+const double incircle_semi_static_eps = 7.1054273576010019e-15; // 64  * DBL_EPSILON/2
+const double orient2d_min = 1e-146, orient2d_max = 1e153;
+const double orient3d_min = 1e-97,  orient3d_max = 1e102;
+const double incircle_min = 1e-73,  incircle_max = 1e76;
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double orient2d_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc)
+{
+    double acx = pa[0] - pc[0];
+    double bcx = pb[0] - pc[0];
+    double acy = pa[1] - pc[1];
+    double bcy = pb[1] - pc[1];
+    double det = acx * bcy - acy * bcx;
+#ifdef CINOLIB_USES_EXACT_PREDICATES
+    double mx = std::max(std::fabs(acx), std::fabs(bcx));
+    double my = std::max(std::fabs(acy), std::fabs(bcy));
+    double lo = std::min(mx, my);
+    double hi = std::max(mx, my);
+    if(lo > orient2d_min && hi < orient2d_max && std::fabs(det) > orient2d_semi_static_eps * mx * my) return det;
+    if(vec_equals_2d(pc,pa) || vec_equals_2d(pc,pb)) return 0; // e.g. shared vertices
+    return orient2d(pa, pb, pc);
+#else
+    return det;
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double orient3d_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc,
+                         const double * pd)
+{
+    double adx = pa[0] - pd[0];
+    double bdx = pb[0] - pd[0];
+    double cdx = pc[0] - pd[0];
+    double ady = pa[1] - pd[1];
+    double bdy = pb[1] - pd[1];
+    double cdy = pc[1] - pd[1];
+    double adz = pa[2] - pd[2];
+    double bdz = pb[2] - pd[2];
+    double cdz = pc[2] - pd[2];
+    double det = adx * (bdy * cdz - bdz * cdy)
+               + bdx * (cdy * adz - cdz * ady)
+               + cdx * (ady * bdz - adz * bdy);
+#ifdef CINOLIB_USES_EXACT_PREDICATES
+    double mx = std::max(std::fabs(adx), std::max(std::fabs(bdx), std::fabs(cdx)));
+    double my = std::max(std::fabs(ady), std::max(std::fabs(bdy), std::fabs(cdy)));
+    double mz = std::max(std::fabs(adz), std::max(std::fabs(bdz), std::fabs(cdz)));
+    double lo = std::min(mx, std::min(my, mz));
+    double hi = std::max(mx, std::max(my, mz));
+    if(lo > orient3d_min && hi < orient3d_max && std::fabs(det) > orient3d_semi_static_eps * mx * my * mz) return det;
+    if(vec_equals_3d(pd,pa) || vec_equals_3d(pd,pb) || vec_equals_3d(pd,pc)) return 0; // e.g. shared vertices
+    return orient3d(pa, pb, pc, pd);
+#else
+    return det;
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double incircle_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc,
+                         const double * pd)
+{
+    double adx = pa[0] - pd[0];
+    double ady = pa[1] - pd[1];
+    double bdx = pb[0] - pd[0];
+    double bdy = pb[1] - pd[1];
+    double cdx = pc[0] - pd[0];
+    double cdy = pc[1] - pd[1];
+
+    double abdet = adx * bdy - bdx * ady;
+    double bcdet = bdx * cdy - cdx * bdy;
+    double cadet = cdx * ady - adx * cdy;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    double det   = alift * bcdet + blift * cadet + clift * abdet;
+#ifdef CINOLIB_USES_EXACT_PREDICATES
+    double mx = std::max(std::fabs(adx), std::max(std::fabs(bdx), std::fabs(cdx)));
+    double my = std::max(std::fabs(ady), std::max(std::fabs(bdy), std::fabs(cdy)));
+    double lo = std::min(mx, my);
+    double hi = std::max(mx, my);
+    if(lo > incircle_min && hi < incircle_max && std::fabs(det) > incircle_semi_static_eps * mx * my * (mx*mx + my*my)) return det;
+    return incircle(pa, pb, pc, pd);
+#else
+    return det;
+#endif
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void orient2d_batch(const double       * pa,
+                    const double       * pb,
+                    const double       * pc,
+                    const unsigned int   n,
+                          double       * res)
+{
+    unsigned int i = 0;
+#ifdef __AVX2__
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffff));
+    const __m256d ax = _mm256_set1_pd(pa[0]), ay = _mm256_set1_pd(pa[1]);
+    const __m256d bx = _mm256_set1_pd(pb[0]), by = _mm256_set1_pd(pb[1]);
+    for(; i+4<=n; i+=4)
+    {
+        const double *c = pc + 2*i;
+        __m256d cx  = _mm256_set_pd(c[6], c[4], c[2], c[0]);
+        __m256d cy  = _mm256_set_pd(c[7], c[5], c[3], c[1]);
+        __m256d acx = _mm256_sub_pd(ax, cx);
+        __m256d bcx = _mm256_sub_pd(bx, cx);
+        __m256d acy = _mm256_sub_pd(ay, cy);
+        __m256d bcy = _mm256_sub_pd(by, cy);
+        __m256d det = _mm256_sub_pd(_mm256_mul_pd(acx, bcy), _mm256_mul_pd(acy, bcx));
+        _mm256_storeu_pd(res+i, det);
+#ifdef CINOLIB_USES_EXACT_PREDICATES
+        __m256d mx  = _mm256_max_pd(_mm256_and_pd(acx, abs_mask), _mm256_and_pd(bcx, abs_mask));
+        __m256d my  = _mm256_max_pd(_mm256_and_pd(acy, abs_mask), _mm256_and_pd(bcy, abs_mask));
+        __m256d eps = _mm256_mul_pd(_mm256_set1_pd(orient2d_semi_static_eps), _mm256_mul_pd(mx, my));
+        __m256d ok  = _mm256_and_pd(_mm256_cmp_pd(_mm256_and_pd(det, abs_mask), eps, _CMP_GT_OQ),
+                      _mm256_and_pd(_mm256_cmp_pd(_mm256_min_pd(mx, my), _mm256_set1_pd(orient2d_min), _CMP_GT_OQ),
+                                    _mm256_cmp_pd(_mm256_max_pd(mx, my), _mm256_set1_pd(orient2d_max), _CMP_LT_OQ)));
+        int certified = _mm256_movemask_pd(ok);
+        for(unsigned int j=0; j<4; ++j)
+        {
+            if(!(certified & (1<<j))) res[i+j] = orient2d_filtered(pa, pb, c+2*j);
+        }
+#else
+        (void)abs_mask;
+#endif
+    }
+#endif
+    for(; i<n; ++i) res[i] = orient2d_filtered(pa, pb, pc+2*i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void orient3d_batch(const double       * pa,
+                    const double       * pb,
+                    const double       * pc,
+                    const double       * pd,
+                    const unsigned int   n,
+                          double       * res)
+{
+    unsigned int i = 0;
+#ifdef __AVX2__
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffff));
+    const __m256d ax = _mm256_set1_pd(pa[0]), ay = _mm256_set1_pd(pa[1]), az = _mm256_set1_pd(pa[2]);
+    const __m256d bx = _mm256_set1_pd(pb[0]), by = _mm256_set1_pd(pb[1]), bz = _mm256_set1_pd(pb[2]);
+    const __m256d cx = _mm256_set1_pd(pc[0]), cy = _mm256_set1_pd(pc[1]), cz = _mm256_set1_pd(pc[2]);
+    for(; i+4<=n; i+=4)
+    {
+        const double *d = pd + 3*i;
+        __m256d dx  = _mm256_set_pd(d[9],  d[6], d[3], d[0]);
+        __m256d dy  = _mm256_set_pd(d[10], d[7], d[4], d[1]);
+        __m256d dz  = _mm256_set_pd(d[11], d[8], d[5], d[2]);
+        __m256d adx = _mm256_sub_pd(ax, dx), bdx = _mm256_sub_pd(bx, dx), cdx = _mm256_sub_pd(cx, dx);
+        __m256d ady = _mm256_sub_pd(ay, dy), bdy = _mm256_sub_pd(by, dy), cdy = _mm256_sub_pd(cy, dy);
+        __m256d adz = _mm256_sub_pd(az, dz), bdz = _mm256_sub_pd(bz, dz), cdz = _mm256_sub_pd(cz, dz);
+        __m256d det = _mm256_add_pd(_mm256_add_pd(
+                      _mm256_mul_pd(adx, _mm256_sub_pd(_mm256_mul_pd(bdy, cdz), _mm256_mul_pd(bdz, cdy))),
+                      _mm256_mul_pd(bdx, _mm256_sub_pd(_mm256_mul_pd(cdy, adz), _mm256_mul_pd(cdz, ady)))),
+                      _mm256_mul_pd(cdx, _mm256_sub_pd(_mm256_mul_pd(ady, bdz), _mm256_mul_pd(adz, bdy))));
+        _mm256_storeu_pd(res+i, det);
+#ifdef CINOLIB_USES_EXACT_PREDICATES
+        __m256d mx  = _mm256_max_pd(_mm256_and_pd(adx, abs_mask), _mm256_max_pd(_mm256_and_pd(bdx, abs_mask), _mm256_and_pd(cdx, abs_mask)));
+        __m256d my  = _mm256_max_pd(_mm256_and_pd(ady, abs_mask), _mm256_max_pd(_mm256_and_pd(bdy, abs_mask), _mm256_and_pd(cdy, abs_mask)));
+        __m256d mz  = _mm256_max_pd(_mm256_and_pd(adz, abs_mask), _mm256_max_pd(_mm256_and_pd(bdz, abs_mask), _mm256_and_pd(cdz, abs_mask)));
+        __m256d eps = _mm256_mul_pd(_mm256_set1_pd(orient3d_semi_static_eps), _mm256_mul_pd(_mm256_mul_pd(mx, my), mz));
+        __m256d lo  = _mm256_min_pd(mx, _mm256_min_pd(my, mz));
+        __m256d hi  = _mm256_max_pd(mx, _mm256_max_pd(my, mz));
+        __m256d ok  = _mm256_and_pd(_mm256_cmp_pd(_mm256_and_pd(det, abs_mask), eps, _CMP_GT_OQ),
+                      _mm256_and_pd(_mm256_cmp_pd(lo, _mm256_set1_pd(orient3d_min), _CMP_GT_OQ),
+                                    _mm256_cmp_pd(hi, _mm256_set1_pd(orient3d_max), _CMP_LT_OQ)));
+        int certified = _mm256_movemask_pd(ok);
+        for(unsigned int j=0; j<4; ++j)
+        {
+            if(!(certified & (1<<j))) res[i+j] = orient3d_filtered(pa, pb, pc, d+3*j);
+        }
+#else
+        (void)abs_mask;
+#endif
+    }
+#endif
+    for(; i<n; ++i) res[i] = orient3d_filtered(pa, pb, pc, pd+3*i);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // true if the area of the triangle p0-p1-p2 is zero
 CINO_INLINE
 bool points_are_colinear_2d(const vec2d & p0,
@@ -223,7 +432,7 @@ bool points_are_colinear_2d(const double * p0,
                             const double * p1,
                             const double * p2)
 {
-    return (orient2d(p0,p1,p2)==0);
+    return (orient2d_filtered(p0,p1,p2)==0);
 }
 
 
@@ -287,7 +496,7 @@ bool points_are_coplanar_3d(const double * p0,
                             const double * p2,
                             const double * p3)
 {
-    return (orient3d(p0,p1,p2,p3)==0);
+    return (orient3d_filtered(p0,p1,p2,p3)==0);
 }
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
@@ -402,9 +611,9 @@ PointInSimplex point_in_triangle_2d(const double * p,
     if(vec_equals_2d(p, t1)) return ON_VERT1;
     if(vec_equals_2d(p, t2)) return ON_VERT2;
 
-    double e0p_area = orient2d(t0, t1, p);
-    double e1p_area = orient2d(t1, t2, p);
-    double e2p_area = orient2d(t2, t0, p);
+    double e0p_area = orient2d_filtered(t0, t1, p);
+    double e1p_area = orient2d_filtered(t1, t2, p);
+    double e2p_area = orient2d_filtered(t2, t0, p);
 
     bool hit = (e0p_area >= 0 && e1p_area >= 0 && e2p_area >= 0) ||
                (e0p_area <= 0 && e1p_area <= 0 && e2p_area <= 0);
@@ -521,10 +730,10 @@ PointInSimplex point_in_tet(const double * p,
     if(vec_equals_3d(p, t3)) return ON_VERT2;
 
     // according to refrence tet as in cinolib/standard_elements_tables.h
-    double f0p_vol = orient3d(t0,t2,t1,p);
-    double f1p_vol = orient3d(t0,t1,t3,p);
-    double f2p_vol = orient3d(t0,t3,t2,p);
-    double f3p_vol = orient3d(t1,t2,t3,p);
+    double f0p_vol = orient3d_filtered(t0,t2,t1,p);
+    double f1p_vol = orient3d_filtered(t0,t1,t3,p);
+    double f2p_vol = orient3d_filtered(t0,t3,t2,p);
+    double f3p_vol = orient3d_filtered(t1,t2,t3,p);
 
     bool hit = (f0p_vol >= 0 && f1p_vol >= 0 && f2p_vol >= 0 && f3p_vol >= 0) ||
                (f0p_vol <= 0 && f1p_vol <= 0 && f2p_vol <= 0 && f3p_vol <= 0);
@@ -585,10 +794,10 @@ SimplexIntersection segment_segment_intersect_2d(const double * s00,
                                                  const double * s11)
 {
     // https://www.geeksforgeeks.org/check-if-two-given-line-segments-intersect/
-    double det_s00 = orient2d(s10, s11, s00);
-    double det_s01 = orient2d(s10, s11, s01);
-    double det_s10 = orient2d(s00, s01, s10);
-    double det_s11 = orient2d(s00, s01, s11);
+    double det_s00 = orient2d_filtered(s10, s11, s00);
+    double det_s01 = orient2d_filtered(s10, s11, s01);
+    double det_s10 = orient2d_filtered(s00, s01, s10);
+    double det_s11 = orient2d_filtered(s00, s01, s11);
 
     // Shewchuk's orient predicates return a rough approximation of the determinant.
     // I am converting values to { -1, 0, 1 } for a simpler check of intersection cases
@@ -818,8 +1027,8 @@ SimplexIntersection segment_triangle_intersect_3d(const double * s0,
         return SIMPLICIAL_COMPLEX;
     }
 
-    auto vol_s0_t = orient3d(s0, t0, t1, t2);
-    auto vol_s1_t = orient3d(s1, t0, t1, t2);
+    auto vol_s0_t = orient3d_filtered(s0, t0, t1, t2);
+    auto vol_s1_t = orient3d_filtered(s1, t0, t1, t2);
 
     if(vol_s0_t > 0 && vol_s1_t > 0) return DO_NOT_INTERSECT; // s is above t
     if(vol_s0_t < 0 && vol_s1_t < 0) return DO_NOT_INTERSECT; // s is below t
@@ -870,9 +1079,9 @@ SimplexIntersection segment_triangle_intersect_3d(const double * s0,
         return SIMPLICIAL_COMPLEX;
     }
 
-    double vol_s_t01 = orient3d(s0, s1, t0, t1);
-    double vol_s_t12 = orient3d(s0, s1, t1, t2);
-    double vol_s_t20 = orient3d(s0, s1, t2, t0);
+    double vol_s_t01 = orient3d_filtered(s0, s1, t0, t1);
+    double vol_s_t12 = orient3d_filtered(s0, s1, t1, t2);
+    double vol_s_t20 = orient3d_filtered(s0, s1, t2, t0);
 
     if((vol_s_t01 > 0 && vol_s_t12 < 0) || (vol_s_t01 < 0 && vol_s_t12 > 0)) return DO_NOT_INTERSECT;
     if((vol_s_t12 > 0 && vol_s_t20 < 0) || (vol_s_t12 < 0 && vol_s_t20 > 0)) return DO_NOT_INTERSECT;
@@ -1023,8 +1232,8 @@ SimplexIntersection triangle_triangle_intersect_2d(const double * t00,
         const double* t0[3] = {t00, t01, t02};
         const double* t1[3] = {t10, t11, t12};
 
-        double opp0_wrt_e = orient2d(t0[e[0]], t0[e[1]], t0[opp0]);
-        double opp1_wrt_e = orient2d(t0[e[0]], t0[e[1]], t1[opp1]);
+        double opp0_wrt_e = orient2d_filtered(t0[e[0]], t0[e[1]], t0[opp0]);
+        double opp1_wrt_e = orient2d_filtered(t0[e[0]], t0[e[1]], t1[opp1]);
 
         if((opp0_wrt_e>0 && opp1_wrt_e<0) || (opp0_wrt_e<0 && opp1_wrt_e>0)) return SIMPLICIAL_COMPLEX;
         return INTERSECT;
@@ -1164,30 +1373,30 @@ SimplexIntersection triangle_triangle_intersect_3d(const double * t00,
         const double* t1[3] = {t10, t11, t12};
 
         // if they are not coplanar, then they form a valid complex
-        if(orient3d(t00, t01, t02, t1[opp1]) != 0) return SIMPLICIAL_COMPLEX;
+        if(orient3d_filtered(t00, t01, t02, t1[opp1]) != 0) return SIMPLICIAL_COMPLEX;
 
         double e0_dropX[2]   = {t0[e[0]][1], t0[e[0]][2]};
         double e1_dropX[2]   = {t0[e[1]][1], t0[e[1]][2]};
         double opp0_dropX[2] = {t0[opp0][1], t0[opp0][2]};
         double opp1_dropX[2] = {t1[opp1][1], t1[opp1][2]};
-        double opp0_wrt_e = orient2d(e0_dropX, e1_dropX, opp0_dropX);
-        double opp1_wrt_e = orient2d(e0_dropX, e1_dropX, opp1_dropX);
+        double opp0_wrt_e = orient2d_filtered(e0_dropX, e1_dropX, opp0_dropX);
+        double opp1_wrt_e = orient2d_filtered(e0_dropX, e1_dropX, opp1_dropX);
         if((opp0_wrt_e > 0 && opp1_wrt_e < 0) || (opp0_wrt_e < 0 && opp1_wrt_e > 0)) return SIMPLICIAL_COMPLEX;
 
         double e0_dropY[2]   = {t0[e[0]][0], t0[e[0]][2]};
         double e1_dropY[2]   = {t0[e[1]][0], t0[e[1]][2]};
         double opp0_dropY[2] = {t0[opp0][0], t0[opp0][2]};
         double opp1_dropY[2] = {t1[opp1][0], t1[opp1][2]};
-        opp0_wrt_e = orient2d(e0_dropY, e1_dropY, opp0_dropY);
-        opp1_wrt_e = orient2d(e0_dropY, e1_dropY, opp1_dropY);
+        opp0_wrt_e = orient2d_filtered(e0_dropY, e1_dropY, opp0_dropY);
+        opp1_wrt_e = orient2d_filtered(e0_dropY, e1_dropY, opp1_dropY);
         if((opp0_wrt_e > 0 && opp1_wrt_e < 0) || (opp0_wrt_e < 0 && opp1_wrt_e > 0)) return SIMPLICIAL_COMPLEX;
 
         double e0_dropZ[2]   = {t0[e[0]][0], t0[e[0]][1]};
         double e1_dropZ[2]   = {t0[e[1]][0], t0[e[1]][1]};
         double opp0_dropZ[2] = {t0[opp0][0], t0[opp0][1]};
         double opp1_dropZ[2] = {t1[opp1][0], t1[opp1][1]};
-        opp0_wrt_e = orient2d(e0_dropZ, e1_dropZ, opp0_dropZ);
-        opp1_wrt_e = orient2d(e0_dropZ, e1_dropZ, opp1_dropZ);
+        opp0_wrt_e = orient2d_filtered(e0_dropZ, e1_dropZ, opp0_dropZ);
+        opp1_wrt_e = orient2d_filtered(e0_dropZ, e1_dropZ, opp1_dropZ);
         if((opp0_wrt_e > 0 && opp1_wrt_e < 0) || (opp0_wrt_e < 0 && opp1_wrt_e > 0)) return SIMPLICIAL_COMPLEX;
 
         return INTERSECT;
@@ -1222,6 +1431,24 @@ SimplexIntersection triangle_triangle_intersect_3d(const double * t00,
 
     // t0 and t1 do not share sub-simplices. They can be fully disjoint, intersecting at a single point, or overlapping
 
+    // early reject: all the vertices of one triangle lie strictly at the same side of the plane of the other
+    double t1_wrt_t0[3] = { orient3d_filtered(t00, t01, t02, t10),
+                            orient3d_filtered(t00, t01, t02, t11),
+                            orient3d_filtered(t00, t01, t02, t12) };
+    if((t1_wrt_t0[0]>0 && t1_wrt_t0[1]>0 && t1_wrt_t0[2]>0) ||
+       (t1_wrt_t0[0]<0 && t1_wrt_t0[1]<0 && t1_wrt_t0[2]<0))
+    {
+        return DO_NOT_INTERSECT;
+    }
+    double t0_wrt_t1[3] = { orient3d_filtered(t10, t11, t12, t00),
+                            orient3d_filtered(t10, t11, t12, t01),
+                            orient3d_filtered(t10, t11, t12, t02) };
+    if((t0_wrt_t1[0]>0 && t0_wrt_t1[1]>0 && t0_wrt_t1[2]>0) ||
+       (t0_wrt_t1[0]<0 && t0_wrt_t1[1]<0 && t0_wrt_t1[2]<0))
+    {
+        return DO_NOT_INTERSECT;
+    }
+
     if(segment_triangle_intersect_3d(t00, t01, t10, t11, t12) >= INTERSECT ||
        segment_triangle_intersect_3d(t01, t02, t10, t11, t12) >= INTERSECT ||
        segment_triangle_intersect_3d(t02, t00, t10, t11, t12) >= INTERSECT ||
@@ -238,6 +238,62 @@ double insphere(const vec3d & pa,
 
 //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+/* Filtered versions of orient2d, orient3d and incircle. With exact predicates enabled,
+ * a semi-static filter (an a priori error bound computed from the largest coordinate
+ * differences) certifies the sign of the fast floating point determinant, and only near
+ * degenerate inputs go through the adaptive Shewchuk predicates, whose first stage is a
+ * dynamic error bound and whose last stage is exact. The returned sign is always the one
+ * of orient2d/orient3d/incircle, the magnitude may differ. In inexact mode these are the
+ * fast predicates. All the composite predicates below are built on top of these.
+*/
+CINO_INLINE
+double orient2d_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double orient3d_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc,
+                         const double * pd);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+double incircle_filtered(const double * pa,
+                         const double * pb,
+                         const double * pc,
+                         const double * pd);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// res[i] = orient2d_filtered(pa, pb, pc+2*i), for n points stored as consecutive xy pairs.
+// Four points at a time are processed with AVX2 instructions, if the compiler enables them
+// (configure with -DCINOLIB_USES_AVX2=ON, or pass -mavx2 / -march=native in the CXXFLAGS)
+CINO_INLINE
+void orient2d_batch(const double       * pa,
+                    const double       * pb,
+                    const double       * pc,
+                    const unsigned int   n,
+                          double       * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// res[i] = orient3d_filtered(pa, pb, pc, pd+3*i), for n points stored as consecutive xyz triplets.
+// Four points at a time are processed with AVX2 instructions, if the compiler enables them
+// (configure with -DCINOLIB_USES_AVX2=ON, or pass -mavx2 / -march=native in the CXXFLAGS)
+CINO_INLINE
+void orient3d_batch(const double       * pa,
+                    const double       * pb,
+                    const double       * pc,
+                    const double       * pd,
+                    const unsigned int   n,
+                          double       * res);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
 // true if the area of the triangle p0-p1-p2 is zero
 CINO_INLINE
 bool points_are_colinear_2d(const vec2d & p0,
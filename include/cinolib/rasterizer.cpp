@@ -0,0 +1,259 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/rasterizer.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+
+namespace cinolib
+{
+
+CINO_INLINE
+Rasterizer::Rasterizer(const unsigned int width, const unsigned int height)
+{
+    modelview = mat4d::DIAG(1);
+    resize(width, height);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::resize(const unsigned int width, const unsigned int height)
+{
+    w = width;
+    h = height;
+    tiles_x = (w + tile_size - 1)/tile_size;
+    tiles_y = (h + tile_size - 1)/tile_size;
+    bins.resize(tiles_x*tiles_y);
+    clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::set_view(const vec3d & dir, const vec3d & center, const double scale)
+{
+    vec3d Z{0,0,1};
+    vec3d a = dir.cross(Z);
+    if(a.norm() == 0) a = vec3d{1,0,0}; // dir is aligned with Z
+    a.normalize();
+
+    mat4d R = mat4d::HOMOGENEOUS(mat3d::ROT_3D(a, Z.angle_rad(dir)));
+    mat4d S = mat4d::DIAG(vec4d{scale, scale, scale, 1});
+    mat4d T = mat4d::TRANS(-center);
+    modelview = R * S * T;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::set_view(const mat4d & mv)
+{
+    modelview = mv;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::project(const vec3d & p, vec2d & pp, double & d) const
+{
+    vec4d res = modelview * p.add_coord(1);
+    res /= res[3];
+    pp[0] = w*(res[0]+1)/2.0;
+    pp[1] = h*(res[1]+1)/2.0;
+    d     = (res[2]+1)/2.0;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::clear()
+{
+    depth.assign(w*h, 1.f);
+    cover.assign(w*h, 0x00);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::draw(const std::vector<vec3d> & verts, const std::vector<unsigned int> & tris)
+{
+    assert(tris.size()%3==0);
+
+    // vertices in window coordinates
+    std::vector<vec3d> win(verts.size());
+    PARALLEL_FOR(0, verts.size(), 10000, [&](const unsigned int vid)
+    {
+        vec2d  pp;
+        double d;
+        project(verts.at(vid), pp, d);
+        win.at(vid) = vec3d{pp[0], pp[1], d};
+    });
+
+    // triangle setup
+    unsigned int nt = tris.size()/3;
+    std::vector<Triangle> setup(nt);
+    std::vector<bool>     valid(nt, false);
+    PARALLEL_FOR(0, nt, 10000, [&](const unsigned int tid)
+    {
+        vec3d v[3] = { win.at(tris.at(3*tid+0)),
+                       win.at(tris.at(3*tid+1)),
+                       win.at(tris.at(3*tid+2)) };
+
+        double area = (v[1].x()-v[0].x())*(v[2].y()-v[0].y()) -
+                      (v[2].x()-v[0].x())*(v[1].y()-v[0].y());
+        if(!std::isfinite(area) || area==0) return;
+        if(area<0) // no culling: flip to counter-clockwise
+        {
+            std::swap(v[1],v[2]);
+            area = -area;
+        }
+
+        Triangle & t = setup.at(tid);
+        for(int i=0; i<3; ++i)
+        {
+            const vec3d & p = v[i];
+            const vec3d & q = v[(i+1)%3];
+            t.a[i]    = p.y() - q.y();
+            t.b[i]    = q.x() - p.x();
+            t.c[i]    = p.x()*q.y() - q.x()*p.y();
+            t.incl[i] = (t.a[i]>0) || (t.a[i]==0 && t.b[i]<0); // left or top edge
+        }
+
+        // edge i is opposite to vertex (i+2)%3, hence it is the barycentric weight of it
+        t.zx = (t.a[1]*v[0].z() + t.a[2]*v[1].z() + t.a[0]*v[2].z())/area;
+        t.zy = (t.b[1]*v[0].z() + t.b[2]*v[1].z() + t.b[0]*v[2].z())/area;
+        t.z0 = (t.c[1]*v[0].z() + t.c[2]*v[1].z() + t.c[0]*v[2].z())/area;
+
+        // pixels whose center is inside the bounding box
+        double xmin = std::min({v[0].x(), v[1].x(), v[2].x()});
+        double xmax = std::max({v[0].x(), v[1].x(), v[2].x()});
+        double ymin = std::min({v[0].y(), v[1].y(), v[2].y()});
+        double ymax = std::max({v[0].y(), v[1].y(), v[2].y()});
+        t.xmin = (int)std::max(0.0, std::ceil (xmin-0.5));
+        t.ymin = (int)std::max(0.0, std::ceil (ymin-0.5));
+        t.xmax = (int)std::min(w-1.0, std::floor(xmax-0.5));
+        t.ymax = (int)std::min(h-1.0, std::floor(ymax-0.5));
+        if(t.xmin>t.xmax || t.ymin>t.ymax) return;
+
+        // fully outside of the depth range
+        double zmin = std::min({v[0].z(), v[1].z(), v[2].z()});
+        double zmax = std::max({v[0].z(), v[1].z(), v[2].z()});
+        if(zmax<0 || zmin>1) return;
+
+        valid.at(tid) = true;
+    });
+
+    // binning (serial, so that each bin lists triangles in submission order)
+    for(auto & bin : bins) bin.clear();
+    for(unsigned int tid=0; tid<nt; ++tid)
+    {
+        if(!valid.at(tid)) continue;
+        const Triangle & t = setup.at(tid);
+        for(unsigned int ty=t.ymin/tile_size; ty<=t.ymax/tile_size; ++ty)
+        for(unsigned int tx=t.xmin/tile_size; tx<=t.xmax/tile_size; ++tx)
+        {
+            bins.at(ty*tiles_x+tx).push_back(tid);
+        }
+    }
+
+    PARALLEL_FOR(0, bins.size(), 2, [&](const unsigned int tile)
+    {
+        rasterize_tile(tile, setup);
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void Rasterizer::rasterize_tile(const unsigned int tile, const std::vector<Triangle> & tris)
+{
+    int x0 = (tile%tiles_x)*tile_size;
+    int y0 = (tile/tiles_x)*tile_size;
+    int x1 = std::min(x0+(int)tile_size, (int)w) - 1;
+    int y1 = std::min(y0+(int)tile_size, (int)h) - 1;
+
+    for(unsigned int tid : bins.at(tile))
+    {
+        const Triangle & t = tris.at(tid);
+        int xb = std::max(x0, t.xmin);
+        int xe = std::min(x1, t.xmax);
+        int yb = std::max(y0, t.ymin);
+        int ye = std::min(y1, t.ymax);
+
+        for(int y=yb; y<=ye; ++y)
+        {
+            double py = y + 0.5;
+            double r0 = t.b[0]*py + t.c[0];
+            double r1 = t.b[1]*py + t.c[1];
+            double r2 = t.b[2]*py + t.c[2];
+            double rz = t.zy*py + t.z0;
+
+            float   * z_row = depth.data() + y*w;
+            uint8_t * c_row = cover.data() + y*w;
+
+            // edge functions are evaluated directly (not incrementally), so
+            // that rows are independent and the loop can be vectorized
+            for(int x=xb; x<=xe; ++x)
+            {
+                double px = x + 0.5;
+                double e0 = t.a[0]*px + r0;
+                double e1 = t.a[1]*px + r1;
+                double e2 = t.a[2]*px + r2;
+                bool in = (e0>0 || (e0==0 && t.incl[0])) &&
+                          (e1>0 || (e1==0 && t.incl[1])) &&
+                          (e2>0 || (e2==0 && t.incl[2]));
+                if(!in) continue;
+
+                double z = t.zx*px + rz;
+                if(z<0 || z>1) continue; // depth clipping
+
+                c_row[x] = 0xFF;
+                if((float)z < z_row[x]) z_row[x] = (float)z;
+            }
+        }
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int Rasterizer::num_covered_pixels() const
+{
+    return std::count(cover.begin(), cover.end(), 0xFF);
+}
+
+}
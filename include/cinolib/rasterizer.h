@@ -0,0 +1,164 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_RASTERIZER_H
+#define CINO_RASTERIZER_H
+
+#include <vector>
+#include <cstdint>
+#include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/meshes/abstract_polyhedralmesh.h>
+
+namespace cinolib
+{
+
+/* GL-free depth and coverage rasterizer, meant for the algorithms that use
+ * an offline GL context only to read back the Z-buffer or the stencil buffer
+ * (ambient occlusion, shadows, build orientation), so that they can also run
+ * on headless machines.
+ *
+ * The pipeline replicates the fixed function setup used across cinolib:
+ *
+ *  - orthographic view, identity projection, viewport covering the whole buffer
+ *  - fragments are sampled at pixel centers, with the top-left fill rule
+ *  - fragments outside the [-1,1] depth range are clipped
+ *  - depth test is GL_LESS, depth values are in [0,1] (1 = cleared)
+ *  - buffers are row major, with row 0 at the bottom (as read by glReadPixels)
+ *
+ * Triangles are set up and binned into square tiles, then tiles are rasterized
+ * in parallel, each by a single thread and in submission order, so the output
+ * does not depend on the number of threads. Coverage mimics the stencil setup
+ * of cast_shadow: 0xFF for every pixel touched by at least one fragment, 0x00
+ * for the background.
+*/
+
+class Rasterizer
+{
+    public:
+
+        explicit Rasterizer(const unsigned int width = 256, const unsigned int height = 256);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void         resize(const unsigned int width, const unsigned int height);
+        unsigned int width () const { return w; }
+        unsigned int height() const { return h; }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // same as glRotate(angle(Z,dir), dir x Z) * glScale(scale) * glTranslate(-center),
+        // i.e. dir is mapped onto the Z axis and the view looks along it
+        void          set_view(const vec3d & dir, const vec3d & center, const double scale);
+        void          set_view(const mat4d & modelview);
+        const mat4d & view() const { return modelview; }
+
+        // same as gl_project with an identity projection and a full buffer viewport
+        void project(const vec3d & p, vec2d & pp, double & depth) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void clear();
+
+        // triangle soup (three vertex ids per triangle), in object space
+        void draw(const std::vector<vec3d> & verts, const std::vector<unsigned int> & tris);
+
+        // all the polygons that are not hidden
+        template<class M, class V, class E, class P>
+        void draw(const AbstractPolygonMesh<M,V,E,P> & m)
+        {
+            std::vector<unsigned int> tris;
+            tris.reserve(3*m.num_polys());
+            for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+            {
+                if(m.poly_data(pid).flags[HIDDEN]) continue;
+                const std::vector<unsigned int> & t = m.poly_tessellation(pid);
+                tris.insert(tris.end(), t.begin(), t.end());
+            }
+            draw(m.vector_verts(), tris);
+        }
+
+        // all the faces that are visible (i.e. that are on the surface of the visible polyhedra)
+        template<class M, class V, class E, class F, class P>
+        void draw(const AbstractPolyhedralMesh<M,V,E,F,P> & m)
+        {
+            std::vector<unsigned int> tris;
+            tris.reserve(3*m.num_faces());
+            for(unsigned int fid=0; fid<m.num_faces(); ++fid)
+            {
+                if(!m.face_is_visible(fid)) continue;
+                std::vector<unsigned int> t = m.face_tessellation(fid);
+                tris.insert(tris.end(), t.begin(), t.end());
+            }
+            draw(m.vector_verts(), tris);
+        }
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        const std::vector<float>   & z_buffer() const { return depth;    }
+        const std::vector<uint8_t> & coverage() const { return cover;    }
+              unsigned int           num_covered_pixels() const;
+
+    protected:
+
+        struct Triangle
+        {
+            double a[3], b[3], c[3]; // edge functions: e(x,y) = a*x + b*y + c (>=0 inside)
+            bool   incl[3];          // top-left fill rule: whether fragments on the edge are in
+            double z0, zx, zy;       // depth plane: z(x,y) = z0 + zx*x + zy*y
+            int    xmin, xmax, ymin, ymax;
+        };
+
+        void rasterize_tile(const unsigned int tile, const std::vector<Triangle> & tris);
+
+        static const unsigned int tile_size = 64;
+
+        unsigned int w, h;
+        unsigned int tiles_x, tiles_y;
+        mat4d        modelview;
+
+        std::vector<float>                     depth;
+        std::vector<uint8_t>                   cover;
+        std::vector<std::vector<unsigned int>> bins; // per tile list of triangles (submission order)
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "rasterizer.cpp"
+#endif
+
+#endif // CINO_RASTERIZER_H
@@ -47,13 +47,20 @@ namespace cinolib
  * A Remeshing Approach to Multiresolution Modeling
  * M.Botsch, L.Kobbelt
  * Symposium on Geomtry Processing, 2004
+ *
+ * If batch_edits is true, the split and collapse sweeps run between batch_edits_begin()
+ * and batch_edits_end() (see AbstractPolygonMesh), which is faster on large meshes.
+ * Removed elements are not replaced by the last ones while sweeping, hence edges are
+ * visited in a different order and the output differs from the default mode (ids and,
+ * possibly, the set of collapsed edges). Both are valid remeshings
 */
 
 template<class M, class V, class E, class P>
 CINO_INLINE
 void remesh_Botsch_Kobbelt_2004(DrawableTrimesh<M,V,E,P> & m,
                                 const double               target_edge_length = -1,
-                                const bool                 preserve_marked_features = true);
+                                const bool                 preserve_marked_features = true,
+                                const bool                 batch_edits = false);
 }
 
 #include "remesh_BotschKobbelt2004.tpp"
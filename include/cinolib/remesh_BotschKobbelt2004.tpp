@@ -51,16 +51,22 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void remesh_Botsch_Kobbelt_2004(DrawableTrimesh<M,V,E,P> & m,
                                 const double               target_edge_length,
-                                const bool                 preserve_marked_features)
+                                const bool                 preserve_marked_features,
+                                const bool                 batch_edits)
 {
     double l = (target_edge_length>0) ? target_edge_length : m.edge_avg_length();
 
+    // in batch mode splits and collapses leave dead elements behind instead of
+    // relocating the last ones into the holes. The mesh is compacted once, before flips
+    if(batch_edits) m.batch_edits_begin();
+
     // 1) split too long edges
     //
     unsigned int count = 0;
     unsigned int ne = m.num_edges();
     for(unsigned int eid=0; eid<ne; ++eid)
     {
+        if (m.edge_is_dead(eid)) continue;
         if (m.edge_length(eid) > 4./3.*l)
         {
             bool mark_children = (preserve_marked_features && m.edge_data(eid).flags[MARKED]);
@@ -85,6 +91,7 @@ void remesh_Botsch_Kobbelt_2004(DrawableTrimesh<M,V,E,P> & m,
     count = 0;
     for(unsigned int eid=0; eid<m.num_edges(); ++eid)
     {
+        if (m.edge_is_dead(eid)) continue;
         bool inc_to_marked = false;
         if(preserve_marked_features)
         {
@@ -103,6 +110,8 @@ void remesh_Botsch_Kobbelt_2004(DrawableTrimesh<M,V,E,P> & m,
     }
     std::cout << "\t" << count << " edges shorter than " << 4./5.*l << " were collapsed." << std::endl;
 
+    if(batch_edits) m.batch_edits_end();
+
     // 3) optimize per vert valence
     //
     count = 0;
@@ -0,0 +1,165 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_REMESH_ISOTROPIC_H
+#define CINO_REMESH_ISOTROPIC_H
+
+#include <cinolib/meshes/trimesh.h>
+#include <ostream>
+#include <functional>
+
+namespace cinolib
+{
+
+/* Isotropic remeshing of triangle meshes, in the spirit of:
+ *
+ * A Remeshing Approach to Multiresolution Modeling
+ * M.Botsch, L.Kobbelt
+ * Symposium on Geomtry Processing, 2004
+ *
+ * Differently from remesh_Botsch_Kobbelt_2004 (which requires a DrawableTrimesh
+ * and does one sweep over the edge ids per pass), this version works on any
+ * Trimesh and iterates until convergence. Each iteration:
+ *
+ *  1) splits edges longer than 4/3 of the target length, longest first
+ *  2) collapses edges shorter than 4/5 of the target length, shortest first,
+ *     unless the collapse would create edges longer than 4/3 of the target.
+ *     Locked vertices (on the boundary or incident to MARKED edges) do not
+ *     move: edges with a locked endpoint collapse onto it
+ *  3) flips edges, as long as flips reduce the deviation of vertex valences
+ *     from the ideal one (6 for inner vertices, 4 for boundary vertices)
+ *  4) moves each vertex towards the barycenter of its neighbors, on its tangent
+ *     plane. Vertices are colored so that no two adjacent vertices have the
+ *     same color, and all vertices of the same color are moved in parallel
+ *
+ * Splits and collapses are prioritized with a heap keyed on the length of the
+ * edges, and run with batch edits open (see AbstractPolygonMesh::batch_edits_begin),
+ * so that edge ids remain stable while the heap is consumed. The mesh is
+ * compacted once per iteration, before relaxation.
+ *
+ * The remesher stops when the number of topological operations in an iteration
+ * drops below convergence_threshold times the number of edges, or after
+ * max_iterations, or when the time budget is exceeded (the check is done after
+ * each pass, hence the time budget may be exceeded by at most one pass).
+*/
+
+struct IsotropicRemeshingOptions
+{
+    double       target_edge_length       = -1;    // if <=0, the average edge length of the input mesh is used
+    unsigned int max_iterations           = 10;
+    double       convergence_threshold    = 0.01;  // min ratio between topological ops and edges to keep iterating
+    double       time_budget              = -1;    // seconds (<=0 means no limit)
+    unsigned int relaxation_steps         = 1;     // rounds of tangential relaxation per iteration
+    bool         preserve_marked_features = true;  // MARKED edges are never flipped, and their vertices never move
+    bool         preserve_boundaries      = true;  // boundary vertices never move (NOTE: boundary edges are MARKED on load)
+    bool         verbose                  = false; // print per iteration stats
+};
+
+struct IsotropicRemeshingStats
+{
+    unsigned int iterations  = 0;
+    unsigned int splits      = 0;
+    unsigned int collapses   = 0;
+    unsigned int flips       = 0;
+    unsigned int colors      = 0;     // colors used for parallel relaxation (last iteration)
+    bool         converged   = false;
+    bool         out_of_time = false;
+    double       seconds     = 0;
+};
+
+CINO_INLINE
+std::ostream & operator<<(std::ostream & in, const IsotropicRemeshingStats & stats);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+IsotropicRemeshingStats remesh_isotropic(      Trimesh<M,V,E,P>          & m,
+                                         const IsotropicRemeshingOptions & opt = IsotropicRemeshingOptions());
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// splits all edges longer than max_length. Returns the number of splits
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_split_long_edges(Trimesh<M,V,E,P> & m,
+                                     const double       max_length);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// collapses edges shorter than min_length, unless the collapse would generate
+// edges longer than max_length, change the topology, flip some triangle or
+// move a locked vertex. Returns the number of collapses
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_collapse_short_edges(Trimesh<M,V,E,P> & m,
+                                         const double       min_length,
+                                         const double       max_length,
+                                         const bool         preserve_marked_features = true,
+                                         const bool         preserve_boundaries      = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// flips edges until vertex valences cannot be further improved. Returns the number of flips
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_equalize_valences(Trimesh<M,V,E,P> & m,
+                                      const bool         preserve_marked_features = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// tangential relaxation of all (unlocked) vertices, color by color.
+// Returns the number of colors used
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_tangential_relaxation(Trimesh<M,V,E,P> & m,
+                                          const unsigned int steps                    = 1,
+                                          const bool         preserve_marked_features = true,
+                                          const bool         preserve_boundaries      = true);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// greedy coloring of the vertices, such that adjacent vertices have different colors.
+// Vertices are grouped by color. Vertices for which skip(vid) is true are not colored
+template<class M, class V, class E, class P>
+CINO_INLINE
+void vert_coloring(const AbstractPolygonMesh<M,V,E,P>       & m,
+                   std::vector<std::vector<unsigned int>>   & colors,
+                   const std::function<bool(unsigned int)>  & skip = nullptr);
+}
+
+#include "remesh_isotropic.tpp"
+
+#endif // CINO_REMESH_ISOTROPIC_H
@@ -0,0 +1,409 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/remesh_isotropic.h>
+#include <cinolib/how_many_seconds.h>
+#include <cinolib/parallel_for.h>
+#include <queue>
+#include <limits>
+
+namespace cinolib
+{
+
+CINO_INLINE
+std::ostream & operator<<(std::ostream & in, const IsotropicRemeshingStats & stats)
+{
+    in << "iterations " << stats.iterations << (stats.converged ? " (converged)" : "") << (stats.out_of_time ? " (out of time)" : "") << "\n";
+    in << "splits     " << stats.splits    << "\n";
+    in << "collapses  " << stats.collapses << "\n";
+    in << "flips      " << stats.flips     << "\n";
+    in << "colors     " << stats.colors    << "\n";
+    in << "time       " << stats.seconds   << "s\n";
+    return in;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+IsotropicRemeshingStats remesh_isotropic(      Trimesh<M,V,E,P>          & m,
+                                         const IsotropicRemeshingOptions & opt)
+{
+    typedef std::chrono::high_resolution_clock Time;
+    Time::time_point t0 = Time::now();
+
+    IsotropicRemeshingStats stats;
+    double l  = (opt.target_edge_length>0) ? opt.target_edge_length : m.edge_avg_length();
+    double lo = 4./5.*l;
+    double hi = 4./3.*l;
+
+    auto out_of_time = [&]()
+    {
+        stats.seconds = how_many_seconds(t0, Time::now());
+        stats.out_of_time = (opt.time_budget>0 && stats.seconds>opt.time_budget);
+        return stats.out_of_time;
+    };
+
+    while(stats.iterations<opt.max_iterations)
+    {
+        ++stats.iterations;
+        unsigned int ne = m.num_edges();
+
+        m.batch_edits_begin();
+        unsigned int splits = remesh_split_long_edges(m, hi);
+        unsigned int collapses = out_of_time() ? 0 : remesh_collapse_short_edges(m, lo, hi, opt.preserve_marked_features, opt.preserve_boundaries);
+        unsigned int flips = out_of_time() ? 0 : remesh_equalize_valences(m, opt.preserve_marked_features);
+        m.batch_edits_end();
+        if(!out_of_time()) stats.colors = remesh_tangential_relaxation(m, opt.relaxation_steps, opt.preserve_marked_features, opt.preserve_boundaries);
+
+        stats.splits    += splits;
+        stats.collapses += collapses;
+        stats.flips     += flips;
+        stats.converged  = (splits+collapses+flips < opt.convergence_threshold*ne);
+
+        if(opt.verbose)
+        {
+            std::cout << "remesh_isotropic: iteration " << stats.iterations << " : "
+                      << splits    << " splits, "
+                      << collapses << " collapses, "
+                      << flips     << " flips, "
+                      << m.num_polys() << " triangles ["
+                      << how_many_seconds(t0, Time::now()) << "s]" << std::endl;
+        }
+        if(stats.converged || out_of_time()) break;
+    }
+    out_of_time();
+    return stats;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_split_long_edges(Trimesh<M,V,E,P> & m,
+                                     const double       max_length)
+{
+    // longest edges first. While batch edits are open edge ids do not change,
+    // hence edges that were removed after being queued are just skipped
+    typedef std::pair<double,unsigned int> Item;
+    std::vector<Item> items;
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        if(m.edge_is_dead(eid)) continue;
+        double len = m.edge_length(eid);
+        if(len>max_length) items.emplace_back(len,eid);
+    }
+    std::priority_queue<Item> q(std::less<Item>(), std::move(items));
+
+    bool batch = !m.batch_edits_open();
+    if(batch) m.batch_edits_begin();
+
+    unsigned int count = 0;
+    while(!q.empty())
+    {
+        unsigned int eid = q.top().second;
+        q.pop();
+        if(m.edge_is_dead(eid)) continue;
+
+        // children inherit the edge data (hence also the MARKED flag) of the split edge
+        unsigned int vid = m.edge_split(eid, 0.5);
+        ++count;
+
+        for(unsigned int e : m.adj_v2e(vid))
+        {
+            double len = m.edge_length(e);
+            if(len>max_length) q.emplace(len,e);
+        }
+    }
+
+    if(batch) m.batch_edits_end();
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_collapse_short_edges(Trimesh<M,V,E,P> & m,
+                                         const double       min_length,
+                                         const double       max_length,
+                                         const bool         preserve_marked_features,
+                                         const bool         preserve_boundaries)
+{
+    auto is_locked = [&](const unsigned int vid)
+    {
+        if(preserve_boundaries && m.vert_is_boundary(vid)) return true;
+        if(preserve_marked_features)
+        {
+            for(unsigned int eid : m.adj_v2e(vid)) if(m.edge_data(eid).flags[MARKED]) return true;
+        }
+        return false;
+    };
+
+    // shortest edges first (see remesh_split_long_edges)
+    typedef std::pair<double,unsigned int> Item;
+    std::vector<Item> items;
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        if(m.edge_is_dead(eid)) continue;
+        double len = m.edge_length(eid);
+        if(len<min_length) items.emplace_back(len,eid);
+    }
+    std::priority_queue<Item,std::vector<Item>,std::greater<Item>> q(std::greater<Item>(), std::move(items));
+
+    bool batch = !m.batch_edits_open();
+    if(batch) m.batch_edits_begin();
+
+    unsigned int count = 0;
+    while(!q.empty())
+    {
+        unsigned int eid = q.top().second;
+        q.pop();
+        if(m.edge_is_dead(eid)) continue;
+        if(m.edge_length(eid)>=min_length) continue; // an endpoint moved after eid was queued
+        if(!m.edge_is_manifold(eid)) continue;
+
+        unsigned int vid0 = m.edge_vert_id(eid,0);
+        unsigned int vid1 = m.edge_vert_id(eid,1);
+
+        // edges with a locked endpoint collapse onto it, so that boundaries and features do not move
+        bool   lock0  = is_locked(vid0);
+        bool   lock1  = is_locked(vid1);
+        double lambda = 0.5;
+        if(lock0 && lock1) continue;
+        if(lock0) lambda = 0.0; else
+        if(lock1) lambda = 1.0;
+
+        // do not generate edges that would be split again
+        vec3d p = m.edge_sample_at(eid, lambda);
+        bool too_long = false;
+        for(unsigned int nbr : m.adj_v2v(vid0)) if(p.dist(m.vert(nbr))>max_length) { too_long = true; break; }
+        for(unsigned int nbr : m.adj_v2v(vid1)) if(p.dist(m.vert(nbr))>max_length) { too_long = true; break; }
+        if(too_long) continue;
+
+        // the collapse may keep the id of either endpoint, and re-creates the edges
+        // of the other one: remember which edges of the locked vertex were MARKED
+        std::vector<unsigned int> marked_nbrs;
+        if(lock0 || lock1)
+        {
+            unsigned int locked = lock0 ? vid0 : vid1;
+            for(unsigned int e : m.adj_v2e(locked))
+            {
+                if(m.edge_data(e).flags[MARKED]) marked_nbrs.push_back(m.vert_opposite_to(e,locked));
+            }
+        }
+
+        int vid = m.edge_collapse(eid, lambda, true, true);
+        if(vid<0) continue;
+        ++count;
+
+        for(unsigned int nbr : marked_nbrs)
+        {
+            int e = m.edge_id(vid,nbr); assert(e>=0);
+            m.edge_data(e).flags[MARKED] = true;
+        }
+
+        for(unsigned int e : m.adj_v2e(vid))
+        {
+            double len = m.edge_length(e);
+            if(len<min_length) q.emplace(len,e);
+        }
+    }
+
+    if(batch) m.batch_edits_end();
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_equalize_valences(Trimesh<M,V,E,P> & m,
+                                      const bool         preserve_marked_features)
+{
+    // flips do not change the boundary, hence vertex flags can be cached
+    std::vector<bool> v_boundary(m.num_verts());
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid) v_boundary[vid] = m.vert_is_boundary(vid);
+    auto deviation = [&](const unsigned int vid, const int delta)
+    {
+        int d = (int)m.adj_v2v(vid).size() + delta - (v_boundary[vid] ? 4 : 6);
+        return d*d;
+    };
+    auto opposite_vert = [&](const unsigned int pid, const unsigned int vid0, const unsigned int vid1)
+    {
+        for(unsigned int vid : m.adj_p2v(pid)) if(vid!=vid0 && vid!=vid1) return vid;
+        assert(false);
+        return vid0;
+    };
+
+    bool batch = !m.batch_edits_open();
+    if(batch) m.batch_edits_begin();
+
+    // each flip strictly reduces the total deviation from the ideal valences,
+    // hence the queue eventually empties. Edges around a flipped edge are re-queued
+    std::queue<unsigned int> q;
+    std::vector<bool> queued(m.num_edges(), false);
+    auto enqueue = [&](const unsigned int eid)
+    {
+        if(eid>=queued.size()) queued.resize(m.num_edges(), false);
+        if(queued.at(eid) || m.edge_is_dead(eid)) return;
+        queued.at(eid) = true;
+        q.push(eid);
+    };
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid) enqueue(eid);
+
+    unsigned int count = 0;
+    while(!q.empty())
+    {
+        unsigned int eid = q.front();
+        q.pop();
+        queued.at(eid) = false;
+        if(m.edge_is_dead(eid)) continue;
+        if(m.adj_e2p(eid).size()!=2) continue; // boundary or non manifold
+        if(preserve_marked_features && m.edge_data(eid).flags[MARKED]) continue;
+
+        unsigned int vid0 = m.edge_vert_id(eid,0);
+        unsigned int vid1 = m.edge_vert_id(eid,1);
+        unsigned int vid2 = opposite_vert(m.adj_e2p(eid).front(), vid0, vid1);
+        unsigned int vid3 = opposite_vert(m.adj_e2p(eid).back(),  vid0, vid1);
+
+        int before = deviation(vid0, 0) + deviation(vid1, 0) + deviation(vid2,0) + deviation(vid3,0);
+        int after  = deviation(vid0,-1) + deviation(vid1,-1) + deviation(vid2,1) + deviation(vid3,1);
+        if(after>=before) continue;
+        if(m.edge_id(vid2,vid3)>=0) continue; // the flipped edge already exists
+
+        P   data    = m.poly_data(m.adj_e2p(eid).front());
+        int new_eid = m.edge_flip(eid);
+        if(new_eid<0) continue;
+        ++count;
+
+        // copy per poly attributes in the newly generated polys (but restore right normal!)
+        for(unsigned int pid : m.adj_e2p(new_eid))
+        {
+            m.poly_data(pid) = data;
+            m.update_p_normal(pid);
+        }
+        for(unsigned int pid : m.adj_e2p(new_eid))
+        {
+            for(unsigned int e : m.adj_p2e(pid)) if((int)e!=new_eid) enqueue(e);
+        }
+    }
+
+    if(batch) m.batch_edits_end();
+    return count;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int remesh_tangential_relaxation(Trimesh<M,V,E,P> & m,
+                                          const unsigned int steps,
+                                          const bool         preserve_marked_features,
+                                          const bool         preserve_boundaries)
+{
+    assert(!m.batch_edits_open());
+
+    std::vector<std::vector<unsigned int>> colors;
+    vert_coloring(m, colors, [&](const unsigned int vid)
+    {
+        if(m.adj_v2v_span(vid).empty()) return true;
+        if(preserve_boundaries && m.vert_is_boundary(vid)) return true;
+        if(preserve_marked_features)
+        {
+            for(unsigned int eid : m.adj_v2e_span(vid)) if(m.edge_data(eid).flags[MARKED]) return true;
+        }
+        return false;
+    });
+
+    // vertices with the same color are not adjacent, hence moving one of them
+    // does not affect the others (neither their barycenter nor their normal)
+    for(unsigned int step=0; step<steps; ++step)
+    for(const auto & vids : colors)
+    {
+        PARALLEL_FOR(0, vids.size(), 1000, [&](const unsigned int i)
+        {
+            unsigned int vid = vids[i];
+            vec3d bary{0,0,0};
+            for(unsigned int nbr : m.adj_v2v_span(vid)) bary += m.vert(nbr);
+            bary /= static_cast<double>(m.adj_v2v_span(vid).size());
+
+            vec3d n{0,0,0};
+            for(unsigned int pid : m.adj_v2p_span(vid))
+            {
+                n += (m.poly_vert(pid,1) - m.poly_vert(pid,0)).cross(m.poly_vert(pid,2) - m.poly_vert(pid,0));
+            }
+            if(n.norm()==0) return;
+            n.normalize();
+
+            vec3d delta = bary - m.vert(vid);
+            m.vert(vid) += delta - n*delta.dot(n);
+        });
+    }
+
+    PARALLEL_FOR(0, m.num_polys(), 1000, [&](const unsigned int pid) { m.update_p_normal(pid); });
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const unsigned int vid) { m.update_v_normal(vid); });
+
+    return colors.size();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void vert_coloring(const AbstractPolygonMesh<M,V,E,P>       & m,
+                   std::vector<std::vector<unsigned int>>   & colors,
+                   const std::function<bool(unsigned int)>  & skip)
+{
+    colors.clear();
+    std::vector<int>          color(m.num_verts(), -1);
+    std::vector<unsigned int> stamp; // stamp[c]==vid if color c is used by some neighbor of vid
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid)
+    {
+        if(skip && skip(vid)) continue;
+        for(unsigned int nbr : m.adj_v2v_span(vid)) if(color[nbr]>=0) stamp[color[nbr]] = vid;
+        unsigned int c = 0;
+        while(c<colors.size() && stamp[c]==vid) ++c;
+        if(c==colors.size())
+        {
+            colors.emplace_back();
+            stamp.push_back(std::numeric_limits<unsigned int>::max());
+        }
+        color[vid] = c;
+        colors[c].push_back(vid);
+    }
+}
+
+}
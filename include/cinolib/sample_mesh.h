@@ -43,8 +43,16 @@ namespace cinolib
 
 /* This is just an awful method that selects a subset of mesh vertices from an input mesh.
  * It works by starting from a random vertex, and iteratively picking as next vertex the one
- * that is furthest from all the previously selected vertices. Distance computation is cheap
- * because the amortized heat based geodesics are used.
+ * that is furthest from all the previously selected vertices. Two strategies are available:
+ *
+ *  - HEAT_GEODESICS: distances are the amortized heat based geodesics. Smooth, but each new
+ *                    sample requires a full solve and a linear scan of all mesh vertices
+ *
+ *  - INCREMENTAL   : distances are shortest paths along mesh edges. The field of distances from
+ *                    the samples is updated with a Dijkstra front that only visits the vertices
+ *                    that are closer to the new sample than to the old ones, and the farthest
+ *                    vertex is kept in a heap. Much faster, and suitable for dense sampling of
+ *                    big meshes
  *
  * For a more serious resource to solve this problem, one may refer to:
  *
@@ -53,9 +61,18 @@ namespace cinolib
  * M.Corsini, P.Cignoni, R.Scopigno
 */
 
+enum class SamplingStrategy
+{
+    HEAT_GEODESICS,
+    INCREMENTAL
+};
+
 template<class M, class V, class E, class P>
 CINO_INLINE
-void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int n_samples, std::vector<unsigned int> & samples);
+void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m,
+                 const unsigned int             n_samples,
+                 std::vector<unsigned int>    & samples,
+                 const SamplingStrategy         strategy = SamplingStrategy::HEAT_GEODESICS);
 
 }
 
@@ -35,19 +35,48 @@
 *********************************************************************************/
 #include <cinolib/sample_mesh.h>
 #include <cinolib/geodesics.h>
+#include <cinolib/dijkstra_engine.h>
+#include <cinolib/indexed_heap.h>
 
 namespace cinolib
 {
 
 template<class M, class V, class E, class P>
 CINO_INLINE
-void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int n_samples, std::vector<unsigned int> & samples)
+void sample_mesh(AbstractPolygonMesh<M,V,E,P> & m,
+                 const unsigned int             n_samples,
+                 std::vector<unsigned int>    & samples,
+                 const SamplingStrategy         strategy)
 {
     assert(n_samples > 0);
 
     srand(time(NULL));
     samples = { rand()%m.num_verts() };
 
+    if(strategy == SamplingStrategy::INCREMENTAL)
+    {
+        DijkstraEngine dijkstra(m);
+        std::vector<double>       min_dist(m.num_verts(), inf_double);
+        std::vector<unsigned int> updated;
+
+        // priorities are negated distances, so that the top is the farthest vertex
+        IndexedHeap farthest(m.num_verts());
+        for(unsigned int vid=0; vid<m.num_verts(); ++vid) farthest.push(vid, -inf_double);
+
+        for(;;)
+        {
+            updated.clear();
+            dijkstra.update_min_distances(samples.back(), min_dist, &updated);
+            for(unsigned int vid : updated) farthest.push(vid, -min_dist.at(vid));
+
+            if(samples.size() == n_samples) break;
+            unsigned int sample = farthest.top();
+            if(min_dist.at(sample) == 0) break; // all vertices have been sampled
+            samples.push_back(sample);
+        }
+        return;
+    }
+
     GeodesicsCache cache;
     ScalarField f = compute_geodesics_amortized(m, cache, samples);
 
@@ -37,6 +37,7 @@
 #define CINO_SHORTEST_PATH_TREE_H
 
 #include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/dijkstra_engine.h>
 
 namespace cinolib
 {
@@ -52,6 +53,13 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int root, std::vector<bool> & tree);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// same as above, reusing a DijkstraEngine already bound to m (and with no constraints active)
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int root, std::vector<bool> & tree, DijkstraEngine & dijkstra);
+
 }
 
 #include "shortest_path_tree.tpp"
@@ -50,11 +50,23 @@ template<class M, class V, class E, class P>
 CINO_INLINE
 void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int root, std::vector<bool> & tree)
 {
+    DijkstraEngine dijkstra(m);
+    shortest_path_tree(m, root, tree, dijkstra);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int root, std::vector<bool> & tree, DijkstraEngine & dijkstra)
+{
+    assert(dijkstra.num_nodes() == m.num_verts());
+
     // if true, the edge is on the tree
     tree = std::vector<bool>(m.num_edges(), false);
 
     std::vector<double> dist;
-    dijkstra_exhaustive(m, root, dist);
+    dijkstra.distances({root}, dist);
 
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
     {
@@ -65,7 +77,7 @@ void shortest_path_tree(AbstractPolygonMesh<M,V,E,P> & m, const unsigned int roo
         // lowest ID. This should avoid the generation of loops
         // (https://en.wikipedia.org/wiki/Shortest-path_tree)
         std::vector<unsigned int> parent;
-        for(unsigned int nbr : m.adj_v2v(vid))
+        for(unsigned int nbr : m.adj_v2v_span(vid))
         {
             int eid = m.edge_id(vid, nbr); assert(eid>=0);
             if(dist.at(vid) == m.edge_length(eid) + dist.at(nbr))
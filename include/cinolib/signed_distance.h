@@ -0,0 +1,77 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_SIGNED_DISTANCE_H
+#define CINO_SIGNED_DISTANCE_H
+
+#include <cinolib/meshes/abstract_polygonmesh.h>
+#include <cinolib/bvh.h>
+
+namespace cinolib
+{
+
+/* Signed distance from a surface mesh, evaluated for batches of query points
+ * (e.g. all the samples of a regular grid). Distances are negative inside the
+ * mesh and positive outside. Unsigned distances are computed with the batched
+ * closest point queries of the BVH, and the sign is determined with the angle
+ * weighted pseudo normal (face, edge or vertex normal, depending on where the
+ * closest point lies).
+ *
+ * Ref: Signed Distance Computation Using the Angle Weighted Pseudonormal
+ *      J.A. Baerentzen and H. Aanaes, IEEE Transactions on Visualization and
+ *      Computer Graphics, 2005
+ *
+ * WARNING: input meshes are assumed to be watertight, consistently oriented
+ * 2 manifolds. No explicit checks are performed.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distances(const AbstractPolygonMesh<M,V,E,P> & m,
+                      const BVH                          & bvh, // must be built with bvh.build_from_mesh_polys(m)
+                      const std::vector<vec3d>           & points,
+                            std::vector<double>          & dist);
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<double> signed_distances(const AbstractPolygonMesh<M,V,E,P> & m,
+                                     const std::vector<vec3d>           & points);
+}
+
+#include "signed_distance.tpp"
+
+#endif // CINO_SIGNED_DISTANCE_H
@@ -0,0 +1,124 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/signed_distance.h>
+#include <cinolib/geometry/triangle_utils.h>
+#include <cinolib/parallel_for.h>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+void signed_distances(const AbstractPolygonMesh<M,V,E,P> & m,
+                      const BVH                          & bvh,
+                      const std::vector<vec3d>           & points,
+                            std::vector<double>          & dist)
+{
+    std::vector<unsigned int> pids;
+    std::vector<vec3d>        pos;
+    bvh.closest_points(points, pids, pos, dist);
+
+    // angle weighted vertex normals (not normalized, only their direction matters)
+    std::vector<vec3d> v_normals(m.num_verts(), vec3d{0,0,0});
+    PARALLEL_FOR(0, m.num_verts(), 1000, [&](const unsigned int vid)
+    {
+        for(unsigned int pid : m.adj_v2p_span(vid))
+        {
+            v_normals[vid] += m.poly_angle_at_vert(pid,vid) * m.poly_data(pid).normal;
+        }
+    });
+
+    PARALLEL_FOR(0, points.size(), 1000, [&](const unsigned int i)
+    {
+        // find the triangle of the poly tessellation where the closest point lies
+        unsigned int pid  = pids[i];
+        const auto & tris = m.poly_tessellation(pid);
+        unsigned int off  = 0;
+        double       best = inf_double;
+        for(unsigned int j=0; j+2<tris.size(); j+=3)
+        {
+            double d = point_to_triangle_dist(pos[i], m.vert(tris[j]), m.vert(tris[j+1]), m.vert(tris[j+2]));
+            if(d<best)
+            {
+                best = d;
+                off  = j;
+            }
+        }
+        unsigned int v[3] = { tris[off], tris[off+1], tris[off+2] };
+
+        // locate the closest point (vertex, edge or face) and pick the corresponding pseudo normal
+        double wgts[3];
+        triangle_barycentric_coords(m.vert(v[0]), m.vert(v[1]), m.vert(v[2]), pos[i], wgts);
+        const double tol = 1e-7;
+        unsigned int n_zeros = 0;
+        for(int j=0; j<3; ++j) if(std::fabs(wgts[j])<tol) ++n_zeros;
+
+        vec3d n = m.poly_data(pid).normal;
+        if(n_zeros==2)
+        {
+            for(int j=0; j<3; ++j) if(std::fabs(wgts[j])>=tol) n = v_normals[v[j]];
+        }
+        else if(n_zeros==1)
+        {
+            unsigned int j   = 0;
+            while(std::fabs(wgts[j])>=tol) ++j;
+            int          eid = m.edge_id(v[(j+1)%3], v[(j+2)%3]);
+            if(eid>=0) // otherwise it's an internal edge of the tessellation, and the face normal is fine
+            {
+                n = vec3d{0,0,0};
+                for(unsigned int nbr : m.adj_e2p_span(eid)) n += m.poly_data(nbr).normal;
+            }
+        }
+
+        if((points[i]-pos[i]).dot(n)<0) dist[i] = -dist[i];
+    });
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+std::vector<double> signed_distances(const AbstractPolygonMesh<M,V,E,P> & m,
+                                     const std::vector<vec3d>           & points)
+{
+    BVH bvh;
+    bvh.build_from_mesh_polys(m);
+    std::vector<double> dist;
+    signed_distances(m, bvh, points, dist);
+    return dist;
+}
+
+}
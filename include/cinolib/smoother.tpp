@@ -63,7 +63,7 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     for(unsigned int vid=0; vid<target.num_verts(); ++vid)
     {
         unsigned int count = 0;
-        for(unsigned int eid : target.adj_v2e(vid))
+        for(unsigned int eid : target.adj_v2e_span(vid))
         {
             if(target.edge_data(eid).flags[MARKED]) ++count;
         }
@@ -81,7 +81,7 @@ void mesh_smoother(      AbstractPolygonMesh<M1,V1,E1,P1> & m,
     for(unsigned int vid=0; vid<m.num_verts(); ++vid)
     {
         unsigned int count = 0;
-        for(unsigned int eid : m.adj_v2e(vid))
+        for(unsigned int eid : m.adj_v2e_span(vid))
         {
             // marked => flagged as a sharp feature
             if(m.edge_data(eid).flags[MARKED]) ++count;
@@ -84,7 +84,7 @@ void subdivision_midpoint(const AbstractPolyhedralMesh<M,V,E,F,P> & m_in,
     //
     std::map<ipair,unsigned int> eid_pid_fmap;
     for(unsigned int pid=0; pid<m_in.num_polys(); ++pid)
-    for(unsigned int eid : m_in.adj_p2e(pid))
+    for(unsigned int eid : m_in.adj_p2e_span(pid))
     {
         std::vector<unsigned int> inc_f = m_in.poly_e2f(pid,eid);
         std::vector<unsigned int> f;
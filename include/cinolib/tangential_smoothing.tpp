@@ -54,7 +54,7 @@ void tangential_smoothing(Trimesh<M,V,E,P> & m, const unsigned int vid)
 
     vec3d  delta{0,0,0};
     double norm_fact = 0.0;
-    for(unsigned int nbr : m.adj_v2v(vid))
+    for(unsigned int nbr : m.adj_v2v_span(vid))
     {
         double area = m.vert_area(vid);
         delta += area * m.vert(nbr);
@@ -66,8 +66,8 @@ void tangential_smoothing(Trimesh<M,V,E,P> & m, const unsigned int vid)
     m.vert(vid) += delta;
 
     // update normals
-    for(unsigned int pid : m.adj_v2p(vid)) m.update_p_normal(pid);
-    for(unsigned int nbr : m.adj_v2v(vid)) m.update_v_normal(nbr);
+    for(unsigned int pid : m.adj_v2p_span(vid)) m.update_p_normal(pid);
+    for(unsigned int nbr : m.adj_v2v_span(vid)) m.update_v_normal(nbr);
     m.update_v_normal(vid);
 }
 
@@ -0,0 +1,196 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/thread_pool.h>
+#include <cinolib/trace_profiler.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace cinolib
+{
+
+CINO_INLINE
+ThreadPool::ThreadPool(const unsigned int n_threads)
+{
+    start(n_threads);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool::~ThreadPool()
+{
+    stop();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ThreadPool & ThreadPool::instance()
+{
+    static ThreadPool pool([]()
+    {
+        const char *env = std::getenv("CINO_NUM_THREADS");
+        return (env!=nullptr) ? (unsigned int)std::max(0,atoi(env)) : 0u;
+    }());
+    return pool;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ThreadPool::set_num_threads(const unsigned int n)
+{
+    // the pool cannot be restarted by one of the threads running a job:
+    // stop would wait for the job to complete, and the job for this thread
+    if(in_parallel_region()) return false;
+
+    std::lock_guard<std::mutex> guard(busy);
+    stop();
+    start(n);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool & ThreadPool::parallel_region_flag()
+{
+    static thread_local bool flag = false;
+    return flag;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ThreadPool::in_parallel_region()
+{
+    return parallel_region_flag();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::start(const unsigned int n_threads)
+{
+    unsigned int n = n_threads;
+    if(n==0) n = std::thread::hardware_concurrency();
+    if(n==0) n = 8;
+
+    quit = false;
+    workers.reserve(n-1);
+    for(unsigned int tid=1; tid<n; ++tid)
+    {
+        workers.emplace_back(&ThreadPool::worker_loop, this, tid, generation);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        quit = true;
+    }
+    cv_start.notify_all();
+    for(std::thread & t : workers) t.join();
+    workers.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool ThreadPool::run(const std::function<void(unsigned int)> & f)
+{
+    if(in_parallel_region()) return false;
+
+    std::unique_lock<std::mutex> lock_busy(busy, std::try_to_lock);
+    if(!lock_busy.owns_lock()) return false;
+
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        job     = &f;
+        pending = workers.size();
+        ++generation;
+    }
+    cv_start.notify_all();
+
+    {
+        RegionGuard region;
+        CINO_PROFILE_ZONE("ThreadPool::job");
+        f(0);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    cv_done.wait(lock, [this]{ return pending==0; });
+    job = nullptr;
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void ThreadPool::worker_loop(const unsigned int thread_id, unsigned long seen)
+{
+    CINO_PROFILE_THREAD("cinolib worker " + std::to_string(thread_id));
+    RegionGuard region;
+    while(true)
+    {
+        const std::function<void(unsigned int)> *f;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv_start.wait(lock, [&]{ return quit || generation!=seen; });
+            if(quit) return;
+            seen = generation;
+            f    = job;
+        }
+
+        {
+            CINO_PROFILE_ZONE("ThreadPool::job");
+            (*f)(thread_id);
+        }
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            last = (--pending==0);
+        }
+        if(last) cv_done.notify_one();
+    }
+}
+
+}
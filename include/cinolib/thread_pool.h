@@ -0,0 +1,124 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_THREAD_POOL_H
+#define CINO_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Persistent pool of worker threads, used by PARALLEL_FOR and PARALLEL_REDUCE.
+ * A process-wide pool is lazily created the first time it is needed (see
+ * instance), so that threads are spawned once and not at each parallel loop.
+ *
+ * The number of threads includes the calling thread, which always takes part
+ * in the job. It defaults to the hardware concurrency, and can be changed with
+ * set_num_threads or with the environment variable CINO_NUM_THREADS.
+ *
+ * The pool runs one job at a time. Jobs issued from inside a job (nested
+ * parallelism), or while another thread is using the pool, are refused, and
+ * the caller is expected to run the job serially (run returns false).
+*/
+
+class ThreadPool
+{
+    public:
+
+        explicit ThreadPool(const unsigned int n_threads = 0); // 0: hardware concurrency
+                ~ThreadPool();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        static ThreadPool & instance();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        unsigned int num_threads() const { return workers.size()+1; }
+        bool         set_num_threads(const unsigned int n); // 0: hardware concurrency. Returns false (and does nothing) if called from a job
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // executes job(thread_id) on each thread of the pool, with thread_id in [0,num_threads).
+        // Returns false without running the job if called from a job or if the pool is busy
+        bool run(const std::function<void(unsigned int)> & job);
+
+        // true for threads running a job of any pool
+        static bool in_parallel_region();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        void start(const unsigned int n_threads);
+        void stop();
+        void worker_loop(const unsigned int thread_id, unsigned long seen); // seen: last generation already served
+
+        static bool & parallel_region_flag();
+
+        // marks the current thread as running a job for the lifetime of the guard
+        struct RegionGuard
+        {
+            RegionGuard()  { parallel_region_flag() = true;  }
+           ~RegionGuard()  { parallel_region_flag() = false; }
+        };
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::vector<std::thread>                   workers;
+        std::mutex                                 busy;        // held by the thread issuing a job
+        std::mutex                                 mutex;       // guards the fields below
+        std::condition_variable                    cv_start;
+        std::condition_variable                    cv_done;
+        const std::function<void(unsigned int)>  * job = nullptr;
+        unsigned long                              generation = 0; // incremented at each job
+        unsigned int                               pending    = 0; // workers still running the current job
+        bool                                       quit       = false;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "thread_pool.cpp"
+#endif
+
+#endif // CINO_THREAD_POOL_H
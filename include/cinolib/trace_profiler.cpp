@@ -0,0 +1,416 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/trace_profiler.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+
+namespace cinolib
+{
+
+CINO_INLINE
+TraceProfiler::TraceProfiler()
+{
+    epoch = 0;
+    epoch = now();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+TraceProfiler & TraceProfiler::instance()
+{
+    // never destroyed, so that threads (and static destructors) can record
+    // events until the very end of the program
+    static TraceProfiler *p = new TraceProfiler();
+    return *p;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+uint64_t TraceProfiler::now() const
+{
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() - epoch;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::zone(const char *name, const uint64_t begin, const uint64_t end)
+{
+    append(ProfilerEvent{name, begin, end, 0.0, PROFILER_ZONE});
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::counter(const char *name, const double increment)
+{
+    if(!enabled()) return;
+    append(ProfilerEvent{name, now(), 0, increment, PROFILER_COUNTER});
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::gauge(const char *name, const double value)
+{
+    if(!enabled()) return;
+    append(ProfilerEvent{name, now(), 0, value, PROFILER_GAUGE});
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::set_thread_name(const std::string & name)
+{
+    ThreadBuffer & b = thread_buffer();
+    std::lock_guard<std::mutex> guard(mutex);
+    b.name = name;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+TraceProfiler::ThreadBuffer & TraceProfiler::thread_buffer()
+{
+    static thread_local ThreadBuffer *b = nullptr;
+    if(b==nullptr)
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        b       = new ThreadBuffer();
+        b->tid  = buffers.size();
+        b->name = "thread " + std::to_string(b->tid);
+        b->head = new Chunk();
+        b->tail = b->head;
+        buffers.push_back(b);
+    }
+    return *b;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::append(const ProfilerEvent & e)
+{
+    ThreadBuffer & b = thread_buffer();
+    uint64_t n = b.size.load(std::memory_order_relaxed);
+    unsigned int i = n % CHUNK_SIZE;
+    if(i==0 && n>0)
+    {
+        // the chunk is linked before the event is published (see snapshot)
+        Chunk *c = b.tail->next.load(std::memory_order_relaxed);
+        if(c==nullptr)
+        {
+            c = new Chunk();
+            b.tail->next.store(c, std::memory_order_release);
+        }
+        b.tail = c;
+    }
+    b.tail->events[i] = e;
+    b.size.store(n+1, std::memory_order_release);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::clear()
+{
+    // chunks are kept, and reused for the next events
+    std::lock_guard<std::mutex> guard(mutex);
+    for(ThreadBuffer *b : buffers)
+    {
+        b->tail = b->head;
+        b->size.store(0, std::memory_order_release);
+    }
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int TraceProfiler::num_events() const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    uint64_t n = 0;
+    for(const ThreadBuffer *b : buffers) n += b->size.load(std::memory_order_acquire);
+    return (unsigned int)n;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<std::vector<ProfilerEvent>> TraceProfiler::snapshot(std::vector<std::string> * thread_names) const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    std::vector<std::vector<ProfilerEvent>> events(buffers.size());
+    if(thread_names!=nullptr) thread_names->clear();
+    for(const ThreadBuffer *b : buffers)
+    {
+        if(thread_names!=nullptr) thread_names->push_back(b->name);
+        uint64_t n = b->size.load(std::memory_order_acquire);
+        events.at(b->tid).reserve(n);
+        const Chunk *c = b->head;
+        while(n>0)
+        {
+            uint64_t m = std::min<uint64_t>(n, CHUNK_SIZE);
+            events.at(b->tid).insert(events.at(b->tid).end(), c->events, c->events+m);
+            n -= m;
+            c  = c->next.load(std::memory_order_acquire);
+        }
+    }
+    return events;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+bool TraceProfiler::write_chrome_trace(const char *filename) const
+{
+    FILE *f = fopen(filename, "w");
+    if(!f)
+    {
+        std::cerr << "ERROR : " << __FILE__ << ", line " << __LINE__ << " : write_chrome_trace() : couldn't open output file " << filename << std::endl;
+        return false;
+    }
+
+    auto json_string = [](const std::string & s)
+    {
+        std::string out = "\"";
+        for(char c : s)
+        {
+            if(c=='"' || c=='\\') { out += '\\'; out += c; }
+            else if((unsigned char)c < 0x20) out += ' ';
+            else out += c;
+        }
+        return out + "\"";
+    };
+
+    std::vector<std::string> thread_names;
+    std::vector<std::vector<ProfilerEvent>> events = snapshot(&thread_names);
+
+    fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    bool first = true;
+    auto sep = [&]() { if(!first) fprintf(f, ",\n"); first = false; };
+
+    // timestamps and durations are in microseconds
+    std::vector<std::pair<unsigned int,const ProfilerEvent*>> counters; // (tid,event)
+    for(unsigned int tid=0; tid<events.size(); ++tid)
+    {
+        sep();
+        fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":%s}}", tid, json_string(thread_names.at(tid)).c_str());
+
+        for(const ProfilerEvent & e : events.at(tid))
+        {
+            switch(e.type)
+            {
+                case PROFILER_ZONE:
+                    sep();
+                    fprintf(f, "{\"name\":%s,\"cat\":\"cinolib\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                            json_string(e.name).c_str(), tid, e.begin*1e-3, (e.end-e.begin)*1e-3);
+                    break;
+
+                case PROFILER_GAUGE:
+                    sep();
+                    fprintf(f, "{\"name\":%s,\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+                            json_string(e.name).c_str(), tid, e.begin*1e-3, e.value);
+                    break;
+
+                case PROFILER_COUNTER:
+                    counters.push_back(std::make_pair(tid,&e));
+                    break;
+            }
+        }
+    }
+
+    // counters are shown as running totals over all threads
+    std::stable_sort(counters.begin(), counters.end(), [](const std::pair<unsigned int,const ProfilerEvent*> & a,
+                                                          const std::pair<unsigned int,const ProfilerEvent*> & b)
+    {
+        return a.second->begin < b.second->begin;
+    });
+    std::map<std::string,double> totals;
+    for(const auto & obj : counters)
+    {
+        double & tot = totals[obj.second->name];
+        tot += obj.second->value;
+        sep();
+        fprintf(f, "{\"name\":%s,\"ph\":\"C\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"args\":{\"value\":%.17g}}",
+                json_string(obj.second->name).c_str(), obj.first, obj.second->begin*1e-3, tot);
+    }
+
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    return true;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+std::vector<ProfilerStats> TraceProfiler::stats() const
+{
+    std::map<std::pair<unsigned int,std::string>,ProfilerStats> table; // (type,name) => stats
+    std::vector<std::vector<ProfilerEvent>> events = snapshot();
+
+    for(std::vector<ProfilerEvent> & list : events)
+    {
+        // zones of a thread are nested: visit them in pre-order (earliest
+        // begin first, outer zones first) and subtract the time of each zone
+        // from the self time of the innermost zone that contains it
+        std::sort(list.begin(), list.end(), [](const ProfilerEvent & a, const ProfilerEvent & b)
+        {
+            if(a.type!=b.type) return a.type < b.type;
+            if(a.begin!=b.begin) return a.begin < b.begin;
+            return a.end > b.end;
+        });
+
+        std::vector<const ProfilerEvent*> stack;
+        std::vector<ProfilerStats*>       stack_stats;
+        for(const ProfilerEvent & e : list)
+        {
+            ProfilerStats & s = table[std::make_pair(e.type,std::string(e.name))];
+            if(s.count==0)
+            {
+                s.name = e.name;
+                s.type = e.type;
+            }
+
+            if(e.type==PROFILER_ZONE)
+            {
+                double t = (e.end-e.begin)*1e-9;
+                s.min    = (s.count==0) ? t : std::min(s.min,t);
+                s.max    = (s.count==0) ? t : std::max(s.max,t);
+                s.total += t;
+                s.self  += t;
+                while(!stack.empty() && stack.back()->end <= e.begin)
+                {
+                    stack.pop_back();
+                    stack_stats.pop_back();
+                }
+                if(!stack.empty()) stack_stats.back()->self -= t;
+                stack.push_back(&e);
+                stack_stats.push_back(&s);
+            }
+            else if(e.type==PROFILER_COUNTER)
+            {
+                s.total += e.value;
+            }
+            else
+            {
+                s.min  = (s.count==0) ? e.value : std::min(s.min,e.value);
+                s.max  = (s.count==0) ? e.value : std::max(s.max,e.value);
+            }
+            ++s.count;
+        }
+    }
+
+    // the last value of a gauge is the most recent sample among all threads
+    std::map<std::string,uint64_t> last_time;
+    for(const std::vector<ProfilerEvent> & list : events)
+    for(const ProfilerEvent & e : list)
+    {
+        if(e.type!=PROFILER_GAUGE) continue;
+        auto it = last_time.find(e.name);
+        if(it==last_time.end() || e.begin >= it->second)
+        {
+            last_time[e.name] = e.begin;
+            table[std::make_pair(e.type,std::string(e.name))].last = e.value;
+        }
+    }
+
+    std::vector<ProfilerStats> res;
+    for(const auto & obj : table) res.push_back(obj.second);
+    std::stable_sort(res.begin(), res.end(), [](const ProfilerStats & a, const ProfilerStats & b)
+    {
+        if(a.type!=b.type) return a.type < b.type;
+        return a.total > b.total;
+    });
+    return res;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void TraceProfiler::report() const
+{
+    std::vector<ProfilerStats> table = stats();
+
+    std::cout << "::::::::::::::: TRACE PROFILER STATISTICS :::::::::::::::" << std::endl;
+    printf("%12s %12s %10s %12s %12s %12s  %s\n", "total(s)", "self(s)", "calls", "avg(ms)", "min(ms)", "max(ms)", "zone");
+    for(const ProfilerStats & s : table)
+    {
+        if(s.type!=PROFILER_ZONE) continue;
+        printf("%12.6f %12.6f %10u %12.4f %12.4f %12.4f  %s\n", s.total, s.self, s.count,
+               1e3*s.total/s.count, 1e3*s.min, 1e3*s.max, s.name.c_str());
+    }
+    for(const ProfilerStats & s : table)
+    {
+        if(s.type==PROFILER_COUNTER) printf("counter %s: %.17g (%u updates)\n", s.name.c_str(), s.total, s.count);
+        if(s.type==PROFILER_GAUGE)   printf("gauge   %s: last %.17g, min %.17g, max %.17g (%u samples)\n",
+                                            s.name.c_str(), s.last, s.min, s.max, s.count);
+    }
+    std::cout << ":::::::::::::::::::::::::::::::::::::::::::::::::::::::::\n" << std::endl;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ProfilerZone::ProfilerZone(const char *name)
+{
+    TraceProfiler & p = TraceProfiler::instance();
+    if(p.enabled())
+    {
+        this->name  = name;
+        this->begin = p.now();
+    }
+    else this->name = nullptr;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+ProfilerZone::~ProfilerZone()
+{
+    if(name==nullptr) return;
+    TraceProfiler & p = TraceProfiler::instance();
+    p.zone(name, begin, p.now());
+}
+
+}
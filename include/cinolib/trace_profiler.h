@@ -0,0 +1,226 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_TRACE_PROFILER_H
+#define CINO_TRACE_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cinolib/cino_inline.h>
+
+namespace cinolib
+{
+
+/* Low overhead instrumentation for hot paths. Unlike Profiler, which keeps a
+ * call tree with string keys and must be driven by hand from a single thread,
+ * TraceProfiler records timestamped events from any number of threads:
+ *
+ *     zones    : scoped time intervals, opened and closed by ProfilerZone (RAII)
+ *     counters : quantities that accumulate over time (e.g. number of tests)
+ *     gauges   : quantities sampled at a given time (e.g. size of a queue)
+ *
+ * Each thread appends events to its own buffer, made of linked chunks of
+ * fixed size. Appending never takes a lock nor moves previous events, so
+ * that exports can run while other threads are still recording. The mutex is
+ * taken only once per thread, to register its buffer. Event names are not
+ * copied: they must outlive the profiler (string literals or __func__).
+ *
+ * Events can be exported in the Chrome trace format, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev, or summarized in a flat table
+ * (report).
+ *
+ * Library code is instrumented with the macros below, which expand to nothing
+ * unless symbol CINOLIB_USES_PROFILER is defined at compilation time:
+ *
+ *     CINO_PROFILE_ZONE("Octree::build"); // times the enclosing scope
+ *     CINO_PROFILE_FUNCTION();            // same, named after the function
+ *     CINO_PROFILE_COUNTER("tests", n);   // adds n to counter "tests"
+ *     CINO_PROFILE_GAUGE("queue", q);     // samples gauge "queue" with value q
+ *     CINO_PROFILE_THREAD("worker");      // names the calling thread in traces
+ *
+ * Recording can also be switched on and off at run time (set_enabled).
+*/
+
+enum
+{
+    PROFILER_ZONE,
+    PROFILER_COUNTER,
+    PROFILER_GAUGE,
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct ProfilerEvent
+{
+    const char   *name;
+    uint64_t      begin; // ns since the creation of the profiler
+    uint64_t      end;   // zones only
+    double        value; // counters (increment) and gauges (sample) only
+    unsigned int  type;
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+struct ProfilerStats
+{
+    std::string  name;
+    unsigned int type  = PROFILER_ZONE;
+    unsigned int count = 0;    // calls for zones, updates for counters and gauges
+    double       total = 0;    // seconds for zones, sum of increments for counters
+    double       self  = 0;    // zones only: seconds not spent into nested zones
+    double       min   = 0;    // seconds for zones, values for gauges
+    double       max   = 0;    // seconds for zones, values for gauges
+    double       last  = 0;    // gauges only
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class TraceProfiler
+{
+    public:
+
+        static TraceProfiler & instance();
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool enabled() const { return on.load(std::memory_order_relaxed); }
+        void set_enabled(const bool b) { on.store(b, std::memory_order_relaxed); }
+
+        uint64_t now() const; // ns since the creation of the profiler
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        void zone   (const char *name, const uint64_t begin, const uint64_t end);
+        void counter(const char *name, const double   increment);
+        void gauge  (const char *name, const double   value);
+
+        void set_thread_name(const std::string & name);
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        // drops all the events recorded so far. Must not run concurrently with
+        // threads that are recording events
+        void clear();
+
+        unsigned int num_events() const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        bool                       write_chrome_trace(const char *filename) const;
+        std::vector<ProfilerStats> stats() const; // zones first, most time consuming first
+        void                       report() const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+    protected:
+
+        static const unsigned int CHUNK_SIZE = 4096;
+
+        struct Chunk
+        {
+            ProfilerEvent         events[CHUNK_SIZE];
+            std::atomic<Chunk*>   next{nullptr};
+        };
+
+        struct ThreadBuffer
+        {
+            unsigned int          tid;
+            std::string           name;
+            Chunk                *head = nullptr;
+            Chunk                *tail = nullptr; // chunk where the next event goes
+            std::atomic<uint64_t> size{0};        // events published so far
+        };
+
+        TraceProfiler();
+
+        ThreadBuffer & thread_buffer(); // buffer of the calling thread (registered at first use)
+        void           append(const ProfilerEvent & e);
+
+        // copies the events published so far by each thread
+        std::vector<std::vector<ProfilerEvent>> snapshot(std::vector<std::string> * thread_names = nullptr) const;
+
+        //::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+        std::atomic<bool>                 on{true};
+        uint64_t                          epoch;   // steady clock ns at creation
+        mutable std::mutex                mutex;   // guards buffers
+        std::vector<ThreadBuffer*>        buffers; // one per thread that ever recorded an event
+};
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+class ProfilerZone
+{
+    public:
+
+        explicit ProfilerZone(const char *name);
+                ~ProfilerZone();
+
+        ProfilerZone(const ProfilerZone &) = delete;
+        ProfilerZone & operator=(const ProfilerZone &) = delete;
+
+    protected:
+
+        const char *name; // nullptr if the profiler was disabled when the zone was opened
+        uint64_t    begin;
+};
+
+}
+
+#define CINO_PROFILE_CAT_(a,b) a##b
+#define CINO_PROFILE_CAT(a,b)  CINO_PROFILE_CAT_(a,b)
+
+#ifdef CINOLIB_USES_PROFILER
+#define CINO_PROFILE_ZONE(name)       cinolib::ProfilerZone CINO_PROFILE_CAT(cino_profiler_zone_,__LINE__)(name)
+#define CINO_PROFILE_FUNCTION()       CINO_PROFILE_ZONE(__func__)
+#define CINO_PROFILE_COUNTER(name,n)  cinolib::TraceProfiler::instance().counter(name,n)
+#define CINO_PROFILE_GAUGE(name,v)    cinolib::TraceProfiler::instance().gauge(name,v)
+#define CINO_PROFILE_THREAD(name)     cinolib::TraceProfiler::instance().set_thread_name(name)
+#else
+#define CINO_PROFILE_ZONE(name)       ((void)0)
+#define CINO_PROFILE_FUNCTION()       ((void)0)
+#define CINO_PROFILE_COUNTER(name,n)  ((void)0)
+#define CINO_PROFILE_GAUGE(name,v)    ((void)0)
+#define CINO_PROFILE_THREAD(name)     ((void)0)
+#endif
+
+#ifndef  CINO_STATIC_LIB
+#include "trace_profiler.cpp"
+#endif
+
+#endif // CINO_TRACE_PROFILER_H
@@ -85,8 +85,8 @@ IntegralCurve<Mesh>::IntegralCurve(const Mesh        & m,
     , m_ptr(&m)
     , grad_ptr(&grad)
 {
-    assert(!m.adj_v2p(vid).empty());
-    unsigned int pid = m.adj_v2p(vid).front();
+    assert(!m.adj_v2p_span(vid).empty());
+    unsigned int pid = m.adj_v2p_span(vid).front();
 
     unsigned int off = 0;
     while(off<m.verts_per_poly() && m.poly_vert_id(pid,off)!=vid) ++off;
@@ -159,7 +159,7 @@ bool IntegralCurve<Mesh>::is_on_edge(const Sample & s, unsigned int & eid, const
     {
         unsigned int vid0 = m_ptr->poly_vert_id(s.pid, non_zero_coords.at(0));
         unsigned int vid1 = m_ptr->poly_vert_id(s.pid, non_zero_coords.at(1));
-        for(unsigned int id : m_ptr->adj_p2e(s.pid))
+        for(unsigned int id : m_ptr->adj_p2e_span(s.pid))
         {
             if (m_ptr->edge_contains_vert(id, vid0) &&
                 m_ptr->edge_contains_vert(id, vid1))
@@ -179,8 +179,8 @@ template<class Mesh>
 CINO_INLINE
 Curve::Sample IntegralCurve<Mesh>::make_sample(const unsigned int vid) const
 {
-    assert(!m_ptr->adj_v2p(vid).empty());
-    unsigned int pid = m_ptr->adj_v2p(vid).front();
+    assert(!m_ptr->adj_v2p_span(vid).empty());
+    unsigned int pid = m_ptr->adj_v2p_span(vid).front();
     unsigned int off = m_ptr->poly_vert_offset(pid, vid);
     Sample s;
     s.pos  = m_ptr->vert(vid);
@@ -229,19 +229,19 @@ Curve::Sample IntegralCurve<Trimesh<>>::move_forward_from_vertex(const unsigned
     Plane tangent_plane(v,n);
 
     vec3d grad{0,0,0};
-    for(unsigned int fid : m_ptr->adj_v2p(vid)) grad += grad_ptr->vec_at(fid);
+    for(unsigned int fid : m_ptr->adj_v2p_span(vid)) grad += grad_ptr->vec_at(fid);
     grad = tangent_plane.project_onto(v+grad) - v;
     grad.normalize();
     assert(grad.norm() > 0);
 
     std::map<unsigned int,vec3d> tangent_space;
-    for(unsigned int nbr : m_ptr->adj_v2v(vid))
+    for(unsigned int nbr : m_ptr->adj_v2v_span(vid))
     {
         tangent_space[nbr] = tangent_plane.project_onto(m_ptr->vert(nbr));
     }
     tangent_space[vid] = m_ptr->vert(vid);
 
-    for(unsigned int fid : m_ptr->adj_v2p(vid))
+    for(unsigned int fid : m_ptr->adj_v2p_span(vid))
     {
         int     eid = m_ptr->edge_opposite_to(fid, vid); assert(eid >= 0);
         vec3d   e0  = tangent_space.at( m_ptr->edge_vert_id(eid,0) );
@@ -273,8 +273,8 @@ CINO_INLINE
 Curve::Sample IntegralCurve<Trimesh<>>::move_forward_from_edge(const unsigned int eid, const vec3d & p)
 {
     assert(m_ptr->edge_is_manifold(eid));
-    unsigned int   f0 = m_ptr->adj_e2p(eid).front();
-    unsigned int   f1 = m_ptr->adj_e2p(eid).back();
+    unsigned int   f0 = m_ptr->adj_e2p_span(eid).front();
+    unsigned int   f1 = m_ptr->adj_e2p_span(eid).back();
     unsigned int   v0 = m_ptr->edge_vert_id(eid,0);
     unsigned int   v1 = m_ptr->edge_vert_id(eid,1);
     unsigned int   v2 = m_ptr->vert_opposite_to(f0, v0, v1);
@@ -320,8 +320,8 @@ Curve::Sample IntegralCurve<Trimesh<>>::move_forward_from_edge(const unsigned in
     assert(grad.norm() > 0);
 
     std::vector<ipair> edges_to_check;
-    for(unsigned int e : m_ptr->adj_p2e(f0)) if (e!=eid) edges_to_check.push_back(std::make_pair(e,f0));
-    for(unsigned int e : m_ptr->adj_p2e(f1)) if (e!=eid) edges_to_check.push_back(std::make_pair(e,f1));
+    for(unsigned int e : m_ptr->adj_p2e_span(f0)) if (e!=eid) edges_to_check.push_back(std::make_pair(e,f0));
+    for(unsigned int e : m_ptr->adj_p2e_span(f1)) if (e!=eid) edges_to_check.push_back(std::make_pair(e,f1));
 
     for(auto obj : edges_to_check)
     {
@@ -540,11 +540,11 @@ Curve::Sample IntegralCurve<Tetmesh<>>::move_forward_from_vertex(const unsigned
 {
     vec3d p = m_ptr->vert(vid);
     vec3d grad{0,0,0};
-    for(unsigned int pid : m_ptr->adj_v2p(vid)) grad += grad_ptr->vec_at(pid);
+    for(unsigned int pid : m_ptr->adj_v2p_span(vid)) grad += grad_ptr->vec_at(pid);
     grad.normalize();
     assert(grad.norm() > 0);
 
-    for(unsigned int pid : m_ptr->adj_v2p(vid))
+    for(unsigned int pid : m_ptr->adj_v2p_span(vid))
     {
         unsigned int  fid = m_ptr->poly_face_opposite_to(pid, vid);
         vec3d v0  = m_ptr->poly_vert(pid, TET_FACES[fid][0]);
@@ -576,14 +576,14 @@ CINO_INLINE
 Curve::Sample IntegralCurve<Tetmesh<>>::move_forward_from_edge(const unsigned int eid, const vec3d & p)
 {
     vec3d grad{0,0,0};
-    for(unsigned int pid : m_ptr->adj_e2p(eid)) grad += grad_ptr->vec_at(pid);
+    for(unsigned int pid : m_ptr->adj_e2p_span(eid)) grad += grad_ptr->vec_at(pid);
     grad.normalize();
     assert(grad.norm() > 0);
 
     unsigned int v0 = m_ptr->edge_vert_id(eid, 0);
     unsigned int v1 = m_ptr->edge_vert_id(eid, 1);
 
-    for(unsigned int pid : m_ptr->adj_e2p(eid))
+    for(unsigned int pid : m_ptr->adj_e2p_span(eid))
     {
         for(unsigned int f=0; f<m_ptr->faces_per_poly(); ++f)
         {
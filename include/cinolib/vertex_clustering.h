@@ -40,15 +40,26 @@
 #include <vector>
 #include <sys/types.h>
 #include <cinolib/cino_inline.h>
+#include <cinolib/geometry/vec_mat.h>
 
 
 namespace cinolib
 {
 
 /* Groups a list of vertices in clusters of elements closer
- * to each other less than a given proximity threshold
+ * to each other less than a given proximity threshold. Clusters
+ * are the connected components of the proximity graph, and are
+ * appended to the output sorted by their lowest vertex id.
  *
- * NOTE: class Vertex should implement the dist() operator
+ * Points are hashed in a uniform grid with cells as large as the
+ * threshold, so that only pairs of points in neighboring cells are
+ * tested. Pair tests run in parallel, and clusters are merged with
+ * a union-find. The cost is linear in the number of points, unless
+ * they are packed much closer than the threshold.
+ *
+ * NOTE: class Vertex should implement the dist() operator. Vertices
+ * that are not cinolib vectors (vec2d, vec3d, ...) cannot be hashed,
+ * and fall back to testing all pairs
 */
 
 template<class Vertex>
@@ -57,6 +68,17 @@ void vertex_clustering(const std::vector<Vertex>             & points,
                        const double                            proximity_thresh,
                        std::vector<std::unordered_set<unsigned int>> & clusters);
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+// grid coordinates of a vertex (up to three). Returns false for types that cannot be hashed
+template<class Vertex>
+CINO_INLINE
+bool vertex_clustering_coords(const Vertex & p, double xyz[3]);
+
+template<unsigned int d, class T>
+CINO_INLINE
+bool vertex_clustering_coords(const mat<d,1,T> & p, double xyz[3]);
+
 }
 
 #include "vertex_clustering.tpp"
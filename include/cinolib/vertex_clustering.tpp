@@ -34,7 +34,10 @@
 *     Italy                                                                     *
 *********************************************************************************/
 #include <cinolib/vertex_clustering.h>
-#include <cinolib/bfs.h>
+#include <cinolib/parallel_for.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 
 namespace cinolib
 {
@@ -45,37 +48,154 @@ void vertex_clustering(const std::vector<Vertex>             & points,
                        const double                            proximity_thresh,
                        std::vector<std::unordered_set<unsigned int>> & clusters)
 {
-    // build v2v connectivity based on point proximity
-    std::vector<std::vector<unsigned int>> v2v(points.size());
-    for(unsigned int vid0=0;      vid0<points.size()-1; ++vid0)
-    for(unsigned int vid1=vid0+1; vid1<points.size();   ++vid1)
+    typedef std::array<int64_t,3> Cell;
+
+    unsigned int nv = points.size();
+    if(nv==0) return;
+
+    // union-find with path halving. Roots are always the lowest id in
+    // the set, so that clusters come out in the same order of a visit
+    // seeded from the lowest unvisited vertex
+    std::vector<unsigned int> parent(nv);
+    for(unsigned int vid=0; vid<nv; ++vid) parent[vid] = vid;
+    auto find = [&parent](unsigned int vid)
     {
-        if (points.at(vid0).dist(points.at(vid1)) < proximity_thresh)
+        while(parent[vid]!=vid)
         {
-            v2v.at(vid0).push_back(vid1);
-            v2v.at(vid1).push_back(vid0);
+            parent[vid] = parent[parent[vid]];
+            vid = parent[vid];
         }
-    }
+        return vid;
+    };
 
-    // visit the resulting graph with BFS to
-    // isolate clusters of adjacent vertices
-    unsigned int nv   = points.size();
-    unsigned int seed = 0;
-    std::vector<bool> visited(nv, false);
-    do
+    // distances are never negative: with no positive threshold all clusters are singletons
+    if(proximity_thresh>0)
     {
-        std::unordered_set<unsigned int> cluster;
-        bfs(v2v, seed, cluster);
+        // grid coordinates and bounding box
+        std::vector<std::array<double,3>> xyz(nv);
+        bool hashable = true;
+        for(unsigned int vid=0; vid<nv && hashable; ++vid)
+        {
+            hashable = vertex_clustering_coords(points[vid], xyz[vid].data());
+        }
+        std::array<double,3> min = {0,0,0}, max = {0,0,0};
+        if(hashable)
+        {
+            min = max = xyz[0];
+            for(const auto & p : xyz)
+            for(int i=0; i<3; ++i)
+            {
+                min[i] = std::min(min[i], p[i]);
+                max[i] = std::max(max[i], p[i]);
+            }
+        }
+
+        // cells must be at least as large as the threshold, so that close points are
+        // either in the same cell or in adjacent ones. Cells are also kept above a tiny
+        // fraction of the bbox, so that cell coordinates never overflow
+        double diag = std::sqrt((max[0]-min[0])*(max[0]-min[0]) +
+                                (max[1]-min[1])*(max[1]-min[1]) +
+                                (max[2]-min[2])*(max[2]-min[2]));
+        double h = std::max(proximity_thresh, diag*std::ldexp(1.0,-40));
+
+        // sort vertices by cell, so that each cell is a contiguous range
+        std::vector<std::pair<Cell,unsigned int>> order(nv);
+        PARALLEL_FOR(0, nv, 10000, [&](const unsigned int vid)
+        {
+            Cell c = {0,0,0};
+            if(hashable)
+            {
+                for(int i=0; i<3; ++i) c[i] = (int64_t)std::floor((xyz[vid][i]-min[i])/h);
+            }
+            order[vid] = std::make_pair(c,vid);
+        });
+        std::sort(order.begin(), order.end());
+
+        std::vector<Cell>         cells;
+        std::vector<unsigned int> cell_beg;
+        for(unsigned int i=0; i<nv; ++i)
+        {
+            if(i==0 || order[i].first!=order[i-1].first)
+            {
+                cells.push_back(order[i].first);
+                cell_beg.push_back(i);
+            }
+        }
+        cell_beg.push_back(nv);
+
+        // each cell is tested against itself and against the half of its neighbors that
+        // comes after it in lexicographic order, so that each pair of cells is visited once
+        std::vector<std::vector<std::pair<unsigned int,unsigned int>>> links(cells.size());
+        PARALLEL_FOR(0, cells.size(), 100, [&](const unsigned int cid)
+        {
+            for(int64_t di=-1; di<=1; ++di)
+            for(int64_t dj=-1; dj<=1; ++dj)
+            for(int64_t dk=-1; dk<=1; ++dk)
+            {
+                Cell off = {di,dj,dk};
+                if(off<Cell{0,0,0}) continue;
+
+                Cell c = {cells[cid][0]+di, cells[cid][1]+dj, cells[cid][2]+dk};
+                auto it = std::lower_bound(cells.begin()+cid, cells.end(), c);
+                if(it==cells.end() || *it!=c) continue;
+                unsigned int nid = it - cells.begin();
 
-        clusters.push_back(cluster);
-        for(unsigned int vid : cluster) visited.at(vid) = true;
+                for(unsigned int i=cell_beg[cid]; i<cell_beg[cid+1]; ++i)
+                for(unsigned int j=(nid==cid) ? i+1 : cell_beg[nid]; j<cell_beg[nid+1]; ++j)
+                {
+                    unsigned int vid0 = order[i].second;
+                    unsigned int vid1 = order[j].second;
+                    if(points[vid0].dist(points[vid1]) < proximity_thresh)
+                    {
+                        links[cid].push_back(std::make_pair(vid0,vid1));
+                    }
+                }
+            }
+        });
 
-        seed = 0;
-        while (seed < nv && visited.at(seed)) ++seed;
+        for(const auto & l : links)
+        for(const auto & e : l)
+        {
+            unsigned int r0 = find(e.first);
+            unsigned int r1 = find(e.second);
+            if(r0<r1) parent[r1] = r0; else
+            if(r1<r0) parent[r0] = r1;
+        }
+    }
+
+    // roots are visited before the other members of their cluster
+    std::vector<unsigned int> cluster_id(nv);
+    for(unsigned int vid=0; vid<nv; ++vid)
+    {
+        unsigned int root = find(vid);
+        if(root==vid)
+        {
+            cluster_id[vid] = clusters.size();
+            clusters.emplace_back();
+        }
+        else cluster_id[vid] = cluster_id[root];
+        clusters.at(cluster_id[vid]).insert(vid);
     }
-    while (seed < nv);
 }
 
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+template<class Vertex>
+CINO_INLINE
+bool vertex_clustering_coords(const Vertex &, double xyz[3])
+{
+    xyz[0] = xyz[1] = xyz[2] = 0;
+    return false;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
+template<unsigned int d, class T>
+CINO_INLINE
+bool vertex_clustering_coords(const mat<d,1,T> & p, double xyz[3])
+{
+    for(unsigned int i=0; i<3; ++i) xyz[i] = (i<d) ? (double)p[i] : 0.0;
+    return d<=3;
 }
 
+}
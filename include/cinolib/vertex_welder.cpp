@@ -0,0 +1,145 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/vertex_welder.h>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+
+namespace cinolib
+{
+
+CINO_INLINE
+VertexWelder::VertexWelder(const double eps) : eps(eps)
+{
+    assert(eps>=0);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void VertexWelder::clear()
+{
+    pos.clear();
+    next.clear();
+    cells.clear();
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+void VertexWelder::reserve(const unsigned int n)
+{
+    pos.reserve(n);
+    next.reserve(n);
+    cells.reserve(n);
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+VertexWelder::Key VertexWelder::key(const vec3d & p) const
+{
+    Key k;
+    if(eps==0)
+    {
+        // exact welding: hash the bit pattern (adding zero maps -0 to +0)
+        double x = p[0]+0.0, y = p[1]+0.0, z = p[2]+0.0;
+        memcpy(&k.i, &x, sizeof(double));
+        memcpy(&k.j, &y, sizeof(double));
+        memcpy(&k.k, &z, sizeof(double));
+    }
+    else
+    {
+        k.i = (int64_t)std::floor(p[0]/eps);
+        k.j = (int64_t)std::floor(p[1]/eps);
+        k.k = (int64_t)std::floor(p[2]/eps);
+    }
+    return k;
+}
+
+//::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+CINO_INLINE
+unsigned int VertexWelder::weld(const vec3d & p)
+{
+    Key k = key(p);
+
+    if(eps==0)
+    {
+        auto it = cells.find(k);
+        if(it!=cells.end()) return it->second;
+    }
+    else
+    {
+        // cells have the size of eps, hence a match can only be in the 27 cells around p
+        unsigned int best_id   = UINT_MAX;
+        double       best_dist = inf_double;
+        for(int64_t di=-1; di<=1; ++di)
+        for(int64_t dj=-1; dj<=1; ++dj)
+        for(int64_t dk=-1; dk<=1; ++dk)
+        {
+            auto it = cells.find(Key{k.i+di, k.j+dj, k.k+dk});
+            if(it==cells.end()) continue;
+            for(unsigned int vid=it->second; vid!=UINT_MAX; vid=next.at(vid))
+            {
+                double d = p.dist(pos.at(vid));
+                if(d<=eps && (d<best_dist || (d==best_dist && vid<best_id)))
+                {
+                    best_id   = vid;
+                    best_dist = d;
+                }
+            }
+        }
+        if(best_id!=UINT_MAX) return best_id;
+    }
+
+    unsigned int fresh_id = (unsigned int)pos.size();
+    pos.push_back(p);
+    auto it = cells.find(k);
+    if(it==cells.end())
+    {
+        next.push_back(UINT_MAX);
+        cells[k] = fresh_id;
+    }
+    else
+    {
+        next.push_back(it->second);
+        it->second = fresh_id;
+    }
+    return fresh_id;
+}
+
+}
@@ -0,0 +1,106 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_VERTEX_WELDER_H
+#define CINO_VERTEX_WELDER_H
+
+#include <cinolib/geometry/vec_mat.h>
+#include <cinolib/min_max_inf.h>
+#include <unordered_map>
+#include <cstdint>
+#include <climits>
+
+namespace cinolib
+{
+
+/* Incremental vertex welding based on a hash of quantized coordinates.
+ * Points are fed one at a time with weld(), which returns the id of the
+ * welded vertex (a fresh id if no previously inserted vertex lies within
+ * eps, the id of the closest such vertex otherwise). Ids are assigned in
+ * order of first appearance, making it suitable to index triangle soups
+ * streamed from disk without ever storing the soup itself. With eps=0
+ * only vertices with exactly the same coordinates are welded.
+ *
+ * Memory is proportional to the number of unique vertices.
+*/
+
+class VertexWelder
+{
+    public:
+
+        explicit VertexWelder(const double eps = 0.0);
+
+        unsigned int weld(const vec3d & p);
+
+        void clear();
+        void reserve(const unsigned int n);
+
+        unsigned int               num_verts() const { return (unsigned int)pos.size(); }
+        const std::vector<vec3d> & verts()     const { return pos; }
+
+    protected:
+
+        struct Key
+        {
+            int64_t i, j, k;
+            bool operator==(const Key & k1) const { return i==k1.i && j==k1.j && k==k1.k; }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key & k) const
+            {
+                uint64_t h = (uint64_t)k.i * 73856093ull;
+                h ^= (uint64_t)k.j * 19349663ull + (h<<6) + (h>>2);
+                h ^= (uint64_t)k.k * 83492791ull + (h<<6) + (h>>2);
+                return (size_t)h;
+            }
+        };
+
+        Key key(const vec3d & p) const;
+
+        double                                  eps;
+        std::vector<vec3d>                      pos;
+        std::vector<unsigned int>               next; // verts in the same cell are chained
+        std::unordered_map<Key,unsigned int,KeyHash> cells;
+};
+
+}
+
+#ifndef  CINO_STATIC_LIB
+#include "vertex_welder.cpp"
+#endif
+
+#endif // CINO_VERTEX_WELDER_H
@@ -0,0 +1,65 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#ifndef CINO_WELD_VERTICES_H
+#define CINO_WELD_VERTICES_H
+
+#include <cinolib/meshes/abstract_polygonmesh.h>
+
+namespace cinolib
+{
+
+/* Merges all the vertices of a mesh that are closer than eps to each other
+ * (or exactly coincident, if eps is zero), rewriting its connectivity in place.
+ * Each cluster of vertices collapses onto its lowest id, which keeps position
+ * and attributes. Polygons that degenerate are removed, as are duplicated ones.
+ * For triangle and quad meshes polygons that lose a vertex are degenerate too.
+ * Vertex, edge and polygon attributes are preserved. Edges that collapse onto
+ * the same edge keep the attributes of the one with lowest id, as vertices do.
+ * Returns the number of removed vertices.
+ *
+ * Useful to stitch polygon soups (e.g. from STL files) and assemblies of
+ * meshes sharing boundaries.
+*/
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int weld_vertices(AbstractPolygonMesh<M,V,E,P> & m, const double eps);
+
+}
+
+#include "weld_vertices.tpp"
+
+#endif // CINO_WELD_VERTICES_H
@@ -0,0 +1,131 @@
+/********************************************************************************
+*  This file is part of CinoLib                                                 *
+*  Copyright(C) 2016: Marco Livesu                                              *
+*                                                                               *
+*  The MIT License                                                              *
+*                                                                               *
+*  Permission is hereby granted, free of charge, to any person obtaining a      *
+*  copy of this software and associated documentation files (the "Software"),   *
+*  to deal in the Software without restriction, including without limitation    *
+*  the rights to use, copy, modify, merge, publish, distribute, sublicense,     *
+*  and/or sell copies of the Software, and to permit persons to whom the        *
+*  Software is furnished to do so, subject to the following conditions:         *
+*                                                                               *
+*  The above copyright notice and this permission notice shall be included in   *
+*  all copies or substantial portions of the Software.                          *
+*                                                                               *
+*  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR   *
+*  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,     *
+*  FITNESS FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE *
+*  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+*  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING      *
+*  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS *
+*  IN THE SOFTWARE.                                                             *
+*                                                                               *
+*  Author(s):                                                                   *
+*                                                                               *
+*     Marco Livesu (marco.livesu@gmail.com)                                     *
+*     http://pers.ge.imati.cnr.it/livesu/                                       *
+*                                                                               *
+*     Italian National Research Council (CNR)                                   *
+*     Institute for Applied Mathematics and Information Technologies (IMATI)    *
+*     Via de Marini, 6                                                          *
+*     16149 Genoa,                                                              *
+*     Italy                                                                     *
+*********************************************************************************/
+#include <cinolib/weld_vertices.h>
+#include <cinolib/vertex_clustering.h>
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <set>
+
+namespace cinolib
+{
+
+template<class M, class V, class E, class P>
+CINO_INLINE
+unsigned int weld_vertices(AbstractPolygonMesh<M,V,E,P> & m, const double eps)
+{
+    assert(eps>=0);
+    assert(!m.batch_edits_open());
+
+    // with eps equal to zero only coincident vertices are merged
+    double thresh = (eps>0) ? eps : std::numeric_limits<double>::denorm_min();
+
+    std::vector<std::unordered_set<unsigned int>> clusters;
+    vertex_clustering(m.vector_verts(), thresh, clusters);
+    if(clusters.size()==m.num_verts()) return 0;
+
+    // clusters are sorted by their lowest vertex id, hence
+    // the surviving vertices do not change their relative order
+    std::vector<unsigned int> v_map(m.num_verts());
+    std::vector<vec3d>        verts(clusters.size());
+    std::vector<V>            v_data(clusters.size());
+    for(unsigned int cid=0; cid<clusters.size(); ++cid)
+    {
+        unsigned int rep = *std::min_element(clusters.at(cid).begin(), clusters.at(cid).end());
+        for(unsigned int vid : clusters.at(cid)) v_map.at(vid) = cid;
+        verts.at(cid)  = m.vert(rep);
+        v_data.at(cid) = m.vert_data(rep);
+    }
+
+    bool fixed_size = (m.mesh_type()==TRIMESH || m.mesh_type()==QUADMESH);
+
+    std::vector<std::vector<unsigned int>> polys;
+    std::vector<P>                         p_data;
+    std::set<std::vector<unsigned int>>    visited;
+    polys.reserve(m.num_polys());
+    p_data.reserve(m.num_polys());
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid)
+    {
+        // remap, dropping consecutive copies of the same vertex
+        std::vector<unsigned int> p;
+        for(unsigned int vid : m.poly_verts_id(pid))
+        {
+            unsigned int new_vid = v_map.at(vid);
+            if(p.empty() || p.back()!=new_vid) p.push_back(new_vid);
+        }
+        while(p.size()>1 && p.front()==p.back()) p.pop_back();
+        if(p.size()<3) continue;
+        if(fixed_size && p.size()<m.verts_per_poly(pid)) continue;
+
+        // non simple polygons are degenerate, and duplicated polygons are discarded
+        std::vector<unsigned int> key = p;
+        std::sort(key.begin(), key.end());
+        if(std::adjacent_find(key.begin(), key.end())!=key.end()) continue;
+        if(!visited.insert(key).second) continue;
+
+        polys.push_back(p);
+        p_data.push_back(m.poly_data(pid));
+    }
+
+    // edges are remapped through v_map as well. Edges that collapse onto the
+    // same welded edge keep the attributes of the one with lowest id
+    std::map<ipair,E> e_data;
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        unsigned int v0 = v_map.at(m.edge_vert_id(eid,0));
+        unsigned int v1 = v_map.at(m.edge_vert_id(eid,1));
+        if(v0!=v1) e_data.emplace(unique_pair(v0,v1), m.edge_data(eid));
+    }
+
+    unsigned int nv = m.num_verts();
+    M m_data = m.mesh_data();
+    m.clear();
+    m.mesh_data() = m_data;
+    m.init(verts, polys);
+
+    for(unsigned int vid=0; vid<m.num_verts(); ++vid) m.vert_data(vid) = v_data.at(vid);
+    for(unsigned int pid=0; pid<m.num_polys(); ++pid) m.poly_data(pid) = p_data.at(pid);
+    for(unsigned int eid=0; eid<m.num_edges(); ++eid)
+    {
+        auto it = e_data.find(unique_pair(m.edge_vert_id(eid,0), m.edge_vert_id(eid,1)));
+        if(it!=e_data.end()) m.edge_data(eid) = it->second;
+    }
+    if(m.mesh_data().update_normals) m.update_normals();
+
+    return nv - m.num_verts();
+}
+
+}
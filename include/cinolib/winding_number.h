@@ -52,6 +52,9 @@ namespace cinolib
  *
  * WARNING: input meshes are assumed to be watertight 2 manifolds.
  * No explicit checks are performed.
+ *
+ * NOTE: these functions cost O(#triangles) per query. To classify
+ * many points against the same mesh, see FastWindingNumber
 */
 
 CINO_INLINE